@@ -0,0 +1,82 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _CMDQUEUE_
+#define _CMDQUEUE_
+
+/* Wait-free single producer, single consumer command ring.
+**
+** The producer (Python code, holding the GIL) pushes fixed size commands that
+** the consumer (the code computing the audio blocks) pops and applies at the
+** start of a block, so the processing state is only written by one thread.
+** Push and pop never block nor allocate; push fails when the ring is full.
+**
+** Resources the consumer may still hold a pointer to (a replaced buffer, an
+** input stream) are handed to PyoCommandQueue_defer. They are released, on the
+** producer side, once the consumer has popped every command pushed before.
+*/
+
+typedef struct {
+    int type; /* defined by the consumer */
+    int index;
+    int index2;
+    int index3;
+    double value;
+    void *ptr;
+    void *ptr2;
+    void *ptr3;
+    unsigned long long time; /* sample at which the command applies, if the consumer uses it */
+} PyoCommand;
+
+typedef struct {
+    unsigned int seq; /* value of head when deferred */
+    void *ptr;
+    void (*release)(void *);
+} PyoDeferred;
+
+typedef struct {
+    PyoCommand *ring;
+    unsigned int mask; /* size - 1, size is a power of two */
+    volatile unsigned int head; /* commands pushed, written by the producer */
+    volatile unsigned int tail; /* commands popped, written by the consumer */
+    PyoDeferred *deferred; /* producer only */
+    int num_deferred;
+    int max_deferred;
+} PyoCommandQueue;
+
+/* `size` is rounded up to a power of two. */
+PyoCommandQueue * PyoCommandQueue_new(int size);
+/* Releases the deferred resources, even those still pending. */
+void PyoCommandQueue_free(PyoCommandQueue *self);
+/* Producer. Returns 0, or -1 if the ring is full. */
+int PyoCommandQueue_push(PyoCommandQueue *self, const PyoCommand *cmd);
+/* Consumer. Returns 1 and copies the oldest command in `cmd`, or 0 if the ring is empty. */
+int PyoCommandQueue_pop(PyoCommandQueue *self, PyoCommand *cmd);
+/* Returns the number of commands waiting in the ring (either side). */
+int PyoCommandQueue_count(PyoCommandQueue *self);
+/* Neither side may run concurrently. Changes to `type` the type of the waiting commands whose ptr is
+   `ptr`, usually to turn the commands about a deleted object into no-ops. */
+void PyoCommandQueue_cancel(PyoCommandQueue *self, void *ptr, int type);
+/* Producer. Schedules `release(ptr)` for when the consumer has caught up with the commands already pushed. */
+void PyoCommandQueue_defer(PyoCommandQueue *self, void *ptr, void (*release)(void *));
+/* Producer. Releases the deferred resources the consumer can't use anymore (also done by push). */
+void PyoCommandQueue_collect(PyoCommandQueue *self);
+
+#endif
@@ -0,0 +1,96 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _DENORMALS_
+#define _DENORMALS_
+
+/* Denormal (subnormal) numbers handling of the audio threads.
+**
+** Recursive filters, reverbs and delay feedback paths decaying towards silence
+** end up computing with subnormal numbers, which are tens of times slower than
+** normal ones on most cpus. Unless told otherwise, the server computes every
+** block with the flush-to-zero and denormals-are-zero modes of the floating-
+** point unit set (MXCSR on x86 with SSE, FPCR/FPSCR on ARM), and gives back to
+** the calling thread its own mode at the end of the block. The scheduler's
+** workers copy the mode of the audio thread. On other targets these functions
+** do nothing.
+**
+** This header expects MYFLT to be defined (include pyomodule.h first).
+*/
+
+#if defined(__SSE__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#define PYO_FP_FLUSH_BITS 0x8040 /* FTZ and DAZ */
+#elif defined(__aarch64__) || (defined(__arm__) && defined(__ARM_NEON))
+#define PYO_FP_FLUSH_BITS (1 << 24) /* FZ */
+#else
+#define PYO_FP_FLUSH_BITS 0
+#endif
+
+/* Returns the floating-point control word of the calling thread. */
+static inline unsigned long
+PyoDenormals_getControl(void)
+{
+#if defined(__SSE__) || defined(__x86_64__)
+    return _mm_getcsr();
+#elif defined(__aarch64__)
+    unsigned long fpcr;
+    __asm__ __volatile__ ("mrs %0, fpcr" : "=r" (fpcr));
+    return fpcr;
+#elif defined(__arm__) && defined(__ARM_NEON)
+    unsigned int fpscr;
+    __asm__ __volatile__ ("vmrs %0, fpscr" : "=r" (fpscr));
+    return fpscr;
+#else
+    return 0;
+#endif
+}
+
+static inline void
+PyoDenormals_setControl(unsigned long control)
+{
+#if defined(__SSE__) || defined(__x86_64__)
+    _mm_setcsr((unsigned int)control);
+#elif defined(__aarch64__)
+    __asm__ __volatile__ ("msr fpcr, %0" : : "r" (control));
+#elif defined(__arm__) && defined(__ARM_NEON)
+    __asm__ __volatile__ ("vmsr fpscr, %0" : : "r" ((unsigned int)control));
+#else
+    (void)control;
+#endif
+}
+
+/* Turns flushing on (flush = 1) or off (flush = 0) for the calling thread. 
+** Returns the previous control word, to give to PyoDenormals_setControl. */
+static inline unsigned long
+PyoDenormals_enter(int flush)
+{
+    unsigned long control = PyoDenormals_getControl();
+    unsigned long wanted = flush ? (control | PYO_FP_FLUSH_BITS) : (control & ~(unsigned long)PYO_FP_FLUSH_BITS);
+    if (wanted != control)
+        PyoDenormals_setControl(wanted);
+    return control;
+}
+
+/* Returns the number of subnormal values in data. The bits are inspected 
+** directly, so the result doesn't depend on the denormals-are-zero mode. */
+unsigned long PyoDenormals_count(MYFLT *data, int size);
+
+#endif
@@ -0,0 +1,98 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _DISKSTREAM_
+#define _DISKSTREAM_
+
+#include "pyomodule.h"
+#include "sndfile.h"
+
+/* Background streaming of sound files for the disk players.
+**
+** A PyoDiskStream owns the SNDFILE of a player. Only the reader threads (a
+** small pool shared by every stream) call libsndfile; the audio thread reads
+** the frames from a cache of fixed size blocks and publishes, after each
+** buffer, where it is, in which direction and at which rate it reads and where
+** the next jump (loop or marker) will land. The readers use these hints to keep
+** filled, for each stream, a window starting at the play head (main area) and
+** the first blocks after the next jump (head area). The stream closest to
+** running dry, in seconds at its current speed, is served first.
+**
+** Both areas are rings of blocks indexed by block number, so a window of
+** consecutive blocks never collides with itself. A block is guarded by a
+** sequence counter: the reader makes it odd while writing and the audio thread
+** discards the copy if the counter changed, so no lock is ever taken in the
+** audio callback. A missing block is requested to the readers and replaced by
+** silence (counted as an underrun), unless the stream is blocking (offline
+** rendering), where the audio thread waits for the data.
+*/
+
+#define PYO_DISK_BLOCK_SIZE 4096 /* frames */
+
+typedef struct {
+    volatile int seq;
+    volatile long block;
+    int frames;
+    MYFLT *data; /* interleaved */
+} PyoDiskBlock;
+
+typedef struct _PyoDiskStream {
+    SNDFILE *sf;
+    SF_INFO info;
+    long nblocks;
+    int main_size; /* blocks in main area */
+    int head_size; /* blocks in head area */
+    PyoDiskBlock *main;
+    PyoDiskBlock *head;
+    MYFLT *readbuf;
+    /* hints published by the audio thread */
+    volatile double pos;
+    volatile int dir;
+    volatile double rate; /* file frames per second */
+    volatile double seg_end;
+    volatile double next_start;
+    volatile long demand;
+    int blocking;
+    int underruns;
+    /* reader side */
+    int busy;
+    struct _PyoDiskStream *next;
+} PyoDiskStream;
+
+/* Opens `path`, fills `info` and starts preloading from `start`. Returns NULL
+   if the file can't be opened. Must be called with the GIL. */
+PyoDiskStream * PyoDiskStream_open(const char *path, SF_INFO *info, double start);
+/* Waits for the reader working on the stream, if any, and closes it. */
+void PyoDiskStream_close(PyoDiskStream *self);
+/* Copies `frames` interleaved frames starting at file frame `start` into `out`,
+   frames outside the file are zeros. Never calls libsndfile. */
+void PyoDiskStream_read(PyoDiskStream *self, long start, int frames, MYFLT *out);
+/* Reading hints: position, direction (1, -1 or 0), rate in file frames per
+   second, end of the current segment and start of the next one. */
+void PyoDiskStream_setPosition(PyoDiskStream *self, double pos, int dir, double rate,
+                               double seg_end, double next_start);
+void PyoDiskStream_setBlocking(PyoDiskStream *self, int blocking);
+int PyoDiskStream_getUnderruns(PyoDiskStream *self);
+
+/* Settings used by the streams opened afterwards. */
+void PyoDiskStream_setBufferDuration(double seconds);
+void PyoDiskStream_setNumThreads(int nthreads);
+
+#endif
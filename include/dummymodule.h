@@ -21,10 +21,22 @@
 #include <Python.h>
 #include "pyomodule.h"
 
+/* Operations of a fused arithmetic expression, see Dummy_init. */
+#define DUMMY_OP_MUL 0
+#define DUMMY_OP_ADD 1
+#define DUMMY_OP_SUB 2
+#define DUMMY_OP_DIV 3
+
 typedef struct {
     pyo_audio_HEAD
     PyObject *input;
     Stream *input_stream;
+    /* Fused arithmetic, applied in order to the input before mul and add. */
+    int num_ops;
+    int *op_types;
+    MYFLT *op_values; /* operand, already inverted for DIV and negated for SUB */
+    PyObject **op_args; /* audio operands, NULL for numbers */
+    Stream **op_streams;
     int modebuffer[2]; // need at least 2 slots for mul & add 
 } Dummy;
 
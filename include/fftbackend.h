@@ -0,0 +1,61 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _FFTBACKEND_
+#define _FFTBACKEND_
+
+/* Implementations of the real fft used by the spectral objects.
+**
+** Every backend computes the transforms of realfft_split and irealfft_split
+** (see fft.h): the forward transform outputs the real parts of the bins 0 to
+** size/2 followed by the imaginary parts of the bins size/2-1 down to 1, and
+** is normalized by size, the inverse transform is not normalized. The input
+** frame is used as scratch memory.
+**
+** "split" is the scalar split-radix transform of fft.c.
+** "vector" computes a complex fft of size/2 points with the radix-4 Stockham
+** passes of vecops.h, so it follows the instruction set selected by
+** pyo_vec_init(). Its output may differ from "split" in the last bits.
+** "fftw" is only available when pyo is built with --use-fftw.
+** The default backend is "fftw" if available, "vector" otherwise.
+**
+** A backend may need a plan per size. Plans are created with the GIL (see
+** fftcache.h), then shared by every thread computing transforms of that size.
+**
+** This header expects MYFLT to be defined (include pyomodule.h first).
+*/
+typedef struct {
+    const char *name;
+    void * (*plan_new)(int size); /* NULL if the backend needs no plan */
+    void (*plan_free)(void *plan);
+    void (*forward)(void *plan, MYFLT *data, MYFLT *outdata, int size, MYFLT **twiddle);
+    void (*inverse)(void *plan, MYFLT *data, MYFLT *outdata, int size, MYFLT **twiddle);
+} PyoFFTBackend;
+
+/* Selects the default backend. Called once at module init. */
+extern void pyo_fft_init(void);
+extern const PyoFFTBackend * pyo_fft_get_backend(void);
+/* Returns -1 if no backend is called name. Objects keep the backend they
+** started with until their size or window changes. */
+extern int pyo_fft_set_backend(const char *name);
+/* Returns the name of the index-th available backend, NULL past the last one. */
+extern const char * pyo_fft_get_backend_name(int index);
+
+#endif
@@ -0,0 +1,55 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _FFTCACHE_
+#define _FFTCACHE_
+
+#include "fftbackend.h"
+
+/* Twiddle factors, analysis windows and fft plans, computed once per (size,
+** wintype, backend) and shared by every object using the same transform.
+** Tables are never modified once computed, objects changing their size or
+** window acquire other tables, with the backend selected at that time.
+**
+** This header expects MYFLT to be defined (include pyomodule.h first).
+*/
+typedef struct _PyoFFTTables {
+    int size;
+    int wintype; /* see wind.h, -1 for no window */
+    const PyoFFTBackend *backend;
+    void *plan; /* plan of the backend for size, NULL if it needs none */
+    MYFLT **twiddle; /* split-radix factors, 4 arrays of size/8 */
+    MYFLT *twiddle2; /* radix-2 factors */
+    MYFLT *window; /* NULL if wintype is -1 */
+    int refcount;
+    struct _PyoFFTTables *next;
+} PyoFFTTables;
+
+/* Must be called with the GIL. */
+PyoFFTTables * PyoFFTTables_acquire(int size, int wintype);
+/* Must be called with the GIL. Accepts NULL. */
+void PyoFFTTables_release(PyoFFTTables *tables);
+
+/* Real transforms of tables->size points, see realfft_split and irealfft_split.
+** data is used as scratch memory. Safe to call from any thread. */
+void PyoFFTTables_forward(PyoFFTTables *tables, MYFLT *data, MYFLT *outdata);
+void PyoFFTTables_inverse(PyoFFTTables *tables, MYFLT *data, MYFLT *outdata);
+
+#endif
@@ -0,0 +1,62 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _FRAMEPOOL_
+#define _FRAMEPOOL_
+
+/* Worker threads computing the transforms of the spectral objects.
+**
+** A frame completed during a block is handed to the pool as a job and its
+** result is only needed one block later, so the transform runs beside the
+** rest of the graph instead of inside the block of the object that happened
+** to complete a frame. PyoFrameJob_wait runs the job in the calling thread
+** when no worker has taken it yet, the audio thread never waits for a busy
+** pool, only for a job already being computed.
+**
+** Jobs may be submitted by the audio thread and by the scheduler's threads.
+*/
+
+typedef struct {
+    void (*func)(void *);
+    void *arg;
+    volatile int state; /* PYO_FRAMEJOB_IDLE, _PENDING or _RUNNING */
+    volatile int queued; /* number of references held by the pool's queue */
+} PyoFrameJob;
+
+#define PYO_FRAMEJOB_IDLE 0
+#define PYO_FRAMEJOB_PENDING 1
+#define PYO_FRAMEJOB_RUNNING 2
+
+typedef struct _PyoFramePool PyoFramePool;
+
+PyoFramePool * PyoFramePool_new(int nthreads);
+/* Computes the jobs still waiting and joins the threads. */
+void PyoFramePool_free(PyoFramePool *self);
+int PyoFramePool_getNumThreads(PyoFramePool *self);
+/* The job must be idle. With a NULL pool, or when the queue is full, the job is run right away. */
+void PyoFramePool_submit(PyoFramePool *self, PyoFrameJob *job);
+
+void PyoFrameJob_init(PyoFrameJob *job, void (*func)(void *), void *arg);
+/* Returns once the last submitted job is done, running it if no worker took it yet. */
+void PyoFrameJob_wait(PyoFrameJob *job);
+/* Waits for the job and for the pool to forget it, before its memory is freed or its data changed. */
+void PyoFrameJob_release(PyoFrameJob *job);
+
+#endif
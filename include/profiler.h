@@ -0,0 +1,62 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _PROFILER_
+#define _PROFILER_
+
+/* Statistics of the time spent in an audio callback.
+**
+** Durations are measured in cycles of the cheapest clock available (the time
+** stamp counter on x86, the virtual counter on ARM64, nanoseconds elsewhere).
+** The histogram counts the calls by power of two: bin k holds the calls that
+** took between 2^k and 2^(k+1) cycles.
+*/
+
+#define PYO_PROFILE_BINS 40
+
+typedef struct {
+    unsigned long long calls;
+    unsigned long long cycles;
+    unsigned long long worst;
+    unsigned long long histogram[PYO_PROFILE_BINS];
+} PyoProfile;
+
+static inline unsigned long long
+PyoProfile_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int lo, hi;
+    __asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+    return ((unsigned long long)hi << 32) | lo;
+#elif defined(__aarch64__)
+    unsigned long long t;
+    __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (t));
+    return t;
+#else
+    extern unsigned long long PyoProfile_nanoseconds(void);
+    return PyoProfile_nanoseconds();
+#endif
+}
+
+void PyoProfile_add(PyoProfile *self, unsigned long long cycles);
+/* Number of cycles per second of PyoProfile_now, measured on the first call. */
+double PyoProfile_getFrequency(void);
+
+#endif
@@ -40,6 +40,7 @@
 #define TYPE_I_FFOO "i|ffOO"
 #define TYPE_O_IF "O|if"
 #define TYPE_S_IFF "s|iff"
+#define TYPE_S_IFFI "s|iffi"
 #define TYPE_S__OIFI "s|Oifi"
 #define TYPE__FFFOO "|fffOO"
 #define TYPE__FFFFFOO "|fffffOO"
@@ -98,6 +99,7 @@
 #define TYPE_I_FFOO "i|ddOO"
 #define TYPE_O_IF "O|id"
 #define TYPE_S_IFF "s|idd"
+#define TYPE_S_IFFI "s|iddi"
 #define TYPE_S__OIFI "s|Oidi"
 #define TYPE__FFFOO "|dddOO"
 #define TYPE__FFFFFOO "|dddddOO"
@@ -144,6 +146,9 @@
 #endif
 #endif
 
+#include "vecops.h"
+#include "vecmath.h"
+
 extern PyTypeObject SineType;
 extern PyTypeObject SineLoopType;
 extern PyTypeObject FmType;
@@ -241,6 +246,8 @@ extern PyTypeObject IRFMType;
 
 extern PyTypeObject GranulatorType;
 extern PyTypeObject LooperType;
+extern PyTypeObject MainParticleType;
+extern PyTypeObject ParticleType;
 extern PyTypeObject HarmonizerType;
 
 extern PyTypeObject MidictlType;
@@ -417,18 +424,38 @@ extern PyTypeObject FrameAccumType;
     Py_CLEAR(self->add_stream);    
 
 #define DELETE_STREAM \
-    Server_removeStream((Server *)self->server, Stream_getStreamId(self->stream)); \
+    Server_removeStream((Server *)self->server, self->stream); \
     Py_INCREF(Py_None); \
     return Py_None;
 
-/* INIT INPUT STREAM */
+/* Replaces an object read by the processing callback. When the server is GIL-free, no block
+   can be computed during the swap, and the old object is released after it (its dealloc may
+   change the stream list). */
+#define SWAP_FIELD(field, value) \
+    { \
+        PyObject *old_field = (PyObject *)self->field; \
+        int swap_locked = Server_lockBlocks((PyObject *)self->server); \
+        self->field = value; \
+        Server_unlockBlocks((PyObject *)self->server, swap_locked); \
+        Py_XDECREF(old_field); \
+    }
+
+extern void Server_graphChanged(PyObject *self);
+
+/* INIT INPUT STREAM, a new connection, server's processing graph must be updated */
 #define INIT_INPUT_STREAM \
-    Py_XDECREF(self->input); \
-    self->input = inputtmp; \
-    input_streamtmp = PyObject_CallMethod((PyObject *)self->input, "_getStream", NULL); \
+    input_streamtmp = PyObject_CallMethod((PyObject *)inputtmp, "_getStream", NULL); \
     Py_INCREF(input_streamtmp); \
-    Py_XDECREF(self->input_stream); \
-    self->input_stream = (Stream *)input_streamtmp;
+    { \
+        PyObject *old_input = self->input, *old_input_stream = (PyObject *)self->input_stream; \
+        int swap_locked = Server_lockBlocks((PyObject *)self->server); \
+        self->input = inputtmp; \
+        self->input_stream = (Stream *)input_streamtmp; \
+        Server_unlockBlocks((PyObject *)self->server, swap_locked); \
+        Server_graphChanged((PyObject *)self->server); \
+        Py_XDECREF(old_input); \
+        Py_XDECREF(old_input_stream); \
+    }
 
 
 /* Set data */
@@ -531,6 +558,7 @@ extern PyTypeObject FrameAccumType;
 		for (i=0; i<self->size+1; i++) { \
 			self->data[i] *= ratio; \
 		} \
+		TableStream_incVersion(self->tablestream); \
 	} \
 	Py_INCREF(Py_None); \
 	return Py_None; \
@@ -578,6 +606,7 @@ extern PyTypeObject FrameAccumType;
     } \
  \
     self->data[pos] = val; \
+    TableStream_incVersion(self->tablestream); \
  \
     Py_RETURN_NONE;
 
@@ -691,8 +720,10 @@ extern PyTypeObject FrameAccumType;
 
 
 /* Init Server & Stream */
+/* Objects keep their Server alive, they may outlive a standalone one (see renderBatch). */
 #define INIT_OBJECT_COMMON \
     self->server = PyServer_get_server(); \
+    Py_INCREF(self->server); \
     self->mul = PyFloat_FromDouble(1); \
     self->add = PyFloat_FromDouble(0); \
     self->bufsize = PyInt_AsLong(PyObject_CallMethod(self->server, "getBufferSize", NULL)); \
@@ -753,8 +784,10 @@ extern PyTypeObject FrameAccumType;
     Py_INCREF(self->matrixstream); \
     return (PyObject *)self->matrixstream; \
 
-#define SET_MUL \
-    PyObject *tmp, *streamtmp; \
+/* Parameter setters. The new value, a float or a PyoObject and its stream, is
+   handed to the server which installs it (see Server_setParam in servermodule.h). */
+#define SET_PARAM(param, modeindex) \
+    PyObject *tmp, *streamtmp = NULL; \
  \
     if (arg == NULL) { \
         Py_INCREF(Py_None); \
@@ -763,60 +796,26 @@ extern PyTypeObject FrameAccumType;
  \
     int isNumber = PyNumber_Check(arg); \
  \
-    tmp = arg; \
-    Py_INCREF(tmp); \
-    Py_DECREF(self->mul); \
     if (isNumber == 1) { \
-        self->mul = PyNumber_Float(tmp); \
-        self->modebuffer[0] = 0; \
+        tmp = PyNumber_Float(arg); \
     } \
     else { \
-        self->mul = tmp; \
-        streamtmp = PyObject_CallMethod((PyObject *)self->mul, "_getStream", NULL); \
-        Py_INCREF(streamtmp); \
-        Py_XDECREF(self->mul_stream); \
-        self->mul_stream = (Stream *)streamtmp; \
-        self->modebuffer[0] = 1; \
+        tmp = arg; \
+        Py_INCREF(tmp); \
+        streamtmp = PyObject_CallMethod(arg, "_getStream", NULL); \
     } \
- \
-    (*self->mode_func_ptr)(self); \
+    Server_setParam((PyObject *)self, &self->param, tmp, &self->param##_stream, (Stream *)streamtmp, \
+                    &self->modebuffer[modeindex], isNumber == 1 ? 0 : 1); \
  \
     Py_INCREF(Py_None); \
     return Py_None; 
 
-#define SET_ADD \
-    PyObject *tmp, *streamtmp; \
-\
-    if (arg == NULL) { \
-        Py_INCREF(Py_None); \
-        return Py_None; \
-    } \
-\
-    int isNumber = PyNumber_Check(arg); \
-\
-    tmp = arg; \
-    Py_INCREF(tmp); \
-    Py_DECREF(self->add); \
-    if (isNumber == 1) { \
-        self->add = PyNumber_Float(tmp); \
-        self->modebuffer[1] = 0; \
-    } \
-    else { \
-        self->add = tmp; \
-        streamtmp = PyObject_CallMethod((PyObject *)self->add, "_getStream", NULL); \
-        Py_INCREF(streamtmp); \
-        Py_XDECREF(self->add_stream); \
-        self->add_stream = (Stream *)streamtmp; \
-        self->modebuffer[1] = 1; \
-    } \
-\
-    (*self->mode_func_ptr)(self); \
-\
-    Py_INCREF(Py_None); \
-    return Py_None; 
+#define SET_MUL SET_PARAM(mul, 0)
+
+#define SET_ADD SET_PARAM(add, 1)
 
 #define SET_SUB \
-    PyObject *tmp, *streamtmp; \
+    PyObject *tmp, *streamtmp = NULL; \
  \
     if (arg == NULL) { \
         Py_INCREF(Py_None); \
@@ -825,29 +824,22 @@ extern PyTypeObject FrameAccumType;
  \
     int isNumber = PyNumber_Check(arg); \
  \
-    tmp = arg; \
-    Py_INCREF(tmp); \
-    Py_DECREF(self->add); \
     if (isNumber == 1) { \
-        self->add = PyNumber_Multiply(PyNumber_Float(tmp), PyFloat_FromDouble(-1)); \
-        self->modebuffer[1] = 0; \
+        tmp = PyFloat_FromDouble(-PyFloat_AsDouble(arg)); \
     } \
     else { \
-        self->add = tmp; \
-        streamtmp = PyObject_CallMethod((PyObject *)self->add, "_getStream", NULL); \
-        Py_INCREF(streamtmp); \
-        Py_XDECREF(self->add_stream); \
-        self->add_stream = (Stream *)streamtmp; \
-        self->modebuffer[1] = 2; \
+        tmp = arg; \
+        Py_INCREF(tmp); \
+        streamtmp = PyObject_CallMethod(arg, "_getStream", NULL); \
     } \
- \
-    (*self->mode_func_ptr)(self); \
+    Server_setParam((PyObject *)self, &self->add, tmp, &self->add_stream, (Stream *)streamtmp, \
+                    &self->modebuffer[1], isNumber == 1 ? 0 : 2); \
  \
     Py_INCREF(Py_None); \
     return Py_None; 
 
 #define SET_DIV \
-    PyObject *tmp, *streamtmp; \
+    PyObject *tmp, *streamtmp = NULL; \
  \
     if (arg == NULL) { \
         Py_INCREF(Py_None); \
@@ -856,26 +848,20 @@ extern PyTypeObject FrameAccumType;
  \
     int isNumber = PyNumber_Check(arg); \
  \
-    tmp = arg; \
-    Py_INCREF(tmp); \
     if (isNumber == 1) { \
-        if (PyFloat_AsDouble(PyNumber_Float(tmp)) != 0.) { \
-            Py_DECREF(self->mul); \
-            self->mul = PyNumber_Divide(PyFloat_FromDouble(1.), PyNumber_Float(tmp)); \
-            self->modebuffer[0] = 0; \
+        if (PyFloat_AsDouble(arg) == 0.) { \
+            Py_INCREF(Py_None); \
+            return Py_None; \
         } \
+        tmp = PyFloat_FromDouble(1. / PyFloat_AsDouble(arg)); \
     } \
     else { \
-        Py_DECREF(self->mul); \
-        self->mul = tmp; \
-        streamtmp = PyObject_CallMethod((PyObject *)self->mul, "_getStream", NULL); \
-        Py_INCREF(streamtmp); \
-        Py_XDECREF(self->mul_stream); \
-        self->mul_stream = (Stream *)streamtmp; \
-        self->modebuffer[0] = 2; \
+        tmp = arg; \
+        Py_INCREF(tmp); \
+        streamtmp = PyObject_CallMethod(arg, "_getStream", NULL); \
     } \
- \
-    (*self->mode_func_ptr)(self); \
+    Server_setParam((PyObject *)self, &self->mul, tmp, &self->mul_stream, (Stream *)streamtmp, \
+                    &self->modebuffer[0], isNumber == 1 ? 0 : 2); \
  \
     Py_INCREF(Py_None); \
     return Py_None; 
@@ -1019,114 +1005,54 @@ extern PyTypeObject FrameAccumType;
     Py_INCREF(Py_None); \
     return Py_None;    
 
-/* Post processing (mul & add) macros */
+/* Same as STOP, from the processing callback itself. */
+#define STOP_PROCESSING \
+    Stream_setStreamActive(self->stream, 0); \
+    Stream_setStreamChnl(self->stream, 0); \
+    Stream_setStreamToDac(self->stream, 0); \
+    memset(self->data, 0, self->bufsize * sizeof(MYFLT));
+
+/* Post processing (mul & add) macros, see vecops.h for the kernels */
 #define POST_PROCESSING_II \
-    MYFLT mul, add, old, val; \
-    int i; \
+    MYFLT mul, add; \
     mul = PyFloat_AS_DOUBLE(self->mul); \
     add = PyFloat_AS_DOUBLE(self->add); \
-    if (mul != 1 || add != 0) { \
-        for (i=0; i<self->bufsize; i++) { \
-            old = self->data[i]; \
-            val = mul * old + add; \
-            self->data[i] = val; \
-        } \
-    }
+    if (mul != 1 || add != 0) \
+        pyo_vec_mul_scalar_add(self->data, mul, add, self->bufsize);
 
 #define POST_PROCESSING_AI \
-    MYFLT add, old, val; \
-    int i; \
     MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    add = PyFloat_AS_DOUBLE(self->add); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old + add; \
-        self->data[i] = val; \
-    }
+    pyo_vec_mul_add_scalar(self->data, mul, PyFloat_AS_DOUBLE(self->add), self->bufsize);
 
 #define POST_PROCESSING_IA \
-    MYFLT mul, old, val; \
-    int i; \
-    mul = PyFloat_AS_DOUBLE(self->mul); \
     MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul * old + add[i]; \
-        self->data[i] = val; \
-    } 
+    pyo_vec_scalar_mul_add(self->data, PyFloat_AS_DOUBLE(self->mul), add, self->bufsize);
 
 #define POST_PROCESSING_AA \
-    MYFLT old, val; \
-    int i; \
     MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
     MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old + add[i]; \
-        self->data[i] = val; \
-    }
+    pyo_vec_muladd(self->data, mul, add, self->bufsize);
 
 #define POST_PROCESSING_REVAI \
-    MYFLT tmp, add, old, val; \
-    int i; \
     MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
-    add = PyFloat_AS_DOUBLE(self->add); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp + add; \
-        self->data[i] = val; \
-    }
+    pyo_vec_div_add_scalar(self->data, mul, PyFloat_AS_DOUBLE(self->add), self->bufsize);
 
 #define POST_PROCESSING_REVAA \
-    MYFLT tmp, old, val; \
-    int i; \
     MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
     MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp + add[i]; \
-        self->data[i] = val; \
-    }
+    pyo_vec_divadd(self->data, mul, add, self->bufsize);
 
 #define POST_PROCESSING_IREVA \
-    MYFLT mul, old, val; \
-    int i; \
-    mul = PyFloat_AS_DOUBLE(self->mul); \
     MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul * old - add[i]; \
-        self->data[i] = val; \
-    } 
+    pyo_vec_scalar_mul_sub(self->data, PyFloat_AS_DOUBLE(self->mul), add, self->bufsize);
 
 #define POST_PROCESSING_AREVA \
-    MYFLT old, val; \
-    int i; \
     MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
     MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        val = mul[i] * old - add[i]; \
-        self->data[i] = val; \
-    }
+    pyo_vec_mulsub(self->data, mul, add, self->bufsize);
 
 #define POST_PROCESSING_REVAREVA \
-    MYFLT tmp, old, val; \
-    int i; \
     MYFLT *mul = Stream_getData((Stream *)self->mul_stream); \
     MYFLT *add = Stream_getData((Stream *)self->add_stream); \
-    for (i=0; i<self->bufsize; i++) { \
-        old = self->data[i]; \
-        tmp = mul[i]; \
-        if (tmp < 0.00001 && tmp > -0.00001) \
-            tmp = 0.00001; \
-        val = old / tmp - add[i]; \
-        self->data[i] = val; \
-    }
+    pyo_vec_divsub(self->data, mul, add, self->bufsize);
 
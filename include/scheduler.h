@@ -0,0 +1,56 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _SCHEDULER_
+#define _SCHEDULER_
+
+#include <Python.h>
+#include "pyomodule.h"
+#include "streammodule.h"
+#include "streamtable.h"
+
+/* Multi-threaded, dependency ordered, execution of the server's stream list.
+**
+** The graph is discovered by running one block serially while recording every
+** Stream_getData/Stream_touch call made by each callback, to which are added the
+** streams every object holds as inputs (found with its tp_traverse), as some reads
+** depend on the signals (Selector's voice, ...). Streams are then split
+** in levels: a stream only shares a level with streams it neither reads nor is
+** read by, so a level can be processed concurrently by the worker threads.
+** Streams flagged "serial" (callbacks calling the Python API or writing into
+** shared tables) become barriers and are always processed alone by the audio
+** thread, which keeps the GIL for the whole block (or takes it around the
+** Python calls when the server is GIL-free, see servermodule.h). Any change to the stream list
+** or to the objects' connections invalidates the levels and triggers a new
+** recording block.
+*/
+typedef struct _PyoScheduler PyoScheduler;
+
+PyoScheduler * PyoScheduler_new(int nthreads);
+void PyoScheduler_free(PyoScheduler *self);
+void PyoScheduler_invalidate(PyoScheduler *self);
+/* Computes one block for every active stream of the table. */
+void PyoScheduler_process(PyoScheduler *self, PyoStreamTable *table);
+/* Returns 1 if the stream at position "index" in the table was computed in the last block. */
+int PyoScheduler_hasRun(PyoScheduler *self, int index, Stream *stream);
+int PyoScheduler_getNumThreads(PyoScheduler *self);
+int PyoScheduler_getNumLevels(PyoScheduler *self);
+
+#endif
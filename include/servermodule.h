@@ -24,10 +24,19 @@
 extern "C" {
 #endif
 
+#include <pthread.h>
 #include "portaudio.h"
 #include "portmidi.h"
 #include "sndfile.h"
 #include "pyomodule.h"
+#include "streamtable.h"
+#include "scheduler.h"
+#include "sndwriter.h"
+#include "profiler.h"
+#include "denormals.h"
+#include "telemetry.h"
+#include "cmdqueue.h"
+#include "framepool.h"
 
 #ifdef USE_JACK
 #include <jack/jack.h>
@@ -37,6 +46,9 @@ extern "C" {
 # include <CoreAudio/AudioHardware.h>
 #endif
 
+#define PYO_OFFLINE_CHUNK_SAMPLES 262144 /* samples handed at once to the offline writer thread */
+#define PYO_OFFLINE_CHUNKS 8
+
 typedef enum {
     PyoPortaudio = 0,
     PyoCoreaudio = 1,
@@ -56,9 +68,24 @@ typedef struct {
 #endif
 } PyoJackBackendData;
     
+#define PYO_SERVER_COMMANDS 4096 /* size of the command ring and of the pending commands heap */
+#define PYO_SERVER_METER_PERIOD 0.05 /* seconds between two readings of the meters */
+#define PYO_SERVER_METER_RECORDS 1024 /* size of the meters ring */
+
+/* Common head of the audio objects, for the code that doesn't know their type. */
+typedef struct {
+    pyo_audio_HEAD
+} PyoAudioObject;
+
+/* Command waiting for its time. `seq` keeps the arrival order of simultaneous commands. */
+typedef struct {
+    PyoCommand cmd;
+    unsigned int seq;
+} PyoPendingCommand;
+
 typedef struct {
     PyObject_HEAD
-    PyObject *streams;
+    PyoStreamTable *streams;
     PyoAudioBackendType audio_be_type;
     void *audio_be_data;
     char *serverName; /* Only used for jack client name */
@@ -78,6 +105,7 @@ typedef struct {
     int server_booted;
     int stream_count;
     int record;
+    int standalone; /* independent offline Server, see PyServer_get_server */
     
     /* global amplitude */
     MYFLT amp;
@@ -99,33 +127,142 @@ typedef struct {
     char *recpath;
     int recformat;
     int rectype;
-    SNDFILE *recfile;
     SF_INFO recinfo;
+    PyoSndWriter *recwriter; /* NULL unless recording, writes the file from its own thread */
+    unsigned long recoverflows; /* overflow counters of the last recording */
+    unsigned long long recdropped;
+    double offlineFactor; /* speed of the last offline rendering, relative to real time */
+
+    /* profiling */
+    int profiling;
+    double cycleFrequency; /* cycles per second of the profiler's clock */
+    PyoProfile profile; /* whole blocks */
+    unsigned long long overruns; /* blocks computed in more than bufferSize/samplingRate */
+    unsigned long long xruns; /* reported by the audio driver */
+
+    /* denormals */
+    int flushDenormals; /* blocks are computed in flush-to-zero mode, see denormals.h */
+    int countDenormals;
+    unsigned long long denormals; /* subnormal samples found in the streams outputs */
+    unsigned long long denormalBlocks; /* blocks with at least one of them */
+    unsigned long long checkedBlocks;
     
-    /* GUI VUMETER */
-    int withGUI;
-    int numPass;
-    int gcount;
+    /* Meters, measured by the audio thread, read by the meter thread and Python, see telemetry.h */
+    int metering;
+    PyoTelemetry *telemetry; /* NULL unless metering and booted */
+    PyObject *meters; /* stream id -> subscribed Stream */
+    PyObject *GUI; /* setRms(*amps), called by the meter thread */
     float *lastRms;
-    PyObject *GUI;
+    PyObject *TIME; /* setTime(h, m, s, ms), called by the meter thread */
+    pthread_t meter_thread;
+    pthread_mutex_t meter_lock;
+    pthread_cond_t meter_cond;
+    int meter_running;
 
     /* Current time */
     unsigned long elapsedSamples; /* time since the server was started */
-    int withTIME;
-    int timePass;
-    int tcount;
-    PyObject *TIME;
+
+    /* Parameter changes, applied by the audio thread at the start of a block */
+    PyoCommandQueue *commands; /* Python -> audio */
+    PyoCommandQueue *garbage; /* audio -> Python, references released by the applied commands */
+    PyoPendingCommand *pending; /* audio side, heap of the commands ordered by time */
+    int num_pending;
+    unsigned int pending_seq;
+    PyoCommand *held; /* events put aside by Server_applyParamCommands */
+    int num_held;
+    int in_block; /* 1 while a block is computed */
+    unsigned long commandDelay; /* in samples, added to the time of the new commands */
+
+    /* Blocks computed without the GIL, see Server_setGILFree */
+    int gilFree;
+    int nogil_block; /* 1 while the audio thread computes a block without the GIL */
+    int python_depth; /* nesting of Server_enterPython */
+    PyGILState_STATE python_state;
+    pthread_mutex_t block_lock; /* held by the audio thread while it computes a block without the GIL */
+    PyoCommandQueue *events; /* audio -> control thread, Python callbacks to run */
+    pthread_t control_thread;
+    pthread_mutex_t control_lock;
+    pthread_cond_t control_cond;
+    int control_running;
+
+    /* Multi-threaded processing */
+    int nthreads; /* total number of threads, the audio thread included */
+    PyoScheduler *scheduler;
+    int fftThreads; /* threads of the frame pool, 0 computes the transforms in the blocks */
+    PyoFramePool *framepool; /* NULL unless fftThreads > 0 and booted */
     
     /* Properties */
     int verbosity; /* a sum of values to display different levels: 1 = error */
                    /* 2 = message, 4 = warning , 8 = debug. Default 7.*/
 } Server;
 
+/* Returns the Server new objects are attached to (borrowed reference): the
+** Server made current for the calling thread by Server.setCurrent(True), or by
+** a standalone Server for the threads computing its blocks and running its
+** callbacks, otherwise the main Server. Standalone Servers (created with
+** standalone=True, offline only) live beside the main one so that several
+** renderings can run at the same time in the same process, see renderBatch. */
 PyObject * PyServer_get_server();
-extern PyObject * Server_removeStream(Server *self, int sid);
+extern PyObject * Server_removeStream(Server *self, Stream *stream);
+/* Replaces a parameter of the audio object `obj`: `*field` becomes `value` and,
+   if `stream` isn't NULL, `*field_stream` becomes `stream` (both are new references
+   given to the server), `*mode` becomes `modeval` and the object's mode function is
+   called. While the server is running, the change is queued and made by the audio
+   thread at the start of a block, after the command delay. */
+extern void Server_setParam(PyObject *obj, PyObject **field, PyObject *value, Stream **field_stream, Stream *stream, int *mode, int modeval);
+
+/* Timeline. Events are kept, with the parameter commands waiting for their time,
+** in a heap ordered by absolute sample time (the time 0 is the first sample
+** computed after the boot, see Server_getElapsedSamples). At the start of each
+** block, before the streams are computed, the server calls in time order
+** `func(obj, time, offset)` for every event whose time falls in the block,
+** `offset` being the position of this sample in the block. An object can then
+** place a trigger at the exact sample, whatever the buffer size, and schedule
+** its next event from the callback. Audio side only: objects schedule their
+** first event from their processing function, which must be serial (see
+** Stream_setStreamSerial) as the heap isn't shared with the processing threads.
+*/
+typedef void (*PyoEventFunc)(PyObject *obj, unsigned long long time, int offset);
+
+/* Returns 0, or -1 if the timeline is full (PYO_SERVER_COMMANDS commands and events). */
+extern int Server_scheduleEvent(PyObject *self, unsigned long long time, PyoEventFunc func, PyObject *obj);
+/* Forgets the waiting events of `obj`. Needs what Server_lockBlocks gives (or the audio side). */
+extern void Server_cancelEvents(PyObject *self, PyObject *obj);
+/* Time of the first sample of the block being computed. */
+extern unsigned long long Server_getElapsedSamples(PyObject *self);
+
+/* Native and Python-calling objects.
+**
+** With Server.setGILFree(True), the blocks are computed without the GIL and
+** the objects must not use the Python API from their processing function:
+** - the Python functions called by objects (Pattern, TrigFunc, ...) are handed
+**   to Server_postCallback, which runs them on a control thread (offline, it takes
+**   the GIL and runs them at once, the rendering doesn't depend on the timing),
+** - occasional calls (stopping a stream at the end of its duration) are surrounded by
+**   Server_enterPython and Server_leavePython, which take the GIL,
+** - streams calling the Python API at every block are flagged with
+**   Stream_setStreamPython, the server then takes the GIL around them.
+** Without GIL-free mode, these are called right away, with the GIL held for the
+** whole block.
+*/
+
+/* Audio side. Runs `func(obj, value)` with the GIL. */
+extern void Server_postCallback(PyObject *self, void (*func)(PyObject *, double), PyObject *obj, double value);
+extern void Server_enterPython(PyObject *self);
+extern void Server_leavePython(PyObject *self);
+/* Python side. Keeps the audio thread from computing a block while a structure it
+   reads outside of the command ring is changed. Returns the value to give to
+   Server_unlockBlocks (blocks computed with the GIL need no lock). */
+extern int Server_lockBlocks(PyObject *self);
+extern void Server_unlockBlocks(PyObject *self, int locked);
+/* Calls `callable` with `arg` as only argument, or without argument if `arg` is
+   Py_None, and prints the errors. Needs the GIL. */
+extern void Server_callPython(PyObject *callable, PyObject *arg);
 extern MYFLT * Server_getInputBuffer(Server *self);    
 extern PmEvent * Server_getMidiEventBuffer(Server *self);    
 extern int Server_getMidiEventCount(Server *self);    
+/* The pool computing the transforms of the spectral objects (may be NULL), see framepool.h. */
+extern PyoFramePool * Server_getFramePool(PyObject *self);
 extern PyTypeObject ServerType;    
     
 
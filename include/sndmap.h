@@ -0,0 +1,60 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _SNDMAP_
+#define _SNDMAP_
+
+#include "pyomodule.h"
+
+/* Shared, memory mapped sound tables.
+**
+** A PyoSndMap holds every channel of a region of a sound file, one after the
+** other, each followed by the guard point the table readers expect
+** (data[size] = data[0]). Tables loading the same region of the same file
+** (same device, inode, size and modification time) share one mapping, and
+** pages are only read from disk when they are touched.
+**
+** A mono WAV (or AIFF-C) file whose samples are already MYFLTs in the native
+** byte order, loaded whole, is mapped in place. Any other file is decoded once
+** with libsndfile into a cache file, reused by later runs as long as the sound
+** doesn't change, then mapped. The cache lives in $PYO_CACHE_DIR, or in
+** $XDG_CACHE_HOME/pyo, or in ~/.cache/pyo. If it can't be written, the decoded
+** data is kept in anonymous memory, still shared in the process.
+**
+** Mappings are private and shared by several tables: a table must make its
+** own copy of the data before writing to it.
+*/
+
+typedef struct _PyoSndMap PyoSndMap;
+
+/* Converts a `start` - `stop` selection, in seconds, to a range of frames. */
+void PyoSndMap_getRange(MYFLT start, MYFLT stop, int sr, long frames, long *first, long *last);
+
+/* Returns the mapping of `path` between `start` and `stop` (see
+   PyoSndMap_getRange), or NULL if the sound can't be mapped. */
+PyoSndMap * PyoSndMap_acquire(const char *path, MYFLT start, MYFLT stop);
+void PyoSndMap_release(PyoSndMap *self);
+
+/* Samples of channel `chnl` (wrapped around the number of channels). */
+MYFLT * PyoSndMap_getData(PyoSndMap *self, int chnl);
+int PyoSndMap_getSize(PyoSndMap *self);
+int PyoSndMap_getSamplingRate(PyoSndMap *self);
+
+#endif
@@ -0,0 +1,86 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _SNDWRITER_
+#define _SNDWRITER_
+
+#include <pthread.h>
+#include "sndfile.h"
+
+/* Pipelined sound file writer.
+**
+** Frames are copied in large chunks; once a chunk is full it is handed to a
+** writer thread which encodes and writes it, while the caller goes on filling
+** the next chunk. The chunks are one contiguous ring, so the writer thread
+** writes every chunk waiting in a single libsndfile call. Handing a chunk over
+** takes no lock and the ring is allocated up front: the caller never allocates.
+**
+** When every chunk is waiting to be written, PyoSndWriter_write waits for the
+** writer thread, or, in realtime mode, drops the frames and counts them.
+**
+** Files opened with PyoSndWriter_open get their disk space reserved ahead of
+** the writes (Linux only), which keeps the filesystem from allocating blocks
+** during the take.
+*/
+
+#define PYO_SNDWRITER_DOUBLE 1 /* frames are doubles instead of floats */
+#define PYO_SNDWRITER_REALTIME 2 /* never waits, frames that don't fit are dropped */
+
+#define PYO_SNDWRITER_CHUNK_FRAMES 8192 /* realtime recordings, frames per chunk */
+#define PYO_SNDWRITER_SECONDS 2 /* realtime recordings, audio held by the ring */
+#define PYO_SNDWRITER_RESERVE 10 /* seconds of disk space reserved at once */
+
+typedef struct {
+    SNDFILE *sf;
+    int fd; /* -1 if the file wasn't opened by PyoSndWriter_open */
+    int nchnls;
+    int chunk_frames;
+    int nchunks;
+    int flags;
+    int frame_size; /* bytes of a frame in the chunks */
+    char *chunks; /* nchunks * chunk_frames interleaved frames */
+    int *frames; /* frames held by each chunk */
+    volatile unsigned int head; /* chunks handed to the writer thread, caller side */
+    volatile unsigned int tail; /* chunks written, writer thread side */
+    volatile int closing;
+    int error;
+    unsigned long overflows; /* calls to write which dropped frames */
+    unsigned long long dropped; /* frames dropped */
+    long long reserved; /* bytes of disk space reserved */
+    long long written; /* bytes written, approximately (header not included) */
+    long long reserve_step;
+    int disk_frame_size;
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} PyoSndWriter;
+
+/* Takes ownership of `sf`, which is closed by PyoSndWriter_close. */
+PyoSndWriter * PyoSndWriter_new(SNDFILE *sf, int nchnls, int chunk_frames, int nchunks, int flags);
+/* Opens `path` for writing with the format of `info` and returns its writer, NULL on failure. */
+PyoSndWriter * PyoSndWriter_open(const char *path, SF_INFO *info, int chunk_frames, int nchunks, int flags);
+/* `data` holds `frames` interleaved frames, floats or doubles depending on the flags. */
+void PyoSndWriter_write(PyoSndWriter *self, const void *data, int frames);
+/* Gets the overflow counters (realtime mode). */
+void PyoSndWriter_getOverflows(PyoSndWriter *self, unsigned long *overflows, unsigned long long *dropped);
+/* Writes what is left, stops the thread, closes the file. Returns -1 if a write failed. */
+int PyoSndWriter_close(PyoSndWriter *self);
+
+#endif
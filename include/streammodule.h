@@ -18,8 +18,12 @@
  * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
  *************************************************************************/
 
+#ifndef Py_STREAMMODULE_H
+#define Py_STREAMMODULE_H
+
 #include <Python.h>
 #include "pyomodule.h"
+#include "profiler.h"
 
 typedef struct {
     PyObject_HEAD
@@ -33,6 +37,10 @@ typedef struct {
     int duration;
     int bufferCountWait;
     int bufferCount;
+    int serial; /* callback must run alone, in list order, on the audio thread */
+    int slot; /* index in the server's stream table, -1 if not registered */
+    int python; /* callback calls the Python API, the GIL must be taken first in GIL-free mode */
+    PyoProfile *profile; /* NULL unless the server is profiling */
     MYFLT *data;
 } Stream;
 
@@ -44,19 +52,32 @@ extern int Stream_getBufferCountWait(Stream *self);
 extern int Stream_getDuration(Stream *self);
 extern int Stream_getStreamChnl(Stream *self);
 extern int Stream_getStreamToDac(Stream *self);
+extern int Stream_getStreamSerial(Stream *self);
+extern int Stream_getStreamSlot(Stream *self);
+extern int Stream_getStreamPython(Stream *self);
 extern MYFLT * Stream_getData(Stream *self);
 extern void Stream_setData(Stream * self, MYFLT *data);
 extern void Stream_setFunctionPtr(Stream *self, void *ptr);
 extern void Stream_callFunction(Stream *self);
 extern void Stream_IncrementBufferCount(Stream *self);
 extern void Stream_IncrementDurationCount(Stream *self);
+extern void Stream_touch(Stream *self);
+/* Reads made by the calling thread are reported to probe->func until Stream_setProbe(NULL). */
+typedef struct {
+    void (*func)(void *arg, Stream *stream);
+    void *arg;
+} StreamProbe;
+extern void Stream_setProbe(StreamProbe *probe);
+extern void Stream_setProfiling(Stream *self, int active);
 extern PyTypeObject StreamType;
 
 #define MAKE_NEW_STREAM(self, type, rt_error)	\
   (self) = (Stream *)(type)->tp_alloc((type), 0);	\
   if ((self) == rt_error) { return rt_error; }	\
 						\
-  (self)->sid = (self)->chnl = (self)->todac = (self)->bufferCountWait = (self)->bufferCount = (self)->bufsize = 0; \
+  (self)->sid = (self)->chnl = (self)->todac = (self)->bufferCountWait = (self)->bufferCount = (self)->bufsize = (self)->serial = (self)->python = 0; \
+  (self)->slot = -1; \
+  (self)->profile = NULL; \
   (self)->active = 1;
 
 #ifdef __STREAM_MODULE
@@ -73,6 +94,11 @@ extern PyTypeObject StreamType;
 #define Stream_setBufferCountWait(op, v) (((Stream *)(op))->bufferCountWait = (v))
 #define Stream_setDuration(op, v) (((Stream *)(op))->duration = (v))
 #define Stream_setBufferSize(op, v) (((Stream *)(op))->bufsize = (v))
+#define Stream_setStreamSerial(op, v) (((Stream *)(op))->serial = (v))
+#define Stream_setStreamSlot(op, v) (((Stream *)(op))->slot = (v))
+#define Stream_setStreamPython(op, v) (((Stream *)(op))->python = (v))
  
 #endif
 /* __STREAMMODULE */
+
+#endif
@@ -0,0 +1,66 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _STREAMTABLE_
+#define _STREAMTABLE_
+
+#include <Python.h>
+#include "pyomodule.h"
+#include "streammodule.h"
+
+/* Native registry of the streams computed by a server.
+**
+** Per-stream fields that never change once a stream is registered (callback,
+** callback argument, output buffer) are stored in contiguous arrays indexed by
+** slot. Slots are recycled through a free list, so adding and removing a stream
+** are O(1). The processing order is an array of slots where a removed stream
+** leaves a hole (-1), squeezed out by PyoStreamTable_compact.
+*/
+typedef struct {
+    int size; /* allocated slots */
+    int count; /* registered streams */
+    Stream **stream;
+    void (**funcptr)();
+    PyObject **object;
+    MYFLT **data;
+    int *position; /* index of the slot in order, -1 if the slot is free */
+    int *next_free;
+    int free_head;
+    int *order;
+    int order_size;
+    int length; /* used entries in order, holes included */
+    int holes;
+} PyoStreamTable;
+
+PyoStreamTable * PyoStreamTable_new();
+void PyoStreamTable_free(PyoStreamTable *self);
+void PyoStreamTable_clear(PyoStreamTable *self);
+int PyoStreamTable_add(PyoStreamTable *self, Stream *stream);
+int PyoStreamTable_remove(PyoStreamTable *self, Stream *stream);
+int PyoStreamTable_moveBefore(PyoStreamTable *self, Stream *stream, Stream *ref);
+/* Returns 1 if the holes were removed, which changes the streams' positions. */
+int PyoStreamTable_compact(PyoStreamTable *self, int force);
+PyObject * PyoStreamTable_getList(PyoStreamTable *self);
+
+/* Stream at position "pos" in processing order, NULL for a hole. */
+#define PyoStreamTable_streamAt(self, pos) \
+    ((self)->order[(pos)] < 0 ? NULL : (self)->stream[(self)->order[(pos)]])
+
+#endif
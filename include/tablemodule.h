@@ -28,6 +28,7 @@ typedef struct {
     int size;
     double samplingRate;
     MYFLT *data;
+    int version; /* incremented each time the table content changes */
 } TableStream;
 
 
@@ -35,13 +36,17 @@ typedef struct {
 (self) = (TableStream *)(type)->tp_alloc((type), 0);	\
 if ((self) == rt_error) { return rt_error; }	\
 \
-(self)->size = 0
+(self)->size = 0; \
+(self)->version = 0
+
+void TableStream_incVersion(TableStream *self);
 
 #else
 
 int TableStream_getSize(PyObject *self);
 double TableStream_getSamplingRate(PyObject *self);
 MYFLT * TableStream_getData(PyObject *self);
+int TableStream_getVersion(PyObject *self);
 extern PyTypeObject TableStreamType;
 
 #endif
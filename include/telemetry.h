@@ -0,0 +1,97 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _TELEMETRY_
+#define _TELEMETRY_
+
+#include <pthread.h>
+
+/* Output and object meters, measured by the audio thread and read elsewhere.
+**
+** The audio thread accumulates the peak and the energy of every output channel
+** and of the subscribed streams, and every `period` blocks pushes one record
+** per meter in a wait-free single producer, single consumer ring. It never
+** calls Python nor waits: when the ring is full (nobody reads it, or the reader
+** is late) the records are dropped and counted. The reader drains the ring into
+** the latest value of each meter, under a lock only readers take, so the meter
+** thread of the Server and the Python code may both read.
+**
+** The audio side functions (accumulate, subscribe and unsubscribe) must not run
+** concurrently, the Server calls the last two with the blocks locked.
+**
+** This header expects MYFLT to be defined (include pyomodule.h first).
+*/
+
+#define PYO_METER_OUTPUT 0 /* index is the output channel */
+#define PYO_METER_STREAM 1 /* index is the stream id */
+
+typedef struct {
+    unsigned long long time; /* elapsed samples at the end of the period */
+    int kind;
+    int index;
+    float peak; /* absolute value */
+    float rms;
+} PyoMeterRecord;
+
+typedef struct {
+    /* audio side */
+    int period; /* blocks per record */
+    int count; /* blocks accumulated in the current period */
+    int nchnls;
+    int num_streams;
+    int max_streams;
+    int *stream_ids;
+    MYFLT **stream_data;
+    float *peaks; /* outputs, then streams */
+    double *sums;
+    /* ring */
+    PyoMeterRecord *ring;
+    unsigned int mask; /* size - 1, size is a power of two */
+    volatile unsigned int head; /* written by the audio thread */
+    volatile unsigned int tail; /* written by the reader */
+    volatile unsigned long long dropped;
+    /* reader side, under lock */
+    pthread_mutex_t lock;
+    unsigned long long time; /* of the latest record read */
+    PyoMeterRecord *outputs; /* nchnls */
+    PyoMeterRecord *streams;
+    int num_latest;
+    int max_latest;
+} PyoTelemetry;
+
+/* `size` (records) is rounded up to a power of two. */
+PyoTelemetry * PyoTelemetry_new(int nchnls, int period, int size);
+void PyoTelemetry_free(PyoTelemetry *self);
+/* Audio side. Accumulates a block of `out` (nchnls interleaved channels) and of
+   the subscribed streams, pushes the records at the end of a period. `time` is
+   the elapsed samples at the end of the block. */
+void PyoTelemetry_process(PyoTelemetry *self, float *out, int size, unsigned long long time);
+/* Audio side. Meters the `size` samples of `data` with the index `id`. Returns -1 if already subscribed. */
+int PyoTelemetry_subscribe(PyoTelemetry *self, int id, MYFLT *data);
+/* Audio side. Returns -1 if `id` isn't subscribed. */
+int PyoTelemetry_unsubscribe(PyoTelemetry *self, int id);
+/* Reader. Pops every waiting record into the latest values, takes the lock itself. Returns the number of records read. */
+int PyoTelemetry_drain(PyoTelemetry *self);
+/* Reader, with the lock held. Returns the latest record of the stream `id`, or NULL. */
+PyoMeterRecord * PyoTelemetry_latest(PyoTelemetry *self, int id);
+/* Reader, with the lock held. Forgets the latest record of the stream `id`. */
+void PyoTelemetry_forget(PyoTelemetry *self, int id);
+
+#endif
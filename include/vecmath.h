@@ -0,0 +1,66 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+
+#ifndef _VECMATH_
+#define _VECMATH_
+
+/* Block versions of the transcendental functions used in per-sample loops
+** (filter coefficients, waveshapers, gain conversions).
+**
+** The accuracy is selected for the whole module with pyo_vec_set_math_accuracy().
+** With PYO_MATH_EXACT (the default), the kernels call the MYSIN, MYCOS, ...
+** macros on each element and their output is identical to the original loops.
+** With PYO_MATH_FAST, they use polynomial approximations computed several
+** lanes at a time with the instruction set selected by pyo_vec_init(). The
+** fast versions are accurate to a few units in the last place of MYFLT for
+** arguments of moderate size (the error grows with |x| for sin, cos and exp,
+** and is absolute rather than relative for tanh near 0).
+**
+** Outputs may point to one of the inputs, the functions are applied element
+** by element. This header expects MYFLT to be defined (it is included by
+** pyomodule.h).
+*/
+
+#define PYO_MATH_EXACT 0
+#define PYO_MATH_FAST 1
+
+/* out[i] = sin(in[i]) */
+extern void (*pyo_vec_sin)(MYFLT *out, MYFLT *in, int size);
+/* out[i] = cos(in[i]) */
+extern void (*pyo_vec_cos)(MYFLT *out, MYFLT *in, int size);
+/* s[i] = sin(in[i]), c[i] = cos(in[i]) */
+extern void (*pyo_vec_sincos)(MYFLT *s, MYFLT *c, MYFLT *in, int size);
+/* out[i] = exp(in[i]) */
+extern void (*pyo_vec_exp)(MYFLT *out, MYFLT *in, int size);
+/* out[i] = pow(base, in[i]), the fast version falls back to the exact one if base <= 0 */
+extern void (*pyo_vec_pow)(MYFLT *out, MYFLT base, MYFLT *in, int size);
+/* out[i] = tanh(in[i]) */
+extern void (*pyo_vec_tanh)(MYFLT *out, MYFLT *in, int size);
+/* out[i] = atan2(y[i], x[i]) */
+extern void (*pyo_vec_atan2)(MYFLT *out, MYFLT *y, MYFLT *x, int size);
+
+/* Selects the exact or the fast kernels. Can be called at any time, the
+** pointers are swapped one at a time. */
+extern void pyo_vec_set_math_accuracy(int accuracy);
+/* Returns the current accuracy (PYO_MATH_EXACT or PYO_MATH_FAST). */
+extern int pyo_vec_get_math_accuracy(void);
+
+#endif
@@ -0,0 +1,94 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#ifndef _VECOPS_
+#define _VECOPS_
+
+/* Block kernels used by the mul/add post-processing macros and by objects
+** with heavy inner loops (Mixer, OscBank).
+**
+** Every kernel exists in a scalar version and, depending on the compiler and
+** the target, in SSE2, AVX2 and NEON versions (float and double, following
+** MYFLT). The best version supported by the running cpu is selected once, by
+** pyo_vec_init(), when the module is imported. Vector versions only use plain
+** multiplications and additions (no fused multiply-add) so their output is
+** identical to the scalar loops, unless noted otherwise.
+**
+** This header expects MYFLT to be defined (it is included by pyomodule.h).
+*/
+
+/* data[i] = data[i] * mul + add */
+extern void (*pyo_vec_mul_scalar_add)(MYFLT *data, MYFLT mul, MYFLT add, int size);
+/* data[i] = data[i] * mul[i] + add */
+extern void (*pyo_vec_mul_add_scalar)(MYFLT *data, MYFLT *mul, MYFLT add, int size);
+/* data[i] = data[i] * mul + add[i] */
+extern void (*pyo_vec_scalar_mul_add)(MYFLT *data, MYFLT mul, MYFLT *add, int size);
+/* data[i] = data[i] * mul[i] + add[i] */
+extern void (*pyo_vec_muladd)(MYFLT *data, MYFLT *mul, MYFLT *add, int size);
+/* data[i] = data[i] * mul - add[i] */
+extern void (*pyo_vec_scalar_mul_sub)(MYFLT *data, MYFLT mul, MYFLT *sub, int size);
+/* data[i] = data[i] * mul[i] - add[i] */
+extern void (*pyo_vec_mulsub)(MYFLT *data, MYFLT *mul, MYFLT *sub, int size);
+/* data[i] = data[i] / div[i] + add, div clipped away from 0 (+/-0.00001 -> 0.00001) */
+extern void (*pyo_vec_div_add_scalar)(MYFLT *data, MYFLT *div, MYFLT add, int size);
+/* data[i] = data[i] / div[i] + add[i] */
+extern void (*pyo_vec_divadd)(MYFLT *data, MYFLT *div, MYFLT *add, int size);
+/* data[i] = data[i] / div[i] - add[i] */
+extern void (*pyo_vec_divsub)(MYFLT *data, MYFLT *div, MYFLT *sub, int size);
+
+/* out[i] += sum over j of ins[j][i] * gains[j], the inputs are summed four at a time */
+extern void (*pyo_vec_mix)(MYFLT *out, MYFLT **ins, MYFLT *gains, int num, int size);
+
+/* Bank of table lookup oscillators (linear interpolation, the table has size
+** points plus the guard point). For each partial j and sample i, adds to out[i]
+** the table value at pos[j] + i * inc[j], wrapped in [0, size[, times amp[j].
+** pos[j] is left at the start of the next block. Vector versions compute one
+** partial per lane, so their sum may differ from the scalar loop in the last bits. */
+extern void (*pyo_vec_osc_bank)(MYFLT *out, MYFLT *table, int size, MYFLT *pos, MYFLT *inc, MYFLT *amp, int num, int bufsize);
+
+/* Bank of num biquad cascades in transposed direct form II, one cascade per lane.
+** Lane j reads in[j * instride + i] (instride = 0 feeds the same input to every
+** lane) and writes out[j * outstride + i], out may be in. For each of the stages,
+** coeffs[(stage * 5 + k) * num + j] holds b0, b1, b2, a1 and a2 (k = 0 to 4,
+** normalized by a0) and state[(stage * 2 + k) * num + j] the two state values. */
+extern void (*pyo_vec_biquad_bank)(MYFLT *out, int outstride, MYFLT *in, int instride, MYFLT *coeffs, MYFLT *state, int num, int stages, int size);
+
+/* One pass of a Stockham complex fft, from the split arrays (xr, xi) to (yr, yi).
+** The pass splits l * s points into s sub-transforms of length l, l / 4 radix-4
+** butterflies each (a single radix-2 butterfly if l is 2). w holds, for each
+** butterfly p, the factors w^p, w^2p and w^3p (w = exp(-2i * pi / l)) as six
+** values: real and imaginary parts. Vector versions compute one sub-transform
+** per lane and fall back to the scalar loop when s is smaller than a vector. */
+extern void (*pyo_vec_fft_pass)(MYFLT *yr, MYFLT *yi, MYFLT *xr, MYFLT *xi, MYFLT *w, int l, int s);
+
+/* Adds num samples of a grain to chnls blocks of out (the blocks are stride
+** values apart). Sample i is the table value at pos + i * inc times the
+** envelope value at epos + i * einc (linear interpolation, both tables have
+** their guard point), times gains[c] in block c. Every position must be in
+** [0, size[ of its table. */
+extern void (*pyo_vec_grain)(MYFLT *out, int stride, int chnls, MYFLT *gains, MYFLT *table, MYFLT pos, MYFLT inc,
+                             MYFLT *env, MYFLT epos, MYFLT einc, int num);
+
+/* Selects the kernels for the running cpu. Called once at module init. */
+extern void pyo_vec_init(void);
+/* Returns the name of the selected instruction set ("scalar", "sse2", "avx2" or "neon"). */
+extern const char * pyo_vec_get_isa(void);
+
+#endif
@@ -246,7 +246,9 @@ OBJECTS_TREE = {'functions': sorted(['pa_count_devices', 'pa_get_default_input',
                                     'pa_list_devices', 'pa_count_host_apis', 'pa_list_host_apis', 'pa_get_default_host_api', 
                                     'pm_count_devices', 'pm_list_devices', 'sndinfo', 'savefile', 'pa_get_output_devices', 
                                     'pa_get_input_devices', 'midiToHz', 'sampsToSec', 'secToSamps', 'example', 'class_args', 
-                                    'pm_get_default_input', 'midiToTranspo', 'getVersion', 'reducePoints']),
+                                    'pm_get_default_input', 'midiToTranspo', 'getVersion', 'reducePoints', 'sndcat',
+                                    'renderParallel', 'renderBatch', 'renderSegments', 'setMathAccuracy', 'getMathAccuracy',
+                                    'setFFTBackend', 'getFFTBackend', 'getFFTBackends']),
         'PyoObject': {'analysis': sorted(['Follower', 'Follower2', 'ZCross']),
                       'controls': sorted(['Fader', 'Sig', 'SigTo', 'Adsr', 'Linseg', 'Expseg']),
                       'dynamics': sorted(['Clip', 'Compress', 'Degrade', 'Mirror', 'Wrap', 'Gate']),
@@ -264,7 +266,7 @@ OBJECTS_TREE = {'functions': sorted(['pa_count_devices', 'pa_get_default_input',
                       'randoms': sorted(['Randi', 'Randh', 'Choice', 'RandInt', 'Xnoise', 'XnoiseMidi']),
                       'players': sorted(['SfMarkerShuffler', 'SfPlayer', 'SfMarkerLooper']),
                       'tableprocess': sorted(['TableRec', 'Osc', 'Pointer', 'Lookup', 'Granulator', 'Pulsar', 
-                                            'TableRead', 'TableMorph', 'Looper', 'TableIndex', 'OscBank']),
+                                            'TableRead', 'TableMorph', 'Looper', 'TableIndex', 'OscBank', 'Particle']),
                       'matrixprocess': sorted(['MatrixRec', 'MatrixPointer', 'MatrixMorph']), 
                       'triggers': sorted(['Metro', 'Beat', 'TrigEnv', 'TrigRand', 'TrigRandInt', 'Select', 'Counter', 'TrigChoice', 
                                         'TrigFunc', 'Thresh', 'Cloud', 'Trig', 'TrigXnoise', 'TrigXnoiseMidi',
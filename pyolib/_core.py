@@ -19,7 +19,7 @@ You should have received a copy of the GNU General Public License
 along with pyo.  If not, see <http://www.gnu.org/licenses/>.
 """
 from types import ListType, SliceType, FloatType, StringType
-import random, os, sys, inspect, tempfile
+import random, os, sys, inspect, tempfile, weakref
 from subprocess import call
 from distutils.sysconfig import get_python_lib
 
@@ -83,6 +83,19 @@ def wrap(arg, i):
     else:
         return x
 
+# Operations of the arithmetic expressions, same values as DUMMY_OP_* in dummymodule.h.
+_OP_MUL, _OP_ADD, _OP_SUB, _OP_DIV = 0, 1, 2, 3
+
+def _fuse(expr, op, x):
+    """
+    Return the arithmetic expression `expr` (root stream, operations list, 
+    links) followed by the operation `op` with operand `x`. The links are 
+    the (Dummy weak reference, expression index) pairs of the unbuilt 
+    Dummy objects whose operations were copied into the expression.
+    
+    """
+    return (expr[0], expr[1] + [(op, x)], expr[2])
+
 def duplicateArgsList(args, num):
     tmp = []
     for arg in args:
@@ -248,7 +261,8 @@ class PyoObject(object):
     between pyo objects or between pyo objects and numbers. Doing so 
     returns a Dummy object with the result of the operation.
     `b = a * 0.5` creates a Dummy object `b` with `mul` attribute set 
-    to 0.5 and leave `a` unchanged.
+    to 0.5 and leave `a` unchanged. Chained operations are fused: 
+    `a * b + c` computes a single Dummy reading `a` directly.
     
     Inplace multiplication, addition, division and substraction can be 
     applied between pyo objects or between pyo objects and numbers. 
@@ -270,21 +284,21 @@ class PyoObject(object):
         self._keep_trace.append(x)
         x, lmax = convertArgsToLists(x)
         if self.__len__() >= lmax:
-            self._add_dummy = Dummy([obj + wrap(x,i/self._op_duplicate) for i, obj in enumerate(self._base_objs)])
+            self._add_dummy = Dummy(exprs=[_fuse(e, _OP_ADD, wrap(x,i/self._op_duplicate)) for i, e in enumerate(self._getExprs())])
         else:
             if isinstance(x, PyoObject):
                 self._add_dummy = x + self
             else:
-                self._add_dummy = Dummy([wrap(self._base_objs,i) + obj for i, obj in enumerate(x)])  
+                self._add_dummy = Dummy(exprs=[_fuse(wrap(self._getExprs(),i), _OP_ADD, obj) for i, obj in enumerate(x)])  
         return self._add_dummy
         
     def __radd__(self, x):
         self._keep_trace.append(x)
         x, lmax = convertArgsToLists(x)
         if self.__len__() >= lmax:
-            self._add_dummy = Dummy([obj + wrap(x,i/self._op_duplicate) for i, obj in enumerate(self._base_objs)])
+            self._add_dummy = Dummy(exprs=[_fuse(e, _OP_ADD, wrap(x,i/self._op_duplicate)) for i, e in enumerate(self._getExprs())])
         else:
-            self._add_dummy = Dummy([wrap(self._base_objs,i) + obj for i, obj in enumerate(x)])                
+            self._add_dummy = Dummy(exprs=[_fuse(wrap(self._getExprs(),i), _OP_ADD, obj) for i, obj in enumerate(x)])                
         return self._add_dummy
             
     def __iadd__(self, x):
@@ -295,14 +309,14 @@ class PyoObject(object):
         self._keep_trace.append(x)
         x, lmax = convertArgsToLists(x)
         if self.__len__() >= lmax:
-            self._add_dummy = Dummy([obj - wrap(x,i/self._op_duplicate) for i, obj in enumerate(self._base_objs)])
+            self._add_dummy = Dummy(exprs=[_fuse(e, _OP_SUB, wrap(x,i/self._op_duplicate)) for i, e in enumerate(self._getExprs())])
         else:
             if isinstance(x, PyoObject):
                 print 'Substraction Warning: %s - %s' % (self.__repr__(), x.__repr__()),
                 print 'Right operator trunctaded to match left operator number of streams.'
-                self._add_dummy = Dummy([obj - wrap(x,i) for i, obj in enumerate(self._base_objs)])
+                self._add_dummy = Dummy(exprs=[_fuse(e, _OP_SUB, wrap(x,i)) for i, e in enumerate(self._getExprs())])
             else:
-                self._add_dummy = Dummy([wrap(self._base_objs,i) - obj for i, obj in enumerate(x)])
+                self._add_dummy = Dummy(exprs=[_fuse(wrap(self._getExprs(),i), _OP_SUB, obj) for i, obj in enumerate(x)])
         return self._add_dummy
 
     def __rsub__(self, x):
@@ -322,21 +336,21 @@ class PyoObject(object):
         self._keep_trace.append(x)
         x, lmax = convertArgsToLists(x)
         if self.__len__() >= lmax:
-            self._mul_dummy = Dummy([obj * wrap(x,i/self._op_duplicate) for i, obj in enumerate(self._base_objs)])
+            self._mul_dummy = Dummy(exprs=[_fuse(e, _OP_MUL, wrap(x,i/self._op_duplicate)) for i, e in enumerate(self._getExprs())])
         else:
             if isinstance(x, PyoObject):
                 self._mul_dummy = x * self 
             else:
-                self._mul_dummy = Dummy([wrap(self._base_objs,i) * obj for i, obj in enumerate(x)])  
+                self._mul_dummy = Dummy(exprs=[_fuse(wrap(self._getExprs(),i), _OP_MUL, obj) for i, obj in enumerate(x)])  
         return self._mul_dummy
         
     def __rmul__(self, x):
         self._keep_trace.append(x)
         x, lmax = convertArgsToLists(x)
         if self.__len__() >= lmax:
-            self._mul_dummy = Dummy([obj * wrap(x,i/self._op_duplicate) for i, obj in enumerate(self._base_objs)])
+            self._mul_dummy = Dummy(exprs=[_fuse(e, _OP_MUL, wrap(x,i/self._op_duplicate)) for i, e in enumerate(self._getExprs())])
         else:
-            self._mul_dummy = Dummy([wrap(self._base_objs,i) * obj for i, obj in enumerate(x)])                
+            self._mul_dummy = Dummy(exprs=[_fuse(wrap(self._getExprs(),i), _OP_MUL, obj) for i, obj in enumerate(x)])                
         return self._mul_dummy
             
     def __imul__(self, x):
@@ -347,14 +361,14 @@ class PyoObject(object):
         self._keep_trace.append(x)
         x, lmax = convertArgsToLists(x)
         if self.__len__() >= lmax:
-            self._mul_dummy = Dummy([obj / wrap(x,i/self._op_duplicate) for i, obj in enumerate(self._base_objs)])
+            self._mul_dummy = Dummy(exprs=[_fuse(e, _OP_DIV, wrap(x,i/self._op_duplicate)) for i, e in enumerate(self._getExprs())])
         else:
             if isinstance(x, PyoObject):
                 print 'Division Warning: %s / %s' % (self.__repr__(), x.__repr__()),
                 print 'Right operator trunctaded to match left operator number of streams.'
-                self._mul_dummy = Dummy([obj / wrap(x,i) for i, obj in enumerate(self._base_objs)])
+                self._mul_dummy = Dummy(exprs=[_fuse(e, _OP_DIV, wrap(x,i)) for i, e in enumerate(self._getExprs())])
             else:
-                self._mul_dummy = Dummy([wrap(self._base_objs,i) / obj for i, obj in enumerate(x)])
+                self._mul_dummy = Dummy(exprs=[_fuse(wrap(self._getExprs(),i), _OP_DIV, obj) for i, obj in enumerate(x)])
         return self._mul_dummy
 
     def __rdiv__(self, x):
@@ -382,6 +396,17 @@ class PyoObject(object):
     def __len__(self):
         return len(self._base_objs)
 
+    def _getExprs(self):
+        # One arithmetic expression (root stream, operations, links) per stream, 
+        # see Dummy. Reversed substractions and divisions give Dummy objects as streams.
+        exprs = []
+        for obj in self._base_objs:
+            if isinstance(obj, PyoObject):
+                exprs.extend(obj._getExprs())
+            else:
+                exprs.append((obj, [], []))
+        return exprs
+
     def __del__(self):
         for obj in self._base_objs:
             obj.deleteStream()
@@ -1202,6 +1227,9 @@ class Dummy(PyoObject):
     objs_list : list of audio Stream objects
         List of Stream objects return by the PyoObject hidden method 
         getBaseObjects().
+    exprs : list of arithmetic expressions
+        Used instead of `objs_list` by the arithmetic operators. One 
+        (root stream, operations list) tuple per stream.
 
     Notes:
     
@@ -1221,6 +1249,16 @@ class Dummy(PyoObject):
     >>> print b
     <pyolib._core.Dummy object at 0x11fd710>
 
+    The streams of a Dummy created by an arithmetic operator are only 
+    built when they are first needed (when the Dummy is played, sent 
+    to an output or given to another object). An operation applied to 
+    a Dummy whose streams are not built yet extends its expression 
+    instead, so `a * b + c` gives a single stream which reads `a` and 
+    computes both operations in one pass, and the intermediate `a * b` 
+    never computes anything. If the intermediate Dummy is kept and its 
+    `mul` or `add` changed later, the expressions fused with it read 
+    its streams from then on, so they follow the change.
+
     Examples:
     
     >>> s = Server().boot()
@@ -1232,15 +1270,91 @@ class Dummy(PyoObject):
     >>> c = Sine(p*1.5, mul=.25).out()
     
     """
-    def __init__(self, objs_list):
+    def __init__(self, objs_list=None, exprs=None):
         PyoObject.__init__(self)
         self._mul = 1
         self._add = 0
-        self._base_objs = objs_list
+        self._objs = objs_list
+        self._exprs = exprs
+        # (Dummy weak reference, expression index, own expression index) of the 
+        # expressions which copied our operations, see _unfuse.
+        self._fused = []
+        if exprs is not None:
+            for i, expr in enumerate(exprs):
+                for ref, j in expr[2]:
+                    dummy = ref()
+                    if dummy is not None:
+                        dummy._fused.append((weakref.ref(self), i, j))
+
+    def _getBaseObjs(self):
+        if self._objs is None:
+            self._objs = [Dummy_base(root, ops) for root, ops, links in self._exprs]
+        return self._objs
+
+    def _setBaseObjs(self, x):
+        self._objs = x
+
+    _base_objs = property(_getBaseObjs, _setBaseObjs)
+
+    def _getExprs(self):
+        if self._objs is None:
+            return [(root, ops, links + [(weakref.ref(self), j)]) for j, (root, ops, links) in enumerate(self._exprs)]
+        return PyoObject._getExprs(self)
+
+    def _unfuse(self):
+        # Called before our mul or add changes: the expressions which copied our 
+        # operations read our streams instead, and follow the change.
+        fused, self._fused = self._fused, []
+        for ref, i, j in fused:
+            dummy = ref()
+            if dummy is not None:
+                dummy._rebase(i, self, j)
+
+    def _rebase(self, i, dummy, j):
+        # Expression `i` reads stream `j` of `dummy` instead of copying its operations.
+        root, ops, links = self._exprs[i]
+        for k, (ref, index) in enumerate(links):
+            if ref() is dummy and index == j:
+                break
+        else:
+            # Already rebased on a Dummy fused after `dummy`.
+            return
+        ops = ops[len(dummy._exprs[j][1]):]
+        root = dummy._base_objs[j]
+        self._exprs[i] = (root, ops, links[k+1:])
+        if self._objs is not None:
+            self._objs[i]._setExpr(root, ops[:-1])
+
+    def __len__(self):
+        if self._objs is None:
+            return len(self._exprs)
+        return len(self._objs)
+
+    def setMul(self, x):
+        self._unfuse()
+        PyoObject.setMul(self, x)
+
+    def setAdd(self, x):
+        self._unfuse()
+        PyoObject.setAdd(self, x)
+
+    def setSub(self, x):
+        self._unfuse()
+        PyoObject.setSub(self, x)
+
+    def setDiv(self, x):
+        self._unfuse()
+        PyoObject.setDiv(self, x)
 
     def __dir__(self):
         return ['mul', 'add']
 
+    def __del__(self):
+        if self._objs is not None:
+            for obj in self._objs:
+                obj.deleteStream()
+                del obj
+
     def deleteStream(self):
         for obj in self._base_objs:
             obj.deleteStream()
@@ -844,8 +844,13 @@ class Convolve(PyoObject):
     
     Notes :
     
-    Convolution is very expensive to compute, so the impulse response must
-    be kept very short to run in real time.
+    When `size` is greater than 64 samples and the server's buffer size is a
+    power-of-two, the convolution is computed in the frequency domain with
+    impulse partitions of one buffer size (uniformly partitioned overlap-save),
+    which allows impulse responses of several seconds to run in real time.
+    The partition spectra are computed once and shared by all Convolve objects
+    using the same table and size. They are recomputed whenever the table
+    content changes, which is expensive for long tables.
     
     Usually convolution generates a high amplitude level, take care of the
     `mul` parameter!
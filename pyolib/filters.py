@@ -54,6 +54,7 @@ class Biquad(PyoObject):
     setFreq(x) : Replace the `freq` attribute.
     setQ(x) : Replace the `q` attribute.
     setType(x) : Replace the `type` attribute.
+    setInterval(x) : Replace the `interval` attribute.
     
     Attributes:
     
@@ -61,6 +62,7 @@ class Biquad(PyoObject):
     freq : float or PyoObject. Cutoff or center frequency of the filter.
     q : float or PyoObject. Q of the filter.
     type : int. Filter type.
+    interval : int. Coefficients update interval for audio rate parameters.
     
     Examples:
     
@@ -77,6 +79,7 @@ class Biquad(PyoObject):
         self._freq = freq
         self._q = q
         self._type = type
+        self._interval = 1
         self._mul = mul
         self._add = add
         self._in_fader = InputFader(input)
@@ -144,6 +147,25 @@ class Biquad(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setType(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setInterval(self, x):
+        """
+        Replace the `interval` attribute.
+
+        When `freq` or `q` is an audio signal, the filter coefficients are 
+        computed every `interval` samples and linearly interpolated in between, 
+        which is much cheaper for slow modulations. 1 (the default) computes 
+        them for every sample.
+        
+        Parameters:
+
+        x : int
+            New `interval` attribute, in samples. 
+
+        """
+        self._interval = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setInterval(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapQ(self._q), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -176,6 +198,13 @@ class Biquad(PyoObject):
     @type.setter
     def type(self, x): self.setType(x)
 
+    @property
+    def interval(self):
+        """int. Coefficients update interval for audio rate parameters.""" 
+        return self._interval
+    @interval.setter
+    def interval(self, x): self.setInterval(x)
+
 class Biquadx(PyoObject):
     """
     A multi-stages sweepable general purpose biquadratic digital filter. 
@@ -213,6 +242,7 @@ class Biquadx(PyoObject):
     setQ(x) : Replace the `q` attribute.
     setType(x) : Replace the `type` attribute.
     setType(x) : Replace the `stages` attribute.
+    setInterval(x) : Replace the `interval` attribute.
 
     Attributes:
 
@@ -221,6 +251,7 @@ class Biquadx(PyoObject):
     q : float or PyoObject. Q of the filter.
     type : int. Filter type.
     stages : int. The number of filtering stages.
+    interval : int. Coefficients update interval for audio rate parameters.
 
     Examples:
 
@@ -237,6 +268,7 @@ class Biquadx(PyoObject):
         self._freq = freq
         self._q = q
         self._type = type
+        self._interval = 1
         self._stages = stages
         self._mul = mul
         self._add = add
@@ -319,6 +351,25 @@ class Biquadx(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setStages(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setInterval(self, x):
+        """
+        Replace the `interval` attribute.
+
+        When `freq` or `q` is an audio signal, the filter coefficients are 
+        computed every `interval` samples and linearly interpolated in between, 
+        which is much cheaper for slow modulations. 1 (the default) computes 
+        them for every sample.
+        
+        Parameters:
+
+        x : int
+            New `interval` attribute, in samples. 
+
+        """
+        self._interval = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setInterval(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapQ(self._q), SLMapMul(self._mul)]
         PyoObject.ctrl(self, map_list, title, wxnoserver)
@@ -351,6 +402,13 @@ class Biquadx(PyoObject):
     @type.setter
     def type(self, x): self.setType(x)
 
+    @property
+    def interval(self):
+        """int. Coefficients update interval for audio rate parameters.""" 
+        return self._interval
+    @interval.setter
+    def interval(self, x): self.setInterval(x)
+
     @property
     def stages(self):
         """int. The number of filtering stages.""" 
@@ -393,6 +451,7 @@ class EQ(PyoObject):
     setQ(x) : Replace the `q` attribute.
     setBoost(x) : Replace the `boost` attribute.
     setType(x) : Replace the `type` attribute.
+    setInterval(x) : Replace the `interval` attribute.
     
     Attributes:
     
@@ -401,6 +460,7 @@ class EQ(PyoObject):
     q : float or PyoObject. Q of the filter.
     boost : float or PyoObject. Boost of the filter at center frequency.
     type : int. Filter type.
+    interval : int. Coefficients update interval for audio rate parameters.
     
     Examples:
     
@@ -420,6 +480,7 @@ class EQ(PyoObject):
         self._q = q
         self._boost = boost
         self._type = type
+        self._interval = 1
         self._mul = mul
         self._add = add
         self._in_fader = InputFader(input)
@@ -501,6 +562,25 @@ class EQ(PyoObject):
         x, lmax = convertArgsToLists(x)
         [obj.setType(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
 
+    def setInterval(self, x):
+        """
+        Replace the `interval` attribute.
+
+        When `freq` or `q` or `boost` is an audio signal, the filter coefficients are 
+        computed every `interval` samples and linearly interpolated in between, 
+        which is much cheaper for slow modulations. 1 (the default) computes 
+        them for every sample.
+        
+        Parameters:
+
+        x : int
+            New `interval` attribute, in samples. 
+
+        """
+        self._interval = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setInterval(wrap(x,i)) for i, obj in enumerate(self._base_objs)]
+
     def ctrl(self, map_list=None, title=None, wxnoserver=False):
         self._map_list = [SLMapFreq(self._freq), SLMapQ(self._q), 
                           SLMap(-40.0, 40.0, "lin", "boost", self._boost), 
@@ -542,6 +622,13 @@ class EQ(PyoObject):
     @type.setter
     def type(self, x): self.setType(x)
 
+    @property
+    def interval(self):
+        """int. Coefficients update interval for audio rate parameters.""" 
+        return self._interval
+    @interval.setter
+    def interval(self, x): self.setInterval(x)
+
 class Tone(PyoObject):
     """
     A first-order recursive low-pass filter with variable frequency response.
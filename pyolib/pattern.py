@@ -52,7 +52,21 @@ class Pattern(PyoObject):
     
     Notes:
 
-    The out() method is bypassed. Pattern doesn't return signal.
+    The calls are placed on the server's timeline, at the exact sample, 
+    without drift. The function is called at the start of the buffer 
+    holding its time (before the buffer is computed), so the changes it 
+    makes apply to the whole buffer. Pattern's signal is a trigger at 
+    the exact sample of each call, which can drive objects waiting for 
+    triggers (TrigEnv, TrigRand, ...) with the precision of a sample, 
+    whatever the buffer size.
+
+    A new time applies to the waiting call, which moves to the last 
+    call plus the new time (or right away if this is already past). 
+    An audio-rate time is read at every sample, the calls are then 
+    made at the start of the buffer holding them.
+
+    The out() method is bypassed. Pattern's signal can not be sent to 
+    audio outs.
     
     Pattern has no `mul` and `add` attributes.
 
@@ -250,6 +264,9 @@ class CallAfter(PyoObject):
   
     Notes:
 
+    The call is placed on the server's timeline and made at the start 
+    of the buffer holding its time, before the buffer is computed.
+
     The out() method is bypassed. CallAfter doesn't return signal.
     
     CallAfter has no `mul` and `add` attributes.
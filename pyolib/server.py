@@ -20,6 +20,7 @@ along with pyo.  If not, see <http://www.gnu.org/licenses/>.
 """
 from _core import *
 from _widgets import createServerGUI
+import math, time, traceback, multiprocessing, Queue, threading
         
 ######################################################################
 ### Proxy of Server object
@@ -59,6 +60,8 @@ class Server(object):
     Methods:
 
     setAmp(x) : Set the overall amplitude.
+    setCommandDelay(x) : Set the delay before the parameter changes are applied.
+    setGILFree(x) : Compute the audio without holding the Python interpreter lock.
     boot() : Boot the server. Must be called before defining any signal 
         processing chain.
     shutdown() : Shut down and clear the server.
@@ -71,10 +74,22 @@ class Server(object):
         This method creates a file called `pyo_rec.aif` in the 
         user's home directory if a path is not supplied.
     recstop() : Stops previously started recording.
+    getRecordOverflows() : Returns the overflow counters of the recording.
     getSamplingRate() : Returns the current sampling rate.
     getNchnls() : Returns the current number of channels.
     getBufferSize() : Returns the current buffer size.
     getIsStarted() : Returns 1 if the server is started, otherwise returns 0.
+    getRealtimeFactor() : Returns the speed of the last offline rendering.
+    setProfiling(x) : Start or stop the measure of the time spent by each object.
+    getProfile() : Returns the time spent by each object and by the whole callback.
+    setFlushDenormals(x) : Compute the audio with denormal numbers flushed to zero.
+    setCountDenormals(x) : Start or stop counting the denormal samples.
+    getDenormals() : Returns the denormal samples counters.
+    setMetering(x) : Start or stop metering the output channels.
+    addMeter(obj) : Meter the output of an object.
+    removeMeter(obj) : Stop metering the output of an object.
+    getMeters() : Returns the latest readings of the output meters.
+    getMeter(obj) : Returns the latest readings of an object's meters.
 
     The next methods must be called before booting the server
 
@@ -86,6 +101,10 @@ class Server(object):
     setBufferSize(x) : Set the buffer size used by the server.
     setNchnls(x) : Set the number of channels used by the server.
     setDuplex(x) : Set the duplex mode used by the server.
+    setThreads(x) : Set the number of threads used to compute the audio streams.
+    setFFTThreads(x) : Set the number of threads computing the FFT and IFFT frames.
+    setDiskBuffer(x) : Set the duration of the sound file streaming buffers.
+    setDiskThreads(x) : Set the number of threads reading the streamed sound files.
     setVerbosity(x) : Set the server's verbosity.
     reinit(sr, nchnls, buffersize, duplex, audio, jackname) : Reinit the server's settings.
         
@@ -266,6 +285,83 @@ class Server(object):
         """        
         self._server.setDuplex(x)
 
+    def setThreads(self, x):
+        """
+        Set the number of threads used to compute the audio streams.
+        
+        Streams that don't depend on each other are computed in parallel. 
+        Objects calling back into python (Pattern, TrigFunc, CallAfter, 
+        etc.) are always computed alone by the audio thread, in the order 
+        they were created. 1, the default, computes every stream serially.
+
+        Parameters:
+
+        x : int
+            Number of threads, the audio thread included.
+
+        """        
+        self._server.setThreads(x)
+
+    def setFFTThreads(self, x):
+        """
+        Set the number of threads computing the FFT and IFFT frames.
+
+        An FFT or IFFT object transforms a whole frame at once when it 
+        is complete, so the blocks where frames complete cost much more 
+        than the others. With a positive value, FFT and IFFT objects 
+        created after the boot hand their frames to these threads and 
+        output the result one buffer later. The transforms then run 
+        beside the rest of the processing. The outputs are the same, 
+        delayed by `buffer size` samples for each FFT and each IFFT. 
+        Objects with a frame smaller than the buffer size aren't 
+        delayed. 0, the default, computes the frames in the blocks.
+
+        Particle objects also use these threads to compute their 
+        grains, without any delay.
+
+        Parameters:
+
+        x : int
+            Number of threads.
+
+        """        
+        self._server.setFFTThreads(x)
+
+    def setDiskBuffer(self, x):
+        """
+        Set the duration of the sound file streaming buffers.
+        
+        SfPlayer, SfMarkerShuffler and SfMarkerLooper never read the 
+        disk in the audio callback. Background threads keep, for each 
+        player, `x` seconds of sound ahead of the reading position and 
+        the beginning of the next loop or marker. Larger values protect 
+        against slow disks at the cost of memory. Only affects players 
+        created afterwards. Default to 2 seconds.
+
+        Parameters:
+
+        x : float
+            Buffer duration in seconds.
+
+        """        
+        self._server.setDiskBuffer(x)
+
+    def setDiskThreads(self, x):
+        """
+        Set the number of threads reading the streamed sound files.
+        
+        The threads are shared by all players, the one closest to run 
+        out of sound is served first. More threads help when playing 
+        many files from network disks. Default to 2.
+
+        Parameters:
+
+        x : int
+            Number of threads.
+
+        """        
+        self._server.setDiskThreads(x)
+
     def setVerbosity(self, x):
         """
         Set the server's verbosity.
@@ -284,6 +380,9 @@ class Server(object):
         Set the server's starting time offset. First `x` seconds will be rendered
         offline as fast as possible.
 
+        With the offline backend, the first `x` seconds are rendered but 
+        not written to the file, which then starts without a fade-in.
+
         Parameters:
 
         x : float
@@ -305,6 +404,61 @@ class Server(object):
         """
         self._amp = x
         self._server.setAmp(x)
+
+    def setCommandDelay(self, x):
+        """
+        Set the delay, in seconds, before the parameter changes are applied.
+
+        While the server is running, the parameter changes (the `set` 
+        methods of the objects, mul, add and the server's amplitude) 
+        are queued and applied by the audio callback at the start of 
+        the next buffer. With a delay, every change made afterward is 
+        applied `x` seconds after the current time of the server, 
+        rounded to the buffer containing that time. Changes made at the 
+        same time keep their relative timing, whatever the moment the 
+        Python code runs. 0 restores the immediate changes.
+
+        Parameters:
+
+        x : float
+            Delay in seconds.
+
+        >>> s.setCommandDelay(.05)
+        >>> a.freq = 500 # heard 50 ms later
+        >>> s.setCommandDelay(0)
+
+        """
+        self._server.setCommandDelay(x)
+
+    def setGILFree(self, x):
+        """
+        Compute the audio without holding the Python interpreter lock.
+
+        By default, the audio callback holds the interpreter lock for 
+        the whole buffer, so a busy Python thread (a user interface, 
+        for example) delays the audio and may cause dropouts. In 
+        GIL-free mode, the objects are computed without the lock and 
+        the Python functions called by the objects (Pattern, Score, 
+        CallAfter, TrigFunc, VarPort, OscDataReceive, the server's 
+        meters and clock) run on a separate control thread, a little 
+        after the buffer that triggered them. The few objects which 
+        need the interpreter at every buffer (readers and recorders 
+        built on Python lists, OscReceive, ...) take the lock around 
+        their own processing only.
+
+        Offline rendering also releases the lock in this mode, which 
+        lets other Python threads (and other renderings, see renderBatch) 
+        run while the file is rendered. The callbacks still take the 
+        lock and run at once, synchronous with the rendered buffers.
+
+        Parameters:
+
+        x : boolean
+            True activates the GIL-free mode, False (the default) 
+            returns to the synchronous mode.
+
+        """
+        self._server.setGILFree(x)
  
     def shutdown(self):
         """
@@ -426,6 +580,21 @@ class Server(object):
         
         """
         self._server.recstop()
+
+    def getRecordOverflows(self):
+        """
+        Returns the overflow counters of the current (or last) recording.
+
+        In real time, the samples to record go through a memory buffer 
+        (about two seconds long) to a thread writing the file, so the 
+        audio callback never waits for the disk. If the disk can't keep 
+        up and the buffer is full, the samples are dropped. Returns a 
+        tuple (overflows, dropped frames), where `overflows` is the 
+        number of buffers which lost samples. Offline rendering waits 
+        for the disk and never drops samples.
+
+        """
+        return self._server.getRecordOverflows()
         
     def getStreams(self):
         """
@@ -462,6 +631,212 @@ class Server(object):
         """
         return self._server.getIsStarted()
 
+    def setProfiling(self, x):
+        """
+        Start or stop the measure of the time spent by each object.
+
+        When active, the server measures every call of every audio 
+        callback and the duration of every block. Starting the profiling 
+        resets the statistics. When it is inactive, the cost is a single 
+        test per object per block.
+
+        Parameters:
+
+        x : boolean
+            True to start profiling, False to stop.
+
+        """
+        self._server.setProfiling(x)
+
+    def getProfile(self):
+        """
+        Returns the time spent by each object and by the whole callback.
+
+        Durations are given in cycles of the profiler's clock. The result 
+        is a dictionary with these keys:
+
+        'frequency' : Number of cycles per second of the clock.
+        'budget' : Cycles available for a block (bufferSize / samplingRate).
+        'callback' : Statistics of the whole blocks, with the extra keys 
+            'load' (mean duration divided by the budget), 'overruns' 
+            (blocks longer than the budget) and 'xruns' (dropouts 
+            reported by the audio driver).
+        'objects' : Dictionary of the statistics of each stream, keyed by 
+            a tuple (object class, stream id).
+
+        Each statistics dictionary holds the number of 'calls', the total 
+        'cycles', the 'mean' and 'worst' durations of a call and the 
+        'histogram' of the durations, where the count at position k is 
+        the number of calls which took between 2**k and 2**(k+1) cycles.
+
+        Returns None if the profiling is not active.
+
+        >>> s.setProfiling(True)
+        >>> # ... later
+        >>> p = s.getProfile()
+        >>> worst = sorted(p['objects'].items(), key=lambda x: -x[1]['cycles'])[:10]
+
+        """
+        return self._server.getProfile()
+
+    def setFlushDenormals(self, x):
+        """
+        Compute the audio with denormal numbers flushed to zero.
+
+        Filters, reverbs and delay lines decaying towards silence end 
+        up computing with denormal (very small) numbers, which can be 
+        many times slower than normal ones. When active (the default), 
+        every block is computed with the flush-to-zero and 
+        denormals-are-zero modes of the processor set, in the audio 
+        thread and in the worker threads (see setThreads). The Denorm 
+        object is then unnecessary. Has no effect on processors without 
+        these modes.
+
+        Parameters:
+
+        x : boolean
+            True to flush denormals to zero, False to keep them.
+
+        """
+        self._server.setFlushDenormals(x)
+
+    def setCountDenormals(self, x):
+        """
+        Start or stop counting the denormal samples.
+
+        When active, the server inspects the output of every object 
+        after every block and counts the denormal samples. Starting the 
+        count resets the counters.
+
+        Parameters:
+
+        x : boolean
+            True to start counting, False to stop.
+
+        """
+        self._server.setCountDenormals(x)
+
+    def getDenormals(self):
+        """
+        Returns the denormal samples counters.
+
+        The result is a dictionary with these keys:
+
+        'samples' : Number of denormal samples found in the objects outputs.
+        'blocks' : Number of blocks with at least one denormal sample.
+        'checked' : Number of blocks inspected.
+        'flush' : 1 if the denormals are flushed to zero, otherwise 0.
+
+        Returns None if the counting is not active.
+
+        >>> s.setFlushDenormals(False)
+        >>> s.setCountDenormals(True)
+        >>> # ... later
+        >>> print s.getDenormals()['samples']
+
+        """
+        return self._server.getDenormals()
+
+    def setMetering(self, x):
+        """
+        Start or stop metering the output channels.
+
+        While metering, the audio thread measures the peak and RMS 
+        amplitudes of every output channel (and of the objects given 
+        to addMeter) every 50 milliseconds and leaves them in a queue, 
+        without calling any Python code nor waiting for a reader. The 
+        gui() meters and clock are updated by a separate thread reading 
+        this queue, so a slow interface can't delay the audio. The 
+        readings are dropped (and counted) when nobody reads them in 
+        time. Metering starts when the gui is shown or when a meter is 
+        added.
+
+        Parameters:
+
+        x : boolean
+            True to start metering, False to stop.
+
+        """
+        self._server.setMetering(x)
+
+    def addMeter(self, obj):
+        """
+        Meter the output of an object.
+
+        The peak and RMS amplitudes of every stream of `obj` (its 
+        `mul` and `add` applied) are measured like the output channels. 
+        See getMeter.
+
+        Parameters:
+
+        obj : PyoObject
+            Object to meter.
+
+        """
+        for o in obj.getBaseObjects():
+            self._server.addMeter(o._getStream())
+
+    def removeMeter(self, obj):
+        """
+        Stop metering the output of an object.
+
+        Parameters:
+
+        obj : PyoObject
+            Object given to addMeter.
+
+        """
+        for o in obj.getBaseObjects():
+            self._server.removeMeter(o._getStream())
+
+    def getMeters(self):
+        """
+        Returns the latest readings of the output meters.
+
+        The result is a dictionary with these keys:
+
+        'time' : Time of the readings, in seconds since the server started.
+        'outputs' : List of (peak, rms) tuples, one per output channel.
+        'streams' : Dictionary of the (peak, rms) tuples of the metered 
+            objects, by stream. See getMeter.
+        'dropped' : Number of readings lost because nobody read them in time.
+
+        Returns None if the metering is not active.
+
+        >>> s.setMetering(True)
+        >>> # ... later
+        >>> print [peak for peak, rms in s.getMeters()['outputs']]
+
+        """
+        return self._server.getMeters()
+
+    def getMeter(self, obj):
+        """
+        Returns the latest readings of an object's meters.
+
+        The result is a list of (peak, rms) tuples, one per stream of 
+        `obj`, None for the streams not read yet. Returns None if the 
+        metering is not active.
+
+        Parameters:
+
+        obj : PyoObject
+            Object given to addMeter.
+
+        """
+        meters = self._server.getMeters()
+        if meters == None:
+            return None
+        return [meters['streams'].get(o._getStream()) for o in obj.getBaseObjects()]
+
+    def getRealtimeFactor(self):
+        """
+        Returns the speed of the last offline rendering, relative to real 
+        time (duration of the sound rendered divided by the time it took).
+        
+        """
+        return self._server.getRealtimeFactor()
+
     @property
     def amp(self):
         """float. Overall amplitude.""" 
@@ -486,3 +861,279 @@ class Server(object):
             self.setVerbosity(x)
         else:
             raise Exception("verbosity must be an integer")
+
+######################################################################
+### Parallel offline rendering
+######################################################################
+def _offlineWorker(results, index, func, args, dur, filename, offset, options):
+    try:
+        s = Server(sr=options["sr"], nchnls=options["nchnls"], buffersize=options["buffersize"], 
+                   duplex=0, audio="offline")
+        s.setVerbosity(options["verbosity"])
+        s.boot()
+        s.recordOptions(dur=dur, filename=filename, fileformat=options["fileformat"], sampletype=options["sampletype"])
+        s.setStartOffset(offset)
+        objs = func(*args)
+        s.start()
+        results.put((index, ""))
+    except:
+        results.put((index, traceback.format_exc()))
+
+def _runOffline(tasks, processes):
+    # A Server is unique in a process, each task is rendered in a child process.
+    if processes == None:
+        processes = multiprocessing.cpu_count()
+    results = multiprocessing.Queue()
+    waiting = range(len(tasks))
+    running = {}
+    errors = []
+    while waiting or running:
+        while waiting and len(running) < processes:
+            i = waiting.pop(0)
+            running[i] = multiprocessing.Process(target=_offlineWorker, args=(results, i) + tasks[i])
+            running[i].start()
+        try:
+            i, error = results.get(True, 0.1)
+            if error:
+                errors.append(error)
+            running.pop(i).join()
+        except Queue.Empty:
+            for i, p in running.items():
+                if p.exitcode not in [None, 0]:
+                    errors.append("Offline rendering %d exited with code %d.\n" % (i, p.exitcode))
+                    del running[i]
+    if errors:
+        raise Exception("".join(errors))
+
+def _offlineOptions(sr, nchnls, buffersize, fileformat, sampletype, verbosity):
+    return {"sr": sr, "nchnls": nchnls, "buffersize": buffersize, "fileformat": fileformat, 
+            "sampletype": sampletype, "verbosity": verbosity}
+
+def renderParallel(jobs, processes=None, sr=44100, nchnls=2, buffersize=256, fileformat=0, sampletype=0, verbosity=1):
+    """
+    Renders independent offline patches at the same time, on all cores.
+
+    Each job is rendered by its own offline Server, in a separate process. 
+    Must be called from a script which has not created a Server. Returns 
+    the realtime factor achieved, the total duration of sound rendered 
+    divided by the elapsed time.
+
+    renderParallel(jobs, processes=None, sr=44100, nchnls=2, buffersize=256, 
+                   fileformat=0, sampletype=0, verbosity=1)
+
+    Parameters:
+
+    jobs : list of tuples
+        Each job is a tuple (func, dur, filename) or (func, dur, filename, args). 
+        `func` is called with the optional `args` once the Server is booted, 
+        it must create the patch and return the objects to keep alive. `dur` 
+        is the duration, in seconds, and `filename` the path of the sound 
+        file to create.
+    processes : int, optional
+        Number of renderings running at the same time. The default (None) 
+        uses the number of cores.
+    sr, nchnls, buffersize : int, optional
+        Server settings used by every job. See Server.
+    fileformat, sampletype : int, optional
+        Format of the created sound files. See Server.recordOptions.
+    verbosity : int, optional
+        Verbosity of the Servers. See Server.setVerbosity. Defaults to 1.
+
+    Examples:
+
+    >>> def patch(freq):
+    ...     return Sine(freq, mul=.3).out()
+    >>> jobs = [(patch, 60, "sine%d.wav" % f, (f,)) for f in [100, 200, 300, 400]]
+    >>> factor = renderParallel(jobs)
+
+    """
+    options = _offlineOptions(sr, nchnls, buffersize, fileformat, sampletype, verbosity)
+    tasks = []
+    total = 0.0
+    for job in jobs:
+        func, dur, filename = job[:3]
+        args = tuple(job[3]) if len(job) > 3 else ()
+        tasks.append((func, args, dur, filename, 0, options))
+        total += dur
+    t0 = time.time()
+    _runOffline(tasks, processes)
+    return total / max(time.time() - t0, 0.000001)
+
+def _batchWorker(tasks, lock, errors, options):
+    while True:
+        lock.acquire()
+        if not tasks:
+            lock.release()
+            return
+        index, func, args, dur, filename = tasks.pop(0)
+        lock.release()
+        s = Server_base(options["sr"], options["nchnls"], options["buffersize"], 0, "offline", "pyo", 1)
+        objs = None
+        try:
+            s.setVerbosity(options["verbosity"])
+            s.boot()
+            s.recordOptions(dur, filename, options["fileformat"], options["sampletype"])
+            # The blocks are computed without the GIL, the renderings run side by side.
+            s.setGILFree(True)
+            s.setCurrent(True)
+            try:
+                objs = func(*args)
+            finally:
+                s.setCurrent(False)
+            s.start()
+        except:
+            errors.append("Job %d:\n%s" % (index, traceback.format_exc()))
+        # The objects are released before their Server.
+        del objs
+        s.shutdown()
+
+def renderBatch(jobs, threads=None, sr=44100, nchnls=2, buffersize=256, fileformat=0, sampletype=0, verbosity=1):
+    """
+    Renders independent offline patches at the same time, in this process.
+
+    Each job is rendered by its own standalone offline Server, with its 
+    own streams and output file, on one of `threads` worker threads. The 
+    blocks are computed without the GIL, so the renderings use as many 
+    cores as there are threads. Unlike renderParallel, the jobs share the 
+    memory of the process: tables created beforehand (SndTable, HarmTable, 
+    ...) can be given to every job, through `args`, and are read by all 
+    the renderings without being loaded again. These tables must not be 
+    modified while rendering. Returns the realtime factor achieved, the 
+    total duration of sound rendered divided by the elapsed time.
+
+    renderBatch(jobs, threads=None, sr=44100, nchnls=2, buffersize=256, 
+                fileformat=0, sampletype=0, verbosity=1)
+
+    Parameters:
+
+    jobs : list of tuples
+        Each job is a tuple (func, dur, filename) or (func, dur, filename, args). 
+        `func` is called with the optional `args` once the job's Server is 
+        booted, the objects it creates are attached to this Server. It must 
+        return the objects to keep alive. `dur` is the duration, in seconds, 
+        and `filename` the path of the sound file to create.
+    threads : int, optional
+        Number of renderings running at the same time. The default (None) 
+        uses the number of cores.
+    sr, nchnls, buffersize : int, optional
+        Server settings used by every job. See Server.
+    fileformat, sampletype : int, optional
+        Format of the created sound files. See Server.recordOptions.
+    verbosity : int, optional
+        Verbosity of the Servers. See Server.setVerbosity. Defaults to 1.
+
+    Examples:
+
+    >>> s = Server(audio="offline")
+    >>> snd = SndTable(SNDS_PATH + "/transparent.aif")
+    >>> def patch(table, speed):
+    ...     return TableRead(table, freq=table.getRate() * speed, loop=True, mul=.5).out()
+    >>> jobs = [(patch, 30, "speed%d.wav" % i, (snd, i * .5)) for i in range(1, 9)]
+    >>> factor = renderBatch(jobs)
+
+    """
+    if threads == None:
+        threads = multiprocessing.cpu_count()
+    options = _offlineOptions(sr, nchnls, buffersize, fileformat, sampletype, verbosity)
+    tasks = []
+    total = 0.0
+    for i, job in enumerate(jobs):
+        func, dur, filename = job[:3]
+        args = tuple(job[3]) if len(job) > 3 else ()
+        tasks.append((i, func, args, dur, filename))
+        total += dur
+    lock = threading.Lock()
+    errors = []
+    workers = [threading.Thread(target=_batchWorker, args=(tasks, lock, errors, options)) 
+               for i in range(max(1, min(threads, len(tasks))))]
+    t0 = time.time()
+    for w in workers:
+        w.start()
+    for w in workers:
+        w.join()
+    if errors:
+        raise Exception("".join(errors))
+    return total / max(time.time() - t0, 0.000001)
+
+def renderSegments(func, dur, filename, segments=None, preroll=1.0, processes=None, sr=44100, nchnls=2, 
+                   buffersize=256, fileformat=0, sampletype=0, verbosity=1):
+    """
+    Renders one offline patch split in time segments, on all cores.
+
+    The duration is split in `segments` parts rendered at the same time, 
+    each in its own process, then joined into `filename`. Each part is 
+    preceded by `preroll` seconds rendered but not written, which let 
+    delays, reverbs and envelopes reach the state they would have in a 
+    single rendering. Must be called from a script which has not created 
+    a Server. Returns the realtime factor achieved, the duration of sound 
+    rendered divided by the elapsed time.
+
+    renderSegments(func, dur, filename, segments=None, preroll=1.0, processes=None, 
+                   sr=44100, nchnls=2, buffersize=256, fileformat=0, sampletype=0, 
+                   verbosity=1)
+
+    Parameters:
+
+    func : callable
+        Called with the time, in seconds, where the process starts in the 
+        piece (0 for the first part), once the Server is booted. It must 
+        create the patch as it is at this time (sound file offsets, position 
+        in a sequence, ...) and return the objects to keep alive.
+    dur : float
+        Duration, in seconds, of the piece.
+    filename : string
+        Path of the sound file to create. Parts are written next to it 
+        and removed once joined.
+    segments : int, optional
+        Number of parts. The default (None) uses the number of processes.
+    preroll : float, optional
+        Duration, in seconds, rendered before each part. Defaults to 1.
+    processes : int, optional
+        Number of parts rendered at the same time. The default (None) 
+        uses the number of cores.
+    sr, nchnls, buffersize : int, optional
+        Server settings. See Server.
+    fileformat, sampletype : int, optional
+        Format of the created sound file. See Server.recordOptions.
+    verbosity : int, optional
+        Verbosity of the Servers. See Server.setVerbosity. Defaults to 1.
+
+    Examples:
+
+    >>> def patch(start):
+    ...     src = SfPlayer(SNDS_PATH + "/transparent.aif", loop=True, offset=start % 3)
+    ...     return Freeverb(src, size=.9, mul=.5).out()
+    >>> factor = renderSegments(patch, 600, "long.wav", preroll=4)
+
+    """
+    if processes == None:
+        processes = multiprocessing.cpu_count()
+    if segments == None:
+        segments = processes
+    options = _offlineOptions(sr, nchnls, buffersize, fileformat, sampletype, verbosity)
+    # Parts are cut at buffer boundaries, so that they join exactly. Durations 
+    # are given half a buffer short since the Server rounds them up.
+    blocksec = buffersize / float(sr)
+    blocks = int(math.ceil(dur / blocksec))
+    pre = int(math.ceil(preroll / blocksec))
+    bounds = [blocks * i // segments for i in range(segments + 1)]
+    tasks = []
+    parts = []
+    for i in range(segments):
+        first, num = bounds[i], bounds[i+1] - bounds[i]
+        if num == 0:
+            continue
+        skip = min(pre, first)
+        part = "%s.part%d" % (filename, i)
+        offset = (skip - 0.5) * blocksec if skip > 0 else 0
+        tasks.append((func, ((first - skip) * blocksec,), (num - 0.5) * blocksec, part, offset, options))
+        parts.append(part)
+    t0 = time.time()
+    try:
+        _runOffline(tasks, processes)
+        sndcat(parts, filename)
+    finally:
+        for part in parts:
+            if os.path.isfile(part):
+                os.remove(part)
+    return blocks * blocksec / max(time.time() - t0, 0.000001)
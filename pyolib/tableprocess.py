@@ -1859,6 +1859,329 @@ class Granulator(PyoObject):
     @basedur.setter
     def basedur(self, x): self.setBaseDur(x)
 
+class Particle(PyoObject):
+    """
+    High density granular synthesis engine.
+
+    Particle starts grains at a given density. Every grain samples
+    the current values of `pitch`, `pos`, `dur` and `pan` when it
+    starts and holds them until the end of its envelope. Grains are
+    kept in a preallocated pool of 4096 overlapping grains (grains
+    started while the pool is full are dropped) and are computed with
+    the vector instructions of the cpu. When the server uses frame
+    threads (see Server.setFFTThreads), large numbers of grains are
+    also split across these threads.
+
+    Parent class: PyoObject
+    
+    Parameters:
+
+    table : PyoTableObject
+        Table containing the waveform samples.
+    env : PyoTableObject
+        Table containing the grain envelope.
+    dens : float or PyoObject, optional
+        Density of grains per second. Defaults to 50.
+    pitch : float or PyoObject, optional
+        Speed, in samples of the table per sample of output, of the 
+        pointer of a grain. Defaults to 1.
+    pos : float or PyoObject, optional
+        Position, in samples, in the waveform table where a grain 
+        starts. Defaults to 0.
+    dur : float or PyoObject, optional
+        Duration, in seconds, of a grain. Defaults to 0.1.
+    dev : float or PyoObject, optional
+        Maximum deviation of the time between two grains, as a 
+        fraction of this time, between 0 and 1. Defaults to 0.01.
+    pan : float or PyoObject, optional
+        Position of a grain on the panning circle, between 0 and 1. 
+        Defaults to 0.5.
+    chnls : int, optional
+        Number of output channels per stream. Defaults to 1.
+    
+    Methods:
+    
+    setTable(x) : Replace the `table` attribute.
+    setEnv(x) : Replace the `env` attribute.
+    setDens(x) : Replace the `dens` attribute.
+    setPitch(x) : Replace the `pitch` attribute.
+    setPos(x) : Replace the `pos` attribute.
+    setDur(x) : Replace the `dur` attribute.
+    setDev(x) : Replace the `dev` attribute.
+    setPan(x) : Replace the `pan` attribute.
+    getNumGrains(all) : Returns the number of grains currently playing.
+    
+    Attributes:
+    
+    table : PyoTableObject. Table containing the waveform samples.
+    env : PyoTableObject. Table containing the grain envelope.
+    dens : float or PyoObject. Density of grains per second.
+    pitch : float or PyoObject. Pitch of new grains.
+    pos : float or PyoObject. Position of new grains in the sound table.
+    dur : float or PyoObject. Duration, in seconds, of new grains.
+    dev : float or PyoObject. Deviation of the time between grains.
+    pan : float or PyoObject. Position of new grains on the panning circle.
+    
+    Examples:
+    
+    >>> s = Server().boot()
+    >>> s.start()
+    >>> snd = SndTable(SNDS_PATH + "/transparent.aif")
+    >>> env = HannTable()
+    >>> pos = Phasor(snd.getRate()*.25, 0, snd.getSize())
+    >>> pan = Noise(.5, .5)
+    >>> p = Particle(snd, env, 2000, [1, 1.001], pos, .1, .5, pan, chnls=2, mul=.01).out()
+
+    """
+    def __init__(self, table, env, dens=50, pitch=1, pos=0, dur=.1, dev=.01, pan=.5, chnls=1, mul=1, add=0):
+        PyoObject.__init__(self)
+        self._table = table
+        self._env = env
+        self._dens = dens
+        self._pitch = pitch
+        self._pos = pos
+        self._dur = dur
+        self._dev = dev
+        self._pan = pan
+        self._chnls = chnls
+        self._mul = mul
+        self._add = add
+        table, env, dens, pitch, pos, dur, dev, pan, mul, add, lmax = convertArgsToLists(table, env, dens, pitch, pos, dur, dev, pan, mul, add)
+        self._base_players = [MainParticle_base(wrap(table,i), wrap(env,i), wrap(dens,i), wrap(pitch,i), wrap(pos,i), wrap(dur,i), 
+                                                wrap(dev,i), wrap(pan,i), chnls) for i in range(lmax)]
+        self._base_objs = []
+        for i in range(lmax):
+            for j in range(chnls):
+                self._base_objs.append(Particle_base(wrap(self._base_players,i), j, wrap(mul,i), wrap(add,i)))
+
+    def __dir__(self):
+        return ['table', 'env', 'dens', 'pitch', 'pos', 'dur', 'dev', 'pan', 'mul', 'add']
+
+    def __del__(self):
+        for obj in self._base_objs:
+            obj.deleteStream()
+            del obj
+        for obj in self._base_players:
+            obj.deleteStream()
+            del obj
+
+    def setTable(self, x):
+        """
+        Replace the `table` attribute.
+        
+        Parameters:
+
+        x : PyoTableObject
+            new `table` attribute.
+        
+        """
+        self._table = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setTable(wrap(x,i)) for i, obj in enumerate(self._base_players)]
+
+    def setEnv(self, x):
+        """
+        Replace the `env` attribute.
+        
+        Parameters:
+
+        x : PyoTableObject
+            new `env` attribute.
+        
+        """
+        self._env = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setEnv(wrap(x,i)) for i, obj in enumerate(self._base_players)]
+
+    def setDens(self, x):
+        """
+        Replace the `dens` attribute.
+        
+        Parameters:
+
+        x : float or PyoObject
+            new `dens` attribute.
+        
+        """
+        self._dens = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setDens(wrap(x,i)) for i, obj in enumerate(self._base_players)]
+
+    def setPitch(self, x):
+        """
+        Replace the `pitch` attribute.
+        
+        Parameters:
+
+        x : float or PyoObject
+            new `pitch` attribute.
+        
+        """
+        self._pitch = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setPitch(wrap(x,i)) for i, obj in enumerate(self._base_players)]
+
+    def setPos(self, x):
+        """
+        Replace the `pos` attribute.
+        
+        Parameters:
+
+        x : float or PyoObject
+            new `pos` attribute.
+        
+        """
+        self._pos = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setPos(wrap(x,i)) for i, obj in enumerate(self._base_players)]
+
+    def setDur(self, x):
+        """
+        Replace the `dur` attribute.
+        
+        Parameters:
+
+        x : float or PyoObject
+            new `dur` attribute.
+        
+        """
+        self._dur = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setDur(wrap(x,i)) for i, obj in enumerate(self._base_players)]
+
+    def setDev(self, x):
+        """
+        Replace the `dev` attribute.
+        
+        Parameters:
+
+        x : float or PyoObject
+            new `dev` attribute.
+        
+        """
+        self._dev = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setDev(wrap(x,i)) for i, obj in enumerate(self._base_players)]
+
+    def setPan(self, x):
+        """
+        Replace the `pan` attribute.
+        
+        Parameters:
+
+        x : float or PyoObject
+            new `pan` attribute.
+        
+        """
+        self._pan = x
+        x, lmax = convertArgsToLists(x)
+        [obj.setPan(wrap(x,i)) for i, obj in enumerate(self._base_players)]
+
+    def getNumGrains(self, all=False):
+        """
+        Returns the number of grains currently playing.
+
+        Parameters:
+
+        all : boolean, optional
+            If True, the number of grains of each grain pool (one
+            per value of the lists given as arguments) is returned
+            as a list. Otherwise, only the number of grains of the
+            first pool is returned as an int. Defaults to False.
+
+        """
+        if not all:
+            return self._base_players[0].getNumGrains()
+        return [obj.getNumGrains() for obj in self._base_players]
+
+    def play(self, dur=0, delay=0):
+        dur, delay, lmax = convertArgsToLists(dur, delay)
+        self._base_players = [obj.play(wrap(dur,i), wrap(delay,i)) for i, obj in enumerate(self._base_players)]
+        self._base_objs = [obj.play(wrap(dur,i), wrap(delay,i)) for i, obj in enumerate(self._base_objs)]
+        return self
+
+    def out(self, chnl=0, inc=1, dur=0, delay=0):
+        dur, delay, lmax = convertArgsToLists(dur, delay)
+        self._base_players = [obj.play(wrap(dur,i), wrap(delay,i)) for i, obj in enumerate(self._base_players)]
+        if type(chnl) == ListType:
+            self._base_objs = [obj.out(wrap(chnl,i), wrap(dur,i), wrap(delay,i)) for i, obj in enumerate(self._base_objs)]
+        else:
+            if chnl < 0:    
+                self._base_objs = [obj.out(i*inc, wrap(dur,i), wrap(delay,i)) for i, obj in enumerate(random.sample(self._base_objs, len(self._base_objs)))]
+            else:   
+                self._base_objs = [obj.out(chnl+i*inc, wrap(dur,i), wrap(delay,i)) for i, obj in enumerate(self._base_objs)]
+        return self
+    
+    def stop(self):
+        [obj.stop() for obj in self._base_players]
+        [obj.stop() for obj in self._base_objs]
+        return self
+
+    def ctrl(self, map_list=None, title=None, wxnoserver=False):
+        self._map_list = [SLMap(1., 5000., 'log', 'dens', self._dens),
+                          SLMap(0.1, 2., 'lin', 'pitch', self._pitch),
+                          SLMap(0.001, 1., 'log', 'dur', self._dur),
+                          SLMap(0., 1., 'lin', 'dev', self._dev),
+                          SLMapPan(self._pan),
+                          SLMapMul(self._mul)]
+        PyoObject.ctrl(self, map_list, title, wxnoserver)
+
+    @property
+    def table(self):
+        """PyoTableObject. Table containing the waveform samples."""
+        return self._table
+    @table.setter
+    def table(self, x): self.setTable(x)
+
+    @property
+    def env(self):
+        """PyoTableObject. Table containing the grain envelope."""
+        return self._env
+    @env.setter
+    def env(self, x): self.setEnv(x)
+
+    @property
+    def dens(self):
+        """float or PyoObject. Density of grains per second."""
+        return self._dens
+    @dens.setter
+    def dens(self, x): self.setDens(x)
+
+    @property
+    def pitch(self):
+        """float or PyoObject. Pitch of new grains."""
+        return self._pitch
+    @pitch.setter
+    def pitch(self, x): self.setPitch(x)
+
+    @property
+    def pos(self):
+        """float or PyoObject. Position of new grains in the sound table."""
+        return self._pos
+    @pos.setter
+    def pos(self, x): self.setPos(x)
+
+    @property
+    def dur(self):
+        """float or PyoObject. Duration, in seconds, of new grains."""
+        return self._dur
+    @dur.setter
+    def dur(self, x): self.setDur(x)
+
+    @property
+    def dev(self):
+        """float or PyoObject. Deviation of the time between grains."""
+        return self._dev
+    @dev.setter
+    def dev(self, x): self.setDev(x)
+
+    @property
+    def pan(self):
+        """float or PyoObject. Position of new grains on the panning circle."""
+        return self._pan
+    @pan.setter
+    def pan(self, x): self.setPan(x)
+
 class TrigTableRec(PyoObject):
     """
     TrigTableRec is for writing samples into a previously created NewTable.
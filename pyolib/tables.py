@@ -1379,6 +1379,17 @@ class SndTable(PyoTableObject):
         Stops reading at `stop` seconds into the file.  Available at 
         initialization time only. The default (None) means the end of 
         the file.
+    mapped : boolean, optional
+        If True, the sound is memory mapped instead of being read in 
+        memory, and tables loading the same sound share the same data. 
+        A mono float file (32 bits, or 64 bits with pyo64) is mapped 
+        directly, any other file is decoded once in a cache file kept 
+        in the directory given by the PYO_CACHE_DIR environment variable 
+        (defaults to ~/.cache/pyo) and reused as long as the sound does 
+        not change. Samples are read from disk only when needed. A table 
+        modified with `put`, `normalize` or `setData` gets its own copy 
+        of the sound. Available at initialization time only. Defaults 
+        to False.
 
     Methods:
 
@@ -1400,7 +1411,7 @@ class SndTable(PyoTableObject):
     >>> a = Osc(table=t, freq=t.getRate(), mul=.5).out()
 
     """
-    def __init__(self, path, chnl=None, start=0, stop=None):
+    def __init__(self, path, chnl=None, start=0, stop=None, mapped=False):
         self._size = []
         self._dur = []
         self._base_objs = []
@@ -1410,14 +1421,14 @@ class SndTable(PyoTableObject):
             _size, _dur, _snd_sr, _snd_chnls, _format, _type = sndinfo(p)
             if chnl == None:
                 if stop == None:
-                    self._base_objs.extend([SndTable_base(p, i, start) for i in range(_snd_chnls)])
+                    self._base_objs.extend([SndTable_base(p, i, start, mapped=int(mapped)) for i in range(_snd_chnls)])
                 else:
-                    self._base_objs.extend([SndTable_base(p, i, start, stop) for i in range(_snd_chnls)])
+                    self._base_objs.extend([SndTable_base(p, i, start, stop, int(mapped)) for i in range(_snd_chnls)])
             else:
                 if stop == None:
-                    self._base_objs.append(SndTable_base(p, chnl, start))
+                    self._base_objs.append(SndTable_base(p, chnl, start, mapped=int(mapped)))
                 else:
-                    self._base_objs.append(SndTable_base(p, chnl, start, stop))
+                    self._base_objs.append(SndTable_base(p, chnl, start, stop, int(mapped)))
             self._size.append(self._base_objs[-1].getSize())
             self._dur.append(self._size[-1] / float(_snd_sr))
         if lmax == 1:
@@ -736,14 +736,23 @@ class Record(PyoObject):
             3 : 32 bits float
             4 : 64 bits float
     buffering : int, optional
-        Number of bufferSize to wait before writing samples to disk.
-        High buffering uses more memory but improves performance.
-        Defaults to 4.
+        Minimum number of bufferSize written to disk at once. The 
+        samples are written by a separate thread, in chunks of at 
+        least 8192 frames, so the audio callback never waits for the 
+        disk. Defaults to 4.
+
+    Methods:
+
+    getOverflows() : Returns the number of overflows and of dropped frames.
         
     Notes:
     
     All parameters can only be set at intialization time.    
 
+    In real time, about two seconds of audio are buffered between the 
+    audio callback and the disk. If the disk is slower than that, the 
+    samples that don't fit are dropped and counted (see getOverflows).
+
     The `stop` method must be called on the object to close the file 
     properly.
     
@@ -785,6 +794,16 @@ class Record(PyoObject):
     def out(self, chnl=0, inc=1, dur=0, delay=0):
         return self
 
+    def getOverflows(self):
+        """
+        Returns a tuple (overflows, dropped frames).
+
+        `overflows` is the number of buffers which lost samples because 
+        the disk was too slow, `dropped frames` the number of frames lost.
+
+        """
+        return self._base_objs[0].getOverflows()
+
     def __dir__(self):
         return []
 
@@ -798,7 +817,9 @@ class Denorm(PyoObject):
 
     Mixes low level (~1e-24 for floats, and ~1e-60 for doubles) noise to a an input signal. 
     Can be used before IIR filters and reverbs to avoid denormalized numbers which may 
-    otherwise result in significantly increased CPU usage. 
+    otherwise result in significantly increased CPU usage. The server already 
+    flushes denormals to zero unless told otherwise (see Server.setFlushDenormals), 
+    so this object is only useful on processors without a flush-to-zero mode.
 
     Parent class: PyoObject
 
@@ -0,0 +1,483 @@
+"""
+Copyright 2010 Olivier Belanger
+
+This file is part of pyo, a python module to help digital signal
+processing script creation.
+
+pyo is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+pyo is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with pyo.  If not, see <http://www.gnu.org/licenses/>.
+"""
+import os, sys, re, math, time, inspect, platform, tempfile, optparse
+try:
+    import json
+except ImportError:
+    import simplejson as json
+
+USAGE = """%prog [options] [output.json]
+       %prog --compare before.json after.json
+
+Measures the DSP cost of every PyoObject listed in OBJECTS_TREE, on the
+offline backend, and saves the results as JSON.
+
+Each object is rendered once per combination of scalar and audio-rate
+values given to its `float or PyoObject` parameters (the modes selected
+by the `modebuffer` array of the C objects). The time spent in the
+streams of the object is read from the server's profiler, so the cost of
+the sources feeding it is not counted. Results are given in nanoseconds
+per sample per instance. The report is saved after every object, its
+`complete` field is false if the run was interrupted.
+
+Use --double to measure the _pyo64 extension and --compare to print the
+difference between two result files (the exit status is 1 if a mode got
+slower than the threshold).
+
+With --fft, an FFT -> IFFT chain is measured instead of the objects, for
+every fft backend available (see getFFTBackends) and every size from 64 to
+65536 points. Each size is rendered long enough to compute at least 16
+frames.
+
+With --grains, Particle is measured instead of the objects, with 250 to
+4000 grains playing at once (its pool holds 4096). The server computes on
+a single thread, the `load` column is the fraction of one core used in
+real time (below 1, the grains are sustained)."""
+
+# Objects which can not run unattended or whose work is done in Python.
+SKIPPED = {'Clean_objects': 'runs a thread', 'Print': 'writes to stdout',
+           'Record': 'writes a sound file', 'Pattern': 'calls a Python function',
+           'CallAfter': 'calls a Python function', 'TrigFunc': 'calls a Python function',
+           'Score': 'calls Python functions', 'VarPort': 'calls a Python function',
+           'ControlRec': 'Python level recorder', 'ControlRead': 'Python level player',
+           'NoteinRec': 'Python level recorder', 'NoteinRead': 'Python level player',
+           'OscSend': 'needs the network', 'OscReceive': 'needs the network',
+           'OscDataSend': 'needs the network', 'OscDataReceive': 'needs the network',
+           'Midictl': 'needs a MIDI device', 'Notein': 'needs a MIDI device',
+           'MidiAdsr': 'needs a MIDI device', 'Dummy': 'created by arithmetic operators'}
+
+# Objects whose `input` parameter expects a trigger stream.
+TRIGGERED = ['TrigEnv', 'TrigRand', 'TrigRandInt', 'Select', 'Counter', 'TrigChoice', 'TrigXnoise',
+             'TrigXnoiseMidi', 'TrigLinseg', 'TrigExpseg', 'Percent', 'TrigTableRec', 'SampHold']
+
+# Arguments which can not be guessed from the documentation.
+OVERRIDES = {'Convolve': lambda src: {'table': src.ir, 'size': 512},
+             'Selector': lambda src: {'inputs': [src.noise, src.sine]},
+             'Interp': lambda src: {'input2': src.sine},
+             'Compare': lambda src: {'comp': src.sine},
+             'SampHold': lambda src: {'controlsig': src.sine},
+             'Choice': lambda src: {'choice': [100, 200, 300, 400]},
+             'TrigChoice': lambda src: {'choice': [100, 200, 300, 400]},
+             'Snap': lambda src: {'choice': [0, 2, 4, 5, 7, 9, 11]},
+             'TableMorph': lambda src: {'input': src.phasor, 'table': src.newtable, 'sources': [src.table, src.env]},
+             'MatrixMorph': lambda src: {'input': src.phasor, 'matrix': src.newmatrix, 'sources': [src.matrix, src.matrix2]},
+             'MatrixPointer': lambda src: {'x': src.phasor, 'y': src.phasor},
+             'Pointer': lambda src: {'index': src.phasor},
+             'Lookup': lambda src: {'index': src.sine},
+             'TableIndex': lambda src: {'index': src.ramp},
+             'TableRead': lambda src: {'freq': src.rate},
+             'Linseg': lambda src: {'list': [(0, 0), (.1, 1), (.5, .5), (1, 0)], 'loop': True},
+             'Expseg': lambda src: {'list': [(0, 0), (.1, 1), (.5, .5), (1, 0)], 'loop': True},
+             'TrigLinseg': lambda src: {'list': [(0, 0), (.005, 1), (.01, 0)]},
+             'TrigExpseg': lambda src: {'list': [(0, 0), (.005, 1), (.01, 0)]},
+             'Seq': lambda src: {'time': .01, 'seq': [1, 2, 1, 3]},
+             'Mixer': lambda src: {'outs': 2, 'chnls': 1},
+             'IFFT': lambda src: {'inreal': src.fft['real'], 'inimag': src.fft['imag']},
+             'CarToPol': lambda src: {'inreal': src.fft['real'], 'inimag': src.fft['imag']},
+             'PolToCar': lambda src: {'inmag': src.pol['mag'], 'inang': src.pol['ang']},
+             'FrameDelta': lambda src: {'input': src.pol['ang']},
+             'FrameAccum': lambda src: {'input': src.pol['ang']}}
+
+class Sources:
+    """
+    Signals and tables shared by all the objects under test.
+
+    """
+    def __init__(self, pyo, sound, sr):
+        self.noise = pyo.Noise(.5)
+        self.sine = pyo.Sine(freq=187, mul=.5)
+        self.phasor = pyo.Phasor(freq=2.3)
+        self.trig = pyo.Metro(.01).play()
+        self.fft = pyo.FFT(self.noise, size=1024, overlaps=4)
+        self.pol = pyo.CarToPol(self.fft['real'], self.fft['imag'])
+        self.env = pyo.HannTable()
+        self.ir = pyo.HarmTable([1, .5, .33, .25, .2], size=1024)
+        if sound is not None:
+            self.table = pyo.SndTable(sound)
+        else:
+            self.table = pyo.HarmTable([1, .5, .33, .25, .2, .167, .143, .125])
+        # Only sound tables know their rate, the others are read at the sampling rate.
+        size = self.table.getSize()
+        self.rate = self.table.getRate() if sound is not None else float(sr) / size
+        self.ramp = pyo.Phasor(freq=self.rate, mul=size)
+        self.newtable = pyo.NewTable(length=.5)
+        self.sound = sound
+        terrain = [[math.sin(2 * math.pi * i / 64) * math.cos(2 * math.pi * j / 64) for i in range(64)] for j in range(64)]
+        self.matrix = pyo.NewMatrix(64, 64, terrain)
+        self.matrix2 = pyo.NewMatrix(64, 64, [[-v for v in row] for row in terrain])
+        self.newmatrix = pyo.NewMatrix(64, 64)
+
+    def guess(self, clsname, name, type):
+        """
+        Returns a value for a required argument given its documented type.
+
+        """
+        if type.startswith("float or PyoObject"):
+            return .5
+        elif type.startswith("PyoObject"):
+            if name == "input" and clsname in TRIGGERED:
+                return self.trig
+            return self.noise
+        elif type.startswith("list of PyoObject"):
+            return [self.noise, self.sine]
+        elif type.startswith("PyoTableObject"):
+            if name == "env":
+                return self.env
+            return self.table
+        elif type.startswith("list of PyoTableObject"):
+            return [self.table, self.env]
+        elif type.startswith("NewTable"):
+            return self.newtable
+        elif type.startswith("NewMatrix") or type.startswith("PyoMatrixObject"):
+            if clsname == "MatrixRec":
+                return self.newmatrix
+            return self.matrix
+        elif type.startswith("string"):
+            if self.sound is None:
+                raise ValueError("needs a sound file (see --sound)")
+            return self.sound
+        elif type.startswith("list"):
+            return [.1, .2, .3, .4]
+        raise ValueError("can't guess a value for '%s' (%s)" % (name, type))
+
+def documented_types(cls):
+    """
+    Returns a dictionary of the types given in the `Parameters` section of
+    the docstring of a class.
+
+    """
+    doc = cls.__doc__ or ""
+    if "Parameters:" not in doc:
+        return {}
+    section = doc.split("Parameters:", 1)[1]
+    for keyword in ["Methods:", "Attributes:", "Notes:", "Examples:", "See also:"]:
+        section = section.split(keyword, 1)[0]
+    return dict(re.findall(r"^\s*(\w+) : (.+?)\s*$", section, re.M))
+
+def modes_of(params, maximum):
+    """
+    Returns the list of the combinations of audio-rate parameters to measure.
+
+    All combinations are measured when there is at most `maximum` of them,
+    otherwise only the all scalar, single audio-rate and all audio-rate
+    combinations are.
+
+    """
+    if 2 ** len(params) <= maximum:
+        return [[p for i, p in enumerate(params) if (mode >> i) & 1] for mode in range(2 ** len(params))]
+    return [[]] + [[p] for p in params] + [list(params)]
+
+def mode_name(params, audio):
+    return " ".join(["%s=%s" % (p, {True: "a", False: "s"}[p in audio]) for p in params]) or "-"
+
+def modulator(pyo, value):
+    """
+    Returns an audio-rate signal varying slowly around `value`.
+
+    """
+    if type(value) not in [int, float]:
+        value = 0.
+    return pyo.Sine(freq=.5, mul=abs(value) * .01 or .01, add=value)
+
+def measure(server, factory, instances, repeat):
+    """
+    Creates `instances` objects with `factory` and returns the best mean
+    cost, in nanoseconds per sample per instance, over `repeat` renderings
+    and the number of streams created by each instance.
+
+    """
+    server.setProfiling(True)
+    known = server.getProfile()['objects'].keys()
+    objs = [factory() for i in range(instances)]
+    for obj in objs:
+        obj.play()
+    best = None
+    for i in range(repeat):
+        server.setProfiling(True)
+        server.start()
+        profile = server.getProfile()
+        streams = [v for k, v in profile['objects'].items() if k not in known]
+        cycles = sum([v['cycles'] for v in streams])
+        samples = profile['callback']['calls'] * server.getBufferSize() * instances
+        if samples == 0:
+            raise RuntimeError("nothing was rendered")
+        ns = cycles / profile['frequency'] * 1e9 / samples
+        if best is None or ns < best:
+            best = ns
+    del objs
+    return best, len(streams) // instances
+
+FFT_SIZES = [2 ** i for i in range(6, 17)]
+
+class FFTChain:
+    """
+    FFT followed by IFFT, measured as a single object.
+
+    """
+    def __init__(self, pyo, input, size):
+        self.fft = pyo.FFT(input, size=size, overlaps=4)
+        self.ifft = pyo.IFFT(self.fft['real'], self.fft['imag'], size=size, overlaps=4)
+
+    def play(self):
+        self.fft.play()
+        self.ifft.play()
+
+def bench_fft(pyo, server, src, tmp, options):
+    """
+    Returns the cost of an FFT -> IFFT chain, in nanoseconds per sample per
+    instance, for each fft backend and size.
+
+    """
+    results = {}
+    default = pyo.getFFTBackend()
+    for backend in pyo.getFFTBackends():
+        pyo.setFFTBackend(backend)
+        results[backend] = {}
+        for size in FFT_SIZES:
+            dur = max(options.dur, 16. * size / options.sr)
+            server.recordOptions(dur=dur, filename=tmp, fileformat=0, sampletype=3)
+            factory = lambda size=size: FFTChain(pyo, src.noise, size)
+            ns, streams = measure(server, factory, options.instances, options.repeat)
+            results[backend][str(size)] = ns
+            if options.verbose:
+                print "%-20s size=%-45d %10.2f ns" % (backend, size, ns)
+    pyo.setFFTBackend(default)
+    server.recordOptions(dur=options.dur, filename=tmp, fileformat=0, sampletype=3)
+    return results
+
+GRAIN_COUNTS = [250, 500, 1000, 2000, 4000]
+
+def bench_grains(pyo, server, src, tmp, options):
+    """
+    Returns the cost of Particle, in nanoseconds per sample, and the number
+    of grains actually playing, for each count of overlapping grains.
+
+    """
+    results = {}
+    server.recordOptions(dur=max(options.dur, 1.), filename=tmp, fileformat=0, sampletype=3)
+    # Grains last .1 second and stop at the end of the table, they start early enough to play whole.
+    pos = pyo.Phasor(freq=.5, mul=max(0, src.table.getSize() - .1 * options.sr))
+    created = []
+    for count in GRAIN_COUNTS:
+        def factory(count=count):
+            created.append(pyo.Particle(src.table, src.env, dens=count * 10, pitch=1, pos=pos,
+                                        dur=.1, dev=.5, pan=src.phasor, chnls=2, mul=.001))
+            return created[-1]
+        ns, streams = measure(server, factory, 1, options.repeat)
+        results[str(count)] = {'ns': ns, 'grains': created[-1].getNumGrains(), 'load': ns * options.sr * 1e-9}
+        del created[:]
+        if options.verbose:
+            print "%-20s grains=%-43d %10.2f ns" % ("Particle", count, ns)
+    server.recordOptions(dur=options.dur, filename=tmp, fileformat=0, sampletype=3)
+    return results
+
+def print_grains(results):
+    print "%-8s%12s%12s%12s" % ("grains", "playing", "ns", "load")
+    for count in GRAIN_COUNTS:
+        res = results[str(count)]
+        print "%-8d%12d%12.2f%12.3f" % (count, res['grains'], res['ns'], res['load'])
+
+def print_fft(results):
+    backends = sorted(results.keys())
+    print "%-8s" % "size" + "".join(["%12s" % b for b in backends])
+    for size in FFT_SIZES:
+        print "%-8d" % size + "".join(["%12.2f" % results[b][str(size)] for b in backends])
+
+def bench_class(pyo, server, src, name, options):
+    cls = getattr(pyo, name)
+    spec = inspect.getargspec(cls.__init__)
+    args = spec[0][1:]
+    defaults = dict(zip(args[len(args) - len(spec[3] or []):], spec[3] or []))
+    types = documented_types(cls)
+    kwargs = {}
+    if name in OVERRIDES:
+        kwargs.update(OVERRIDES[name](src))
+    for arg in args:
+        if arg not in kwargs and arg not in defaults:
+            kwargs[arg] = src.guess(name, arg, types.get(arg, ""))
+    params = [a for a in args if types.get(a, "").startswith("float or PyoObject") or a in ["mul", "add"]]
+    result = {'modes': {}}
+    for audio in modes_of(params, options.combinations):
+        values = dict(kwargs)
+        for p in audio:
+            values[p] = modulator(pyo, kwargs.get(p, defaults.get(p)))
+        factory = lambda values=values: cls(**values)
+        ns, streams = measure(server, factory, options.instances, options.repeat)
+        result['modes'][mode_name(params, audio)] = ns
+        result['streams'] = streams
+    return result
+
+def save(report, output):
+    """
+    Writes the report, replacing the previous one only once it is complete
+    on disk, so a crash while measuring keeps the results already saved.
+
+    """
+    tmp = output + ".tmp"
+    f = open(tmp, "w")
+    json.dump(report, f, indent=1, sort_keys=True)
+    f.close()
+    os.rename(tmp, output)
+
+def run(options, output):
+    if options.double:
+        import pyo64 as pyo
+        module = "_pyo64"
+    else:
+        import pyo
+        module = "_pyo"
+
+    if options.sound is None and os.path.isfile(os.path.join(pyo.SNDS_PATH, "transparent.aif")):
+        options.sound = os.path.join(pyo.SNDS_PATH, "transparent.aif")
+
+    fd, tmp = tempfile.mkstemp(suffix=".wav")
+    os.close(fd)
+    server = pyo.Server(sr=options.sr, nchnls=1, buffersize=options.buffersize, duplex=0, audio="offline")
+    server.setVerbosity(1)
+    server.boot()
+    server.recordOptions(dur=options.dur, filename=tmp, fileformat=0, sampletype=3)
+    src = Sources(pyo, options.sound, options.sr)
+
+    names = []
+    if not options.fft and not options.grains:
+        for category, classes in sorted(pyo.OBJECTS_TREE['PyoObject'].items()):
+            names.extend([(category, name) for name in classes])
+    if options.only:
+        names = [(c, n) for c, n in names if n in options.only.split(",")]
+
+    server.setProfiling(True)
+    report = {'module': module, 'version': pyo.PYO_VERSION, 'python': sys.version.split()[0],
+              'platform': platform.platform(), 'machine': platform.machine(),
+              'date': time.strftime("%Y-%m-%d %H:%M:%S"), 'sr': options.sr,
+              'buffersize': options.buffersize, 'instances': options.instances,
+              'duration': options.dur, 'repeat': options.repeat,
+              'results': {}, 'skipped': {}, 'errors': {},
+              'frequency': server.getProfile()['frequency'], 'complete': False}
+    # Saved after every object, 'complete' stays False if the run doesn't reach the end.
+    for category, name in names:
+        if name in SKIPPED:
+            report['skipped'][name] = SKIPPED[name]
+            continue
+        try:
+            result = bench_class(pyo, server, src, name, options)
+        except Exception, e:
+            report['errors'][name] = "%s: %s" % (e.__class__.__name__, e)
+            if options.verbose:
+                print >> sys.stderr, "%-20s error: %s" % (name, report['errors'][name])
+            save(report, output)
+            continue
+        result['category'] = category
+        report['results'][name] = result
+        save(report, output)
+        if options.verbose:
+            for mode, ns in sorted(result['modes'].items()):
+                print "%-20s %-50s %10.2f ns" % (name, mode, ns)
+    if options.fft:
+        report['fft'] = bench_fft(pyo, server, src, tmp, options)
+    if options.grains:
+        report['grains'] = bench_grains(pyo, server, src, tmp, options)
+    server.setProfiling(False)
+    server.shutdown()
+    os.remove(tmp)
+
+    report['complete'] = True
+    save(report, output)
+    if options.fft:
+        print_fft(report['fft'])
+        print "%d fft backends measured. Results saved in %s" % (len(report['fft']), output)
+        return
+    if options.grains:
+        print_grains(report['grains'])
+        print "%d grain counts measured. Results saved in %s" % (len(report['grains']), output)
+        return
+    print "%d objects measured, %d skipped, %d errors. Results saved in %s" % \
+          (len(report['results']), len(report['skipped']), len(report['errors']), output)
+
+def compare(before, after, threshold):
+    """
+    Prints the cost ratio of every mode found in both reports and returns
+    the number of regressions.
+
+    """
+    a, b = json.load(open(before)), json.load(open(after))
+    print "before: %s %s (%s)" % (a['module'], a['version'], a['date'])
+    print "after:  %s %s (%s)" % (b['module'], b['version'], b['date'])
+    rows = []
+    for name, result in b['results'].items():
+        if name not in a['results']:
+            continue
+        for mode, ns in result['modes'].items():
+            old = a['results'][name]['modes'].get(mode)
+            if old:
+                rows.append((ns / old, name, mode, old, ns))
+    for backend, sizes in b.get('fft', {}).items():
+        for size, ns in sizes.items():
+            old = a.get('fft', {}).get(backend, {}).get(size)
+            if old:
+                rows.append((ns / old, "FFT/IFFT " + backend, "size=" + size, old, ns))
+    for count, res in b.get('grains', {}).items():
+        old = a.get('grains', {}).get(count)
+        if old:
+            rows.append((res['ns'] / old['ns'], "Particle", "grains=" + count, old['ns'], res['ns']))
+    rows.sort()
+    regressions = 0
+    for ratio, name, mode, old, ns in rows:
+        flag = ""
+        if ratio > 1. + threshold:
+            flag = "  <-- slower"
+            regressions += 1
+        print "%-20s %-50s %10.2f %10.2f %6.2fx%s" % (name, mode, old, ns, ratio, flag)
+    if rows:
+        print "geometric mean of the ratios: %.3f" % math.exp(sum([math.log(r[0]) for r in rows]) / len(rows))
+    print "%d modes compared, %d slower by more than %d%%" % (len(rows), regressions, threshold * 100)
+    return regressions
+
+if __name__ == "__main__":
+    parser = optparse.OptionParser(usage=USAGE)
+    parser.add_option("--double", action="store_true", default=False, help="measure the _pyo64 extension")
+    parser.add_option("--sr", type="int", default=44100, help="sampling rate [default: %default]")
+    parser.add_option("--buffersize", type="int", default=256, help="buffer size [default: %default]")
+    parser.add_option("--instances", type="int", default=8, help="instances of each object [default: %default]")
+    parser.add_option("--dur", type="float", default=0.5, help="seconds rendered per measure [default: %default]")
+    parser.add_option("--repeat", type="int", default=3, help="renderings per mode, the best is kept [default: %default]")
+    parser.add_option("--combinations", type="int", default=16,
+                      help="maximum number of modes measured per object [default: %default]")
+    parser.add_option("--sound", default=None, help="sound file used by tables and players")
+    parser.add_option("--only", default=None, help="comma separated list of the objects to measure")
+    parser.add_option("--fft", action="store_true", default=False,
+                      help="measure the fft backends instead of the objects")
+    parser.add_option("--grains", action="store_true", default=False,
+                      help="measure Particle with 250 to 4000 overlapping grains instead of the objects")
+    parser.add_option("--compare", action="store_true", default=False, help="compare two result files")
+    parser.add_option("--threshold", type="float", default=0.1,
+                      help="ratio over which a mode is reported as slower [default: %default]")
+    parser.add_option("-v", "--verbose", action="store_true", default=False, help="print the results as they come")
+    options, args = parser.parse_args()
+
+    if options.compare:
+        if len(args) != 2:
+            parser.error("--compare needs two result files")
+        sys.exit(compare(args[0], args[1], options.threshold) > 0)
+
+    if args:
+        output = args[0]
+    else:
+        output = "benchmark%s.json" % {True: "64", False: ""}[options.double]
+    run(options, output)
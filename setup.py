@@ -45,10 +45,19 @@ if '--use-jack' in sys.argv:
 if '--use-coreaudio' in sys.argv: 
     sys.argv.remove('--use-coreaudio') 
     macros.append(('USE_COREAUDIO',None))
+
+fftw_libraries = []
+if '--use-fftw' in sys.argv:
+    sys.argv.remove('--use-fftw')
+    macros.append(('USE_FFTW',None))
+    if ('USE_DOUBLE',None) in macros:
+        fftw_libraries.append('fftw3')
+    else:
+        fftw_libraries.append('fftw3f')
     
 path = 'src/engine/'
 files = ['pyomodule.c', 'servermodule.c', 'streammodule.c', 'dummymodule.c', 'mixmodule.c', 'inputfadermodule.c',
-        'interpolation.c', 'fft.c', "wind.c"]
+        'interpolation.c', 'fft.c', "wind.c", 'scheduler.c', 'streamtable.c', 'vecops.c', 'vecmath.c', 'diskstream.c', 'sndmap.c', 'sndwriter.c', 'profiler.c', 'cmdqueue.c', 'denormals.c', 'telemetry.c', 'fftcache.c', 'framepool.c', 'fftbackend.c']
 source_files = [path + f for f in files]
 
 path = 'src/objects/'
@@ -64,15 +73,15 @@ source_files = source_files + [path + f for f in files]
 if sys.platform == "win32":
     include_dirs = ['C:\portaudio\include', 'C:\Program Files\Mega-Nerd\libsndfile\include',
                     'C:\portmidi\pm_common', 'C:\liblo', 'C:\pthreads\include', 'include']
-    library_dirs = ['C:\portaudio', 'C:\Program Files\Mega-Nerd\libsndfile', 'C:\portmidi', 'C:\liblo']
-    libraries = ['portaudio', 'portmidi', 'sndfile-1', 'lo']
+    library_dirs = ['C:\portaudio', 'C:\Program Files\Mega-Nerd\libsndfile', 'C:\portmidi', 'C:\liblo', 'C:\pthreads\lib']
+    libraries = ['portaudio', 'portmidi', 'sndfile-1', 'lo', 'pthreadVC2'] + fftw_libraries
     extension = [Extension(extension_name, source_files, include_dirs=include_dirs, libraries=libraries, 
                 library_dirs=library_dirs, extra_compile_args=["-Wno-strict-prototypes"], define_macros=macros)]
 else:
     tsrt = time.strftime('"%d %b %Y %H:%M:%S"', time.gmtime())
     macros.append(('TIMESTAMP', tsrt))
     include_dirs = ['include', '/usr/local/include']
-    libraries = ['portaudio', 'portmidi', 'sndfile', 'lo']
+    libraries = ['portaudio', 'portmidi', 'sndfile', 'lo', 'pthread'] + fftw_libraries
     if build_osx_with_jack_support:
         libraries.append('jack')
     extension = [Extension(extension_name, source_files, include_dirs=include_dirs, libraries=libraries, 
@@ -0,0 +1,127 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include <stdlib.h>
+#include "cmdqueue.h"
+
+PyoCommandQueue *
+PyoCommandQueue_new(int size)
+{
+    int n = 1;
+    PyoCommandQueue *self = (PyoCommandQueue *)calloc(1, sizeof(PyoCommandQueue));
+
+    while (n < size)
+        n <<= 1;
+    self->ring = (PyoCommand *)calloc(n, sizeof(PyoCommand));
+    self->mask = n - 1;
+    self->head = self->tail = 0;
+    return self;
+}
+
+void
+PyoCommandQueue_free(PyoCommandQueue *self)
+{
+    int i;
+
+    if (self == NULL)
+        return;
+    for (i=0; i<self->num_deferred; i++)
+        (*self->deferred[i].release)(self->deferred[i].ptr);
+    free(self->deferred);
+    free(self->ring);
+    free(self);
+}
+
+int
+PyoCommandQueue_push(PyoCommandQueue *self, const PyoCommand *cmd)
+{
+    unsigned int head = self->head;
+
+    if (self->num_deferred)
+        PyoCommandQueue_collect(self);
+    if (head - self->tail > self->mask)
+        return -1;
+    self->ring[head & self->mask] = *cmd;
+    /* The command must be visible before the new head. */
+    __sync_synchronize();
+    self->head = head + 1;
+    return 0;
+}
+
+int
+PyoCommandQueue_pop(PyoCommandQueue *self, PyoCommand *cmd)
+{
+    unsigned int tail = self->tail;
+
+    if (tail == self->head)
+        return 0;
+    __sync_synchronize();
+    *cmd = self->ring[tail & self->mask];
+    /* The slot must be read before the producer can reuse it. */
+    __sync_synchronize();
+    self->tail = tail + 1;
+    return 1;
+}
+
+int
+PyoCommandQueue_count(PyoCommandQueue *self)
+{
+    return (int)(self->head - self->tail);
+}
+
+void
+PyoCommandQueue_cancel(PyoCommandQueue *self, void *ptr, int type)
+{
+    unsigned int i;
+
+    for (i=self->tail; i!=self->head; i++) {
+        if (self->ring[i & self->mask].ptr == ptr)
+            self->ring[i & self->mask].type = type;
+    }
+}
+
+void
+PyoCommandQueue_defer(PyoCommandQueue *self, void *ptr, void (*release)(void *))
+{
+    if (self->num_deferred == self->max_deferred) {
+        self->max_deferred = self->max_deferred ? self->max_deferred * 2 : 8;
+        self->deferred = (PyoDeferred *)realloc(self->deferred, self->max_deferred * sizeof(PyoDeferred));
+    }
+    self->deferred[self->num_deferred].seq = self->head;
+    self->deferred[self->num_deferred].ptr = ptr;
+    self->deferred[self->num_deferred].release = release;
+    self->num_deferred++;
+}
+
+void
+PyoCommandQueue_collect(PyoCommandQueue *self)
+{
+    int i, j = 0;
+    unsigned int tail = self->tail;
+
+    __sync_synchronize();
+    for (i=0; i<self->num_deferred; i++) {
+        if ((int)(tail - self->deferred[i].seq) >= 0)
+            (*self->deferred[i].release)(self->deferred[i].ptr);
+        else
+            self->deferred[j++] = self->deferred[i];
+    }
+    self->num_deferred = j;
+}
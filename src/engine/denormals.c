@@ -0,0 +1,46 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include <string.h>
+#include "denormals.h"
+
+#ifdef USE_DOUBLE
+#define DENORM_UINT unsigned long long
+#define DENORM_EXP 0x7FF0000000000000ULL
+#else
+#define DENORM_UINT unsigned int
+#define DENORM_EXP 0x7F800000U
+#endif
+
+unsigned long
+PyoDenormals_count(MYFLT *data, int size)
+{
+    int i;
+    unsigned long count = 0;
+    DENORM_UINT bits;
+
+    for (i=0; i<size; i++) {
+        memcpy(&bits, &data[i], sizeof(MYFLT));
+        /* Zero exponent, non-zero mantissa. */
+        count += (bits & DENORM_EXP) == 0 && (bits << 1) != 0;
+    }
+    return count;
+}
@@ -0,0 +1,407 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include <Python.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include "diskstream.h"
+
+#define PYO_DISK_MAX_BATCH 8 /* blocks loaded for a stream before looking at the others */
+#define PYO_DISK_BLOCKING_TIMEOUT 5.0 /* seconds */
+
+static pthread_mutex_t disk_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t disk_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t disk_idle = PTHREAD_COND_INITIALIZER;
+static PyoDiskStream *disk_streams = NULL;
+static double disk_seconds = 2.0;
+static int disk_nthreads = 2;
+static int disk_running = 0;
+
+static long
+PyoDiskStream_blockOf(double pos)
+{
+    return (long)floor(pos / PYO_DISK_BLOCK_SIZE);
+}
+
+static int
+PyoDiskStream_present(PyoDiskBlock *area, int size, long blk)
+{
+    PyoDiskBlock *slot = &area[blk % size];
+    return slot->block == blk && (slot->seq & 1) == 0;
+}
+
+static int
+PyoDiskStream_available(PyoDiskStream *self, long blk)
+{
+    return PyoDiskStream_present(self->main, self->main_size, blk) ||
+           PyoDiskStream_present(self->head, self->head_size, blk);
+}
+
+/* Walks the blocks the player will need, in playing order: the pending demand,
+   the main window from the play head to the end of the segment and the head
+   of the next segment. Returns how many seconds of sound are available before
+   the first missing block, or -1 if nothing is missing. */
+static double
+PyoDiskStream_findMissing(PyoDiskStream *self, long *blk, int *inhead)
+{
+    int k, dir;
+    long b, last, demand;
+    double pos, rate, dist;
+
+    demand = self->demand;
+    if (demand >= 0) {
+        if (!PyoDiskStream_available(self, demand)) {
+            *blk = demand;
+            *inhead = 0;
+            return 0.0;
+        }
+        __sync_bool_compare_and_swap(&self->demand, demand, -1);
+    }
+
+    pos = self->pos;
+    rate = self->rate;
+    if (rate < 1.0)
+        rate = 1.0;
+    dir = self->dir;
+    if (dir == 0)
+        dir = 1;
+
+    /* main window, one block of margin behind the play head */
+    last = PyoDiskStream_blockOf(self->seg_end) + dir;
+    b = PyoDiskStream_blockOf(pos) - dir;
+    for (k=0; k<self->main_size; k++, b+=dir) {
+        if ((dir > 0 && (b >= self->nblocks || b > last)) || (dir < 0 && (b < 0 || b < last)))
+            break;
+        if (b < 0 || b >= self->nblocks)
+            continue;
+        if (!PyoDiskStream_present(self->main, self->main_size, b)) {
+            *blk = b;
+            *inhead = 0;
+            dist = (k - 1) * PYO_DISK_BLOCK_SIZE;
+            return (dist > 0 ? dist : 0.0) / rate;
+        }
+    }
+
+    /* head of the next segment */
+    dist = fabs(self->seg_end - pos);
+    b = PyoDiskStream_blockOf(self->next_start) - dir;
+    for (k=0; k<self->head_size; k++, b+=dir) {
+        if (b < 0 || b >= self->nblocks)
+            continue;
+        if (!PyoDiskStream_available(self, b)) {
+            *blk = b;
+            *inhead = 1;
+            return (dist + k * PYO_DISK_BLOCK_SIZE) / rate;
+        }
+    }
+    return -1.0;
+}
+
+/* Reader side: reads block `blk` from the file and stores it in its slot. */
+static void
+PyoDiskStream_load(PyoDiskStream *self, long blk, int inhead, long *filepos)
+{
+    int got, frames, chnls = self->info.channels;
+    long start = blk * PYO_DISK_BLOCK_SIZE;
+    PyoDiskBlock *slot;
+
+    if (inhead)
+        slot = &self->head[blk % self->head_size];
+    else
+        slot = &self->main[blk % self->main_size];
+
+    frames = self->info.frames - start;
+    if (frames > PYO_DISK_BLOCK_SIZE)
+        frames = PYO_DISK_BLOCK_SIZE;
+
+    if (*filepos != start)
+        sf_seek(self->sf, start, SEEK_SET);
+    got = SF_READ(self->sf, self->readbuf, frames * chnls) / chnls;
+    if (got < 0)
+        got = 0;
+    memset(self->readbuf + got * chnls, 0, (frames - got) * chnls * sizeof(MYFLT));
+    *filepos = start + got;
+
+    __sync_fetch_and_add(&slot->seq, 1);
+    __sync_synchronize();
+    memcpy(slot->data, self->readbuf, frames * chnls * sizeof(MYFLT));
+    slot->frames = frames;
+    slot->block = blk;
+    __sync_synchronize();
+    __sync_fetch_and_add(&slot->seq, 1);
+}
+
+static void *
+PyoDiskStream_reader(void *arg)
+{
+    int i, inhead, id = (int)(long)arg;
+    long blk, filepos;
+    double u, best_u = 0.0;
+    PyoDiskStream *ds, *best;
+    struct timeval now;
+    struct timespec until;
+
+    pthread_mutex_lock(&disk_lock);
+    while (id < disk_nthreads) {
+        best = NULL;
+        for (ds=disk_streams; ds!=NULL; ds=ds->next) {
+            if (ds->busy)
+                continue;
+            u = PyoDiskStream_findMissing(ds, &blk, &inhead);
+            if (u >= 0.0 && (best == NULL || u < best_u)) {
+                best = ds;
+                best_u = u;
+            }
+        }
+        if (best != NULL) {
+            best->busy = 1;
+            pthread_mutex_unlock(&disk_lock);
+            filepos = -1;
+            for (i=0; i<PYO_DISK_MAX_BATCH; i++) {
+                if (PyoDiskStream_findMissing(best, &blk, &inhead) < 0.0)
+                    break;
+                PyoDiskStream_load(best, blk, inhead, &filepos);
+            }
+            pthread_mutex_lock(&disk_lock);
+            best->busy = 0;
+            pthread_cond_broadcast(&disk_idle);
+        }
+        else {
+            gettimeofday(&now, NULL);
+            until.tv_sec = now.tv_sec;
+            until.tv_nsec = now.tv_usec * 1000 + 5000000;
+            if (until.tv_nsec >= 1000000000) {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&disk_work, &disk_lock, &until);
+        }
+    }
+    disk_running--;
+    pthread_mutex_unlock(&disk_lock);
+    return NULL;
+}
+
+static PyoDiskBlock *
+PyoDiskStream_allocArea(int size, int chnls)
+{
+    int i;
+    PyoDiskBlock *area = (PyoDiskBlock *)calloc(size, sizeof(PyoDiskBlock));
+    for (i=0; i<size; i++) {
+        area[i].block = -1;
+        area[i].data = (MYFLT *)calloc(PYO_DISK_BLOCK_SIZE * chnls, sizeof(MYFLT));
+    }
+    return area;
+}
+
+PyoDiskStream *
+PyoDiskStream_open(const char *path, SF_INFO *info, double start)
+{
+    int size;
+    PyoDiskStream *self;
+    pthread_t thread;
+    pthread_attr_t attr;
+
+    info->format = 0;
+    SNDFILE *sf = sf_open(path, SFM_READ, info);
+    if (sf == NULL)
+        return NULL;
+
+    self = (PyoDiskStream *)calloc(1, sizeof(PyoDiskStream));
+    self->sf = sf;
+    self->info = *info;
+    self->nblocks = (info->frames + PYO_DISK_BLOCK_SIZE - 1) / PYO_DISK_BLOCK_SIZE;
+    size = (int)ceil(disk_seconds * info->samplerate / PYO_DISK_BLOCK_SIZE);
+    if (size < 4)
+        size = 4;
+    if (size > self->nblocks)
+        size = self->nblocks > 0 ? self->nblocks : 1;
+    self->main_size = size;
+    self->head_size = size / 4 > 2 ? size / 4 : 2;
+    self->main = PyoDiskStream_allocArea(self->main_size, info->channels);
+    self->head = PyoDiskStream_allocArea(self->head_size, info->channels);
+    self->readbuf = (MYFLT *)malloc(PYO_DISK_BLOCK_SIZE * info->channels * sizeof(MYFLT));
+    self->pos = self->next_start = start;
+    self->dir = 1;
+    self->rate = info->samplerate;
+    self->seg_end = info->frames;
+    self->demand = -1;
+
+    pthread_mutex_lock(&disk_lock);
+    self->next = disk_streams;
+    disk_streams = self;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    while (disk_running < disk_nthreads) {
+        if (pthread_create(&thread, &attr, PyoDiskStream_reader, (void *)(long)disk_running) != 0)
+            break;
+        disk_running++;
+    }
+    pthread_attr_destroy(&attr);
+    pthread_cond_broadcast(&disk_work);
+    pthread_mutex_unlock(&disk_lock);
+
+    return self;
+}
+
+void
+PyoDiskStream_close(PyoDiskStream *self)
+{
+    int i;
+    PyoDiskStream **prev;
+
+    if (self == NULL)
+        return;
+
+    pthread_mutex_lock(&disk_lock);
+    for (prev=&disk_streams; *prev!=NULL; prev=&(*prev)->next) {
+        if (*prev == self) {
+            *prev = self->next;
+            break;
+        }
+    }
+    while (self->busy)
+        pthread_cond_wait(&disk_idle, &disk_lock);
+    pthread_mutex_unlock(&disk_lock);
+
+    sf_close(self->sf);
+    for (i=0; i<self->main_size; i++)
+        free(self->main[i].data);
+    for (i=0; i<self->head_size; i++)
+        free(self->head[i].data);
+    free(self->main);
+    free(self->head);
+    free(self->readbuf);
+    free(self);
+}
+
+/* Audio side: copies frames of a block if it is in the slot, 0 otherwise. */
+static int
+PyoDiskStream_copy(PyoDiskBlock *slot, long blk, int off, int frames, int chnls, MYFLT *out)
+{
+    int seq = slot->seq;
+    __sync_synchronize();
+    if ((seq & 1) || slot->block != blk || (off + frames) > slot->frames)
+        return 0;
+    memcpy(out, slot->data + off * chnls, frames * chnls * sizeof(MYFLT));
+    __sync_synchronize();
+    return slot->seq == seq;
+}
+
+void
+PyoDiskStream_read(PyoDiskStream *self, long start, int frames, MYFLT *out)
+{
+    int n, off, chnls, ok;
+    long blk, waited;
+    struct timespec pause = {0, 50000};
+
+    if (self == NULL) {
+        return;
+    }
+    chnls = self->info.channels;
+
+    while (frames > 0) {
+        if (start < 0 || start >= self->info.frames) {
+            if (start < 0)
+                n = (-start) < frames ? (int)(-start) : frames;
+            else
+                n = frames;
+            memset(out, 0, n * chnls * sizeof(MYFLT));
+        }
+        else {
+            blk = start / PYO_DISK_BLOCK_SIZE;
+            off = (int)(start - blk * PYO_DISK_BLOCK_SIZE);
+            n = PYO_DISK_BLOCK_SIZE - off;
+            if (n > frames)
+                n = frames;
+            if (n > self->info.frames - start)
+                n = (int)(self->info.frames - start);
+            ok = PyoDiskStream_copy(&self->main[blk % self->main_size], blk, off, n, chnls, out) ||
+                 PyoDiskStream_copy(&self->head[blk % self->head_size], blk, off, n, chnls, out);
+            if (!ok) {
+                self->demand = blk;
+                if (self->blocking) {
+                    for (waited=0; !ok && waited<(long)(PYO_DISK_BLOCKING_TIMEOUT/0.00005); waited++) {
+                        self->demand = blk;
+                        pthread_cond_signal(&disk_work);
+                        nanosleep(&pause, NULL);
+                        ok = PyoDiskStream_copy(&self->main[blk % self->main_size], blk, off, n, chnls, out) ||
+                             PyoDiskStream_copy(&self->head[blk % self->head_size], blk, off, n, chnls, out);
+                    }
+                }
+                if (!ok) {
+                    self->underruns++;
+                    memset(out, 0, n * chnls * sizeof(MYFLT));
+                }
+            }
+        }
+        out += n * chnls;
+        start += n;
+        frames -= n;
+    }
+}
+
+void
+PyoDiskStream_setPosition(PyoDiskStream *self, double pos, int dir, double rate,
+                          double seg_end, double next_start)
+{
+    if (self == NULL)
+        return;
+    self->pos = pos;
+    self->dir = dir;
+    self->rate = rate;
+    self->seg_end = seg_end;
+    self->next_start = next_start;
+}
+
+void
+PyoDiskStream_setBlocking(PyoDiskStream *self, int blocking)
+{
+    if (self != NULL)
+        self->blocking = blocking;
+}
+
+int
+PyoDiskStream_getUnderruns(PyoDiskStream *self)
+{
+    return self == NULL ? 0 : self->underruns;
+}
+
+void
+PyoDiskStream_setBufferDuration(double seconds)
+{
+    if (seconds > 0.0)
+        disk_seconds = seconds;
+}
+
+void
+PyoDiskStream_setNumThreads(int nthreads)
+{
+    if (nthreads < 1)
+        nthreads = 1;
+    pthread_mutex_lock(&disk_lock);
+    disk_nthreads = nthreads;
+    pthread_cond_broadcast(&disk_work);
+    pthread_mutex_unlock(&disk_lock);
+}
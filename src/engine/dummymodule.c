@@ -73,6 +73,41 @@ Dummy_setProcMode(Dummy *self)
     }
 }
 
+/* Each operation is computed like the mul or add post-processing of a Dummy
+** holding it, so a fused expression gives the same samples as the chain of
+** Dummy objects it replaces, without their streams and buffers. */
+static void
+Dummy_apply_ops(Dummy *self)
+{
+    int k;
+    MYFLT *arg;
+
+    for (k=0; k<self->num_ops; k++) {
+        if (self->op_streams[k] == NULL) {
+            if (self->op_types[k] == DUMMY_OP_MUL || self->op_types[k] == DUMMY_OP_DIV)
+                pyo_vec_mul_scalar_add(self->data, self->op_values[k], 0.0, self->bufsize);
+            else
+                pyo_vec_mul_scalar_add(self->data, 1.0, self->op_values[k], self->bufsize);
+            continue;
+        }
+        arg = Stream_getData(self->op_streams[k]);
+        switch (self->op_types[k]) {
+            case DUMMY_OP_MUL:
+                pyo_vec_mul_add_scalar(self->data, arg, 0.0, self->bufsize);
+                break;
+            case DUMMY_OP_ADD:
+                pyo_vec_scalar_mul_add(self->data, 1.0, arg, self->bufsize);
+                break;
+            case DUMMY_OP_SUB:
+                pyo_vec_scalar_mul_sub(self->data, 1.0, arg, self->bufsize);
+                break;
+            case DUMMY_OP_DIV:
+                pyo_vec_div_add_scalar(self->data, arg, 0.0, self->bufsize);
+                break;
+        }
+    }
+}
+
 static void
 Dummy_compute_next_data_frame(Dummy *self)
 {
@@ -81,24 +116,36 @@ Dummy_compute_next_data_frame(Dummy *self)
     for (i=0; i<self->bufsize; i++) {
         self->data[i] = in[i];
     }    
+    if (self->num_ops > 0)
+        Dummy_apply_ops(self);
     (*self->muladd_func_ptr)(self);
 }
 
 static int
 Dummy_traverse(Dummy *self, visitproc visit, void *arg)
 {
+    int k;
     pyo_VISIT
     Py_VISIT(self->input);
     Py_VISIT(self->input_stream);
+    for (k=0; k<self->num_ops; k++) {
+        Py_VISIT(self->op_args[k]);
+        Py_VISIT(self->op_streams[k]);
+    }
     return 0;
 }
 
 static int 
 Dummy_clear(Dummy *self)
 {
+    int k;
     pyo_CLEAR
     Py_CLEAR(self->input);
     Py_CLEAR(self->input_stream);
+    for (k=0; k<self->num_ops; k++) {
+        Py_CLEAR(self->op_args[k]);
+        Py_CLEAR(self->op_streams[k]);
+    }
     return 0;
 }
 
@@ -107,6 +154,10 @@ Dummy_dealloc(Dummy* self)
 {
     free(self->data);
     Dummy_clear(self);
+    free(self->op_types);
+    free(self->op_values);
+    free(self->op_args);
+    free(self->op_streams);
     self->ob_type->tp_free((PyObject*)self);
 }
 
@@ -126,9 +177,6 @@ Dummy_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     Stream_setFunctionPtr(self->stream, Dummy_compute_next_data_frame);
     self->mode_func_ptr = Dummy_setProcMode;
 
-    Py_INCREF(self->stream);
-    PyObject_CallMethod(self->server, "addStream", "O", self->stream);    
-
     return (PyObject *)self;
 }
 
@@ -152,14 +200,179 @@ Dummy_initialize(Dummy *self)
     return Py_None;
 }
 
+/* Checks that `ops` is a list of (operation, operand) tuples. */
+static int
+Dummy_checkOps(PyObject *ops)
+{
+    int k, n;
+    PyObject *op;
+
+    if (! PyList_Check(ops)) {
+        PyErr_SetString(PyExc_TypeError, "Dummy operations must be a list.");
+        return -1;
+    }
+    n = PyList_Size(ops);
+    for (k=0; k<n; k++) {
+        op = PyList_GET_ITEM(ops, k);
+        if (! PyTuple_Check(op) || PyTuple_Size(op) != 2 || ! PyInt_Check(PyTuple_GET_ITEM(op, 0)) ||
+            PyInt_AsLong(PyTuple_GET_ITEM(op, 0)) < DUMMY_OP_MUL || PyInt_AsLong(PyTuple_GET_ITEM(op, 0)) > DUMMY_OP_DIV) {
+            PyErr_SetString(PyExc_TypeError, "Dummy operations must be (operation, operand) tuples.");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Fills the arrays (of `n` items) with the first `n` operations of `ops`, already checked.
+   Returns -1, with no reference left, if an operand has no stream. */
+static int
+Dummy_parseOps(PyObject *ops, int n, int *types, MYFLT *values, PyObject **args, Stream **streams)
+{
+    int k, type;
+    PyObject *op, *arg;
+
+    for (k=0; k<n; k++) {
+        op = PyList_GET_ITEM(ops, k);
+        type = PyInt_AsLong(PyTuple_GET_ITEM(op, 0));
+        arg = PyTuple_GET_ITEM(op, 1);
+        types[k] = type;
+        args[k] = NULL;
+        streams[k] = NULL;
+        if (PyNumber_Check(arg)) {
+            values[k] = PyFloat_AsDouble(arg);
+            if (type == DUMMY_OP_SUB)
+                values[k] = -values[k];
+            else if (type == DUMMY_OP_DIV) {
+                /* Like setDiv, a division by zero is ignored. */
+                if (values[k] == 0.)
+                    values[k] = 1.;
+                else
+                    values[k] = 1. / values[k];
+            }
+        }
+        else {
+            streams[k] = (Stream *)PyObject_CallMethod(arg, "_getStream", NULL);
+            if (streams[k] == NULL) {
+                while (--k >= 0) {
+                    Py_XDECREF(args[k]);
+                    Py_XDECREF(streams[k]);
+                }
+                return -1;
+            }
+            Py_INCREF(arg);
+            args[k] = arg;
+        }
+    }
+    return 0;
+}
+
+/* Dummy_base(input, ops) computes a fused arithmetic expression: ops is a list of
+** (operation, operand) tuples, operation being one of the DUMMY_OP_* values and
+** operand a number or an audio object, applied in order to input. The last
+** operation sets mul or add, as the arithmetic operators of the objects do. */
 int
 Dummy_init(Dummy *self, PyObject *args, PyObject *kwds)
 {
-    
+    int n;
+    PyObject *inputtmp, *input_streamtmp, *opstmp, *op;
+    static const char *setters[] = {"setMul", "setAdd", "setSub", "setDiv"};
+
+    static char *kwlist[] = {"input", "ops", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "OO", kwlist, &inputtmp, &opstmp))
+        return -1; 
+
+    if (Dummy_checkOps(opstmp) < 0)
+        return -1;
+    n = PyList_Size(opstmp);
+    if (n == 0) {
+        PyErr_SetString(PyExc_TypeError, "Dummy operations must be a non-empty list.");
+        return -1;
+    }
+
+    Py_INCREF(inputtmp);
+    INIT_INPUT_STREAM
+
+    self->num_ops = 0;
+    self->op_types = (int *)realloc(self->op_types, n * sizeof(int));
+    self->op_values = (MYFLT *)realloc(self->op_values, n * sizeof(MYFLT));
+    self->op_args = (PyObject **)realloc(self->op_args, n * sizeof(PyObject *));
+    self->op_streams = (Stream **)realloc(self->op_streams, n * sizeof(Stream *));
+    if (Dummy_parseOps(opstmp, n - 1, self->op_types, self->op_values, self->op_args, self->op_streams) < 0)
+        return -1;
+    self->num_ops = n - 1;
+
+    op = PyList_GET_ITEM(opstmp, n-1);
+    PyObject_CallMethod((PyObject *)self, (char *)setters[PyInt_AsLong(PyTuple_GET_ITEM(op, 0))], "O", PyTuple_GET_ITEM(op, 1));
+
+    Py_INCREF(self->stream);
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);    
+
+    (*self->mode_func_ptr)(self);
+
     Py_INCREF(self);
     return 0;
 }
 
+/* _setExpr(input, ops) replaces the input and the fused operations applied
+** before mul and add (which are kept). Used when the expression is rebased on
+** the streams of a Dummy it was fused with, see Dummy._unfuse in _core.py. */
+static PyObject *
+Dummy_setExpr(Dummy *self, PyObject *args)
+{
+    int k, n, old_num, locked;
+    int *types, *old_types;
+    MYFLT *values, *old_values;
+    PyObject *inputtmp, *input_streamtmp, *opstmp, **op_args, **old_args;
+    Stream **op_streams, **old_streams;
+
+    if (! PyArg_ParseTuple(args, "OO", &inputtmp, &opstmp))
+        return NULL;
+    if (Dummy_checkOps(opstmp) < 0)
+        return NULL;
+    n = PyList_Size(opstmp);
+
+    types = (int *)malloc((n + 1) * sizeof(int));
+    values = (MYFLT *)malloc((n + 1) * sizeof(MYFLT));
+    op_args = (PyObject **)malloc((n + 1) * sizeof(PyObject *));
+    op_streams = (Stream **)malloc((n + 1) * sizeof(Stream *));
+    if (Dummy_parseOps(opstmp, n, types, values, op_args, op_streams) < 0) {
+        free(types);
+        free(values);
+        free(op_args);
+        free(op_streams);
+        return NULL;
+    }
+
+    Py_INCREF(inputtmp);
+    INIT_INPUT_STREAM
+
+    old_num = self->num_ops;
+    old_types = self->op_types;
+    old_values = self->op_values;
+    old_args = self->op_args;
+    old_streams = self->op_streams;
+    locked = Server_lockBlocks((PyObject *)self->server);
+    self->op_types = types;
+    self->op_values = values;
+    self->op_args = op_args;
+    self->op_streams = op_streams;
+    self->num_ops = n;
+    Server_unlockBlocks((PyObject *)self->server, locked);
+    Server_graphChanged((PyObject *)self->server);
+    for (k=0; k<old_num; k++) {
+        Py_XDECREF(old_args[k]);
+        Py_XDECREF(old_streams[k]);
+    }
+    free(old_types);
+    free(old_values);
+    free(old_args);
+    free(old_streams);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyObject *
 Dummy_setInput(Dummy *self, PyObject *arg)
 {
@@ -176,6 +389,8 @@ Dummy_setInput(Dummy *self, PyObject *arg)
 
     (*self->mode_func_ptr)(self);
 
+    Server_graphChanged((PyObject *)self->server);
+
     Py_INCREF(Py_None);
     return Py_None;
 }
@@ -217,6 +432,7 @@ static PyMethodDef Dummy_methods[] = {
     {"out", (PyCFunction)Dummy_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
     {"stop", (PyCFunction)Dummy_stop, METH_NOARGS, "Stops computing."},
 	{"setInput", (PyCFunction)Dummy_setInput, METH_O, "Sets the input sound object."},
+    {"_setExpr", (PyCFunction)Dummy_setExpr, METH_VARARGS, "Sets the input and the fused operations."},
 	{"setMul", (PyCFunction)Dummy_setMul, METH_O, "Sets mul factor."},
 	{"setAdd", (PyCFunction)Dummy_setAdd, METH_O, "Sets add factor."},
     {"setSub", (PyCFunction)Dummy_setSub, METH_O, "Sets inverse add factor."},
@@ -0,0 +1,285 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fft.h"
+#include "fftbackend.h"
+#ifdef USE_FFTW
+#include <fftw3.h>
+#endif
+
+/*** split: scalar split-radix ***/
+static void
+split_forward(void *plan, MYFLT *data, MYFLT *outdata, int size, MYFLT **twiddle)
+{
+    realfft_split(data, outdata, size, twiddle);
+}
+
+static void
+split_inverse(void *plan, MYFLT *data, MYFLT *outdata, int size, MYFLT **twiddle)
+{
+    irealfft_split(data, outdata, size, twiddle);
+}
+
+/*** vector: complex fft of size/2 points, radix-4 Stockham passes ***/
+typedef struct {
+    int passes;
+    MYFLT *w; /* factors of every pass, see pyo_vec_fft_pass */
+    MYFLT *rw; /* cos and sin of 2 pi k / size, for k <= size/4 */
+} VectorPlan;
+
+static void *
+vector_plan_new(int size)
+{
+    int l, p, k = 0, m = size >> 1;
+    double a;
+    VectorPlan *plan = (VectorPlan *)malloc(sizeof(VectorPlan));
+
+    plan->passes = 0;
+    plan->w = (MYFLT *)malloc((m * 2 + 1) * sizeof(MYFLT));
+    for (l=m; l>1; l=(l>=4 ? l>>2 : l>>1)) {
+        plan->passes++;
+        if (l < 4)
+            continue;
+        for (p=0; p<(l>>2); p++) {
+            a = -TWOPI * p / l;
+            plan->w[k++] = cos(a);
+            plan->w[k++] = sin(a);
+            plan->w[k++] = cos(2 * a);
+            plan->w[k++] = sin(2 * a);
+            plan->w[k++] = cos(3 * a);
+            plan->w[k++] = sin(3 * a);
+        }
+    }
+    plan->rw = (MYFLT *)malloc(((size >> 2) + 1) * 2 * sizeof(MYFLT));
+    for (k=0; k<=(size>>2); k++) {
+        plan->rw[k*2] = cos(TWOPI * k / size);
+        plan->rw[k*2+1] = sin(TWOPI * k / size);
+    }
+    return plan;
+}
+
+static void
+vector_plan_free(void *plan)
+{
+    free(((VectorPlan *)plan)->w);
+    free(((VectorPlan *)plan)->rw);
+    free(plan);
+}
+
+/* Runs the passes from buf to the other buffer and back, returns the buffer holding the result. */
+static MYFLT *
+vector_passes(VectorPlan *plan, MYFLT *buf, MYFLT *other, int m)
+{
+    int l, s = 1;
+    MYFLT *tmp, *w = plan->w;
+
+    for (l=m; l>1; l=(l>=4 ? l>>2 : l>>1)) {
+        pyo_vec_fft_pass(other, other + m, buf, buf + m, w, l, s);
+        if (l >= 4) {
+            w += (l >> 2) * 6;
+            s <<= 2;
+        }
+        else
+            s <<= 1;
+        tmp = buf; buf = other; other = tmp;
+    }
+    return buf;
+}
+
+static void
+vector_forward(void *plan, MYFLT *data, MYFLT *outdata, int size, MYFLT **twiddle)
+{
+    int k, m = size >> 1;
+    MYFLT ar, ai, br, bi, er, ei, odr, odi, wor, woi, c, s, *z;
+    MYFLT *rw = ((VectorPlan *)plan)->rw;
+    MYFLT scl = 0.5 / size;
+
+    /* z[t] = data[2t] + i data[2t+1] */
+    for (k=0; k<m; k++) {
+        outdata[k] = data[2*k];
+        outdata[m+k] = data[2*k+1];
+    }
+    z = vector_passes((VectorPlan *)plan, outdata, data, m);
+
+    /* Splits the spectrum of z in the spectra of the even and odd samples, by pairs of bins k and m-k. */
+    ar = z[0]; ai = z[m];
+    outdata[0] = (ar + ai) / size;
+    outdata[m] = (ar - ai) / size;
+    for (k=1; k<=(m>>1); k++) {
+        ar = z[k]; ai = z[m+k];
+        br = z[m-k]; bi = -z[size-k];
+        er = ar + br; ei = ai + bi;
+        odr = ai - bi; odi = br - ar;
+        c = rw[k*2]; s = rw[k*2+1];
+        wor = c * odr + s * odi;
+        woi = c * odi - s * odr;
+        outdata[k] = (er + wor) * scl;
+        outdata[size-k] = (ei + woi) * scl;
+        if (k < m - k) {
+            outdata[m-k] = (er - wor) * scl;
+            outdata[m+k] = (woi - ei) * scl;
+        }
+    }
+}
+
+static void
+vector_inverse(void *plan, MYFLT *data, MYFLT *outdata, int size, MYFLT **twiddle)
+{
+    int k, m = size >> 1, passes = ((VectorPlan *)plan)->passes;
+    MYFLT ar, ai, br, bi, er, ei, dr, di, odr, odi, c, s, *z;
+    MYFLT *rw = ((VectorPlan *)plan)->rw;
+    /* The passes must end in data, the samples are then interleaved in outdata. */
+    MYFLT *buf = (passes & 1) ? outdata : data;
+
+    /* Builds the conjugate spectrum of z[t] = x[2t] + i x[2t+1], by pairs of bins k and m-k. */
+    ar = data[0]; br = data[m];
+    buf[0] = ar + br;
+    buf[m] = br - ar;
+    for (k=1; k<=(m>>1); k++) {
+        ar = data[k]; ai = data[size-k];
+        br = data[m-k]; bi = -data[m+k];
+        er = ar + br; ei = ai + bi;
+        dr = ar - br; di = ai - bi;
+        c = rw[k*2]; s = rw[k*2+1];
+        odr = c * dr - s * di;
+        odi = c * di + s * dr;
+        buf[k] = er - odi;
+        buf[m+k] = -(ei + odr);
+        if (k < m - k) {
+            buf[m-k] = er + odi;
+            buf[size-k] = ei - odr;
+        }
+    }
+    z = vector_passes((VectorPlan *)plan, buf, buf == data ? outdata : data, m);
+
+    for (k=0; k<m; k++) {
+        outdata[2*k] = z[k];
+        outdata[2*k+1] = -z[m+k];
+    }
+}
+
+#ifdef USE_FFTW
+/*** fftw: halfcomplex transforms, one pair of plans per size ***/
+#ifndef USE_DOUBLE
+#define FFTW(name) fftwf_##name
+#else
+#define FFTW(name) fftw_##name
+#endif
+
+typedef struct {
+    FFTW(plan) forward;
+    FFTW(plan) inverse;
+} FFTWPlan;
+
+static void *
+fftw_plan_new(int size)
+{
+    MYFLT *in = (MYFLT *)FFTW(malloc)(size * sizeof(MYFLT));
+    MYFLT *out = (MYFLT *)FFTW(malloc)(size * sizeof(MYFLT));
+    FFTWPlan *plan = (FFTWPlan *)malloc(sizeof(FFTWPlan));
+
+    /* The frames of the objects are not aligned for fftw, plans must accept any array. */
+    plan->forward = FFTW(plan_r2r_1d)(size, in, out, FFTW_R2HC, FFTW_ESTIMATE | FFTW_UNALIGNED);
+    plan->inverse = FFTW(plan_r2r_1d)(size, in, out, FFTW_HC2R, FFTW_ESTIMATE | FFTW_UNALIGNED);
+    FFTW(free)(in);
+    FFTW(free)(out);
+    return plan;
+}
+
+static void
+fftw_plan_free(void *plan)
+{
+    FFTW(destroy_plan)(((FFTWPlan *)plan)->forward);
+    FFTW(destroy_plan)(((FFTWPlan *)plan)->inverse);
+    free(plan);
+}
+
+/* fftw uses the halfcomplex layout of realfft_split, only the normalization differs. */
+static void
+fftw_forward(void *plan, MYFLT *data, MYFLT *outdata, int size, MYFLT **twiddle)
+{
+    int i;
+    MYFLT scl = 1.0 / size;
+
+    FFTW(execute_r2r)(((FFTWPlan *)plan)->forward, data, outdata);
+    for (i=0; i<size; i++)
+        outdata[i] *= scl;
+}
+
+static void
+fftw_inverse(void *plan, MYFLT *data, MYFLT *outdata, int size, MYFLT **twiddle)
+{
+    FFTW(execute_r2r)(((FFTWPlan *)plan)->inverse, data, outdata);
+}
+#endif
+
+/*** Selection ***/
+static const PyoFFTBackend fft_backends[] = {
+    {"split", NULL, NULL, split_forward, split_inverse},
+    {"vector", vector_plan_new, vector_plan_free, vector_forward, vector_inverse},
+#ifdef USE_FFTW
+    {"fftw", fftw_plan_new, fftw_plan_free, fftw_forward, fftw_inverse},
+#endif
+};
+
+#define FFT_NUM_BACKENDS ((int)(sizeof(fft_backends) / sizeof(PyoFFTBackend)))
+
+static const PyoFFTBackend *fft_backend = &fft_backends[0];
+
+void
+pyo_fft_init(void)
+{
+#ifdef USE_FFTW
+    pyo_fft_set_backend("fftw");
+#else
+    pyo_fft_set_backend("vector");
+#endif
+}
+
+const PyoFFTBackend *
+pyo_fft_get_backend(void)
+{
+    return fft_backend;
+}
+
+int
+pyo_fft_set_backend(const char *name)
+{
+    int i;
+    for (i=0; i<FFT_NUM_BACKENDS; i++) {
+        if (strcmp(fft_backends[i].name, name) == 0) {
+            fft_backend = &fft_backends[i];
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char *
+pyo_fft_get_backend_name(int index)
+{
+    if (index < 0 || index >= FFT_NUM_BACKENDS)
+        return NULL;
+    return fft_backends[index].name;
+}
@@ -0,0 +1,101 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include <stdlib.h>
+#include "fft.h"
+#include "wind.h"
+#include "fftcache.h"
+
+static PyoFFTTables *fft_tables = NULL;
+
+PyoFFTTables *
+PyoFFTTables_acquire(int size, int wintype)
+{
+    int i;
+    PyoFFTTables *tables;
+    const PyoFFTBackend *backend = pyo_fft_get_backend();
+
+    for (tables=fft_tables; tables!=NULL; tables=tables->next) {
+        if (tables->size == size && tables->wintype == wintype && tables->backend == backend) {
+            tables->refcount++;
+            return tables;
+        }
+    }
+
+    tables = (PyoFFTTables *)malloc(sizeof(PyoFFTTables));
+    tables->size = size;
+    tables->wintype = wintype;
+    tables->backend = backend;
+    tables->plan = backend->plan_new != NULL ? (*backend->plan_new)(size) : NULL;
+    tables->twiddle = (MYFLT **)malloc(4 * sizeof(MYFLT *));
+    for (i=0; i<4; i++)
+        tables->twiddle[i] = (MYFLT *)malloc((size >> 3) * sizeof(MYFLT));
+    fft_compute_split_twiddle(tables->twiddle, size);
+    tables->twiddle2 = (MYFLT *)malloc(size * sizeof(MYFLT));
+    fft_compute_radix2_twiddle(tables->twiddle2, size);
+    if (wintype >= 0) {
+        tables->window = (MYFLT *)malloc(size * sizeof(MYFLT));
+        gen_window(tables->window, size, wintype);
+    }
+    else
+        tables->window = NULL;
+    tables->refcount = 1;
+    tables->next = fft_tables;
+    fft_tables = tables;
+    return tables;
+}
+
+void
+PyoFFTTables_release(PyoFFTTables *tables)
+{
+    int i;
+    PyoFFTTables **prev;
+
+    if (tables == NULL || --tables->refcount > 0)
+        return;
+
+    for (prev=&fft_tables; *prev!=NULL; prev=&(*prev)->next) {
+        if (*prev == tables) {
+            *prev = tables->next;
+            break;
+        }
+    }
+    for (i=0; i<4; i++)
+        free(tables->twiddle[i]);
+    free(tables->twiddle);
+    free(tables->twiddle2);
+    free(tables->window);
+    if (tables->plan != NULL)
+        (*tables->backend->plan_free)(tables->plan);
+    free(tables);
+}
+
+void
+PyoFFTTables_forward(PyoFFTTables *tables, MYFLT *data, MYFLT *outdata)
+{
+    (*tables->backend->forward)(tables->plan, data, outdata, tables->size, tables->twiddle);
+}
+
+void
+PyoFFTTables_inverse(PyoFFTTables *tables, MYFLT *data, MYFLT *outdata)
+{
+    (*tables->backend->inverse)(tables->plan, data, outdata, tables->size, tables->twiddle);
+}
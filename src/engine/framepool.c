@@ -0,0 +1,172 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "framepool.h"
+
+#define PYO_FRAMEPOOL_JOBS 1024
+
+struct _PyoFramePool {
+    int nthreads;
+    pthread_t *threads;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    PyoFrameJob *queue[PYO_FRAMEPOOL_JOBS];
+    int head; /* under lock */
+    int count;
+    int running;
+};
+
+/* Returns 1 if the calling thread took the job and computed it. */
+static int
+PyoFrameJob_run(PyoFrameJob *job)
+{
+    if (!__sync_bool_compare_and_swap(&job->state, PYO_FRAMEJOB_PENDING, PYO_FRAMEJOB_RUNNING))
+        return 0;
+    (*job->func)(job->arg);
+    __sync_synchronize();
+    job->state = PYO_FRAMEJOB_IDLE;
+    return 1;
+}
+
+static void *
+PyoFramePool_worker(void *arg)
+{
+    PyoFramePool *self = (PyoFramePool *)arg;
+    PyoFrameJob *job;
+
+    pthread_mutex_lock(&self->lock);
+    for (;;) {
+        while (self->count == 0 && self->running)
+            pthread_cond_wait(&self->cond, &self->lock);
+        if (self->count == 0)
+            break;
+        job = self->queue[self->head];
+        self->head = (self->head + 1) % PYO_FRAMEPOOL_JOBS;
+        self->count--;
+        pthread_mutex_unlock(&self->lock);
+        PyoFrameJob_run(job);
+        /* Last access to the job, its owner may free it from now on. */
+        __sync_fetch_and_sub(&job->queued, 1);
+        pthread_mutex_lock(&self->lock);
+    }
+    pthread_mutex_unlock(&self->lock);
+    return NULL;
+}
+
+PyoFramePool *
+PyoFramePool_new(int nthreads)
+{
+    int i;
+    PyoFramePool *self = (PyoFramePool *)calloc(1, sizeof(PyoFramePool));
+
+    pthread_mutex_init(&self->lock, NULL);
+    pthread_cond_init(&self->cond, NULL);
+    self->running = 1;
+    self->threads = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+    for (i=0; i<nthreads; i++) {
+        if (pthread_create(&self->threads[i], NULL, PyoFramePool_worker, self) != 0)
+            break;
+    }
+    self->nthreads = i;
+    return self;
+}
+
+void
+PyoFramePool_free(PyoFramePool *self)
+{
+    int i;
+
+    if (self == NULL)
+        return;
+    pthread_mutex_lock(&self->lock);
+    self->running = 0;
+    pthread_cond_broadcast(&self->cond);
+    pthread_mutex_unlock(&self->lock);
+    for (i=0; i<self->nthreads; i++)
+        pthread_join(self->threads[i], NULL);
+    /* Without threads, nobody emptied the queue. */
+    for (; self->count > 0; self->count--) {
+        PyoFrameJob_run(self->queue[self->head]);
+        __sync_fetch_and_sub(&self->queue[self->head]->queued, 1);
+        self->head = (self->head + 1) % PYO_FRAMEPOOL_JOBS;
+    }
+    pthread_mutex_destroy(&self->lock);
+    pthread_cond_destroy(&self->cond);
+    free(self->threads);
+    free(self);
+}
+
+int
+PyoFramePool_getNumThreads(PyoFramePool *self)
+{
+    return self != NULL ? self->nthreads : 0;
+}
+
+void
+PyoFramePool_submit(PyoFramePool *self, PyoFrameJob *job)
+{
+    job->state = PYO_FRAMEJOB_PENDING;
+    if (self == NULL || self->nthreads == 0) {
+        PyoFrameJob_run(job);
+        return;
+    }
+    pthread_mutex_lock(&self->lock);
+    if (self->count == PYO_FRAMEPOOL_JOBS) {
+        pthread_mutex_unlock(&self->lock);
+        PyoFrameJob_run(job);
+        return;
+    }
+    __sync_fetch_and_add(&job->queued, 1);
+    self->queue[(self->head + self->count) % PYO_FRAMEPOOL_JOBS] = job;
+    self->count++;
+    pthread_cond_signal(&self->cond);
+    pthread_mutex_unlock(&self->lock);
+}
+
+void
+PyoFrameJob_init(PyoFrameJob *job, void (*func)(void *), void *arg)
+{
+    job->func = func;
+    job->arg = arg;
+    job->state = PYO_FRAMEJOB_IDLE;
+    job->queued = 0;
+}
+
+void
+PyoFrameJob_wait(PyoFrameJob *job)
+{
+    if (PyoFrameJob_run(job))
+        return;
+    /* A worker is computing it. */
+    while (job->state != PYO_FRAMEJOB_IDLE)
+        sched_yield();
+    __sync_synchronize();
+}
+
+void
+PyoFrameJob_release(PyoFrameJob *job)
+{
+    PyoFrameJob_wait(job);
+    while (job->queued > 0)
+        sched_yield();
+}
@@ -228,6 +228,8 @@ InputFader_setInput(InputFader *self, PyObject *args, PyObject *kwds)
         self->proc_func_ptr = InputFader_process_two;
 	}    
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -29,6 +29,7 @@
 typedef struct {
     pyo_audio_HEAD
     PyObject *input;
+    PyObject *input_streams;
     int modebuffer[2];
 } Mix;
 
@@ -85,13 +86,13 @@ Mix_compute_next_data_frame(Mix *self)
     int i, j;
     MYFLT old;
     PyObject *stream;
-    Py_ssize_t lsize = PyList_Size(self->input);
+    Py_ssize_t lsize = PyList_Size(self->input_streams);
 
     MYFLT buffer[self->bufsize];
     memset(&buffer, 0, sizeof(buffer));
 
     for (i=0; i<lsize; i++) {
-        stream = PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, i), "_getStream", NULL);
+        stream = PyList_GET_ITEM(self->input_streams, i);
         MYFLT *in = Stream_getData((Stream *)stream);
         for (j=0; j<self->bufsize; j++) {
             old = buffer[j];
@@ -110,6 +111,8 @@ static int
 Mix_traverse(Mix *self, visitproc visit, void *arg)
 {
     pyo_VISIT
+    Py_VISIT(self->input);
+    Py_VISIT(self->input_streams);
     return 0;
 }
 
@@ -117,6 +120,8 @@ static int
 Mix_clear(Mix *self)
 {
     pyo_CLEAR
+    Py_CLEAR(self->input);
+    Py_CLEAR(self->input_streams);
     return 0;
 }
 
@@ -150,6 +155,8 @@ Mix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 static int
 Mix_init(Mix *self, PyObject *args, PyObject *kwds)
 {
+    int i;
+    Py_ssize_t lsize;
     PyObject *inputtmp=NULL, *multmp=NULL, *addtmp=NULL;
 
     static char *kwlist[] = {"input", "mul", "add", NULL};
@@ -160,6 +167,12 @@ Mix_init(Mix *self, PyObject *args, PyObject *kwds)
     Py_INCREF(inputtmp);
     Py_XDECREF(self->input);
     self->input = inputtmp;
+    lsize = PyList_Size(self->input);
+    Py_XDECREF(self->input_streams);
+    self->input_streams = PyList_New(lsize);
+    for (i=0; i<lsize; i++) {
+        PyList_SET_ITEM(self->input_streams, i, PyObject_CallMethod(PyList_GET_ITEM(self->input, i), "_getStream", NULL));
+    }
     
     if (multmp) {
         PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
@@ -0,0 +1,63 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include <time.h>
+#include <sys/time.h>
+#include "profiler.h"
+
+unsigned long long
+PyoProfile_nanoseconds(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (unsigned long long)tv.tv_sec * 1000000000ULL + tv.tv_usec * 1000ULL;
+}
+
+void
+PyoProfile_add(PyoProfile *self, unsigned long long cycles)
+{
+    int bin = cycles == 0 ? 0 : 63 - __builtin_clzll(cycles);
+
+    if (bin >= PYO_PROFILE_BINS)
+        bin = PYO_PROFILE_BINS - 1;
+    self->calls++;
+    self->cycles += cycles;
+    if (cycles > self->worst)
+        self->worst = cycles;
+    self->histogram[bin]++;
+}
+
+double
+PyoProfile_getFrequency(void)
+{
+    static double frequency = 0.0;
+    unsigned long long c0, t0, c1, t1;
+    struct timespec wait = {0, 20000000};
+
+    if (frequency == 0.0) {
+        t0 = PyoProfile_nanoseconds();
+        c0 = PyoProfile_now();
+        nanosleep(&wait, NULL);
+        t1 = PyoProfile_nanoseconds();
+        c1 = PyoProfile_now();
+        frequency = (double)(c1 - c0) * 1000000000.0 / (double)(t1 - t0);
+    }
+    return frequency;
+}
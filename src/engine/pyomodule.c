@@ -28,6 +28,7 @@
 #include "dummymodule.h"
 #include "tablemodule.h"
 #include "matrixmodule.h"
+#include "fftbackend.h"
 
 /****** Portaudio utilities ******/
 static void portaudio_assert(PaError ecode, const char* cmdName) {
@@ -531,6 +532,68 @@ savefile(PyObject *self, PyObject *args, PyObject *kwds) {
     Py_RETURN_NONE;    
 }
 
+#define sndcat_info \
+"\nConcatenates soundfiles into a new one.\n\n\
+All files must have the same sampling rate and number of channels. The new file gets the format of the first one.\n\nsndcat(paths, path)\n\nParameters:\n\n    \
+paths : list of strings\n        Paths of the soundfiles to concatenate, in order.\n    \
+path : string\n        Full path (including extension) of the new file.\n\n"
+
+static PyObject *
+sndcat(PyObject *self, PyObject *args, PyObject *kwds) {
+    int i, num;
+    sf_count_t n;
+    char *path, *inpath;
+    double *buf;
+    PyObject *paths;
+    SNDFILE *infile, *outfile = NULL;
+    SF_INFO info, outinfo;
+    static char *kwlist[] = {"paths", "path", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "Os", kwlist, &paths, &path))
+        return PyInt_FromLong(-1);
+    if (! PyList_Check(paths) || PyList_Size(paths) == 0) {
+        printf("sndcat: paths must be a non empty list of strings.\n");
+        return PyInt_FromLong(-1);
+    }
+
+    num = PyList_Size(paths);
+    buf = NULL;
+    for (i=0; i<num; i++) {
+        inpath = PyString_AsString(PyList_GET_ITEM(paths, i));
+        info.format = 0;
+        if (inpath == NULL || ! (infile = sf_open(inpath, SFM_READ, &info))) {
+            printf("sndcat: failed to open the file %s.\n", inpath == NULL ? "" : inpath);
+            break;
+        }
+        if (outfile == NULL) {
+            outinfo = info;
+            if (! (outfile = sf_open(path, SFM_WRITE, &outinfo))) {
+                printf("sndcat: not able to open output file %s.\n", path);
+                sf_close(infile);
+                break;
+            }
+            buf = (double *)malloc(65536 * info.channels * sizeof(double));
+        }
+        else if (info.channels != outinfo.channels || info.samplerate != outinfo.samplerate) {
+            printf("sndcat: %s doesn't have the sampling rate and channels of %s.\n", inpath, 
+                   PyString_AsString(PyList_GET_ITEM(paths, 0)));
+            sf_close(infile);
+            break;
+        }
+        /* Doubles keep every sample type intact. */
+        while ((n = sf_readf_double(infile, buf, 65536)) > 0)
+            sf_writef_double(outfile, buf, n);
+        sf_close(infile);
+    }
+    if (outfile != NULL)
+        sf_close(outfile);
+    free(buf);
+    if (i < num)
+        return PyInt_FromLong(-1);
+
+    Py_RETURN_NONE;
+}
+
 #define reducePoints_info \
 "\nDouglas–Peucker curve reduction algorithm.\n\n\
 This function receives a list of points as input and returns a simplified list by eliminating redundancies.\n\n\
@@ -696,6 +759,71 @@ reducePoints(PyObject *self, PyObject *args, PyObject *kwds)
     return pPointsOut;    
 }
 
+/****** Math accuracy ******/
+#define setMathAccuracy_info \
+"\nSets the accuracy of the block transcendental functions used by the audio objects.\n\n\
+Biquad, EQ, Disto and Degrade compute their sines, cosines, powers and arctangents a block at a time.\n\
+The setting is global to the module.\n\nsetMathAccuracy(x)\n\nParameters:\n\n    \
+x : int\n        0 (exact) uses the standard math library for every sample. 1 (fast) uses vectorized\n\
+        polynomial approximations, accurate to a few units in the last place. Defaults to 0.\n\n"
+
+static PyObject *
+setMathAccuracy(PyObject *self, PyObject *arg) {
+    if (! PyInt_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "setMathAccuracy: argument must be an integer (0 = exact, 1 = fast).");
+        return NULL;
+    }
+    pyo_vec_set_math_accuracy(PyInt_AsLong(arg));
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+getMathAccuracy(PyObject *self) {
+    return PyInt_FromLong(pyo_vec_get_math_accuracy());
+}
+
+/****** FFT backend ******/
+#define setFFTBackend_info \
+"\nSets the implementation of the real fft used by the spectral objects (FFT, IFFT, Convolve).\n\n\
+Objects created afterwards, or changing their size or window, use the new backend. The setting\n\
+is global to the module.\n\nsetFFTBackend(x)\n\nParameters:\n\n    \
+x : string\n        'split' is the scalar split-radix transform. 'vector' uses radix-4 passes\n\
+        vectorized for the running cpu, its output may differ from 'split' in the last bits.\n\
+        'fftw' is available when pyo is built with --use-fftw. getFFTBackends() returns the\n\
+        available backends. Defaults to 'fftw' if available, 'vector' otherwise.\n\n"
+
+static PyObject *
+setFFTBackend(PyObject *self, PyObject *arg) {
+    if (! PyString_Check(arg)) {
+        PyErr_SetString(PyExc_TypeError, "setFFTBackend: argument must be a string.");
+        return NULL;
+    }
+    if (pyo_fft_set_backend(PyString_AsString(arg)) < 0) {
+        PyErr_Format(PyExc_ValueError, "setFFTBackend: unknown backend '%s'.", PyString_AsString(arg));
+        return NULL;
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+getFFTBackend(PyObject *self) {
+    return PyString_FromString(pyo_fft_get_backend()->name);
+}
+
+static PyObject *
+getFFTBackends(PyObject *self) {
+    int i;
+    PyObject *name, *names = PyList_New(0);
+    for (i=0; pyo_fft_get_backend_name(i)!=NULL; i++) {
+        name = PyString_FromString(pyo_fft_get_backend_name(i));
+        PyList_Append(names, name);
+        Py_DECREF(name);
+    }
+    return names;
+}
+
 /****** Conversion utilities ******/
 static PyObject *
 midiToHz(PyObject *self, PyObject *arg) {
@@ -737,11 +865,17 @@ static PyMethodDef pyo_functions[] = {
 {"pm_get_default_input", (PyCFunction)portmidi_get_default_input, METH_NOARGS, "Returns Portmidi default input device."},
 {"sndinfo", (PyCFunction)sndinfo, METH_VARARGS|METH_KEYWORDS, sndinfo_info},
 {"savefile", (PyCFunction)savefile, METH_VARARGS|METH_KEYWORDS, savefile_info},
+{"sndcat", (PyCFunction)sndcat, METH_VARARGS|METH_KEYWORDS, sndcat_info},
 {"reducePoints", (PyCFunction)reducePoints, METH_VARARGS|METH_KEYWORDS, reducePoints_info},
 {"midiToHz", (PyCFunction)midiToHz, METH_O, "Returns the frequency in Hertz equivalent to the given midi note."},
 {"midiToTranspo", (PyCFunction)midiToTranspo, METH_O, "Returns the transposition factor equivalent to the given midi note (central key = 60)."},
 {"sampsToSec", (PyCFunction)sampsToSec, METH_O, "Returns the number of samples equivalent of the given duration in seconds."},
 {"secToSamps", (PyCFunction)secToSamps, METH_O, "Returns the duration in seconds equivalent to the given number of samples."},
+{"setMathAccuracy", (PyCFunction)setMathAccuracy, METH_O, setMathAccuracy_info},
+{"getMathAccuracy", (PyCFunction)getMathAccuracy, METH_NOARGS, "Returns the accuracy of the block transcendental functions (0 = exact, 1 = fast)."},
+{"setFFTBackend", (PyCFunction)setFFTBackend, METH_O, setFFTBackend_info},
+{"getFFTBackend", (PyCFunction)getFFTBackend, METH_NOARGS, "Returns the name of the fft backend used by new spectral objects."},
+{"getFFTBackends", (PyCFunction)getFFTBackends, METH_NOARGS, "Returns the list of the available fft backends."},
 {NULL, NULL, 0, NULL},
 };
 
@@ -754,6 +888,9 @@ init_pyo64(void)
 {
     PyObject *m;
     
+    pyo_vec_init();
+    pyo_fft_init();
+
     m = Py_InitModule3(LIB_BASE_NAME, pyo_functions, "Python digital signal processing module.");
 
     if (PyType_Ready(&ServerType) < 0)
@@ -1617,6 +1754,16 @@ init_pyo64(void)
         return;
     Py_INCREF(&LooperType);
     PyModule_AddObject(m, "Looper_base", (PyObject *)&LooperType);
+
+    if (PyType_Ready(&MainParticleType) < 0)
+        return;
+    Py_INCREF(&MainParticleType);
+    PyModule_AddObject(m, "MainParticle_base", (PyObject *)&MainParticleType);
+
+    if (PyType_Ready(&ParticleType) < 0)
+        return;
+    Py_INCREF(&ParticleType);
+    PyModule_AddObject(m, "Particle_base", (PyObject *)&ParticleType);
     
 	if (PyType_Ready(&HarmonizerType) < 0)
         return;
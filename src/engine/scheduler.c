@@ -0,0 +1,493 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include <Python.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include "scheduler.h"
+#include "denormals.h"
+
+typedef struct {
+    Stream *stream;
+    int level; /* -1 means the stream was not active when the graph was recorded */
+    int ran;
+} PyoSchedNode;
+
+typedef struct {
+    Stream *stream;
+    int index;
+} PyoSchedKey;
+
+struct _PyoScheduler {
+    int nthreads;
+    pthread_t *workers;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    int generation;
+    int quit;
+    unsigned long fpcontrol; /* floating-point mode of the audio thread, copied by the workers */
+    /* level currently processed by the workers is order[next..end[,
+       next, end, remaining and dirty are only accessed with atomic builtins */
+    int next;
+    int end;
+    int remaining;
+    int dirty;
+    int num_nodes;
+    PyoSchedNode *nodes;
+    PyoSchedKey *keys; /* nodes sorted by stream address */
+    int *order; /* nodes sorted by level */
+    int num_levels;
+    int *level_start;
+    char *level_serial;
+    /* graph recording */
+    int current;
+    int num_edges;
+    int edge_size;
+    int *edge_from;
+    Stream **edge_to;
+    StreamProbe probe; /* installed on the audio thread while recording */
+};
+
+static void
+PyoScheduler_addEdge(PyoScheduler *self, Stream *stream)
+{
+    if (self->num_edges == self->edge_size) {
+        self->edge_size = self->edge_size == 0 ? 256 : self->edge_size * 2;
+        self->edge_from = (int *)realloc(self->edge_from, self->edge_size * sizeof(int));
+        self->edge_to = (Stream **)realloc(self->edge_to, self->edge_size * sizeof(Stream *));
+    }
+    self->edge_from[self->num_edges] = self->current;
+    self->edge_to[self->num_edges] = stream;
+    self->num_edges++;
+}
+
+static void
+PyoScheduler_probe(void *arg, Stream *stream)
+{
+    PyoScheduler_addEdge((PyoScheduler *)arg, stream);
+}
+
+static void
+PyoScheduler_declareStream(PyoScheduler *self, PyObject *obj)
+{
+    if (PyObject_TypeCheck(obj, &StreamType))
+        PyoScheduler_addEdge(self, (Stream *)obj);
+}
+
+/* Visit function of the objects' tp_traverse, collects the streams they hold,
+   directly or in the lists, tuples and dictionaries of their inputs. */
+static int
+PyoScheduler_visitInput(PyObject *obj, void *arg)
+{
+    Py_ssize_t i, pos = 0;
+    PyObject *key, *value;
+    PyoScheduler *self = (PyoScheduler *)arg;
+
+    if (PyList_Check(obj)) {
+        for (i=0; i<PyList_GET_SIZE(obj); i++)
+            PyoScheduler_declareStream(self, PyList_GET_ITEM(obj, i));
+    }
+    else if (PyTuple_Check(obj)) {
+        for (i=0; i<PyTuple_GET_SIZE(obj); i++)
+            PyoScheduler_declareStream(self, PyTuple_GET_ITEM(obj, i));
+    }
+    else if (PyDict_Check(obj)) {
+        while (PyDict_Next(obj, &pos, &key, &value))
+            PyoScheduler_declareStream(self, value);
+    }
+    else
+        PyoScheduler_declareStream(self, obj);
+    return 0;
+}
+
+static int
+PyoScheduler_compareKeys(const void *a, const void *b)
+{
+    const PyoSchedKey *ka = (const PyoSchedKey *)a;
+    const PyoSchedKey *kb = (const PyoSchedKey *)b;
+    if (ka->stream < kb->stream)
+        return -1;
+    else if (ka->stream > kb->stream)
+        return 1;
+    return 0;
+}
+
+static int
+PyoScheduler_lookup(PyoScheduler *self, Stream *stream)
+{
+    PyoSchedKey key, *found;
+    key.stream = stream;
+    found = (PyoSchedKey *)bsearch(&key, self->keys, self->num_nodes, sizeof(PyoSchedKey), PyoScheduler_compareKeys);
+    if (found == NULL)
+        return -1;
+    return found->index;
+}
+
+static inline void
+PyoScheduler_runNode(PyoScheduler *self, int index)
+{
+    PyoSchedNode *node = &self->nodes[index];
+    if (Stream_getStreamActive(node->stream) == 1) {
+        Stream_callFunction(node->stream);
+        node->ran = 1;
+    }
+}
+
+/* Grabs nodes of the current level until none is left. Returns the number of nodes computed. */
+static int
+PyoScheduler_work(PyoScheduler *self)
+{
+    int k, done = 0;
+    k = __atomic_load_n(&self->next, __ATOMIC_ACQUIRE);
+    for (;;) {
+        if (k >= __atomic_load_n(&self->end, __ATOMIC_ACQUIRE))
+            break;
+        /* On failure, k is reloaded with the current value of next. */
+        if (__atomic_compare_exchange_n(&self->next, &k, k+1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            PyoScheduler_runNode(self, self->order[k]);
+            /* Publishes the node's output to the audio thread. */
+            __atomic_fetch_sub(&self->remaining, 1, __ATOMIC_RELEASE);
+            done++;
+            k++;
+        }
+    }
+    return done;
+}
+
+static void *
+PyoScheduler_worker(void *arg)
+{
+    int gen = 0, quit = 0;
+    unsigned long control = PyoDenormals_getControl();
+    PyoScheduler *self = (PyoScheduler *)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&self->lock);
+        while (self->quit == 0 && self->generation == gen)
+            pthread_cond_wait(&self->cond, &self->lock);
+        gen = self->generation;
+        quit = self->quit;
+        if (self->fpcontrol != control) {
+            control = self->fpcontrol;
+            PyoDenormals_setControl(control);
+        }
+        pthread_mutex_unlock(&self->lock);
+        if (quit)
+            break;
+        /* Takes what is left of the level, then sleeps until the next parallel one. */
+        PyoScheduler_work(self);
+    }
+    return NULL;
+}
+
+PyoScheduler *
+PyoScheduler_new(int nthreads)
+{
+    int i;
+    PyoScheduler *self = (PyoScheduler *)calloc(1, sizeof(PyoScheduler));
+
+    if (nthreads < 1)
+        nthreads = 1;
+    self->dirty = 1;
+    pthread_mutex_init(&self->lock, NULL);
+    pthread_cond_init(&self->cond, NULL);
+    self->workers = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+    self->nthreads = 1;
+    for (i=1; i<nthreads; i++) {
+        if (pthread_create(&self->workers[i-1], NULL, PyoScheduler_worker, self) != 0)
+            break;
+        self->nthreads++;
+    }
+    return self;
+}
+
+static void
+PyoScheduler_clearNodes(PyoScheduler *self)
+{
+    int i;
+    for (i=0; i<self->num_nodes; i++) {
+        Py_DECREF(self->nodes[i].stream);
+    }
+    self->num_nodes = 0;
+}
+
+void
+PyoScheduler_free(PyoScheduler *self)
+{
+    int i;
+
+    pthread_mutex_lock(&self->lock);
+    self->quit = 1;
+    pthread_cond_broadcast(&self->cond);
+    pthread_mutex_unlock(&self->lock);
+    for (i=0; i<(self->nthreads-1); i++) {
+        pthread_join(self->workers[i], NULL);
+    }
+    pthread_mutex_destroy(&self->lock);
+    pthread_cond_destroy(&self->cond);
+
+    PyoScheduler_clearNodes(self);
+    free(self->workers);
+    free(self->nodes);
+    free(self->keys);
+    free(self->order);
+    free(self->level_start);
+    free(self->level_serial);
+    free(self->edge_from);
+    free(self->edge_to);
+    free(self);
+}
+
+void
+PyoScheduler_invalidate(PyoScheduler *self)
+{
+    __atomic_store_n(&self->dirty, 1, __ATOMIC_RELEASE);
+}
+
+int
+PyoScheduler_getNumThreads(PyoScheduler *self)
+{
+    return self->nthreads;
+}
+
+int
+PyoScheduler_getNumLevels(PyoScheduler *self)
+{
+    return self->num_levels;
+}
+
+int
+PyoScheduler_hasRun(PyoScheduler *self, int index, Stream *stream)
+{
+    if (index >= self->num_nodes || self->nodes[index].stream != stream)
+        index = PyoScheduler_lookup(self, stream);
+    if (index < 0)
+        return 0;
+    return self->nodes[index].ran;
+}
+
+/* Splits the recorded nodes in levels, from the edges collected by the probe. */
+static void
+PyoScheduler_computeLevels(PyoScheduler *self)
+{
+    int i, j, k, a, b, lvl, barrier = -1, maxlevel = -1;
+    int n = self->num_nodes;
+    int *pred_start = (int *)calloc(n + 1, sizeof(int));
+    int *preds = (int *)malloc((self->num_edges + 1) * sizeof(int));
+    int *fill = (int *)calloc(n + 1, sizeof(int));
+
+    /* An edge orders the two streams as they are in the list, whatever the direction of the read. */
+    for (k=0; k<self->num_edges; k++) {
+        j = PyoScheduler_lookup(self, self->edge_to[k]);
+        i = self->edge_from[k];
+        if (j < 0 || j == i)
+            continue;
+        b = i > j ? i : j;
+        pred_start[b+1]++;
+    }
+    for (i=0; i<n; i++) {
+        pred_start[i+1] += pred_start[i];
+    }
+    for (k=0; k<self->num_edges; k++) {
+        j = PyoScheduler_lookup(self, self->edge_to[k]);
+        i = self->edge_from[k];
+        if (j < 0 || j == i)
+            continue;
+        a = i < j ? i : j;
+        b = i > j ? i : j;
+        preds[pred_start[b] + fill[b]++] = a;
+    }
+
+    for (i=0; i<n; i++) {
+        if (self->nodes[i].ran == 0) {
+            self->nodes[i].level = -1;
+            continue;
+        }
+        if (Stream_getStreamSerial(self->nodes[i].stream)) {
+            lvl = barrier = maxlevel + 1;
+        }
+        else {
+            lvl = barrier + 1;
+            for (k=pred_start[i]; k<pred_start[i+1]; k++) {
+                a = self->nodes[preds[k]].level;
+                if (a >= lvl)
+                    lvl = a + 1;
+            }
+        }
+        self->nodes[i].level = lvl;
+        if (lvl > maxlevel)
+            maxlevel = lvl;
+    }
+
+    /* Counting sort of the nodes by level, keeping the list order inside a level. */
+    self->num_levels = maxlevel + 1;
+    self->level_start = (int *)realloc(self->level_start, (self->num_levels + 2) * sizeof(int));
+    self->level_serial = (char *)realloc(self->level_serial, (self->num_levels + 1) * sizeof(char));
+    for (i=0; i<=(self->num_levels+1); i++) {
+        self->level_start[i] = 0;
+    }
+    for (i=0; i<n; i++) {
+        if (self->nodes[i].level >= 0)
+            self->level_start[self->nodes[i].level+1]++;
+    }
+    for (i=0; i<self->num_levels; i++) {
+        self->level_start[i+1] += self->level_start[i];
+        self->level_serial[i] = 0;
+    }
+    for (i=0; i<=self->num_levels; i++) {
+        fill[i] = self->level_start[i];
+    }
+    for (i=0; i<n; i++) {
+        lvl = self->nodes[i].level;
+        if (lvl >= 0) {
+            self->order[fill[lvl]++] = i;
+            if (Stream_getStreamSerial(self->nodes[i].stream))
+                self->level_serial[lvl] = 1;
+        }
+    }
+
+    free(pred_start);
+    free(preds);
+    free(fill);
+}
+
+/* Computes the block serially, in list order, while recording the connections between streams. */
+static void
+PyoScheduler_record(PyoScheduler *self, PyoStreamTable *table)
+{
+    int i, count = table->length;
+    PyObject *obj;
+
+    PyoScheduler_clearNodes(self);
+    self->nodes = (PyoSchedNode *)realloc(self->nodes, (count + 1) * sizeof(PyoSchedNode));
+    self->keys = (PyoSchedKey *)realloc(self->keys, (count + 1) * sizeof(PyoSchedKey));
+    self->order = (int *)realloc(self->order, (count + 1) * sizeof(int));
+    for (i=0; i<count; i++) {
+        self->nodes[i].stream = PyoStreamTable_streamAt(table, i);
+        Py_INCREF(self->nodes[i].stream);
+        self->nodes[i].level = -1;
+        self->nodes[i].ran = 0;
+        self->keys[i].stream = self->nodes[i].stream;
+        self->keys[i].index = i;
+    }
+    self->num_nodes = count;
+    qsort(self->keys, count, sizeof(PyoSchedKey), PyoScheduler_compareKeys);
+
+    /* Changes made by the callbacks themselves will trigger a new recording. */
+    __atomic_store_n(&self->dirty, 0, __ATOMIC_RELEASE);
+    self->num_edges = 0;
+    __atomic_store_n(&self->end, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&self->next, 0, __ATOMIC_RELEASE);
+    self->probe.func = PyoScheduler_probe;
+    self->probe.arg = self;
+    Stream_setProbe(&self->probe);
+    for (i=0; i<count; i++) {
+        self->current = i;
+        PyoScheduler_runNode(self, i);
+    }
+    Stream_setProbe(NULL);
+
+    /* Reads can depend on the data (Selector's voice, ...), the streams each object
+       holds are edges too, whether they were read in this block or not. */
+    for (i=0; i<count; i++) {
+        obj = self->nodes[i].stream->streamobject;
+        if (obj != NULL && obj->ob_type->tp_traverse != NULL) {
+            self->current = i;
+            obj->ob_type->tp_traverse(obj, PyoScheduler_visitInput, self);
+        }
+    }
+
+    PyoScheduler_computeLevels(self);
+}
+
+/* Graph changed during the block, finishes it serially with the streams not computed yet. */
+static void
+PyoScheduler_finishSerially(PyoScheduler *self, PyoStreamTable *table, int level)
+{
+    int i, index;
+    Stream *stream;
+
+    for (i=0; i<table->length; i++) {
+        stream = PyoStreamTable_streamAt(table, i);
+        if (stream == NULL)
+            continue;
+        index = PyoScheduler_hasRun(self, i, stream) ? -1 : PyoScheduler_lookup(self, stream);
+        if (index >= 0 && (self->nodes[index].level > level || self->nodes[index].level < 0))
+            PyoScheduler_runNode(self, index);
+    }
+}
+
+void
+PyoScheduler_process(PyoScheduler *self, PyoStreamTable *table)
+{
+    int i, l, k, begin, end;
+
+    /* The server squeezes the holes out of the table before calling us. */
+    if (__atomic_load_n(&self->dirty, __ATOMIC_ACQUIRE) || table->length != self->num_nodes) {
+        PyoScheduler_record(self, table);
+        return;
+    }
+
+    for (i=0; i<self->num_nodes; i++) {
+        self->nodes[i].ran = 0;
+    }
+    /* end first, a late worker of the previous block must not see next below it. */
+    __atomic_store_n(&self->end, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&self->next, 0, __ATOMIC_RELEASE);
+
+    for (l=0; l<self->num_levels; l++) {
+        begin = self->level_start[l];
+        end = self->level_start[l+1];
+        if (self->nthreads == 1 || self->level_serial[l] || (end - begin) == 1) {
+            for (k=begin; k<end; k++) {
+                PyoScheduler_runNode(self, self->order[k]);
+            }
+            __atomic_store_n(&self->next, end, __ATOMIC_RELEASE);
+            if (__atomic_load_n(&self->dirty, __ATOMIC_ACQUIRE)) {
+                PyoScheduler_finishSerially(self, table, l);
+                break;
+            }
+        }
+        else {
+            /* Workers sleep on the condition between parallel levels, only this thread waits actively. */
+            __atomic_store_n(&self->remaining, end - begin, __ATOMIC_RELAXED);
+            __atomic_store_n(&self->end, end, __ATOMIC_RELEASE);
+            pthread_mutex_lock(&self->lock);
+            self->generation++;
+            self->fpcontrol = PyoDenormals_getControl();
+            pthread_cond_broadcast(&self->cond);
+            pthread_mutex_unlock(&self->lock);
+            PyoScheduler_work(self);
+            while (__atomic_load_n(&self->remaining, __ATOMIC_ACQUIRE) > 0)
+                sched_yield();
+        }
+    }
+
+    /* Streams started after the graph was recorded. */
+    if (l == self->num_levels) {
+        for (i=0; i<self->num_nodes; i++) {
+            if (self->nodes[i].level < 0 && Stream_getStreamActive(self->nodes[i].stream) == 1) {
+                PyoScheduler_runNode(self, i);
+                PyoScheduler_invalidate(self);
+            }
+        }
+    }
+}
@@ -22,6 +22,7 @@
 #include <math.h>
 #include <assert.h>
 #include <stdarg.h>
+#include <sys/time.h>
 
 #include "structmember.h"
 #include "portaudio.h"
@@ -29,15 +30,40 @@
 #include "sndfile.h"
 #include "streammodule.h"
 #include "pyomodule.h"
+#include "diskstream.h"
 #include "servermodule.h"
 
 static Server *my_server = NULL;
+
+/* Server of the calling thread, overrides my_server, see PyServer_get_server. */
+static pthread_key_t thread_server_key;
+static pthread_once_t thread_server_once = PTHREAD_ONCE_INIT;
+
+static void
+Server_createThreadKey(void)
+{
+    pthread_key_create(&thread_server_key, NULL);
+}
+
+static Server *
+Server_getThreadServer(void)
+{
+    pthread_once(&thread_server_once, Server_createThreadKey);
+    return (Server *)pthread_getspecific(thread_server_key);
+}
+
+static void
+Server_setThreadServer(Server *server)
+{
+    pthread_once(&thread_server_once, Server_createThreadKey);
+    pthread_setspecific(thread_server_key, server);
+}
 static PyObject *Server_shut_down(Server *self);
 static PyObject *Server_stop(Server *self);
-static void Server_process_gui(Server *server);
-static void Server_process_time(Server *server);
 static inline void Server_process_buffers(Server *server);
+static void Server_collectGarbage(Server *self);
 static int Server_start_rec_internal(Server *self, char *filename);
+static void Server_closeRecording(Server *self);
 
 #ifdef USE_COREAUDIO
 static int coreaudio_stop_callback(Server *self);
@@ -146,7 +172,9 @@ pa_callback_interleaved( const void *inputBuffer, void *outputBuffer,
     
     /* avoid unused variable warnings */
     (void) timeInfo;
-    (void) statusFlags;
+
+    if (statusFlags & (paInputOverflow | paOutputUnderflow))
+        server->xruns++;
 
     if (server->withPortMidi == 1) {
         portmidiGetEvents(server);
@@ -190,7 +218,9 @@ pa_callback_nonInterleaved( const void *inputBuffer, void *outputBuffer,
     
     /* avoid unused variable warnings */
     (void) timeInfo;
-    (void) statusFlags;
+
+    if (statusFlags & (paInputOverflow | paOutputUnderflow))
+        server->xruns++;
     
     if (server->withPortMidi == 1) {
         portmidiGetEvents(server);
@@ -281,6 +311,14 @@ jack_bufsize_cb (jack_nframes_t nframes, void *arg)
     return 0;
 }
 
+static int
+jack_xrun_cb (void *arg)
+{
+    Server *s = (Server *) arg;
+    s->xruns++;
+    return 0;
+}
+
 static void
 jack_error_cb (const char *desc)
 {
@@ -662,6 +700,7 @@ Server_jack_init (Server *self)
     jack_set_sample_rate_callback(be_data->jack_client, jack_srate_cb, (void *) self);
     jack_on_shutdown (be_data->jack_client, jack_shutdown_cb, (void *) self);
     jack_set_buffer_size_callback (be_data->jack_client, jack_bufsize_cb, (void *) self);
+    jack_set_xrun_callback (be_data->jack_client, jack_xrun_cb, (void *) self);
     return 0;
 }
 
@@ -1072,15 +1111,30 @@ Server_offline_start (Server *self)
     }
     Server_message(self,"Offline Server rendering file %s dur=%f\n", self->recpath, self->recdur);
     int numBlocks = ceil(self->recdur * self->samplingRate/self->bufferSize);
+    int count = 0;
+    double elapsed;
+    struct timeval t0, t1;
+    PyThreadState *state = NULL;
     Server_debug(self,"Number of blocks: %i\n", numBlocks);
+    gettimeofday(&t0, NULL);
+    /* Encoding and writing happen on the writer thread while the next blocks are computed. */
     Server_start_rec_internal(self, self->recpath);
-    while (numBlocks-- > 0 && self->server_stopped == 0) {
+    /* Lets the control thread run the Python callbacks while rendering. */
+    if (self->gilFree)
+        state = PyEval_SaveThread();
+    while (count < numBlocks && self->server_stopped == 0) {
         offline_process_block((Server *) self);   
+        count++;
     }
+    if (state != NULL)
+        PyEval_RestoreThread(state);
     self->server_started = 0;
-    self->record = 0;
-    sf_close(self->recfile);
-    Server_message(self,"Offline Server rendering finished.\n"); 
+    Server_collectGarbage(self);
+    Server_closeRecording(self);
+    gettimeofday(&t1, NULL);
+    elapsed = (t1.tv_sec - t0.tv_sec) + (t1.tv_usec - t0.tv_usec) * 0.000001;
+    self->offlineFactor = count * self->bufferSize / self->samplingRate / (elapsed > 0.000001 ? elapsed : 0.000001);
+    Server_message(self,"Offline Server rendering finished (%.1f times faster than real time).\n", self->offlineFactor); 
     return 0;
 }
 
@@ -1091,6 +1145,471 @@ Server_offline_stop (Server *self)
     return 0;
 }
 
+/***************************************************/
+/*  Parameter commands                             */
+
+enum {
+    SERVER_CMD_PARAM = 0, /* ptr: object, ptr2: value, ptr3: stream or NULL, index/index2/index3: offsets of the fields */
+    SERVER_CMD_AMP, /* value: new amplitude */
+    SERVER_CMD_EVENT, /* ptr: object, ptr2: PyoEventFunc, see Server_scheduleEvent */
+    SERVER_CMD_CANCELLED /* event of a stopped or deleted object */
+};
+
+/* Releases the references held by a command (the new values of a discarded
+   command or, in the garbage ring, the replaced ones). Needs the GIL. */
+static void
+Server_releaseCommand(PyoCommand *cmd)
+{
+    if (cmd->type != SERVER_CMD_PARAM)
+        return;
+    Py_XDECREF((PyObject *)cmd->ptr2);
+    Py_XDECREF((PyObject *)cmd->ptr3);
+    Py_XDECREF((PyObject *)cmd->ptr);
+}
+
+/* Python side. Releases the references given back by the audio thread. */
+static void
+Server_collectGarbage(Server *self)
+{
+    PyoCommand cmd;
+
+    while (PyoCommandQueue_pop(self->garbage, &cmd))
+        Server_releaseCommand(&cmd);
+}
+
+/* `direct` is 1 when called with the GIL, outside of the audio thread's command processing. */
+static void
+Server_applyCommand(Server *self, PyoCommand *cmd, int direct)
+{
+    char *obj;
+    PyObject **field;
+    Stream **field_stream;
+    PyoCommand trash;
+    int offset;
+
+    switch (cmd->type) {
+        case SERVER_CMD_AMP:
+            self->amp = (MYFLT)cmd->value;
+            break;
+        case SERVER_CMD_EVENT:
+            /* Late events (scheduled for a block already computed) fire at the start of this one. */
+            offset = cmd->time > self->elapsedSamples ? (int)(cmd->time - self->elapsedSamples) : 0;
+            (*(PyoEventFunc)cmd->ptr2)((PyObject *)cmd->ptr, cmd->time, offset);
+            break;
+        case SERVER_CMD_PARAM:
+            obj = (char *)cmd->ptr;
+            field = (PyObject **)(obj + cmd->index);
+            field_stream = (Stream **)(obj + cmd->index2);
+            trash.type = SERVER_CMD_PARAM;
+            trash.ptr = cmd->ptr;
+            trash.ptr2 = *field;
+            trash.ptr3 = NULL;
+            *field = (PyObject *)cmd->ptr2;
+            if (cmd->ptr3 != NULL) {
+                trash.ptr3 = *field_stream;
+                *field_stream = (Stream *)cmd->ptr3;
+                Server_graphChanged((PyObject *)self);
+            }
+            *(int *)(obj + cmd->index3) = (int)cmd->value;
+            (*((PyoAudioObject *)obj)->mode_func_ptr)(obj);
+            /* The garbage ring holds as many commands as can be in flight, it can't be full. */
+            if (direct || PyoCommandQueue_push(self->garbage, &trash) < 0)
+                Server_releaseCommand(&trash);
+            break;
+    }
+}
+
+static int
+Server_pendingBefore(PyoPendingCommand *a, PyoPendingCommand *b)
+{
+    if (a->cmd.time != b->cmd.time)
+        return a->cmd.time < b->cmd.time;
+    return (int)(a->seq - b->seq) < 0;
+}
+
+/* Audio side. Returns -1 if the heap is full. */
+static int
+Server_pushPending(Server *self, PyoCommand *cmd)
+{
+    int i, parent;
+    PyoPendingCommand tmp, *heap = self->pending;
+
+    if (self->num_pending == PYO_SERVER_COMMANDS)
+        return -1;
+    i = self->num_pending++;
+    heap[i].cmd = *cmd;
+    heap[i].seq = self->pending_seq++;
+    while (i > 0) {
+        parent = (i - 1) / 2;
+        if (!Server_pendingBefore(&heap[i], &heap[parent]))
+            break;
+        tmp = heap[i]; heap[i] = heap[parent]; heap[parent] = tmp;
+        i = parent;
+    }
+    return 0;
+}
+
+static void
+Server_popPending(Server *self, PyoCommand *cmd)
+{
+    int i = 0, child;
+    PyoPendingCommand tmp, *heap = self->pending;
+
+    *cmd = heap[0].cmd;
+    heap[0] = heap[--self->num_pending];
+    for (;;) {
+        child = 2 * i + 1;
+        if (child >= self->num_pending)
+            break;
+        if (child + 1 < self->num_pending && Server_pendingBefore(&heap[child+1], &heap[child]))
+            child++;
+        if (!Server_pendingBefore(&heap[child], &heap[i]))
+            break;
+        tmp = heap[i]; heap[i] = heap[child]; heap[child] = tmp;
+        i = child;
+    }
+}
+
+/* Audio side, at the start of a block. Every command (or event, see
+   Server_scheduleEvent) whose time falls before the end of the block is applied,
+   in time order. If too many commands are waiting, the new ones are applied early. */
+static void
+Server_applyCommands(Server *self)
+{
+    PyoCommand cmd;
+    unsigned long long end = (unsigned long long)self->elapsedSamples + self->bufferSize;
+
+    while (PyoCommandQueue_pop(self->commands, &cmd)) {
+        if (Server_pushPending(self, &cmd) < 0)
+            Server_applyCommand(self, &cmd, 0);
+    }
+    while (self->num_pending > 0 && self->pending[0].cmd.time < end) {
+        Server_popPending(self, &cmd);
+        Server_applyCommand(self, &cmd, 0);
+    }
+}
+
+/* Python side, when no block can run (see Server_mustQueue and Server_sendCommand).
+   Applies the parameter commands as Server_applyCommands does, but the events
+   stay on the timeline: they are only fired by the blocks. */
+static void
+Server_applyParamCommands(Server *self)
+{
+    PyoCommand cmd;
+    int i;
+    unsigned long long end = (unsigned long long)self->elapsedSamples + self->bufferSize;
+
+    while (PyoCommandQueue_pop(self->commands, &cmd)) {
+        if (Server_pushPending(self, &cmd) < 0)
+            Server_applyCommand(self, &cmd, 0);
+    }
+    self->num_held = 0;
+    while (self->num_pending > 0 && self->pending[0].cmd.time < end) {
+        Server_popPending(self, &cmd);
+        if (cmd.type == SERVER_CMD_EVENT)
+            self->held[self->num_held++] = cmd;
+        else
+            Server_applyCommand(self, &cmd, 0);
+    }
+    for (i=0; i<self->num_held; i++) {
+        if (self->held[i].type == SERVER_CMD_EVENT)
+            Server_pushPending(self, &self->held[i]);
+    }
+    self->num_held = 0;
+}
+
+int
+Server_scheduleEvent(PyObject *obj, unsigned long long time, PyoEventFunc func, PyObject *target)
+{
+    Server *self = (Server *)obj;
+    PyoCommand cmd;
+
+    cmd.type = SERVER_CMD_EVENT;
+    cmd.ptr = target;
+    cmd.ptr2 = (void *)func;
+    cmd.ptr3 = NULL;
+    cmd.time = time;
+    return Server_pushPending(self, &cmd);
+}
+
+/* The heap can't be reordered while it is being popped (an event may stop an object), the events
+   are only marked. */
+void
+Server_cancelEvents(PyObject *obj, PyObject *target)
+{
+    Server *self = (Server *)obj;
+    int i;
+
+    for (i=0; i<self->num_pending; i++) {
+        if (self->pending[i].cmd.type == SERVER_CMD_EVENT && self->pending[i].cmd.ptr == target)
+            self->pending[i].cmd.type = SERVER_CMD_CANCELLED;
+    }
+    for (i=0; i<self->num_held; i++) {
+        if (self->held[i].type == SERVER_CMD_EVENT && self->held[i].ptr == target)
+            self->held[i].type = SERVER_CMD_CANCELLED;
+    }
+}
+
+unsigned long long
+Server_getElapsedSamples(PyObject *obj)
+{
+    return (unsigned long long)((Server *)obj)->elapsedSamples;
+}
+
+/* Returns 1 if a change must go through the command ring. It doesn't when no block
+   can be running concurrently: the server is stopped (the queued commands are then
+   applied first, to keep their order), or the call comes from a Python callback run
+   by the block itself. Objects that aren't computed yet (`registered` is 0) are
+   changed directly as well. */
+static int
+Server_mustQueue(Server *self, int registered)
+{
+    int locked;
+
+    if (self == NULL || self->commands == NULL)
+        return 0;
+    if (self->commandDelay > 0)
+        return 1;
+    if (self->in_block || !registered)
+        return 0;
+    if (self->server_started == 0) {
+        locked = Server_lockBlocks((PyObject *)self);
+        Server_applyParamCommands(self);
+        Server_collectGarbage(self);
+        Server_unlockBlocks((PyObject *)self, locked);
+        return 0;
+    }
+    return 1;
+}
+
+/* Python side. The blocks are computed while the audio thread holds the GIL
+   (or the block lock, see Server_lockBlocks), so when the ring is full the
+   commands can be applied right away. */
+static void
+Server_sendCommand(Server *self, PyoCommand *cmd)
+{
+    int locked;
+
+    Server_collectGarbage(self);
+    cmd->time = (unsigned long long)self->elapsedSamples + self->commandDelay;
+    if (PyoCommandQueue_push(self->commands, cmd) < 0) {
+        locked = Server_lockBlocks((PyObject *)self);
+        Server_applyParamCommands(self);
+        Server_collectGarbage(self);
+        PyoCommandQueue_push(self->commands, cmd);
+        Server_unlockBlocks((PyObject *)self, locked);
+    }
+}
+
+void
+Server_setParam(PyObject *obj, PyObject **field, PyObject *value, Stream **field_stream, Stream *stream, int *mode, int modeval)
+{
+    PyoAudioObject *audio = (PyoAudioObject *)obj;
+    Server *self = (Server *)audio->server;
+    PyoCommand cmd;
+
+    Py_INCREF(obj);
+    cmd.type = SERVER_CMD_PARAM;
+    cmd.index = (int)((char *)field - (char *)obj);
+    cmd.index2 = (int)((char *)field_stream - (char *)obj);
+    cmd.index3 = (int)((char *)mode - (char *)obj);
+    cmd.value = modeval;
+    cmd.ptr = obj;
+    cmd.ptr2 = value;
+    cmd.ptr3 = stream;
+    if (Server_mustQueue(self, audio->stream != NULL && Stream_getStreamSlot(audio->stream) >= 0))
+        Server_sendCommand(self, &cmd);
+    else
+        Server_applyCommand(self, &cmd, 1);
+}
+
+/* Drops the commands not applied yet, with the references they hold. */
+static void
+Server_clearCommands(Server *self)
+{
+    PyoCommand cmd;
+
+    if (self->commands == NULL)
+        return;
+    while (PyoCommandQueue_pop(self->commands, &cmd))
+        Server_releaseCommand(&cmd);
+    while (self->num_pending > 0) {
+        Server_popPending(self, &cmd);
+        Server_releaseCommand(&cmd);
+    }
+    Server_collectGarbage(self);
+}
+
+/***************************************************/
+/*  Blocks computed without the GIL                */
+
+enum {
+    SERVER_EVENT_NONE = 0, /* cancelled */
+    SERVER_EVENT_CALL /* ptr: object, ptr2: function, value */
+};
+
+void
+Server_callPython(PyObject *callable, PyObject *arg)
+{
+    PyObject *tuple, *result;
+
+    if (arg == Py_None)
+        tuple = PyTuple_New(0);
+    else {
+        tuple = PyTuple_New(1);
+        Py_INCREF(arg);
+        PyTuple_SET_ITEM(tuple, 0, arg);
+    }
+    result = PyObject_Call(callable, tuple, NULL);
+    if (result == NULL)
+        PyErr_Print();
+    else
+        Py_DECREF(result);
+    Py_DECREF(tuple);
+}
+
+void
+Server_enterPython(PyObject *obj)
+{
+    Server *self = (Server *)obj;
+
+    if (self == NULL || self->nogil_block == 0)
+        return;
+    if (self->python_depth++ == 0) {
+        self->python_state = PyGILState_Ensure();
+        self->in_block = 1;
+    }
+}
+
+void
+Server_leavePython(PyObject *obj)
+{
+    Server *self = (Server *)obj;
+
+    if (self == NULL || self->nogil_block == 0)
+        return;
+    if (--self->python_depth == 0) {
+        self->in_block = 0;
+        PyGILState_Release(self->python_state);
+    }
+}
+
+void
+Server_postCallback(PyObject *obj, void (*func)(PyObject *, double), PyObject *target, double value)
+{
+    Server *self = (Server *)obj;
+    PyoCommand cmd;
+
+    /* Offline, the call is made at its exact place in the rendering, as with the GIL. */
+    if (self != NULL && self->nogil_block && self->audio_be_type != PyoOffline) {
+        cmd.type = SERVER_EVENT_CALL;
+        cmd.ptr = target;
+        cmd.ptr2 = (void *)func;
+        cmd.value = value;
+        if (PyoCommandQueue_push(self->events, &cmd) == 0) {
+            pthread_cond_signal(&self->control_cond);
+            return;
+        }
+        /* The control thread is late, wait for the GIL rather than losing the call. */
+        Server_enterPython(obj);
+        (*func)(target, value);
+        Server_leavePython(obj);
+        return;
+    }
+    Server_enterPython(obj);
+    (*func)(target, value);
+    Server_leavePython(obj);
+}
+
+/* Control thread side, with the GIL. */
+static void
+Server_dispatchEvents(Server *self)
+{
+    PyoCommand cmd;
+
+    while (PyoCommandQueue_pop(self->events, &cmd)) {
+        if (cmd.type == SERVER_EVENT_CALL)
+            (*(void (*)(PyObject *, double))cmd.ptr2)((PyObject *)cmd.ptr, cmd.value);
+    }
+}
+
+static void *
+Server_controlThread(void *arg)
+{
+    Server *self = (Server *)arg;
+    PyGILState_STATE s;
+    struct timeval now;
+    struct timespec until;
+
+    /* Objects created by the callbacks belong to this Server. */
+    Server_setThreadServer(self);
+    pthread_mutex_lock(&self->control_lock);
+    while (self->control_running) {
+        if (PyoCommandQueue_count(self->events) > 0) {
+            pthread_mutex_unlock(&self->control_lock);
+            s = PyGILState_Ensure();
+            Server_dispatchEvents(self);
+            PyGILState_Release(s);
+            pthread_mutex_lock(&self->control_lock);
+        }
+        else {
+            /* The audio thread signals without the lock, a signal may be missed. */
+            gettimeofday(&now, NULL);
+            until.tv_sec = now.tv_sec;
+            until.tv_nsec = now.tv_usec * 1000 + 5000000;
+            if (until.tv_nsec >= 1000000000) {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&self->control_cond, &self->control_lock, &until);
+        }
+    }
+    pthread_mutex_unlock(&self->control_lock);
+    return NULL;
+}
+
+/* Python side, with the GIL. */
+static void
+Server_stopControlThread(Server *self)
+{
+    if (self->control_running == 0)
+        return;
+    pthread_mutex_lock(&self->control_lock);
+    self->control_running = 0;
+    pthread_cond_signal(&self->control_cond);
+    pthread_mutex_unlock(&self->control_lock);
+    /* Called by a callback run on the control thread, which ends after it. */
+    if (pthread_equal(pthread_self(), self->control_thread)) {
+        pthread_detach(self->control_thread);
+        return;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    pthread_join(self->control_thread, NULL);
+    Py_END_ALLOW_THREADS
+    Server_dispatchEvents(self);
+}
+
+int
+Server_lockBlocks(PyObject *obj)
+{
+    Server *self = (Server *)obj;
+
+    /* in_block: called by a Python function run by the block itself, which holds the lock. */
+    if (self == NULL || self->gilFree == 0 || self->in_block)
+        return 0;
+    Py_BEGIN_ALLOW_THREADS
+    pthread_mutex_lock(&self->block_lock);
+    Py_END_ALLOW_THREADS
+    return 1;
+}
+
+void
+Server_unlockBlocks(PyObject *obj, int locked)
+{
+    if (locked)
+        pthread_mutex_unlock(&((Server *)obj)->block_lock);
+}
+
 /***************************************************/
 /*  Main Processing functions                      */
 
@@ -1099,21 +1618,55 @@ Server_process_buffers(Server *server)
 {
     float *out = server->output_buffer;    
     MYFLT buffer[server->nchnls][server->bufferSize];
-    int i, j, chnl;
-    int count = server->stream_count;
-    int nchnls = server->nchnls;
-    MYFLT amp = server->amp;
+    int i, j, chnl, slot, count;
+    MYFLT amp;
+    PyoStreamTable *table = server->streams;
     Stream *stream_tmp;
     MYFLT *data;
-
+    unsigned long long start = 0, cycles;
+    unsigned long fpcontrol, denormals = 0;
+    PyGILState_STATE s = PyGILState_UNLOCKED;
+    int nogil = 0;
+
+    if (server->profiling)
+        start = PyoProfile_now();
+    fpcontrol = PyoDenormals_enter(server->flushDenormals);
     memset(&buffer, 0, sizeof(buffer));
-    PyGILState_STATE s = PyGILState_Ensure();
+    if (server->gilFree) {
+        pthread_mutex_lock(&server->block_lock);
+        /* GIL-free mode may have been turned off while we were waiting. */
+        if (server->gilFree)
+            nogil = server->nogil_block = 1;
+        else
+            pthread_mutex_unlock(&server->block_lock);
+    }
+    if (nogil == 0) {
+        s = PyGILState_Ensure();
+        server->in_block = 1;
+    }
+    Server_applyCommands(server);
+    amp = server->amp;
+    /* The scheduler's graph is already invalidated by the removals that left holes. */
+    PyoStreamTable_compact(table, server->scheduler != NULL);
+    count = table->length;
+    if (server->scheduler != NULL)
+        PyoScheduler_process(server->scheduler, table);
     for (i=0; i<count; i++) {
-        stream_tmp = (Stream *)PyList_GET_ITEM(server->streams, i);
-        if (Stream_getStreamActive(stream_tmp) == 1) {
-            Stream_callFunction(stream_tmp);
+        slot = table->order[i];
+        if (slot < 0)
+            continue;
+        stream_tmp = table->stream[slot];
+        if (server->scheduler != NULL ? PyoScheduler_hasRun(server->scheduler, i, stream_tmp) : Stream_getStreamActive(stream_tmp) == 1) {
+            if (server->scheduler == NULL) {
+                if (server->profiling || Stream_getStreamPython(stream_tmp))
+                    Stream_callFunction(stream_tmp);
+                else
+                    (*table->funcptr[slot])(table->object[slot]);
+            }
+            if (server->countDenormals)
+                denormals += PyoDenormals_count(table->data[slot], server->bufferSize);
             if (Stream_getStreamToDac(stream_tmp) != 0) {
-                data = Stream_getData(stream_tmp);
+                data = table->data[slot];
                 chnl = Stream_getStreamChnl(stream_tmp);
                 for (j=0; j < server->bufferSize; j++) {
                     buffer[chnl][j] += *data++;
@@ -1126,14 +1679,12 @@ Server_process_buffers(Server *server)
         else if (Stream_getBufferCountWait(stream_tmp) != 0)
             Stream_IncrementBufferCount(stream_tmp);
     }
-    if (server->withGUI == 1 && nchnls <= 8) {
-        Server_process_gui(server);
-    }
-    if (server->withTIME == 1) {
-        Server_process_time(server);
+    if (server->countDenormals) {
+        server->denormals += denormals;
+        server->denormalBlocks += denormals > 0;
+        server->checkedBlocks++;
     }
     server->elapsedSamples += server->bufferSize;
-    PyGILState_Release(s);
     if (amp != server->lastAmp) {
         server->timeCount = 0;
         server->stepVal = (amp - server->currentAmp) / server->timeStep;
@@ -1149,90 +1700,191 @@ Server_process_buffers(Server *server)
             out[(i*server->nchnls)+j] = (float)buffer[j][i] * server->currentAmp;
         }
     }
-    if (server->record == 1)
-        sf_write_float(server->recfile, out, server->bufferSize * server->nchnls);
-
-}
-
-static void
-Server_process_gui(Server *server)
-{
-    float rms[server->nchnls];
-    float *out = server->output_buffer;
-    float outAmp;
-    int i,j;
-    for (j=0; j<server->nchnls; j++) {
-        rms[j] = 0.0;
-        for (i=0; i<server->bufferSize; i++) {
-            outAmp = out[(i*server->nchnls)+j];
-            outAmp *= outAmp;
-            if (outAmp > rms[j])
-                rms[j] = outAmp;
-        }
-    }    
-    if (server->gcount <= server->numPass) {
-        for (j=0; j<server->nchnls; j++) {            
-            server->lastRms[j] = (rms[j] + server->lastRms[j]) * 0.5;
-        }    
-        server->gcount++;
+    if (server->telemetry != NULL)
+        PyoTelemetry_process(server->telemetry, out, server->bufferSize, server->elapsedSamples);
+    /* Still under the GIL (or the block lock), the recording can't be closed meanwhile. */
+    if (server->record == 1 && server->recwriter != NULL)
+        PyoSndWriter_write(server->recwriter, out, server->bufferSize);
+    if (nogil) {
+        server->nogil_block = 0;
+        pthread_mutex_unlock(&server->block_lock);
     }
     else {
-        for (j=0; j<server->nchnls; j++) {            
-            server->lastRms[j] = (rms[j] + server->lastRms[j]) * 0.5;
-        }  
-        switch (server->nchnls) {
-            case 1:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "f", server->lastRms[0]);
-                break;
-            case 2:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ff", server->lastRms[0], server->lastRms[1]);
-                break;
-            case 3:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fff", server->lastRms[0], server->lastRms[1], server->lastRms[2]);
-                break;
-            case 4:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3]);
-                break;
-            case 5:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4]);
-                break;
-            case 6:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5]);
-                break;
-            case 7:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "fffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6]);
-                break;
-            case 8:
-                PyObject_CallMethod((PyObject *)server->GUI, "setRms", "ffffffff", server->lastRms[0], server->lastRms[1], server->lastRms[2], server->lastRms[3], server->lastRms[4], server->lastRms[5], server->lastRms[6], server->lastRms[7]);
-                break;
-        }        
-        server->gcount = 0;
+        server->in_block = 0;
+        PyGILState_Release(s);
     }
+    PyoDenormals_setControl(fpcontrol);
+
+    if (server->profiling) {
+        cycles = PyoProfile_now() - start;
+        PyoProfile_add(&server->profile, cycles);
+        if (cycles > server->bufferSize / server->samplingRate * server->cycleFrequency)
+            server->overruns++;
+    }
+
 }
 
+/***************************************************/
+/*  Meters                                         */
+
+/* Python side (GIL held) or meter thread (GIL held). Hands the latest readings
+   of the output meters to the GUI and the elapsed time to the TIME object. */
 static void
-Server_process_time(Server *server)
-{
-    int hours, minutes, seconds, milliseconds;
-    float sr = server->samplingRate;
-    double sampsToSecs;
-    
-    if (server->tcount <= server->timePass) {
-        server->tcount++;
+Server_showMeters(Server *self, unsigned long long *last)
+{
+    PyoTelemetry *t = self->telemetry;
+    PyObject *amps = NULL, *func, *ret;
+    double peak, value;
+    int j, hours, minutes, seconds, milliseconds;
+
+    pthread_mutex_lock(&t->lock);
+    if (t->time == *last) {
+        pthread_mutex_unlock(&t->lock);
+        return;
+    }
+    *last = t->time;
+    if (self->GUI != NULL) {
+        amps = PyTuple_New(t->nchnls);
+        for (j=0; j<t->nchnls; j++) {
+            /* The GUI expects squared amplitudes, smoothed like they always were. */
+            peak = t->outputs[j].peak;
+            self->lastRms[j] = (peak * peak + self->lastRms[j]) * 0.5;
+            PyTuple_SET_ITEM(amps, j, PyFloat_FromDouble(self->lastRms[j]));
+        }
     }
-    else {
-        sampsToSecs = (double)(server->elapsedSamples / sr);
-        seconds = (int)sampsToSecs;
-        milliseconds = (int)((sampsToSecs - seconds) * 1000);
+    pthread_mutex_unlock(&t->lock);
+
+    if (amps != NULL) {
+        func = PyObject_GetAttrString(self->GUI, "setRms");
+        ret = func != NULL ? PyObject_CallObject(func, amps) : NULL;
+        if (ret == NULL)
+            PyErr_Print();
+        Py_XDECREF(ret);
+        Py_XDECREF(func);
+        Py_DECREF(amps);
+    }
+    if (self->TIME != NULL) {
+        value = *last / self->samplingRate;
+        seconds = (int)value;
+        milliseconds = (int)((value - seconds) * 1000);
         minutes = seconds / 60;
         hours = minutes / 60;
         minutes = minutes % 60;
         seconds = seconds % 60;
-        PyObject_CallMethod((PyObject *)server->TIME, "setTime", "iiii", hours, minutes, seconds, milliseconds);   
-        server->tcount = 0;
+        ret = PyObject_CallMethod((PyObject *)self->TIME, "setTime", "iiii", hours, minutes, seconds, milliseconds);
+        if (ret == NULL)
+            PyErr_Print();
+        Py_XDECREF(ret);
+    }
+}
+
+/* Reads the meters every PYO_SERVER_METER_PERIOD seconds and takes the GIL only
+   to call the GUI, the audio thread never waits for it. */
+static void *
+Server_meterThread(void *arg)
+{
+    Server *self = (Server *)arg;
+    PyGILState_STATE s;
+    struct timeval now;
+    struct timespec until;
+    unsigned long long last = 0;
+
+    pthread_mutex_lock(&self->meter_lock);
+    while (self->meter_running) {
+        gettimeofday(&now, NULL);
+        until.tv_sec = now.tv_sec;
+        until.tv_nsec = now.tv_usec * 1000 + (long)(PYO_SERVER_METER_PERIOD * 1000000000);
+        while (until.tv_nsec >= 1000000000) {
+            until.tv_sec++;
+            until.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&self->meter_cond, &self->meter_lock, &until);
+        if (self->meter_running == 0)
+            break;
+        PyoTelemetry_drain(self->telemetry);
+        if (self->telemetry->time == last)
+            continue;
+        pthread_mutex_unlock(&self->meter_lock);
+        s = PyGILState_Ensure();
+        Server_showMeters(self, &last);
+        PyGILState_Release(s);
+        pthread_mutex_lock(&self->meter_lock);
+    }
+    pthread_mutex_unlock(&self->meter_lock);
+    return NULL;
+}
+
+/* Python side, with the GIL. */
+static void
+Server_stopMeterThread(Server *self)
+{
+    if (self->meter_running == 0)
+        return;
+    pthread_mutex_lock(&self->meter_lock);
+    self->meter_running = 0;
+    pthread_cond_signal(&self->meter_cond);
+    pthread_mutex_unlock(&self->meter_lock);
+    /* Called by the GUI from the meter thread, which ends after it. */
+    if (pthread_equal(pthread_self(), self->meter_thread)) {
+        pthread_detach(self->meter_thread);
+        return;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    pthread_join(self->meter_thread, NULL);
+    Py_END_ALLOW_THREADS
+}
+
+/* Python side, with the GIL. Creates the meters once the Server is booted
+   (the period depends on the buffer size), and the meter thread if a GUI or
+   a TIME object needs it. */
+static void
+Server_startMetering(Server *self)
+{
+    PyoTelemetry *t;
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    int i, period, locked;
+
+    if (self->metering == 0 || self->server_booted == 0)
+        return;
+    if (self->telemetry == NULL) {
+        period = (int)(PYO_SERVER_METER_PERIOD * self->samplingRate / self->bufferSize + 0.5);
+        t = PyoTelemetry_new(self->nchnls, period, PYO_SERVER_METER_RECORDS);
+        while (PyDict_Next(self->meters, &pos, &key, &value))
+            PyoTelemetry_subscribe(t, PyInt_AsLong(key), Stream_getData((Stream *)value));
+        self->lastRms = (float *)realloc(self->lastRms, self->nchnls * sizeof(float));
+        for (i=0; i<self->nchnls; i++)
+            self->lastRms[i] = 0.0;
+        locked = Server_lockBlocks((PyObject *)self);
+        self->telemetry = t;
+        Server_unlockBlocks((PyObject *)self, locked);
+    }
+    if ((self->GUI != NULL || self->TIME != NULL) && self->meter_running == 0) {
+        PyEval_InitThreads();
+        self->meter_running = 1;
+        if (pthread_create(&self->meter_thread, NULL, Server_meterThread, self) != 0) {
+            self->meter_running = 0;
+            Server_error(self, "Unable to start the meter thread.\n");
+        }
     }
 }
 
+/* Python side, with the GIL. */
+static void
+Server_stopMetering(Server *self)
+{
+    PyoTelemetry *t = self->telemetry;
+    int locked;
+
+    Server_stopMeterThread(self);
+    if (t == NULL)
+        return;
+    locked = Server_lockBlocks((PyObject *)self);
+    self->telemetry = NULL;
+    Server_unlockBlocks((PyObject *)self, locked);
+    PyoTelemetry_free(t);
+}
+
 /***************************************************/
 
 /* Global function called by any new audio object to 
@@ -1240,7 +1892,8 @@ Server_process_time(Server *server)
 PyObject *
 PyServer_get_server()
 {
-    return (PyObject *)my_server;
+    Server *server = Server_getThreadServer();
+    return (PyObject *)(server != NULL ? server : my_server);
 }
 
 static PyObject *
@@ -1255,6 +1908,7 @@ Server_shut_down(Server *self)
     if (self->server_started == 1) {
         Server_stop((Server *)self);
     }
+    Server_closeRecording(self);
     switch (self->audio_be_type) {
         case PyoPortaudio:
             ret = Server_pa_deinit(self);
@@ -1277,6 +1931,17 @@ Server_shut_down(Server *self)
     if (ret < 0) {
         Server_error(self, "Error closing audio backend.\n");
     }
+
+    if (self->scheduler != NULL) {
+        PyoScheduler_free(self->scheduler);
+        self->scheduler = NULL;
+    }
+    if (self->framepool != NULL) {
+        PyoFramePool_free(self->framepool);
+        self->framepool = NULL;
+    }
+    Server_stopControlThread(self);
+    Server_stopMetering(self);
     
     if (self->withPortMidi == 1) {
         Pm_Close(self->in);
@@ -1290,37 +1955,77 @@ Server_shut_down(Server *self)
 static int
 Server_traverse(Server *self, visitproc visit, void *arg)
 {
-    Py_VISIT(self->streams);
+    int i;
+    if (self->streams != NULL) {
+        for (i=0; i<self->streams->length; i++) {
+            Py_VISIT(PyoStreamTable_streamAt(self->streams, i));
+        }
+    }
+    Py_VISIT(self->meters);
     return 0;
 }
 
 static int 
 Server_clear(Server *self)
 {    
-    Py_CLEAR(self->streams);
+    if (self->streams != NULL) {
+        PyoStreamTable_free(self->streams);
+        self->streams = NULL;
+    }
     return 0;
 }
 
 static void
 Server_dealloc(Server* self)
 {  
-    Server_shut_down(self);
+    if (self->server_booted)
+        Server_shut_down(self);
+    Server_stopControlThread(self);
+    Server_stopMetering(self);
+    if (Server_getThreadServer() == self)
+        Server_setThreadServer(NULL);
     Server_clear(self);
+    Server_clearCommands(self);
+    PyoCommandQueue_free(self->commands);
+    PyoCommandQueue_free(self->garbage);
+    PyoCommandQueue_free(self->events);
+    pthread_mutex_destroy(&self->block_lock);
+    pthread_mutex_destroy(&self->control_lock);
+    pthread_cond_destroy(&self->control_cond);
+    pthread_mutex_destroy(&self->meter_lock);
+    pthread_cond_destroy(&self->meter_cond);
+    Py_XDECREF(self->meters);
+    Py_XDECREF(self->GUI);
+    Py_XDECREF(self->TIME);
+    free(self->lastRms);
+    free(self->pending);
+    free(self->held);
     free(self->input_buffer);
     free(self->serverName);
+    free(self->recpath);
     self->ob_type->tp_free((PyObject*)self);
 }
 
 static PyObject *
 Server_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 {
-    if (PyServer_get_server() != NULL) {
-        Server_warning((Server *) PyServer_get_server(), "Warning: A Server is already created!\n"
+    static char *kwlist[] = {"sr", "nchnls", "buffersize", "duplex", "audio", "jackname", "standalone", NULL};
+    double sr;
+    int nchnls, bufferSize, duplex, standalone = 0;
+    char *audioType, *serverName;
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "|diiissi", kwlist, 
+            &sr, &nchnls, &bufferSize, &duplex, &audioType, &serverName, &standalone))
+        return NULL;
+    if (standalone == 0 && my_server != NULL) {
+        Server_warning(my_server, "Warning: A Server is already created!\n"
             "If you put this Server in a new variable, please delete it!\n");
-        return PyServer_get_server();
+        Py_INCREF(my_server);
+        return (PyObject *)my_server;
     }    
     Server *self;
     self = (Server *)type->tp_alloc(type, 0);
+    self->standalone = standalone;
     self->server_booted = 0;
     self->audio_be_data = NULL;
     self->serverName = (char *) calloc(32, sizeof(char));
@@ -1334,30 +2039,69 @@ Server_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->midi_input = -1;
     self->amp = self->resetAmp = 1.;
     self->currentAmp = self->lastAmp = 0.;
-    self->withGUI = 0;
-    self->withTIME = 0;
+    self->metering = 0;
+    self->telemetry = NULL;
+    self->meters = PyDict_New();
+    self->GUI = self->TIME = NULL;
+    self->lastRms = NULL;
+    pthread_mutex_init(&self->meter_lock, NULL);
+    pthread_cond_init(&self->meter_cond, NULL);
+    self->meter_running = 0;
     self->verbosity = 7;
+    self->nthreads = 1;
+    self->scheduler = NULL;
+    self->fftThreads = 0;
+    self->framepool = NULL;
     self->recdur = -1;
     self->recformat = 0;
     self->rectype = 0;
     self->startoffset = 0.0;
-    Py_XDECREF(my_server);
-    Py_XINCREF(self);
-    my_server = (Server *)self;
+    self->recwriter = NULL;
+    self->recoverflows = self->recdropped = 0;
+    self->offlineFactor = 0.0;
+    self->profiling = 0;
+    self->xruns = 0;
+    self->flushDenormals = 1;
+    self->countDenormals = 0;
+    self->commands = PyoCommandQueue_new(PYO_SERVER_COMMANDS);
+    /* Every command in flight, queued or pending, may give its references back at once. */
+    self->garbage = PyoCommandQueue_new(2 * PYO_SERVER_COMMANDS);
+    self->pending = (PyoPendingCommand *)malloc(PYO_SERVER_COMMANDS * sizeof(PyoPendingCommand));
+    self->held = (PyoCommand *)malloc(PYO_SERVER_COMMANDS * sizeof(PyoCommand));
+    self->num_held = 0;
+    self->num_pending = 0;
+    self->pending_seq = 0;
+    self->in_block = 0;
+    self->commandDelay = 0;
+    self->gilFree = 0;
+    self->nogil_block = 0;
+    self->python_depth = 0;
+    pthread_mutex_init(&self->block_lock, NULL);
+    self->events = PyoCommandQueue_new(PYO_SERVER_COMMANDS);
+    pthread_mutex_init(&self->control_lock, NULL);
+    pthread_cond_init(&self->control_cond, NULL);
+    self->control_running = 0;
+    self->recpath = NULL;
+    if (standalone == 0) {
+        Py_XINCREF(self);
+        my_server = (Server *)self;
+    }
     return (PyObject *)self;
 }
 
 static int
 Server_init(Server *self, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"sr", "nchnls", "buffersize", "duplex", "audio", "jackname", NULL};
+    static char *kwlist[] = {"sr", "nchnls", "buffersize", "duplex", "audio", "jackname", "standalone", NULL};
     
     char *audioType = "portaudio";
     char *serverName = "pyo";
+    char *home;
+    int standalone = 0;
 
     //Server_debug(self, "Server_init. Compiled " TIMESTAMP "\n");  // Only for debugging purposes
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, "|diiiss", kwlist, 
-            &self->samplingRate, &self->nchnls, &self->bufferSize, &self->duplex, &audioType, &serverName))
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "|diiissi", kwlist, 
+            &self->samplingRate, &self->nchnls, &self->bufferSize, &self->duplex, &audioType, &serverName, &standalone))
         return -1;
     if (strcmp(audioType, "jack") == 0) {
         self->audio_be_type = PyoJack;
@@ -1375,13 +2119,21 @@ Server_init(Server *self, PyObject *args, PyObject *kwds)
         Server_warning(self, "Unknown audio type. Using Portaudio\n");
         self->audio_be_type = PyoPortaudio;
     }
+    /* The audio devices and the midi library can't be shared by several Servers. */
+    if (self->standalone && self->audio_be_type != PyoOffline) {
+        Server_warning(self, "A standalone Server can only render offline. Using offline\n");
+        self->audio_be_type = PyoOffline;
+    }
     strncpy(self->serverName, serverName, 32);
     if (strlen(serverName) > 31) {
         self->serverName[31] = '\0';
     }
-    self->recpath = getenv("HOME");
-    if (self->recpath != NULL)
-        strncat(self->recpath, "/pyo_rec.wav", strlen("/pyo_rec.wav")); 
+    home = getenv("HOME");
+    if (home != NULL) {
+        free(self->recpath);
+        self->recpath = (char *)malloc(strlen(home) + strlen("/pyo_rec.wav") + 1);
+        sprintf(self->recpath, "%s/pyo_rec.wav", home);
+    }
     return 0;
 }
 
@@ -1504,23 +2256,80 @@ Server_setDuplex(Server *self, PyObject *arg)
 static PyObject *
 Server_setAmp(Server *self, PyObject *arg)
 {
+    PyoCommand cmd;
+
     if (arg != NULL) {
         int check = PyNumber_Check(arg);
         
         if (check) {
-            self->amp = PyFloat_AsDouble(PyNumber_Float(arg));
-            if (self->amp != 0.0)
-                self->resetAmp = self->amp;
+            cmd.type = SERVER_CMD_AMP;
+            cmd.value = PyFloat_AsDouble(arg);
+            if (cmd.value != 0.0)
+                self->resetAmp = cmd.value;
+            if (Server_mustQueue(self, 1))
+                Server_sendCommand(self, &cmd);
+            else
+                Server_applyCommand(self, &cmd, 1);
         }
     }
     Py_INCREF(Py_None);
     return Py_None;
 }
 
+static PyObject *
+Server_setCommandDelay(Server *self, PyObject *arg)
+{
+    if (arg != NULL && PyNumber_Check(arg)) {
+        double delay = PyFloat_AsDouble(arg);
+        self->commandDelay = delay > 0.0 ? (unsigned long)(delay * self->samplingRate + 0.5) : 0;
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setCurrent(Server *self, PyObject *arg)
+{
+    if (PyObject_IsTrue(arg))
+        Server_setThreadServer(self);
+    else if (Server_getThreadServer() == self)
+        Server_setThreadServer(NULL);
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setGILFree(Server *self, PyObject *arg)
+{
+    int locked, active = PyObject_IsTrue(arg);
+
+    if (active && self->gilFree == 0) {
+        PyEval_InitThreads();
+        if (self->control_running == 0) {
+            self->control_running = 1;
+            if (pthread_create(&self->control_thread, NULL, Server_controlThread, self) != 0) {
+                self->control_running = 0;
+                Server_error(self, "Unable to start the control thread.\n");
+                Py_INCREF(Py_None);
+                return Py_None;
+            }
+        }
+        /* We hold the GIL, no block is being computed. */
+        self->gilFree = 1;
+    }
+    else if (!active && self->gilFree) {
+        locked = Server_lockBlocks((PyObject *)self);
+        self->gilFree = 0;
+        Server_unlockBlocks((PyObject *)self, locked);
+        Server_stopControlThread(self);
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyObject *
 Server_setAmpCallable(Server *self, PyObject *arg)
 {
-    int i;
     PyObject *tmp;
     
     if (arg == NULL) {
@@ -1533,20 +2342,8 @@ Server_setAmpCallable(Server *self, PyObject *arg)
     Py_XDECREF(self->GUI);
     Py_INCREF(tmp);
     self->GUI = tmp;
-
-    self->lastRms = (float *)realloc(self->lastRms, self->nchnls * sizeof(float));
-    for (i=0; i<self->nchnls; i++) {
-        self->lastRms[i] = 0.0;
-    }
-    
-    for (i=1; i<100; i++) {
-        if ((self->bufferSize * i / self->samplingRate) > 0.045) {
-            self->numPass = i;
-            break;
-        }
-    } 
-    self->gcount = 0;
-    self->withGUI = 1;
+    self->metering = 1;
+    Server_startMetering(self);
     
     Py_INCREF(Py_None);
     return Py_None;
@@ -1555,7 +2352,6 @@ Server_setAmpCallable(Server *self, PyObject *arg)
 static PyObject *
 Server_setTimeCallable(Server *self, PyObject *arg)
 {
-    int i;
     PyObject *tmp;
     
     if (arg == NULL) {
@@ -1568,20 +2364,114 @@ Server_setTimeCallable(Server *self, PyObject *arg)
     Py_XDECREF(self->TIME);
     Py_INCREF(tmp);
     self->TIME = tmp;
+    self->metering = 1;
+    Server_startMetering(self);
+    
+    Py_INCREF(Py_None);
+    return Py_None;
+}
 
-    for (i=1; i<100; i++) {
-        if ((self->bufferSize * i / self->samplingRate) > 0.06) {
-            self->timePass = i;
-            break;
+static PyObject *
+Server_setMetering(Server *self, PyObject *arg)
+{
+    self->metering = PyObject_IsTrue(arg);
+    if (self->metering)
+        Server_startMetering(self);
+    else
+        Server_stopMetering(self);
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_addMeter(Server *self, PyObject *args)
+{
+    PyObject *stream, *key;
+    int locked;
+
+    if (! PyArg_ParseTuple(args, "O!", &StreamType, &stream))
+        return NULL;
+    key = PyInt_FromLong(Stream_getStreamId((Stream *)stream));
+    if (PyDict_GetItem(self->meters, key) == NULL) {
+        PyDict_SetItem(self->meters, key, stream);
+        if (self->telemetry != NULL) {
+            locked = Server_lockBlocks((PyObject *)self);
+            PyoTelemetry_subscribe(self->telemetry, Stream_getStreamId((Stream *)stream), Stream_getData((Stream *)stream));
+            Server_unlockBlocks((PyObject *)self, locked);
         }
-    } 
-    self->tcount = 0;
-    self->withTIME = 1;
-    
+    }
+    Py_DECREF(key);
+    self->metering = 1;
+    Server_startMetering(self);
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_removeMeter(Server *self, PyObject *args)
+{
+    PyObject *stream, *key;
+    int id, locked;
+
+    if (! PyArg_ParseTuple(args, "O!", &StreamType, &stream))
+        return NULL;
+    id = Stream_getStreamId((Stream *)stream);
+    key = PyInt_FromLong(id);
+    if (PyDict_GetItem(self->meters, key) != NULL) {
+        if (self->telemetry != NULL) {
+            locked = Server_lockBlocks((PyObject *)self);
+            PyoTelemetry_unsubscribe(self->telemetry, id);
+            Server_unlockBlocks((PyObject *)self, locked);
+            /* Nothing about the stream is pushed anymore, its last records can go. */
+            PyoTelemetry_drain(self->telemetry);
+            pthread_mutex_lock(&self->telemetry->lock);
+            PyoTelemetry_forget(self->telemetry, id);
+            pthread_mutex_unlock(&self->telemetry->lock);
+        }
+        /* The stream (and the data the audio thread was reading) may go only now. */
+        PyDict_DelItem(self->meters, key);
+    }
+    Py_DECREF(key);
     Py_INCREF(Py_None);
     return Py_None;
 }
 
+static PyObject *
+Server_getMeters(Server *self)
+{
+    PyoTelemetry *t = self->telemetry;
+    PyObject *dict, *outputs, *streams, *key, *value, *tmp;
+    PyoMeterRecord *rec;
+    Py_ssize_t pos = 0;
+    int j;
+
+    if (t == NULL) {
+        Server_warning(self, "Metering is off or the Server isn't booted, see Server.setMetering.\n");
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    PyoTelemetry_drain(t);
+    outputs = PyList_New(t->nchnls);
+    streams = PyDict_New();
+    pthread_mutex_lock(&t->lock);
+    for (j=0; j<t->nchnls; j++)
+        PyList_SET_ITEM(outputs, j, Py_BuildValue("(ff)", t->outputs[j].peak, t->outputs[j].rms));
+    while (PyDict_Next(self->meters, &pos, &key, &value)) {
+        rec = PyoTelemetry_latest(t, PyInt_AsLong(key));
+        if (rec != NULL) {
+            tmp = Py_BuildValue("(ff)", rec->peak, rec->rms);
+            PyDict_SetItem(streams, value, tmp);
+            Py_DECREF(tmp);
+        }
+    }
+    dict = Py_BuildValue("{s:d,s:O,s:O,s:K}", "time", t->time / self->samplingRate, "outputs", outputs,
+                         "streams", streams, "dropped", t->dropped);
+    pthread_mutex_unlock(&t->lock);
+    Py_DECREF(outputs);
+    Py_DECREF(streams);
+    return dict;
+}
+
 static PyObject *
 Server_setVerbosity(Server *self, PyObject *arg)
 {
@@ -1597,6 +2487,119 @@ Server_setVerbosity(Server *self, PyObject *arg)
     return Py_None;
 }
 
+static PyObject *
+Server_setThreads(Server *self, PyObject *arg)
+{
+    if (self->server_booted) {
+        Server_warning(self, "Can't change number of threads for booted server.\n");
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    if (arg != NULL && PyInt_Check(arg)) {
+        self->nthreads = PyInt_AsLong(arg);
+        if (self->nthreads < 1)
+            self->nthreads = 1;
+    }
+    else {
+        Server_error(self, "Number of threads must be an integer.\n");
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setFFTThreads(Server *self, PyObject *arg)
+{
+    if (self->server_booted) {
+        Server_warning(self, "Can't change number of FFT threads for booted server.\n");
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    if (arg != NULL && PyInt_Check(arg)) {
+        self->fftThreads = PyInt_AsLong(arg);
+        if (self->fftThreads < 0)
+            self->fftThreads = 0;
+    }
+    else {
+        Server_error(self, "Number of FFT threads must be an integer.\n");
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setDiskBuffer(Server *self, PyObject *arg)
+{
+    if (arg != NULL && PyNumber_Check(arg)) {
+        PyoDiskStream_setBufferDuration(PyFloat_AsDouble(PyNumber_Float(arg)));
+    }
+    else {
+        Server_error(self, "Disk buffer duration must be a number.\n");
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setDiskThreads(Server *self, PyObject *arg)
+{
+    if (arg != NULL && PyInt_Check(arg)) {
+        PyoDiskStream_setNumThreads(PyInt_AsLong(arg));
+    }
+    else {
+        Server_error(self, "Number of disk threads must be an integer.\n");
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setProfiling(Server *self, PyObject *arg)
+{
+    int i, locked;
+    Stream *stream;
+
+    locked = Server_lockBlocks((PyObject *)self);
+    self->profiling = PyObject_IsTrue(arg);
+    if (self->profiling) {
+        self->cycleFrequency = PyoProfile_getFrequency();
+        memset(&self->profile, 0, sizeof(PyoProfile));
+        self->overruns = self->xruns = 0;
+    }
+    if (self->streams != NULL) {
+        for (i=0; i<self->streams->length; i++) {
+            stream = PyoStreamTable_streamAt(self->streams, i);
+            if (stream != NULL)
+                Stream_setProfiling(stream, self->profiling);
+        }
+    }
+    Server_unlockBlocks((PyObject *)self, locked);
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setFlushDenormals(Server *self, PyObject *arg)
+{
+    self->flushDenormals = PyObject_IsTrue(arg);
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+static PyObject *
+Server_setCountDenormals(Server *self, PyObject *arg)
+{
+    int locked;
+
+    locked = Server_lockBlocks((PyObject *)self);
+    self->countDenormals = PyObject_IsTrue(arg);
+    if (self->countDenormals)
+        self->denormals = self->denormalBlocks = self->checkedBlocks = 0;
+    Server_unlockBlocks((PyObject *)self, locked);
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 static PyObject *
 Server_setStartOffset(Server *self, PyObject *arg)
 {
@@ -1679,11 +2682,20 @@ Server_boot(Server *self)
     self->server_started = 0;
     self->stream_count = 0;
     self->elapsedSamples = 0;
+    /* The times of the commands and events left by the previous run start over. */
+    Server_clearCommands(self);
     
-    midierr = Server_pm_init(self);
-    Server_debug(self, "PortMidi initialization return code : %d.\n", midierr);
+    if (self->standalone == 0) {
+        midierr = Server_pm_init(self);
+        Server_debug(self, "PortMidi initialization return code : %d.\n", midierr);
+    }
+    else
+        self->withPortMidi = 0;
 
-    self->streams = PyList_New(0);
+    if (self->streams == NULL)
+        self->streams = PyoStreamTable_new();
+    else
+        PyoStreamTable_clear(self->streams);
     switch (self->audio_be_type) {
         case PyoPortaudio:
             audioerr = Server_pa_init(self);
@@ -1732,6 +2744,15 @@ Server_boot(Server *self)
     }
     if (audioerr == 0 && midierr == 0) {
         self->server_booted = 1;
+        if (self->nthreads > 1) {
+            self->scheduler = PyoScheduler_new(self->nthreads);
+            Server_debug(self, "Processing threads : %d.\n", PyoScheduler_getNumThreads(self->scheduler));
+        }
+        if (self->fftThreads > 0) {
+            self->framepool = PyoFramePool_new(self->fftThreads);
+            Server_debug(self, "Frame threads : %d.\n", PyoFramePool_getNumThreads(self->framepool));
+        }
+        Server_startMetering(self);
     }
     else {
         self->server_booted = 0;
@@ -1757,10 +2778,15 @@ Server_start(Server *self)
         return Py_None;
     }
     int err = -1;
+    Server *previous;
     
     /* Ensure Python is set up for threading */
     PyEval_InitThreads();
 
+    /* Objects created by the streams computed by this thread belong to this Server. */
+    previous = Server_getThreadServer();
+    Server_setThreadServer(self);
+
     self->server_stopped = 0;
     self->server_started = 1;
     self->timeStep = (int)(0.01 * self->samplingRate);
@@ -1768,9 +2794,21 @@ Server_start(Server *self)
     if (self->startoffset > 0.0) {
         Server_message(self,"Rendering %.2f seconds offline...\n", self->startoffset);
         int numBlocks = ceil(self->startoffset * self->samplingRate/self->bufferSize);
-        self->lastAmp = 1.0; self->amp = 0.0;
-        while (numBlocks-- > 0) {
-            offline_process_block((Server *) self); 
+        /* Offline, the skipped part is rendered as usual so the recording starts seamlessly. */
+        if (self->audio_be_type != PyoOffline) {
+            self->lastAmp = 1.0; self->amp = 0.0;
+        }
+        if (self->gilFree) {
+            Py_BEGIN_ALLOW_THREADS
+            while (numBlocks-- > 0) {
+                offline_process_block((Server *) self); 
+            }
+            Py_END_ALLOW_THREADS
+        }
+        else {
+            while (numBlocks-- > 0) {
+                offline_process_block((Server *) self); 
+            }
         }
         Server_message(self,"Offline rendering completed. Start realtime processing.\n");
         self->startoffset = 0.0;
@@ -1796,6 +2834,7 @@ Server_start(Server *self)
             err = Server_offline_start(self);
             break;           
     }
+    Server_setThreadServer(previous);
     if (err) {
         Server_error(self, "Error starting server.");
     }
@@ -1838,6 +2877,7 @@ Server_stop(Server *self)
     else {
         self->server_stopped = 1;
     }
+    Server_collectGarbage(self);
     Py_INCREF(Py_None);
     return Py_None;
 }
@@ -1846,10 +2886,16 @@ static PyObject *
 Server_recordOptions(Server *self, PyObject *args, PyObject *kwds)
 {    
     static char *kwlist[] = {"dur", "filename", "fileformat", "sampletype", NULL};
+    char *filename = NULL;
     
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, "d|sii", kwlist, &self->recdur, &self->recpath, &self->recformat, &self->rectype)) {
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "d|sii", kwlist, &self->recdur, &filename, &self->recformat, &self->rectype)) {
         return PyInt_FromLong(-1);
     }
+    /* Kept, the string may be gone when the rendering starts. */
+    if (filename != NULL) {
+        free(self->recpath);
+        self->recpath = strdup(filename);
+    }
     
     Py_INCREF(Py_None);
     return Py_None;
@@ -1874,6 +2920,9 @@ Server_start_rec(Server *self, PyObject *args, PyObject *kwds)
 static int 
 Server_start_rec_internal(Server *self, char *filename)
 {
+    PyoSndWriter *writer;
+    int chunk, locked;
+
     /* Prepare sfinfo */
     self->recinfo.samplerate = (int)self->samplingRate;
     self->recinfo.channels = self->nchnls;
@@ -1904,38 +2953,79 @@ Server_start_rec_internal(Server *self, char *filename)
             break;
     }
     
-    /* Open the output file. */
-    if (filename == NULL) {
-        if (! (self->recfile = sf_open(self->recpath, SFM_WRITE, &self->recinfo))) {   
-            Server_error(self, "Not able to open output file %s.\n", self->recpath);
-            return -1;
-        }
+    if (filename == NULL)
+        filename = self->recpath;
+    Server_closeRecording(self);
+    self->recoverflows = self->recdropped = 0;
+
+    /* Open the output file. Offline, the rendering waits for the disk, in real time
+       the audio thread never does (the frames that don't fit in the ring are dropped). */
+    if (self->audio_be_type == PyoOffline) {
+        writer = PyoSndWriter_open(filename, &self->recinfo, PYO_OFFLINE_CHUNK_SAMPLES / self->nchnls + self->bufferSize, 
+                                   PYO_OFFLINE_CHUNKS, 0);
     }
     else {
-        if (! (self->recfile = sf_open(filename, SFM_WRITE, &self->recinfo))) {   
-            Server_error(self, "Not able to open output file %s.\n", filename);
-            return -1;
-        }
+        chunk = PYO_SNDWRITER_CHUNK_FRAMES > self->bufferSize ? PYO_SNDWRITER_CHUNK_FRAMES : self->bufferSize;
+        writer = PyoSndWriter_open(filename, &self->recinfo, chunk, 
+                                   (int)(PYO_SNDWRITER_SECONDS * self->samplingRate / chunk) + 2, PYO_SNDWRITER_REALTIME);
+    }
+    if (writer == NULL) {
+        Server_error(self, "Not able to open output file %s.\n", filename);
+        return -1;
     }
     
+    locked = Server_lockBlocks((PyObject *)self);
+    self->recwriter = writer;
     self->record = 1;
+    Server_unlockBlocks((PyObject *)self, locked);
     return 0;
 }
 
+/* Python side. */
+static void
+Server_closeRecording(Server *self)
+{
+    PyoSndWriter *writer;
+    int locked = Server_lockBlocks((PyObject *)self);
+
+    writer = self->recwriter;
+    self->recwriter = NULL;
+    self->record = 0;
+    Server_unlockBlocks((PyObject *)self, locked);
+    if (writer == NULL)
+        return;
+    PyoSndWriter_getOverflows(writer, &self->recoverflows, &self->recdropped);
+    if (PyoSndWriter_close(writer) < 0)
+        Server_error(self, "Error while writing the recorded file.\n");
+    if (self->recdropped > 0)
+        Server_warning(self, "Recording: %llu frames dropped, the disk was too slow.\n", self->recdropped);
+}
+
 static PyObject *
 Server_stop_rec(Server *self, PyObject *args)
 {
-    self->record = 0;
-    sf_close(self->recfile);
+    Server_closeRecording(self);
     
     Py_INCREF(Py_None);
     return Py_None;
 }
 
+static PyObject *
+Server_getRecordOverflows(Server *self)
+{
+    unsigned long overflows = self->recoverflows;
+    unsigned long long dropped = self->recdropped;
+
+    if (self->recwriter != NULL)
+        PyoSndWriter_getOverflows(self->recwriter, &overflows, &dropped);
+    return Py_BuildValue("(kK)", overflows, dropped);
+}
+
 static PyObject *
 Server_addStream(Server *self, PyObject *args)
 {
     PyObject *tmp;
+    int locked;
     
     if (! PyArg_ParseTuple(args, "O", &tmp))
         return PyInt_FromLong(-1); 
@@ -1945,77 +3035,92 @@ Server_addStream(Server *self, PyObject *args)
         return PyInt_FromLong(-1);
     }
 
-    Py_INCREF(tmp);
-    PyList_Append(self->streams, tmp);
+    if (! PyObject_TypeCheck(tmp, &StreamType)) {
+        Server_error(self, "Need a pyo object as argument\n");
+        return PyInt_FromLong(-1);
+    }
 
-    self->stream_count++;
+    locked = Server_lockBlocks((PyObject *)self);
+    if (self->streams == NULL)
+        self->streams = PyoStreamTable_new();
+    if (PyoStreamTable_add(self->streams, (Stream *)tmp) >= 0)
+        self->stream_count++;
+    if (self->profiling)
+        Stream_setProfiling((Stream *)tmp, 1);
+    Server_graphChanged((PyObject *)self);
+    Server_unlockBlocks((PyObject *)self, locked);
     
     Py_INCREF(Py_None);
     return Py_None;
 }
 
 PyObject *
-Server_removeStream(Server *self, int id)
-{
-    int i, sid;
-    Stream *stream_tmp;
-    
-    for (i=0; i<self->stream_count; i++) {
-        stream_tmp = (Stream *)PyList_GET_ITEM(self->streams, i);
-        sid = Stream_getStreamId(stream_tmp);
-        if (sid == id) {
-            Server_debug(self, "Removed stream id %d\n", id);
-            PySequence_DelItem(self->streams, i);
-            self->stream_count--;
-        }
-    }
+Server_removeStream(Server *self, Stream *stream)
+{
+    int id = Stream_getStreamId(stream);
+    int locked = Server_lockBlocks((PyObject *)self);
+
+    if (self->streams != NULL && PyoStreamTable_remove(self->streams, stream) == 0) {
+        Server_debug(self, "Removed stream id %d\n", id);
+        self->stream_count--;
+        Server_graphChanged((PyObject *)self);
+    }
+    /* The object may be gone before the control thread gets to its callbacks. */
+    if (self->events != NULL)
+        PyoCommandQueue_cancel(self->events, Stream_getStreamObject(stream), SERVER_EVENT_NONE);
+    if (self->pending != NULL)
+        Server_cancelEvents((PyObject *)self, Stream_getStreamObject(stream));
+    Server_unlockBlocks((PyObject *)self, locked);
     Py_INCREF(Py_None);
     return Py_None;    
 }
 
-PyObject *
-Server_changeStreamPosition(Server *self, PyObject *args)
+static PyObject *
+Server_removeStreamFromPython(Server *self, PyObject *args)
 {
-    int err, i, rsid, csid, sid;
-    Stream *ref_stream_tmp, *cur_stream_tmp, *stream_tmp;
+    PyObject *tmp;
 
-    if (! PyArg_ParseTuple(args, "OO", &ref_stream_tmp, &cur_stream_tmp))
+    if (! PyArg_ParseTuple(args, "O!", &StreamType, &tmp))
         return PyInt_FromLong(-1); 
 
-    rsid = Stream_getStreamId(ref_stream_tmp);
-    csid = Stream_getStreamId(cur_stream_tmp);
-    
-    for (i=0; i<self->stream_count; i++) {
-        stream_tmp = (Stream *)PyList_GET_ITEM(self->streams, i);
-        sid = Stream_getStreamId(stream_tmp);
-        if (sid == csid) {
-            PySequence_DelItem(self->streams, i);
-            self->stream_count--;
-            break;
-        }
-    }
+    return Server_removeStream(self, (Stream *)tmp);
+}
 
-    for (i=0; i<self->stream_count; i++) {
-        stream_tmp = (Stream *)PyList_GET_ITEM(self->streams, i);
-        sid = Stream_getStreamId(stream_tmp);
-        if (sid == rsid) {
-            break;
-        }
-    }
+PyObject *
+Server_changeStreamPosition(Server *self, PyObject *args)
+{
+    Stream *ref_stream_tmp, *cur_stream_tmp;
+    int locked;
 
-    Py_INCREF(cur_stream_tmp);
-    err = PyList_Insert(self->streams, i, (PyObject *)cur_stream_tmp);
-    self->stream_count++;
+    if (! PyArg_ParseTuple(args, "O!O!", &StreamType, &ref_stream_tmp, &StreamType, &cur_stream_tmp))
+        return PyInt_FromLong(-1); 
+
+    locked = Server_lockBlocks((PyObject *)self);
+    PyoStreamTable_moveBefore(self->streams, cur_stream_tmp, ref_stream_tmp);
+    Server_graphChanged((PyObject *)self);
+    Server_unlockBlocks((PyObject *)self, locked);
 
     Py_INCREF(Py_None);
     return Py_None;    
 }
 
+void
+Server_graphChanged(PyObject *self)
+{
+    if (self != NULL && ((Server *)self)->scheduler != NULL)
+        PyoScheduler_invalidate(((Server *)self)->scheduler);
+}
+
 MYFLT *
 Server_getInputBuffer(Server *self) {
     return (MYFLT *)self->input_buffer;
 }
 
+PyoFramePool *
+Server_getFramePool(PyObject *self) {
+    return self != NULL ? ((Server *)self)->framepool : NULL;
+}
+
 PmEvent *
 Server_getMidiEventBuffer(Server *self) {
     return (PmEvent *)self->midiEvents;
@@ -2044,6 +3149,89 @@ Server_getBufferSize(Server *self)
     return PyInt_FromLong(self->bufferSize);
 }
 
+static PyObject *
+Server_profileToDict(PyoProfile *profile)
+{
+    int i, last;
+    PyObject *dict, *histo;
+
+    for (last=PYO_PROFILE_BINS; last>0 && profile->histogram[last-1]==0; last--);
+    histo = PyList_New(last);
+    for (i=0; i<last; i++) {
+        PyList_SET_ITEM(histo, i, PyLong_FromUnsignedLongLong(profile->histogram[i]));
+    }
+    dict = Py_BuildValue("{s:K,s:K,s:K,s:d,s:N}", "calls", profile->calls, "cycles", profile->cycles,
+                         "worst", profile->worst, 
+                         "mean", profile->calls ? (double)profile->cycles / profile->calls : 0.0,
+                         "histogram", histo);
+    return dict;
+}
+
+static PyObject *
+Server_getProfile(Server *self)
+{
+    int i;
+    const char *name;
+    Stream *stream;
+    PyObject *profile, *objects, *callback, *key, *value;
+    double budget = self->bufferSize / self->samplingRate * self->cycleFrequency;
+
+    if (self->profiling == 0) {
+        Server_warning(self, "Profiling is not active, see Server.setProfiling.\n");
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+
+    objects = PyDict_New();
+    if (self->streams != NULL) {
+        for (i=0; i<self->streams->length; i++) {
+            stream = PyoStreamTable_streamAt(self->streams, i);
+            if (stream == NULL || stream->profile == NULL)
+                continue;
+            name = strrchr(Stream_getStreamObject(stream)->ob_type->tp_name, '.');
+            name = name == NULL ? Stream_getStreamObject(stream)->ob_type->tp_name : name + 1;
+            key = Py_BuildValue("(si)", name, Stream_getStreamId(stream));
+            value = Server_profileToDict(stream->profile);
+            PyDict_SetItem(objects, key, value);
+            Py_DECREF(key);
+            Py_DECREF(value);
+        }
+    }
+
+    callback = Server_profileToDict(&self->profile);
+    value = Py_BuildValue("d", self->profile.calls ? self->profile.cycles / (budget * self->profile.calls) : 0.0);
+    PyDict_SetItemString(callback, "load", value);
+    Py_DECREF(value);
+    value = PyLong_FromUnsignedLongLong(self->overruns);
+    PyDict_SetItemString(callback, "overruns", value);
+    Py_DECREF(value);
+    value = PyLong_FromUnsignedLongLong(self->xruns);
+    PyDict_SetItemString(callback, "xruns", value);
+    Py_DECREF(value);
+
+    profile = Py_BuildValue("{s:d,s:d,s:N,s:N}", "frequency", self->cycleFrequency, "budget", budget,
+                            "callback", callback, "objects", objects);
+    return profile;
+}
+
+static PyObject *
+Server_getDenormals(Server *self)
+{
+    if (self->countDenormals == 0) {
+        Server_warning(self, "Denormals counting is not active, see Server.setCountDenormals.\n");
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    return Py_BuildValue("{s:K,s:K,s:K,s:i}", "samples", self->denormals, "blocks", self->denormalBlocks,
+                         "checked", self->checkedBlocks, "flush", self->flushDenormals);
+}
+
+static PyObject *
+Server_getRealtimeFactor(Server *self)
+{
+    return PyFloat_FromDouble(self->offlineFactor);
+}
+
 static PyObject *
 Server_getIsStarted(Server *self)
 {
@@ -2053,8 +3241,9 @@ Server_getIsStarted(Server *self)
 static PyObject *
 Server_getStreams(Server *self)
 {
-    Py_INCREF(self->streams);
-    return self->streams;
+    if (self->streams == NULL)
+        return PyList_New(0);
+    return PyoStreamTable_getList(self->streams);
 }
 
 
@@ -2068,20 +3257,32 @@ static PyMethodDef Server_methods[] = {
     {"setNchnls", (PyCFunction)Server_setNchnls, METH_O, "Sets the server's number of channels."},
     {"setDuplex", (PyCFunction)Server_setDuplex, METH_O, "Sets the server's duplex mode (0 = only out, 1 = in/out)."},
     {"setAmp", (PyCFunction)Server_setAmp, METH_O, "Sets the overall amplitude."},
+    {"setCommandDelay", (PyCFunction)Server_setCommandDelay, METH_O, "Sets the delay, in seconds, before the parameter changes are applied."},
+    {"setCurrent", (PyCFunction)Server_setCurrent, METH_O, "If True, the objects created by the calling thread are attached to this Server, otherwise to the main Server."},
+    {"setGILFree", (PyCFunction)Server_setGILFree, METH_O, "Computes the blocks without holding the GIL, the Python callbacks run on a control thread."},
     {"setAmpCallable", (PyCFunction)Server_setAmpCallable, METH_O, "Sets the Server's GUI object."},
     {"setTimeCallable", (PyCFunction)Server_setTimeCallable, METH_O, "Sets the Server's TIME object."},
+    {"setMetering", (PyCFunction)Server_setMetering, METH_O, "Turns the meters on or off."},
+    {"addMeter", (PyCFunction)Server_addMeter, METH_VARARGS, "Meters a stream."},
+    {"removeMeter", (PyCFunction)Server_removeMeter, METH_VARARGS, "Stops metering a stream."},
+    {"getMeters", (PyCFunction)Server_getMeters, METH_NOARGS, "Returns the latest readings of the meters."},
     {"setVerbosity", (PyCFunction)Server_setVerbosity, METH_O, "Sets the verbosity."},
     {"setStartOffset", (PyCFunction)Server_setStartOffset, METH_O, "Sets starting time offset."},
+    {"setThreads", (PyCFunction)Server_setThreads, METH_O, "Sets the number of threads used to compute the audio streams."},
+    {"setFFTThreads", (PyCFunction)Server_setFFTThreads, METH_O, "Sets the number of threads computing the transforms of the FFT objects."},
+    {"setDiskBuffer", (PyCFunction)Server_setDiskBuffer, METH_O, "Sets the duration, in seconds, of the sound file streaming buffers."},
+    {"setDiskThreads", (PyCFunction)Server_setDiskThreads, METH_O, "Sets the number of threads reading the streamed sound files."},
     {"boot", (PyCFunction)Server_boot, METH_NOARGS, "Setup and boot the server."},
     {"shutdown", (PyCFunction)Server_shut_down, METH_NOARGS, "Shut down the server."},
     {"start", (PyCFunction)Server_start, METH_NOARGS, "Starts the server's callback loop."},
     {"stop", (PyCFunction)Server_stop, METH_NOARGS, "Stops the server's callback loop."},
     {"recordOptions", (PyCFunction)Server_recordOptions, METH_VARARGS|METH_KEYWORDS, "Sets format settings for offline rendering and global recording."},
     {"recstart", (PyCFunction)Server_start_rec, METH_VARARGS|METH_KEYWORDS, "Start automatic output recording."},
+    {"getRecordOverflows", (PyCFunction)Server_getRecordOverflows, METH_NOARGS, "Returns the overflow counters of the current or last recording."},
     {"recstop", (PyCFunction)Server_stop_rec, METH_NOARGS, "Stop automatic output recording."},
     {"addStream", (PyCFunction)Server_addStream, METH_VARARGS, "Adds an audio stream to the server. \
                                                                 This is for internal use and must never be called by the user."},
-    {"removeStream", (PyCFunction)Server_removeStream, METH_VARARGS, "Adds an audio stream to the server. \
+    {"removeStream", (PyCFunction)Server_removeStreamFromPython, METH_VARARGS, "Adds an audio stream to the server. \
                                                                 This is for internal use and must never be called by the user."},
     {"changeStreamPosition", (PyCFunction)Server_changeStreamPosition, METH_VARARGS, "Puts an audio stream before another in the stack. \
                                                                 This is for internal use and must never be called by the user."},
@@ -2089,12 +3290,22 @@ static PyMethodDef Server_methods[] = {
     {"getSamplingRate", (PyCFunction)Server_getSamplingRate, METH_NOARGS, "Returns the server's sampling rate."},
     {"getNchnls", (PyCFunction)Server_getNchnls, METH_NOARGS, "Returns the server's current number of channels."},
     {"getBufferSize", (PyCFunction)Server_getBufferSize, METH_NOARGS, "Returns the server's buffer size."},
+    {"setProfiling", (PyCFunction)Server_setProfiling, METH_O, "Starts or stops the measure of the time spent by each object."},
+    {"getProfile", (PyCFunction)Server_getProfile, METH_NOARGS, "Returns the time spent by each object and by the whole callback."},
+    {"setFlushDenormals", (PyCFunction)Server_setFlushDenormals, METH_O, "Computes the blocks in flush-to-zero mode or not."},
+    {"setCountDenormals", (PyCFunction)Server_setCountDenormals, METH_O, "Starts or stops counting the subnormal samples produced by the objects."},
+    {"getDenormals", (PyCFunction)Server_getDenormals, METH_NOARGS, "Returns the subnormal samples counters."},
+    {"getRealtimeFactor", (PyCFunction)Server_getRealtimeFactor, METH_NOARGS, "Returns the speed, relative to real time, of the last offline rendering."},
     {"getIsStarted", (PyCFunction)Server_getIsStarted, METH_NOARGS, "Returns 1 if the server is started, otherwise returns 0."},
     {NULL}  /* Sentinel */
 };
 
 static PyMemberDef Server_members[] = {
-    {"streams", T_OBJECT_EX, offsetof(Server, streams), 0, "Server's streams list."},
+    {NULL}  /* Sentinel */
+};
+
+static PyGetSetDef Server_getsets[] = {
+    {"streams", (getter)Server_getStreams, NULL, "Server's streams list.", NULL},
     {NULL}  /* Sentinel */
 };
 
@@ -2129,7 +3340,7 @@ PyTypeObject ServerType = {
     0,		               /* tp_iternext */
     Server_methods,             /* tp_methods */
     Server_members,             /* tp_members */
-    0,                      /* tp_getset */
+    Server_getsets,                      /* tp_getset */
     0,                         /* tp_base */
     0,                         /* tp_dict */
     0,                         /* tp_descr_get */
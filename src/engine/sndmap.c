@@ -0,0 +1,559 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include <Python.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sndmap.h"
+#include "sndfile.h"
+
+void
+PyoSndMap_getRange(MYFLT start, MYFLT stop, int sr, long frames, long *first, long *last)
+{
+    if (stop <= 0 || stop <= start || (stop*sr) > frames)
+        *last = frames;
+    else
+        *last = (unsigned int)(stop * sr);
+
+    if (start < 0 || (start*sr) > frames)
+        *first = 0;
+    else
+        *first = (unsigned int)(start * sr);
+}
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+#define PYO_SNDMAP_MAGIC "PYOSND1"
+#define PYO_SNDMAP_HEADER_SIZE 4096 /* bytes, keeps the samples page aligned */
+#define PYO_SNDMAP_CHUNK 65536 /* frames decoded at once */
+
+struct _PyoSndMap {
+    /* identity of the sound file */
+    dev_t dev;
+    ino_t ino;
+    off_t fsize;
+    time_t mtime;
+    long first;
+    long last;
+    /* content */
+    int sr;
+    int channels;
+    long size; /* frames per channel, without the guard point */
+    void *base;
+    size_t length;
+    MYFLT *data; /* first channel, the others follow every size+1 samples */
+    int refcount;
+    struct _PyoSndMap *next;
+};
+
+/* Header of a cache file, followed by the samples at PYO_SNDMAP_HEADER_SIZE. */
+typedef struct {
+    char magic[8];
+    int myflt;
+    int sr;
+    int channels;
+    int reserved;
+    long long first;
+    long long last;
+    long long fsize;
+    long long mtime;
+    long long dev;
+    long long ino;
+} PyoSndMapHeader;
+
+/* Guards sndmap_list and the refcounts, files are decoded outside of it. */
+static pthread_mutex_t sndmap_lock = PTHREAD_MUTEX_INITIALIZER;
+static PyoSndMap *sndmap_list = NULL;
+static int sndmap_serial = 0; /* distinct temporary names for threads writing the same cache */
+
+static int
+PyoSndMap_isBigEndian(void)
+{
+    union { int i; char c[sizeof(int)]; } u;
+    u.i = 1;
+    return u.c[0] == 0;
+}
+
+static unsigned long
+PyoSndMap_le(const unsigned char *p, int bytes)
+{
+    unsigned long v = 0;
+    while (bytes-- > 0)
+        v = (v << 8) | p[bytes];
+    return v;
+}
+
+static unsigned long
+PyoSndMap_be(const unsigned char *p, int bytes)
+{
+    unsigned long v = 0;
+    int i;
+    for (i=0; i<bytes; i++)
+        v = (v << 8) | p[i];
+    return v;
+}
+
+/* Finds where the samples of a WAV or AIFF-C file start, if they are stored as
+   MYFLTs in the native byte order. Returns -1 if the file can't be mapped as is. */
+static int
+PyoSndMap_probe(int fd, off_t fsize, int channels, long frames, off_t *offset)
+{
+    unsigned char h[40];
+    unsigned long len, tag;
+    off_t pos = 12;
+    int fmt = 0, bytes = sizeof(MYFLT);
+
+    *offset = -1;
+    if (pread(fd, h, 12, 0) != 12)
+        return -1;
+
+    if (memcmp(h, "RIFF", 4) == 0 && memcmp(h+8, "WAVE", 4) == 0) {
+        if (PyoSndMap_isBigEndian())
+            return -1;
+        while (*offset < 0 && pos + 8 <= fsize) {
+            if (pread(fd, h, 8, pos) != 8)
+                return -1;
+            len = PyoSndMap_le(h+4, 4);
+            if (memcmp(h, "fmt ", 4) == 0) {
+                if (len < 16 || len > 40 || pread(fd, h, len, pos+8) != (ssize_t)len)
+                    return -1;
+                tag = PyoSndMap_le(h, 2);
+                if (tag == 0xFFFE && len >= 26) /* WAVE_FORMAT_EXTENSIBLE, look at the sub format */
+                    tag = PyoSndMap_le(h+24, 2);
+                if (tag != 3 || PyoSndMap_le(h+2, 2) != channels || 
+                    PyoSndMap_le(h+12, 2) != channels * bytes || PyoSndMap_le(h+14, 2) != 8 * bytes)
+                    return -1;
+                fmt = 1;
+            }
+            else if (memcmp(h, "data", 4) == 0 && fmt)
+                *offset = pos + 8;
+            pos += 8 + len + (len & 1);
+        }
+    }
+    else if (memcmp(h, "FORM", 4) == 0 && memcmp(h+8, "AIFC", 4) == 0) {
+        if (!PyoSndMap_isBigEndian())
+            return -1;
+        while (*offset < 0 && pos + 8 <= fsize) {
+            if (pread(fd, h, 8, pos) != 8)
+                return -1;
+            len = PyoSndMap_be(h+4, 4);
+            if (memcmp(h, "COMM", 4) == 0) {
+                if (len < 22 || pread(fd, h, 22, pos+8) != 22)
+                    return -1;
+                if (PyoSndMap_be(h, 2) != channels || PyoSndMap_be(h+6, 2) != 8 * bytes ||
+                    (bytes == 4 && memcmp(h+18, "fl32", 4) != 0 && memcmp(h+18, "FL32", 4) != 0) ||
+                    (bytes == 8 && memcmp(h+18, "fl64", 4) != 0 && memcmp(h+18, "FL64", 4) != 0))
+                    return -1;
+                fmt = 1;
+            }
+            else if (memcmp(h, "SSND", 4) == 0 && fmt) {
+                if (pread(fd, h, 4, pos+8) != 4)
+                    return -1;
+                *offset = pos + 16 + PyoSndMap_be(h, 4);
+            }
+            pos += 8 + len + (len & 1);
+        }
+    }
+
+    if (*offset < 0 || *offset % bytes != 0 || *offset + (off_t)frames * channels * bytes > fsize)
+        return -1;
+    return 0;
+}
+
+/* Maps the samples of a mono file in place. The mapping is one page longer
+   than the file when needed, so the guard point never falls beyond its end. */
+static int
+PyoSndMap_mapInPlace(PyoSndMap *self, int fd, off_t offset)
+{
+    long page = sysconf(_SC_PAGESIZE);
+    off_t aligned = offset - offset % page;
+    size_t delta = offset - aligned, filelen;
+    void *base;
+
+    self->length = delta + (self->size + 1) * sizeof(MYFLT);
+    self->length = (self->length + page - 1) / page * page;
+    base = mmap(NULL, self->length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return -1;
+    filelen = self->fsize - aligned;
+    if (filelen > self->length)
+        filelen = self->length;
+    if (mmap(base, filelen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, aligned) == MAP_FAILED) {
+        munmap(base, self->length);
+        return -1;
+    }
+    self->base = base;
+    self->data = (MYFLT *)((char *)base + delta);
+    self->data[self->size] = self->data[0];
+    return 0;
+}
+
+/* Decodes the region in planar channels, followed by their guard point, into
+   `data` or, if `fd` is not -1, into the cache file `fd` after its header. */
+static int
+PyoSndMap_decode(PyoSndMap *self, SNDFILE *sf, MYFLT *data, int fd)
+{
+    long done, n, got, i, stride = self->size + 1;
+    int c, err = 0, chnls = self->channels;
+    size_t bytes;
+    off_t where;
+    MYFLT *buf, *plane, *first;
+
+    buf = (MYFLT *)malloc(PYO_SNDMAP_CHUNK * (chnls + 1) * sizeof(MYFLT));
+    first = (MYFLT *)calloc(chnls, sizeof(MYFLT));
+    if (buf == NULL || first == NULL) {
+        free(buf);
+        free(first);
+        return -1;
+    }
+    plane = buf + PYO_SNDMAP_CHUNK * chnls;
+
+    sf_seek(sf, self->first, SEEK_SET);
+    for (done=0; done<self->size && err == 0; done+=n) {
+        n = self->size - done;
+        if (n > PYO_SNDMAP_CHUNK)
+            n = PYO_SNDMAP_CHUNK;
+        got = SF_READ(sf, buf, n * chnls) / chnls;
+        if (got < 0)
+            got = 0;
+        if (got < n)
+            memset(buf + got * chnls, 0, (n - got) * chnls * sizeof(MYFLT));
+        for (c=0; c<chnls; c++) {
+            for (i=0; i<n; i++)
+                plane[i] = buf[i*chnls+c];
+            if (done == 0)
+                first[c] = plane[0];
+            if (fd == -1)
+                memcpy(data + c * stride + done, plane, n * sizeof(MYFLT));
+            else {
+                bytes = n * sizeof(MYFLT);
+                where = PYO_SNDMAP_HEADER_SIZE + (off_t)(c * stride + done) * sizeof(MYFLT);
+                if (pwrite(fd, plane, bytes, where) != (ssize_t)bytes)
+                    err = -1;
+            }
+        }
+    }
+
+    for (c=0; c<chnls && err == 0; c++) {
+        if (fd == -1)
+            data[c * stride + self->size] = first[c];
+        else {
+            where = PYO_SNDMAP_HEADER_SIZE + (off_t)(c * stride + self->size) * sizeof(MYFLT);
+            if (pwrite(fd, &first[c], sizeof(MYFLT), where) != sizeof(MYFLT))
+                err = -1;
+        }
+    }
+
+    free(buf);
+    free(first);
+    return err;
+}
+
+static size_t
+PyoSndMap_dataLength(PyoSndMap *self)
+{
+    return (size_t)self->channels * (self->size + 1) * sizeof(MYFLT);
+}
+
+static void
+PyoSndMap_fillHeader(PyoSndMap *self, PyoSndMapHeader *hd)
+{
+    memset(hd, 0, sizeof(PyoSndMapHeader));
+    memcpy(hd->magic, PYO_SNDMAP_MAGIC, 8);
+    hd->myflt = sizeof(MYFLT);
+    hd->sr = self->sr;
+    hd->channels = self->channels;
+    hd->first = self->first;
+    hd->last = self->last;
+    hd->fsize = self->fsize;
+    hd->mtime = self->mtime;
+    hd->dev = self->dev;
+    hd->ino = self->ino;
+}
+
+/* Builds the name of the cache file of the region, creating the cache
+   directory if needed. */
+static int
+PyoSndMap_cacheName(PyoSndMap *self, char *name, size_t len)
+{
+    char dir[1024], *env, *p;
+
+    if ((env = getenv("PYO_CACHE_DIR")) != NULL && *env)
+        snprintf(dir, sizeof(dir), "%s", env);
+    else if ((env = getenv("XDG_CACHE_HOME")) != NULL && *env)
+        snprintf(dir, sizeof(dir), "%s/pyo", env);
+    else if ((env = getenv("HOME")) != NULL && *env)
+        snprintf(dir, sizeof(dir), "%s/.cache/pyo", env);
+    else
+        return -1;
+
+    for (p=dir+1; *p; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            mkdir(dir, 0755);
+            *p = '/';
+        }
+    }
+    if (mkdir(dir, 0755) != 0 && errno != EEXIST)
+        return -1;
+
+    snprintf(name, len, "%s/%llx-%llx-%ld-%ld.f%d", dir, (unsigned long long)self->dev, 
+             (unsigned long long)self->ino, self->first, self->last, (int)(8 * sizeof(MYFLT)));
+    return 0;
+}
+
+/* Maps the cache file `name` if it was decoded from the same sound. */
+static int
+PyoSndMap_mapCache(PyoSndMap *self, const char *name)
+{
+    PyoSndMapHeader hd, expected;
+    struct stat st;
+    void *base;
+    int fd;
+
+    fd = open(name, O_RDONLY);
+    if (fd < 0)
+        return -1;
+    PyoSndMap_fillHeader(self, &expected);
+    if (pread(fd, &hd, sizeof(hd), 0) != sizeof(hd) || memcmp(&hd, &expected, sizeof(hd)) != 0 ||
+        fstat(fd, &st) != 0 || st.st_size != PYO_SNDMAP_HEADER_SIZE + (off_t)PyoSndMap_dataLength(self)) {
+        close(fd);
+        return -1;
+    }
+    base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return -1;
+    self->base = base;
+    self->length = st.st_size;
+    self->data = (MYFLT *)((char *)base + PYO_SNDMAP_HEADER_SIZE);
+    return 0;
+}
+
+/* Decodes the region into a new cache file, renamed to `name` once complete. */
+static int
+PyoSndMap_writeCache(PyoSndMap *self, SNDFILE *sf, const char *name)
+{
+    PyoSndMapHeader hd;
+    char tmp[1300];
+    int fd, err;
+
+    snprintf(tmp, sizeof(tmp), "%s.%d.%d.tmp", name, (int)getpid(), __sync_fetch_and_add(&sndmap_serial, 1));
+    fd = open(tmp, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return -1;
+    PyoSndMap_fillHeader(self, &hd);
+    err = ftruncate(fd, PYO_SNDMAP_HEADER_SIZE + (off_t)PyoSndMap_dataLength(self));
+    if (err == 0)
+        err = PyoSndMap_decode(self, sf, NULL, fd);
+    if (err == 0 && pwrite(fd, &hd, sizeof(hd), 0) != sizeof(hd))
+        err = -1;
+    if (close(fd) != 0)
+        err = -1;
+    if (err == 0)
+        err = rename(tmp, name);
+    if (err != 0)
+        unlink(tmp);
+    return err;
+}
+
+/* Last resort, the decoded region is kept in anonymous memory. */
+static int
+PyoSndMap_mapAnonymous(PyoSndMap *self, SNDFILE *sf)
+{
+    void *base;
+
+    self->length = PyoSndMap_dataLength(self);
+    base = mmap(NULL, self->length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+        return -1;
+    if (PyoSndMap_decode(self, sf, (MYFLT *)base, -1) != 0) {
+        munmap(base, self->length);
+        return -1;
+    }
+    self->base = base;
+    self->data = (MYFLT *)base;
+    return 0;
+}
+
+static int
+PyoSndMap_same(PyoSndMap *a, PyoSndMap *b)
+{
+    return a->dev == b->dev && a->ino == b->ino && a->fsize == b->fsize && a->mtime == b->mtime &&
+           a->first == b->first && a->last == b->last;
+}
+
+/* Returns a new reference to the map of the same region, NULL if there is none. Called with the lock held. */
+static PyoSndMap *
+PyoSndMap_find(PyoSndMap *self)
+{
+    PyoSndMap *map;
+    for (map=sndmap_list; map!=NULL; map=map->next) {
+        if (PyoSndMap_same(map, self)) {
+            map->refcount++;
+            return map;
+        }
+    }
+    return NULL;
+}
+
+PyoSndMap *
+PyoSndMap_acquire(const char *path, MYFLT start, MYFLT stop)
+{
+    struct stat st;
+    SF_INFO info;
+    SNDFILE *sf;
+    PyoSndMap *self, *map;
+    off_t offset;
+    int fd;
+    char name[1200];
+
+    if (stat(path, &st) != 0)
+        return NULL;
+    info.format = 0;
+    sf = sf_open(path, SFM_READ, &info);
+    if (sf == NULL)
+        return NULL;
+
+    self = (PyoSndMap *)calloc(1, sizeof(PyoSndMap));
+    self->dev = st.st_dev;
+    self->ino = st.st_ino;
+    self->fsize = st.st_size;
+    self->mtime = st.st_mtime;
+    self->sr = info.samplerate;
+    self->channels = info.channels;
+    PyoSndMap_getRange(start, stop, self->sr, (long)info.frames, &self->first, &self->last);
+    self->size = self->last - self->first;
+    self->refcount = 1;
+
+    pthread_mutex_lock(&sndmap_lock);
+    map = PyoSndMap_find(self);
+    pthread_mutex_unlock(&sndmap_lock);
+    if (map != NULL) {
+        sf_close(sf);
+        free(self);
+        return map;
+    }
+
+    if (self->channels == 1 && self->first == 0 && self->last == info.frames) {
+        fd = open(path, O_RDONLY);
+        if (fd >= 0) {
+            if (PyoSndMap_probe(fd, st.st_size, 1, self->size, &offset) == 0)
+                PyoSndMap_mapInPlace(self, fd, offset);
+            close(fd);
+        }
+    }
+    if (self->base == NULL && PyoSndMap_cacheName(self, name, sizeof(name)) == 0) {
+        if (PyoSndMap_mapCache(self, name) != 0 && PyoSndMap_writeCache(self, sf, name) == 0)
+            PyoSndMap_mapCache(self, name);
+    }
+    if (self->base == NULL)
+        PyoSndMap_mapAnonymous(self, sf);
+    sf_close(sf);
+
+    if (self->base == NULL) {
+        free(self);
+        return NULL;
+    }
+
+    /* Another thread may have loaded the same region meanwhile, the first one inserted is shared. */
+    pthread_mutex_lock(&sndmap_lock);
+    map = PyoSndMap_find(self);
+    if (map == NULL) {
+        self->next = sndmap_list;
+        sndmap_list = self;
+    }
+    pthread_mutex_unlock(&sndmap_lock);
+    if (map != NULL) {
+        munmap(self->base, self->length);
+        free(self);
+        return map;
+    }
+    return self;
+}
+
+void
+PyoSndMap_release(PyoSndMap *self)
+{
+    PyoSndMap **p;
+
+    if (self == NULL)
+        return;
+    pthread_mutex_lock(&sndmap_lock);
+    if (--self->refcount == 0) {
+        for (p=&sndmap_list; *p!=NULL; p=&(*p)->next) {
+            if (*p == self) {
+                *p = self->next;
+                break;
+            }
+        }
+        munmap(self->base, self->length);
+        free(self);
+    }
+    pthread_mutex_unlock(&sndmap_lock);
+}
+
+MYFLT *
+PyoSndMap_getData(PyoSndMap *self, int chnl)
+{
+    if (chnl < 0)
+        chnl = 0;
+    return self->data + (chnl % self->channels) * (self->size + 1);
+}
+
+int
+PyoSndMap_getSize(PyoSndMap *self)
+{
+    return (int)self->size;
+}
+
+int
+PyoSndMap_getSamplingRate(PyoSndMap *self)
+{
+    return self->sr;
+}
+
+#else
+
+/* No mapping on Windows, SndTable falls back to reading the whole sound. */
+struct _PyoSndMap {
+    int unused;
+};
+
+PyoSndMap * PyoSndMap_acquire(const char *path, MYFLT start, MYFLT stop) { return NULL; }
+void PyoSndMap_release(PyoSndMap *self) {}
+MYFLT * PyoSndMap_getData(PyoSndMap *self, int chnl) { return NULL; }
+int PyoSndMap_getSize(PyoSndMap *self) { return 0; }
+int PyoSndMap_getSamplingRate(PyoSndMap *self) { return 0; }
+
+#endif
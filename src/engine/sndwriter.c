@@ -0,0 +1,283 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#if defined(__linux__)
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include "sndwriter.h"
+
+/* Reserves the disk space of the next writes, the file size doesn't change. */
+static void
+PyoSndWriter_reserve(PyoSndWriter *self, long long bytes)
+{
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+    if (self->fd < 0 || self->written + bytes <= self->reserved)
+        return;
+    if (fallocate(self->fd, FALLOC_FL_KEEP_SIZE, self->reserved, self->reserve_step + bytes) == 0)
+        self->reserved += self->reserve_step + bytes;
+    else
+        self->fd = -1; /* not supported by the filesystem */
+#endif
+}
+
+static void *
+PyoSndWriter_run(void *arg)
+{
+    PyoSndWriter *self = (PyoSndWriter *)arg;
+    unsigned int head;
+    int i, n, chunk, frames;
+    sf_count_t done;
+    struct timeval now;
+    struct timespec until;
+
+    for (;;) {
+        head = self->head;
+        __sync_synchronize();
+        if (head != self->tail) {
+            /* Every chunk waiting up to the end of the ring, in one call. Only the
+               last chunk handed over may be partial. */
+            chunk = self->tail % self->nchunks;
+            n = head - self->tail;
+            if (n > self->nchunks - chunk)
+                n = self->nchunks - chunk;
+            frames = 0;
+            for (i=0; i<n; i++)
+                frames += self->frames[chunk+i];
+            PyoSndWriter_reserve(self, (long long)frames * self->disk_frame_size);
+            if (self->flags & PYO_SNDWRITER_DOUBLE)
+                done = sf_writef_double(self->sf, (double *)(self->chunks + (size_t)chunk * self->chunk_frames * self->frame_size), frames);
+            else
+                done = sf_writef_float(self->sf, (float *)(self->chunks + (size_t)chunk * self->chunk_frames * self->frame_size), frames);
+            if (done != frames)
+                self->error = 1;
+            self->written += (long long)frames * self->disk_frame_size;
+            for (i=0; i<n; i++)
+                self->frames[chunk+i] = 0;
+            __sync_synchronize();
+            self->tail += n;
+            if ((self->flags & PYO_SNDWRITER_REALTIME) == 0) {
+                pthread_mutex_lock(&self->lock);
+                pthread_cond_broadcast(&self->cond);
+                pthread_mutex_unlock(&self->lock);
+            }
+            continue;
+        }
+        if (self->closing) {
+            /* The last chunk may have been handed over just before. */
+            __sync_synchronize();
+            if (self->head == self->tail)
+                break;
+            continue;
+        }
+        /* A realtime caller signals without the lock, a signal may be missed. */
+        pthread_mutex_lock(&self->lock);
+        if (self->head == self->tail && !self->closing) {
+            gettimeofday(&now, NULL);
+            until.tv_sec = now.tv_sec;
+            until.tv_nsec = now.tv_usec * 1000 + 5000000;
+            if (until.tv_nsec >= 1000000000) {
+                until.tv_sec++;
+                until.tv_nsec -= 1000000000;
+            }
+            pthread_cond_timedwait(&self->cond, &self->lock, &until);
+        }
+        pthread_mutex_unlock(&self->lock);
+    }
+    return NULL;
+}
+
+/* Gives back the space reserved past the end of the file, once it is closed. */
+static void
+PyoSndWriter_release(PyoSndWriter *self, int fd)
+{
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+    struct stat st;
+
+    if (fd < 0)
+        return;
+    if (fstat(fd, &st) == 0 && self->reserved > st.st_size)
+        fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, st.st_size, self->reserved - st.st_size);
+    close(fd);
+#endif
+}
+
+PyoSndWriter *
+PyoSndWriter_new(SNDFILE *sf, int nchnls, int chunk_frames, int nchunks, int flags)
+{
+    PyoSndWriter *self = (PyoSndWriter *)calloc(1, sizeof(PyoSndWriter));
+
+    self->sf = sf;
+    self->fd = -1;
+    self->nchnls = nchnls;
+    self->chunk_frames = chunk_frames;
+    self->nchunks = nchunks;
+    self->flags = flags;
+    self->frame_size = nchnls * ((flags & PYO_SNDWRITER_DOUBLE) ? sizeof(double) : sizeof(float));
+    self->chunks = (char *)calloc((size_t)nchunks * chunk_frames, self->frame_size);
+    self->frames = (int *)calloc(nchunks, sizeof(int));
+    self->disk_frame_size = self->frame_size;
+    pthread_mutex_init(&self->lock, NULL);
+    pthread_cond_init(&self->cond, NULL);
+    if (self->chunks == NULL || pthread_create(&self->thread, NULL, PyoSndWriter_run, self) != 0) {
+        pthread_mutex_destroy(&self->lock);
+        pthread_cond_destroy(&self->cond);
+        free(self->chunks);
+        free(self->frames);
+        free(self);
+        return NULL;
+    }
+    return self;
+}
+
+/* Bytes of a sample in the file. */
+static int
+PyoSndWriter_sampleSize(int format)
+{
+    switch (format & SF_FORMAT_SUBMASK) {
+        case SF_FORMAT_PCM_S8:
+        case SF_FORMAT_PCM_U8:
+            return 1;
+        case SF_FORMAT_PCM_16:
+            return 2;
+        case SF_FORMAT_PCM_24:
+            return 3;
+        case SF_FORMAT_DOUBLE:
+            return 8;
+        default:
+            return 4;
+    }
+}
+
+PyoSndWriter *
+PyoSndWriter_open(const char *path, SF_INFO *info, int chunk_frames, int nchunks, int flags)
+{
+    SNDFILE *sf;
+    PyoSndWriter *self;
+    int fd = -1;
+
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+    fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return NULL;
+    if ((sf = sf_open_fd(fd, SFM_WRITE, info, 1)) == NULL) {
+        close(fd);
+        return NULL;
+    }
+#else
+    if ((sf = sf_open(path, SFM_WRITE, info)) == NULL)
+        return NULL;
+#endif
+    if ((self = PyoSndWriter_new(sf, info->channels, chunk_frames, nchunks, flags)) == NULL) {
+        sf_close(sf);
+        return NULL;
+    }
+    self->fd = fd;
+    self->disk_frame_size = info->channels * PyoSndWriter_sampleSize(info->format);
+    self->reserve_step = (long long)PYO_SNDWRITER_RESERVE * info->samplerate * self->disk_frame_size;
+    return self;
+}
+
+/* Hands the chunk being filled to the writer thread. */
+static void
+PyoSndWriter_push(PyoSndWriter *self)
+{
+    __sync_synchronize();
+    self->head++;
+    if (self->flags & PYO_SNDWRITER_REALTIME)
+        pthread_cond_signal(&self->cond);
+    else {
+        pthread_mutex_lock(&self->lock);
+        pthread_cond_broadcast(&self->cond);
+        pthread_mutex_unlock(&self->lock);
+    }
+}
+
+void
+PyoSndWriter_write(PyoSndWriter *self, const void *data, int frames)
+{
+    int n, chunk;
+    const char *src = (const char *)data;
+
+    while (frames > 0) {
+        if (self->head - self->tail == (unsigned int)self->nchunks) {
+            if (self->flags & PYO_SNDWRITER_REALTIME) {
+                self->overflows++;
+                self->dropped += frames;
+                return;
+            }
+            pthread_mutex_lock(&self->lock);
+            while (self->head - self->tail == (unsigned int)self->nchunks)
+                pthread_cond_wait(&self->cond, &self->lock);
+            pthread_mutex_unlock(&self->lock);
+        }
+        __sync_synchronize();
+        chunk = self->head % self->nchunks;
+        n = self->chunk_frames - self->frames[chunk];
+        if (n > frames)
+            n = frames;
+        memcpy(self->chunks + ((size_t)chunk * self->chunk_frames + self->frames[chunk]) * self->frame_size, src, (size_t)n * self->frame_size);
+        self->frames[chunk] += n;
+        src += (size_t)n * self->frame_size;
+        frames -= n;
+        if (self->frames[chunk] == self->chunk_frames)
+            PyoSndWriter_push(self);
+    }
+}
+
+void
+PyoSndWriter_getOverflows(PyoSndWriter *self, unsigned long *overflows, unsigned long long *dropped)
+{
+    *overflows = self->overflows;
+    *dropped = self->dropped;
+}
+
+int
+PyoSndWriter_close(PyoSndWriter *self)
+{
+    int err, fd = -1;
+
+    if (self->head - self->tail < (unsigned int)self->nchunks && self->frames[self->head % self->nchunks] > 0)
+        PyoSndWriter_push(self);
+    pthread_mutex_lock(&self->lock);
+    self->closing = 1;
+    pthread_cond_broadcast(&self->cond);
+    pthread_mutex_unlock(&self->lock);
+    pthread_join(self->thread, NULL);
+
+    err = self->error ? -1 : 0;
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+    if (self->fd >= 0 && self->reserved > 0)
+        fd = dup(self->fd);
+#endif
+    sf_close(self->sf);
+    PyoSndWriter_release(self, fd);
+    pthread_mutex_destroy(&self->lock);
+    pthread_cond_destroy(&self->cond);
+    free(self->chunks);
+    free(self->frames);
+    free(self);
+    return err;
+}
@@ -19,15 +19,41 @@
  *************************************************************************/
 
 #include <Python.h>
+#include <pthread.h>
 #include "structmember.h"
 #include "pyomodule.h"
 
 #define __STREAM_MODULE
 #include "streammodule.h"
 #undef __STREAM_MODULE
+#include "servermodule.h"
 
 int stream_id = 1;
 
+/* Probe of the calling thread, called with every stream whose data is read while a
+   scheduler records its graph. stream_probing counts the threads having one, so the
+   thread-specific lookup is skipped when no graph is recorded. */
+static pthread_key_t stream_probe_key;
+static pthread_once_t stream_probe_once = PTHREAD_ONCE_INIT;
+static int stream_probing = 0;
+
+static void
+Stream_createProbeKey(void)
+{
+    pthread_key_create(&stream_probe_key, NULL);
+}
+
+static inline void
+Stream_probe(Stream *self)
+{
+    StreamProbe *probe;
+    if (__atomic_load_n(&stream_probing, __ATOMIC_RELAXED) == 0)
+        return;
+    probe = (StreamProbe *)pthread_getspecific(stream_probe_key);
+    if (probe != NULL)
+        (*probe->func)(probe->arg, self);
+}
+
 int 
 Stream_getNewStreamId() 
 {
@@ -38,6 +64,7 @@ static void
 Stream_dealloc(Stream* self)
 {
     free(self->data);
+    free(self->profile);
     Py_XDECREF(self->streamobject);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -108,6 +135,24 @@ Stream_getStreamToDac(Stream *self)
     return self->todac;
 }
 
+int
+Stream_getStreamSerial(Stream *self)
+{
+    return self->serial;
+}
+
+int
+Stream_getStreamSlot(Stream *self)
+{
+    return self->slot;
+}
+
+int
+Stream_getStreamPython(Stream *self)
+{
+    return self->python;
+}
+
 int
 Stream_getBufferCountWait(Stream *self)
 {
@@ -123,9 +168,30 @@ Stream_getDuration(Stream *self)
 MYFLT *
 Stream_getData(Stream *self)
 {
+    Stream_probe(self);
     return (MYFLT *)self->data;
 }    
 
+/* Signals a read of self's internal buffers by another object (main/child pairs). */
+void
+Stream_touch(Stream *self)
+{
+    Stream_probe(self);
+}    
+
+void
+Stream_setProbe(StreamProbe *probe)
+{
+    StreamProbe *old;
+    pthread_once(&stream_probe_once, Stream_createProbeKey);
+    old = (StreamProbe *)pthread_getspecific(stream_probe_key);
+    pthread_setspecific(stream_probe_key, probe);
+    if (probe != NULL && old == NULL)
+        __atomic_fetch_add(&stream_probing, 1, __ATOMIC_RELAXED);
+    else if (probe == NULL && old != NULL)
+        __atomic_fetch_sub(&stream_probing, 1, __ATOMIC_RELAXED);
+}    
+
 void
 Stream_setData(Stream *self, MYFLT *data)
 {
@@ -137,11 +203,40 @@ void Stream_setFunctionPtr(Stream *self, void *ptr)
     self->funcptr = ptr;
 }
 
+/* Several Servers may be computing their blocks at the same time, see PyServer_get_server. */
+#define Stream_getServer(self) (((PyoAudioObject *)(self)->streamobject)->server)
+
 void Stream_callFunction(Stream *self)
 {
-    (*self->funcptr)(self->streamobject);
+    unsigned long long start;
+
+    if (self->python)
+        Server_enterPython(Stream_getServer(self));
+    if (self->profile == NULL)
+        (*self->funcptr)(self->streamobject);
+    else {
+        start = PyoProfile_now();
+        (*self->funcptr)(self->streamobject);
+        PyoProfile_add(self->profile, PyoProfile_now() - start);
+    }
+    if (self->python)
+        Server_leavePython(Stream_getServer(self));
 }    
 
+/* Starts (and resets) or stops the measure of the time spent in the callback. */
+void Stream_setProfiling(Stream *self, int active)
+{
+    if (active) {
+        if (self->profile == NULL)
+            self->profile = (PyoProfile *)malloc(sizeof(PyoProfile));
+        memset(self->profile, 0, sizeof(PyoProfile));
+    }
+    else {
+        free(self->profile);
+        self->profile = NULL;
+    }
+}
+
 void Stream_IncrementBufferCount(Stream *self) 
 {
     self->bufferCount++;
@@ -155,7 +250,9 @@ void Stream_IncrementDurationCount(Stream *self)
 {
     self->bufferCount++;
     if (self->bufferCount >= self->duration) {
+        Server_enterPython(Stream_getServer(self));
         PyObject_CallMethod((PyObject *)Stream_getStreamObject(self), "stop", NULL);
+        Server_leavePython(Stream_getServer(self));
         self->duration = self->bufferCount = 0;
     }
 }
@@ -0,0 +1,188 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include <Python.h>
+#include <stdlib.h>
+#include <string.h>
+#include "streamtable.h"
+
+PyoStreamTable *
+PyoStreamTable_new()
+{
+    PyoStreamTable *self = (PyoStreamTable *)calloc(1, sizeof(PyoStreamTable));
+    self->free_head = -1;
+    return self;
+}
+
+void
+PyoStreamTable_clear(PyoStreamTable *self)
+{
+    int i, slot;
+    for (i=0; i<self->length; i++) {
+        slot = self->order[i];
+        if (slot >= 0) {
+            Stream_setStreamSlot(self->stream[slot], -1);
+            Py_DECREF(self->stream[slot]);
+        }
+    }
+    for (i=0; i<self->size; i++) {
+        self->position[i] = -1;
+        self->next_free[i] = i + 1 < self->size ? i + 1 : -1;
+    }
+    self->free_head = self->size > 0 ? 0 : -1;
+    self->count = self->length = self->holes = 0;
+}
+
+void
+PyoStreamTable_free(PyoStreamTable *self)
+{
+    PyoStreamTable_clear(self);
+    free(self->stream);
+    free(self->funcptr);
+    free(self->object);
+    free(self->data);
+    free(self->position);
+    free(self->next_free);
+    free(self->order);
+    free(self);
+}
+
+static void
+PyoStreamTable_grow(PyoStreamTable *self)
+{
+    int i, oldsize = self->size;
+    self->size = oldsize == 0 ? 64 : oldsize * 2;
+    self->stream = (Stream **)realloc(self->stream, self->size * sizeof(Stream *));
+    self->funcptr = (void (**)())realloc(self->funcptr, self->size * sizeof(void (*)()));
+    self->object = (PyObject **)realloc(self->object, self->size * sizeof(PyObject *));
+    self->data = (MYFLT **)realloc(self->data, self->size * sizeof(MYFLT *));
+    self->position = (int *)realloc(self->position, self->size * sizeof(int));
+    self->next_free = (int *)realloc(self->next_free, self->size * sizeof(int));
+    for (i=oldsize; i<self->size; i++) {
+        self->position[i] = -1;
+        self->next_free[i] = i + 1 < self->size ? i + 1 : self->free_head;
+    }
+    self->free_head = oldsize;
+}
+
+int
+PyoStreamTable_compact(PyoStreamTable *self, int force)
+{
+    int i, j, slot;
+    if (self->holes == 0 || (!force && (self->holes * 4) < self->length))
+        return 0;
+    for (i=0, j=0; i<self->length; i++) {
+        slot = self->order[i];
+        if (slot >= 0) {
+            self->order[j] = slot;
+            self->position[slot] = j++;
+        }
+    }
+    self->length = j;
+    self->holes = 0;
+    return 1;
+}
+
+int
+PyoStreamTable_add(PyoStreamTable *self, Stream *stream)
+{
+    int slot;
+
+    if (Stream_getStreamSlot(stream) >= 0)
+        return -1;
+    if (self->free_head < 0)
+        PyoStreamTable_grow(self);
+    /* Never compacts here, streams can be added while the server iterates over the table. */
+    if (self->length == self->order_size) {
+        self->order_size = self->order_size == 0 ? 64 : self->order_size * 2;
+        self->order = (int *)realloc(self->order, self->order_size * sizeof(int));
+    }
+
+    slot = self->free_head;
+    self->free_head = self->next_free[slot];
+    Py_INCREF(stream);
+    self->stream[slot] = stream;
+    self->funcptr[slot] = stream->funcptr;
+    self->object[slot] = stream->streamobject;
+    self->data[slot] = stream->data;
+    self->position[slot] = self->length;
+    self->order[self->length++] = slot;
+    self->count++;
+    Stream_setStreamSlot(stream, slot);
+    return slot;
+}
+
+int
+PyoStreamTable_remove(PyoStreamTable *self, Stream *stream)
+{
+    int slot = Stream_getStreamSlot(stream);
+
+    if (slot < 0 || slot >= self->size || self->stream[slot] != stream)
+        return -1;
+    self->order[self->position[slot]] = -1;
+    self->holes++;
+    self->position[slot] = -1;
+    self->next_free[slot] = self->free_head;
+    self->free_head = slot;
+    self->count--;
+    Stream_setStreamSlot(stream, -1);
+    Py_DECREF(stream);
+    return 0;
+}
+
+int
+PyoStreamTable_moveBefore(PyoStreamTable *self, Stream *stream, Stream *ref)
+{
+    int from, to, slot = Stream_getStreamSlot(stream), refslot = Stream_getStreamSlot(ref);
+
+    if (slot < 0 || slot == refslot)
+        return -1;
+    PyoStreamTable_compact(self, 1);
+    from = self->position[slot];
+    /* Unknown reference, the stream goes at the end. */
+    to = refslot >= 0 ? self->position[refslot] : self->length;
+    if (from < to) {
+        memmove(&self->order[from], &self->order[from+1], (to - from - 1) * sizeof(int));
+        to--;
+    }
+    else
+        memmove(&self->order[to+1], &self->order[to], (from - to) * sizeof(int));
+    self->order[to] = slot;
+    for (from=0; from<self->length; from++) {
+        self->position[self->order[from]] = from;
+    }
+    return 0;
+}
+
+PyObject *
+PyoStreamTable_getList(PyoStreamTable *self)
+{
+    int i, j;
+    Stream *stream;
+    PyObject *list = PyList_New(self->count);
+    for (i=0, j=0; i<self->length; i++) {
+        stream = PyoStreamTable_streamAt(self, i);
+        if (stream != NULL) {
+            Py_INCREF(stream);
+            PyList_SET_ITEM(list, j++, (PyObject *)stream);
+        }
+    }
+    return list;
+}
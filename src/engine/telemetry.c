@@ -0,0 +1,232 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "telemetry.h"
+
+PyoTelemetry *
+PyoTelemetry_new(int nchnls, int period, int size)
+{
+    int n = 1;
+    PyoTelemetry *self = (PyoTelemetry *)calloc(1, sizeof(PyoTelemetry));
+
+    while (n < size)
+        n <<= 1;
+    self->ring = (PyoMeterRecord *)calloc(n, sizeof(PyoMeterRecord));
+    self->mask = n - 1;
+    self->period = period > 0 ? period : 1;
+    self->nchnls = nchnls;
+    self->peaks = (float *)calloc(nchnls, sizeof(float));
+    self->sums = (double *)calloc(nchnls, sizeof(double));
+    self->outputs = (PyoMeterRecord *)calloc(nchnls, sizeof(PyoMeterRecord));
+    pthread_mutex_init(&self->lock, NULL);
+    return self;
+}
+
+void
+PyoTelemetry_free(PyoTelemetry *self)
+{
+    if (self == NULL)
+        return;
+    pthread_mutex_destroy(&self->lock);
+    free(self->ring);
+    free(self->stream_ids);
+    free(self->stream_data);
+    free(self->peaks);
+    free(self->sums);
+    free(self->outputs);
+    free(self->streams);
+    free(self);
+}
+
+static void
+PyoTelemetry_push(PyoTelemetry *self, int kind, int index, float peak, double sum, int samples, unsigned long long time)
+{
+    unsigned int head = self->head;
+    PyoMeterRecord *rec;
+
+    if (head - self->tail > self->mask) {
+        self->dropped++;
+        return;
+    }
+    rec = &self->ring[head & self->mask];
+    rec->time = time;
+    rec->kind = kind;
+    rec->index = index;
+    rec->peak = peak;
+    rec->rms = (float)sqrt(sum / samples);
+    /* The record must be visible before the new head. */
+    __sync_synchronize();
+    self->head = head + 1;
+}
+
+void
+PyoTelemetry_process(PyoTelemetry *self, float *out, int size, unsigned long long time)
+{
+    int i, j, nchnls = self->nchnls, samples;
+    float x, peak;
+    double sum;
+    MYFLT *data;
+
+    for (j=0; j<nchnls; j++) {
+        peak = self->peaks[j];
+        sum = 0.0;
+        for (i=0; i<size; i++) {
+            x = out[i*nchnls+j];
+            sum += x * x;
+            x = x < 0.0f ? -x : x;
+            if (x > peak)
+                peak = x;
+        }
+        self->peaks[j] = peak;
+        self->sums[j] += sum;
+    }
+    for (j=0; j<self->num_streams; j++) {
+        data = self->stream_data[j];
+        peak = self->peaks[nchnls+j];
+        sum = 0.0;
+        for (i=0; i<size; i++) {
+            x = (float)data[i];
+            sum += x * x;
+            x = x < 0.0f ? -x : x;
+            if (x > peak)
+                peak = x;
+        }
+        self->peaks[nchnls+j] = peak;
+        self->sums[nchnls+j] += sum;
+    }
+    if (++self->count < self->period)
+        return;
+    samples = self->count * size;
+    for (j=0; j<nchnls; j++)
+        PyoTelemetry_push(self, PYO_METER_OUTPUT, j, self->peaks[j], self->sums[j], samples, time);
+    for (j=0; j<self->num_streams; j++)
+        PyoTelemetry_push(self, PYO_METER_STREAM, self->stream_ids[j], self->peaks[nchnls+j], self->sums[nchnls+j], samples, time);
+    memset(self->peaks, 0, (nchnls + self->num_streams) * sizeof(float));
+    memset(self->sums, 0, (nchnls + self->num_streams) * sizeof(double));
+    self->count = 0;
+}
+
+int
+PyoTelemetry_subscribe(PyoTelemetry *self, int id, MYFLT *data)
+{
+    int i, n = self->nchnls + self->num_streams;
+
+    for (i=0; i<self->num_streams; i++) {
+        if (self->stream_ids[i] == id)
+            return -1;
+    }
+    if (self->num_streams == self->max_streams) {
+        self->max_streams = self->max_streams ? self->max_streams * 2 : 8;
+        self->stream_ids = (int *)realloc(self->stream_ids, self->max_streams * sizeof(int));
+        self->stream_data = (MYFLT **)realloc(self->stream_data, self->max_streams * sizeof(MYFLT *));
+        self->peaks = (float *)realloc(self->peaks, (self->nchnls + self->max_streams) * sizeof(float));
+        self->sums = (double *)realloc(self->sums, (self->nchnls + self->max_streams) * sizeof(double));
+    }
+    self->stream_ids[self->num_streams] = id;
+    self->stream_data[self->num_streams] = data;
+    self->peaks[n] = 0.0f;
+    self->sums[n] = 0.0;
+    self->num_streams++;
+    return 0;
+}
+
+int
+PyoTelemetry_unsubscribe(PyoTelemetry *self, int id)
+{
+    int i, j, nchnls = self->nchnls;
+
+    for (i=0; i<self->num_streams; i++) {
+        if (self->stream_ids[i] == id)
+            break;
+    }
+    if (i == self->num_streams)
+        return -1;
+    for (j=i+1; j<self->num_streams; j++) {
+        self->stream_ids[j-1] = self->stream_ids[j];
+        self->stream_data[j-1] = self->stream_data[j];
+        self->peaks[nchnls+j-1] = self->peaks[nchnls+j];
+        self->sums[nchnls+j-1] = self->sums[nchnls+j];
+    }
+    self->num_streams--;
+    return 0;
+}
+
+PyoMeterRecord *
+PyoTelemetry_latest(PyoTelemetry *self, int id)
+{
+    int i;
+
+    for (i=0; i<self->num_latest; i++) {
+        if (self->streams[i].index == id)
+            return &self->streams[i];
+    }
+    return NULL;
+}
+
+void
+PyoTelemetry_forget(PyoTelemetry *self, int id)
+{
+    PyoMeterRecord *rec = PyoTelemetry_latest(self, id);
+
+    if (rec != NULL)
+        *rec = self->streams[--self->num_latest];
+}
+
+int
+PyoTelemetry_drain(PyoTelemetry *self)
+{
+    int count = 0;
+    unsigned int tail;
+    PyoMeterRecord rec, *latest;
+
+    pthread_mutex_lock(&self->lock);
+    tail = self->tail;
+    while (tail != self->head) {
+        __sync_synchronize();
+        rec = self->ring[tail & self->mask];
+        /* The slot must be read before the audio thread can reuse it. */
+        __sync_synchronize();
+        self->tail = ++tail;
+        count++;
+        if (rec.kind == PYO_METER_OUTPUT) {
+            if (rec.index < self->nchnls)
+                self->outputs[rec.index] = rec;
+        }
+        else {
+            latest = PyoTelemetry_latest(self, rec.index);
+            if (latest == NULL) {
+                if (self->num_latest == self->max_latest) {
+                    self->max_latest = self->max_latest ? self->max_latest * 2 : 8;
+                    self->streams = (PyoMeterRecord *)realloc(self->streams, self->max_latest * sizeof(PyoMeterRecord));
+                }
+                latest = &self->streams[self->num_latest++];
+            }
+            *latest = rec;
+        }
+        if (rec.time > self->time)
+            self->time = rec.time;
+    }
+    pthread_mutex_unlock(&self->lock);
+    return count;
+}
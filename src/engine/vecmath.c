@@ -0,0 +1,655 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include "pyomodule.h"
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#if defined(__SSE2__)
+#define PYO_VEC_SSE2
+#endif
+#if defined(__clang__) || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#define PYO_VEC_AVX2
+#endif
+#if defined(PYO_VEC_SSE2) || defined(PYO_VEC_AVX2)
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define PYO_VEC_NEON
+#include <arm_neon.h>
+#endif
+
+/* Constants of the fast approximations. VM_ROUND rounds to the nearest integer
+** when added and subtracted. Adding VM_EXP_BIAS to an integer n leaves n plus
+** the exponent bias in the low bits of the mantissa, shifting them by
+** VM_MANT_BITS gives 2^n. sin and cos use Taylor polynomials on [-pi/2, pi/2],
+** exp uses one on [-ln(2)/2, ln(2)/2] and atan one on [-tan(pi/8), tan(pi/8)]. */
+#ifndef USE_DOUBLE
+typedef uint32_t vm_uint;
+#define VM_ROUND 12582912.0f
+#define VM_EXP_BIAS 8388735.0f
+#define VM_MANT_BITS 23
+#define VM_EXP_MIN -126.0f
+#define VM_EXP_MAX 127.0f
+#define VM_TANH_MAX 9.0f
+#define VM_TINY 1.0e-30f
+#define VM_TWOPI_HI 6.28125f
+#define VM_TWOPI_LO 1.9353071795864769e-3f
+static const MYFLT vm_sin_coeffs[] = {-1.0f/6.0f, 1.0f/120.0f, -1.0f/5040.0f, 1.0f/362880.0f, -1.0f/39916800.0f};
+static const MYFLT vm_exp_coeffs[] = {1.0f, 1.0f, 1.0f/2.0f, 1.0f/6.0f, 1.0f/24.0f, 1.0f/120.0f, 1.0f/720.0f, 1.0f/5040.0f};
+static const MYFLT vm_atan_coeffs[] = {-3.33329491539e-1f, 1.99777106478e-1f, -1.38776856032e-1f, 8.05374449538e-2f};
+#else
+typedef uint64_t vm_uint;
+#define VM_ROUND 6755399441055744.0
+#define VM_EXP_BIAS 4503599627371519.0
+#define VM_MANT_BITS 52
+#define VM_EXP_MIN -1022.0
+#define VM_EXP_MAX 1023.0
+#define VM_TANH_MAX 19.0
+#define VM_TINY 1.0e-300
+#define VM_TWOPI_HI 6.2831854820251465
+#define VM_TWOPI_LO -1.7484556000744883e-07
+static const MYFLT vm_sin_coeffs[] = {-1.0/6.0, 1.0/120.0, -1.0/5040.0, 1.0/362880.0, -1.0/39916800.0,
+                                      1.0/6227020800.0, -1.0/1307674368000.0, 1.0/355687428096000.0,
+                                      -1.0/121645100408832000.0, 1.0/51090942171709440000.0};
+static const MYFLT vm_exp_coeffs[] = {1.0, 1.0, 1.0/2.0, 1.0/6.0, 1.0/24.0, 1.0/120.0, 1.0/720.0, 1.0/5040.0,
+                                      1.0/40320.0, 1.0/362880.0, 1.0/3628800.0, 1.0/39916800.0, 1.0/479001600.0,
+                                      1.0/6227020800.0};
+static const MYFLT vm_atan_coeffs[] = {-1.0/3.0, 1.0/5.0, -1.0/7.0, 1.0/9.0, -1.0/11.0, 1.0/13.0, -1.0/15.0, 1.0/17.0,
+                                       -1.0/19.0, 1.0/21.0, -1.0/23.0, 1.0/25.0, -1.0/27.0, 1.0/29.0, -1.0/31.0,
+                                       1.0/33.0, -1.0/35.0};
+#endif
+#define VM_SIN_TERMS (int)(sizeof(vm_sin_coeffs) / sizeof(MYFLT))
+#define VM_EXP_TERMS (int)(sizeof(vm_exp_coeffs) / sizeof(MYFLT))
+#define VM_ATAN_TERMS (int)(sizeof(vm_atan_coeffs) / sizeof(MYFLT))
+#define VM_LN2 0.69314718055994530942
+#define VM_LOG2E 1.44269504088896340736
+#define VM_TAN_PI8 0.41421356237309504880
+
+/*** Exact kernels ***/
+static void
+sin_c(MYFLT *out, MYFLT *in, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        out[i] = MYSIN(in[i]);
+}
+
+static void
+cos_c(MYFLT *out, MYFLT *in, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        out[i] = MYCOS(in[i]);
+}
+
+static void
+sincos_c(MYFLT *s, MYFLT *c, MYFLT *in, int size)
+{
+    int i;
+    MYFLT x;
+    for (i=0; i<size; i++) {
+        x = in[i];
+        s[i] = MYSIN(x);
+        c[i] = MYCOS(x);
+    }
+}
+
+static void
+exp_c(MYFLT *out, MYFLT *in, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        out[i] = MYEXP(in[i]);
+}
+
+static void
+pow_c(MYFLT *out, MYFLT base, MYFLT *in, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        out[i] = MYPOW(base, in[i]);
+}
+
+static void
+tanh_c(MYFLT *out, MYFLT *in, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        out[i] = MYTANH(in[i]);
+}
+
+static void
+atan2_c(MYFLT *out, MYFLT *y, MYFLT *x, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        out[i] = MYATAN2(y[i], x[i]);
+}
+
+/* Builds the fast kernels of an instruction set from its V_* operations (see
+** vecops.c) and V_MIN, V_MAX, V_ABS, V_COPYSIGN(x, s) (|x| with the sign of s),
+** V_SELGT(a, b, t, f) (a > b ? t : f) and V_POW2N(n) (2^n for an integer n).
+** The scalar instantiation handles the tails of the vector ones, all of them
+** use the same operations so a value does not depend on its position. */
+#define VEC_MATH_KERNELS(SFX, ATTR) \
+ATTR static inline V_TYPE \
+vm_poly_##SFX(V_TYPE z, const MYFLT *coeffs, int n) \
+{ \
+    V_TYPE p = V_SET1(coeffs[n-1]); \
+    for (n-=2; n>=0; n--) \
+        p = V_ADD(V_MUL(p, z), V_SET1(coeffs[n])); \
+    return p; \
+} \
+ATTR static inline V_TYPE \
+vm_sin_##SFX(V_TYPE x) \
+{ \
+    V_TYPE n, z; \
+    n = V_SUB(V_ADD(V_MUL(x, V_SET1((MYFLT)(1.0 / TWOPI))), V_SET1(VM_ROUND)), V_SET1(VM_ROUND)); \
+    x = V_SUB(V_SUB(x, V_MUL(n, V_SET1(VM_TWOPI_HI))), V_MUL(n, V_SET1(VM_TWOPI_LO))); \
+    x = V_MIN(x, V_SUB(V_SET1((MYFLT)PI), x)); \
+    x = V_MAX(x, V_SUB(V_SET1((MYFLT)-PI), x)); \
+    z = V_MUL(x, x); \
+    return V_ADD(x, V_MUL(V_MUL(x, z), vm_poly_##SFX(z, vm_sin_coeffs, VM_SIN_TERMS))); \
+} \
+ATTR static inline V_TYPE \
+vm_exp2_##SFX(V_TYPE t) \
+{ \
+    V_TYPE n; \
+    t = V_MAX(V_MIN(t, V_SET1(VM_EXP_MAX)), V_SET1(VM_EXP_MIN)); \
+    n = V_SUB(V_ADD(t, V_SET1(VM_ROUND)), V_SET1(VM_ROUND)); \
+    t = V_MUL(V_SUB(t, n), V_SET1((MYFLT)VM_LN2)); \
+    return V_MUL(vm_poly_##SFX(t, vm_exp_coeffs, VM_EXP_TERMS), V_POW2N(n)); \
+} \
+ATTR static void \
+sin_fast_##SFX(MYFLT *out, MYFLT *in, int size) \
+{ \
+    int i = 0; \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(out+i, vm_sin_##SFX(V_LOAD(in+i))); \
+    if (i < size) \
+        sin_fast_c(out+i, in+i, size-i); \
+} \
+ATTR static void \
+cos_fast_##SFX(MYFLT *out, MYFLT *in, int size) \
+{ \
+    int i = 0; \
+    V_TYPE hp = V_SET1((MYFLT)(PI / 2)); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(out+i, vm_sin_##SFX(V_ADD(V_LOAD(in+i), hp))); \
+    if (i < size) \
+        cos_fast_c(out+i, in+i, size-i); \
+} \
+ATTR static void \
+sincos_fast_##SFX(MYFLT *s, MYFLT *c, MYFLT *in, int size) \
+{ \
+    int i = 0; \
+    V_TYPE x, hp = V_SET1((MYFLT)(PI / 2)); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) { \
+        x = V_LOAD(in+i); \
+        V_STORE(s+i, vm_sin_##SFX(x)); \
+        V_STORE(c+i, vm_sin_##SFX(V_ADD(x, hp))); \
+    } \
+    if (i < size) \
+        sincos_fast_c(s+i, c+i, in+i, size-i); \
+} \
+ATTR static void \
+exp_fast_##SFX(MYFLT *out, MYFLT *in, int size) \
+{ \
+    int i = 0; \
+    V_TYPE l = V_SET1((MYFLT)VM_LOG2E); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(out+i, vm_exp2_##SFX(V_MUL(V_LOAD(in+i), l))); \
+    if (i < size) \
+        exp_fast_c(out+i, in+i, size-i); \
+} \
+ATTR static void \
+pow_fast_##SFX(MYFLT *out, MYFLT base, MYFLT *in, int size) \
+{ \
+    int i = 0; \
+    V_TYPE l; \
+    if (base <= 0) { \
+        pow_c(out, base, in, size); \
+        return; \
+    } \
+    l = V_SET1(MYLOG(base) / MYLOG(2.0)); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(out+i, vm_exp2_##SFX(V_MUL(V_LOAD(in+i), l))); \
+    if (i < size) \
+        pow_fast_c(out+i, base, in+i, size-i); \
+} \
+ATTR static void \
+tanh_fast_##SFX(MYFLT *out, MYFLT *in, int size) \
+{ \
+    int i = 0; \
+    V_TYPE e, one = V_SET1(1.0), l = V_SET1((MYFLT)(2.0 * VM_LOG2E)); \
+    V_TYPE mx = V_SET1(VM_TANH_MAX), mn = V_SET1(-VM_TANH_MAX); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) { \
+        e = vm_exp2_##SFX(V_MUL(V_MAX(V_MIN(V_LOAD(in+i), mx), mn), l)); \
+        V_STORE(out+i, V_DIV(V_SUB(e, one), V_ADD(e, one))); \
+    } \
+    if (i < size) \
+        tanh_fast_c(out+i, in+i, size-i); \
+} \
+ATTR static void \
+atan2_fast_##SFX(MYFLT *out, MYFLT *y, MYFLT *x, int size) \
+{ \
+    int i = 0; \
+    V_TYPE vx, vy, ax, ay, t, u, a; \
+    V_TYPE zero = V_SET1(0.0), one = V_SET1(1.0), tp8 = V_SET1((MYFLT)VM_TAN_PI8); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) { \
+        vx = V_LOAD(x+i); \
+        vy = V_LOAD(y+i); \
+        ax = V_ABS(vx); \
+        ay = V_ABS(vy); \
+        t = V_DIV(V_MIN(ax, ay), V_MAX(V_MAX(ax, ay), V_SET1(VM_TINY))); \
+        u = V_SELGT(t, tp8, V_DIV(V_SUB(t, one), V_ADD(t, one)), t); \
+        a = V_MUL(u, u); \
+        a = V_ADD(u, V_MUL(V_MUL(u, a), vm_poly_##SFX(a, vm_atan_coeffs, VM_ATAN_TERMS))); \
+        a = V_ADD(a, V_SELGT(t, tp8, V_SET1((MYFLT)(PI / 4)), zero)); \
+        a = V_SELGT(ay, ax, V_SUB(V_SET1((MYFLT)(PI / 2)), a), a); \
+        a = V_SELGT(zero, vx, V_SUB(V_SET1((MYFLT)PI), a), a); \
+        V_STORE(out+i, V_COPYSIGN(a, vy)); \
+    } \
+    if (i < size) \
+        atan2_fast_c(out+i, y+i, x+i, size-i); \
+}
+
+#define VEC_MATH_SELECT(SFX) \
+    pyo_vec_sin = sin_##SFX; \
+    pyo_vec_cos = cos_##SFX; \
+    pyo_vec_sincos = sincos_##SFX; \
+    pyo_vec_exp = exp_##SFX; \
+    pyo_vec_pow = pow_##SFX; \
+    pyo_vec_tanh = tanh_##SFX; \
+    pyo_vec_atan2 = atan2_##SFX
+
+/*** Scalar ***/
+static inline MYFLT
+vm_min_c(MYFLT a, MYFLT b)
+{
+    return a < b ? a : b;
+}
+static inline MYFLT
+vm_max_c(MYFLT a, MYFLT b)
+{
+    return a > b ? a : b;
+}
+static inline MYFLT
+vm_abs_c(MYFLT x)
+{
+    return x < 0 ? -x : x;
+}
+static inline MYFLT
+vm_copysign_c(MYFLT x, MYFLT s)
+{
+    x = vm_abs_c(x);
+    return s < 0 ? -x : x;
+}
+static inline MYFLT
+vm_selgt_c(MYFLT a, MYFLT b, MYFLT t, MYFLT f)
+{
+    return a > b ? t : f;
+}
+static inline MYFLT
+vm_pow2n_c(MYFLT n)
+{
+    union { MYFLT f; vm_uint i; } u;
+    u.f = n + VM_EXP_BIAS;
+    u.i <<= VM_MANT_BITS;
+    return u.f;
+}
+#define V_TYPE MYFLT
+#define V_WIDTH 1
+#define V_LOAD(p) (*(p))
+#define V_STORE(p, x) (*(p) = (x))
+#define V_SET1(x) ((MYFLT)(x))
+#define V_MUL(a, b) ((a) * (b))
+#define V_ADD(a, b) ((a) + (b))
+#define V_SUB(a, b) ((a) - (b))
+#define V_DIV(a, b) ((a) / (b))
+#define V_MIN vm_min_c
+#define V_MAX vm_max_c
+#define V_ABS vm_abs_c
+#define V_COPYSIGN vm_copysign_c
+#define V_SELGT vm_selgt_c
+#define V_POW2N vm_pow2n_c
+VEC_MATH_KERNELS(c, )
+#undef V_TYPE
+#undef V_WIDTH
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_MUL
+#undef V_ADD
+#undef V_SUB
+#undef V_DIV
+#undef V_MIN
+#undef V_MAX
+#undef V_ABS
+#undef V_COPYSIGN
+#undef V_SELGT
+#undef V_POW2N
+
+/*** SSE2 ***/
+#ifdef PYO_VEC_SSE2
+#ifndef USE_DOUBLE
+#define V_TYPE __m128
+#define V_WIDTH 4
+#define V_LOAD _mm_loadu_ps
+#define V_STORE _mm_storeu_ps
+#define V_SET1 _mm_set1_ps
+#define V_MUL _mm_mul_ps
+#define V_ADD _mm_add_ps
+#define V_SUB _mm_sub_ps
+#define V_DIV _mm_div_ps
+#define V_MIN _mm_min_ps
+#define V_MAX _mm_max_ps
+static inline __m128
+abs_sse2(__m128 x)
+{
+    return _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+}
+static inline __m128
+copysign_sse2(__m128 x, __m128 s)
+{
+    __m128 sign = _mm_set1_ps(-0.0f);
+    return _mm_or_ps(_mm_andnot_ps(sign, x), _mm_and_ps(sign, s));
+}
+static inline __m128
+selgt_sse2(__m128 a, __m128 b, __m128 t, __m128 f)
+{
+    __m128 mask = _mm_cmpgt_ps(a, b);
+    return _mm_or_ps(_mm_and_ps(mask, t), _mm_andnot_ps(mask, f));
+}
+static inline __m128
+pow2n_sse2(__m128 n)
+{
+    return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(_mm_add_ps(n, _mm_set1_ps(VM_EXP_BIAS))), VM_MANT_BITS));
+}
+#else
+#define V_TYPE __m128d
+#define V_WIDTH 2
+#define V_LOAD _mm_loadu_pd
+#define V_STORE _mm_storeu_pd
+#define V_SET1 _mm_set1_pd
+#define V_MUL _mm_mul_pd
+#define V_ADD _mm_add_pd
+#define V_SUB _mm_sub_pd
+#define V_DIV _mm_div_pd
+#define V_MIN _mm_min_pd
+#define V_MAX _mm_max_pd
+static inline __m128d
+abs_sse2(__m128d x)
+{
+    return _mm_andnot_pd(_mm_set1_pd(-0.0), x);
+}
+static inline __m128d
+copysign_sse2(__m128d x, __m128d s)
+{
+    __m128d sign = _mm_set1_pd(-0.0);
+    return _mm_or_pd(_mm_andnot_pd(sign, x), _mm_and_pd(sign, s));
+}
+static inline __m128d
+selgt_sse2(__m128d a, __m128d b, __m128d t, __m128d f)
+{
+    __m128d mask = _mm_cmpgt_pd(a, b);
+    return _mm_or_pd(_mm_and_pd(mask, t), _mm_andnot_pd(mask, f));
+}
+static inline __m128d
+pow2n_sse2(__m128d n)
+{
+    return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(_mm_add_pd(n, _mm_set1_pd(VM_EXP_BIAS))), VM_MANT_BITS));
+}
+#endif
+#define V_ABS abs_sse2
+#define V_COPYSIGN copysign_sse2
+#define V_SELGT selgt_sse2
+#define V_POW2N pow2n_sse2
+VEC_MATH_KERNELS(sse2, )
+#undef V_TYPE
+#undef V_WIDTH
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_MUL
+#undef V_ADD
+#undef V_SUB
+#undef V_DIV
+#undef V_MIN
+#undef V_MAX
+#undef V_ABS
+#undef V_COPYSIGN
+#undef V_SELGT
+#undef V_POW2N
+#endif
+
+/*** AVX2 ***/
+#ifdef PYO_VEC_AVX2
+#define VEC_AVX2_ATTR __attribute__((target("avx2")))
+#ifndef USE_DOUBLE
+#define V_TYPE __m256
+#define V_WIDTH 8
+#define V_LOAD _mm256_loadu_ps
+#define V_STORE _mm256_storeu_ps
+#define V_SET1 _mm256_set1_ps
+#define V_MUL _mm256_mul_ps
+#define V_ADD _mm256_add_ps
+#define V_SUB _mm256_sub_ps
+#define V_DIV _mm256_div_ps
+#define V_MIN _mm256_min_ps
+#define V_MAX _mm256_max_ps
+VEC_AVX2_ATTR static inline __m256
+abs_avx2(__m256 x)
+{
+    return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+}
+VEC_AVX2_ATTR static inline __m256
+copysign_avx2(__m256 x, __m256 s)
+{
+    __m256 sign = _mm256_set1_ps(-0.0f);
+    return _mm256_or_ps(_mm256_andnot_ps(sign, x), _mm256_and_ps(sign, s));
+}
+VEC_AVX2_ATTR static inline __m256
+selgt_avx2(__m256 a, __m256 b, __m256 t, __m256 f)
+{
+    return _mm256_blendv_ps(f, t, _mm256_cmp_ps(a, b, _CMP_GT_OQ));
+}
+VEC_AVX2_ATTR static inline __m256
+pow2n_avx2(__m256 n)
+{
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(_mm256_add_ps(n, _mm256_set1_ps(VM_EXP_BIAS))), VM_MANT_BITS));
+}
+#else
+#define V_TYPE __m256d
+#define V_WIDTH 4
+#define V_LOAD _mm256_loadu_pd
+#define V_STORE _mm256_storeu_pd
+#define V_SET1 _mm256_set1_pd
+#define V_MUL _mm256_mul_pd
+#define V_ADD _mm256_add_pd
+#define V_SUB _mm256_sub_pd
+#define V_DIV _mm256_div_pd
+#define V_MIN _mm256_min_pd
+#define V_MAX _mm256_max_pd
+VEC_AVX2_ATTR static inline __m256d
+abs_avx2(__m256d x)
+{
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+}
+VEC_AVX2_ATTR static inline __m256d
+copysign_avx2(__m256d x, __m256d s)
+{
+    __m256d sign = _mm256_set1_pd(-0.0);
+    return _mm256_or_pd(_mm256_andnot_pd(sign, x), _mm256_and_pd(sign, s));
+}
+VEC_AVX2_ATTR static inline __m256d
+selgt_avx2(__m256d a, __m256d b, __m256d t, __m256d f)
+{
+    return _mm256_blendv_pd(f, t, _mm256_cmp_pd(a, b, _CMP_GT_OQ));
+}
+VEC_AVX2_ATTR static inline __m256d
+pow2n_avx2(__m256d n)
+{
+    return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(VM_EXP_BIAS))), VM_MANT_BITS));
+}
+#endif
+#define V_ABS abs_avx2
+#define V_COPYSIGN copysign_avx2
+#define V_SELGT selgt_avx2
+#define V_POW2N pow2n_avx2
+VEC_MATH_KERNELS(avx2, VEC_AVX2_ATTR)
+#undef V_TYPE
+#undef V_WIDTH
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_MUL
+#undef V_ADD
+#undef V_SUB
+#undef V_DIV
+#undef V_MIN
+#undef V_MAX
+#undef V_ABS
+#undef V_COPYSIGN
+#undef V_SELGT
+#undef V_POW2N
+#endif
+
+/*** NEON (AArch64) ***/
+#ifdef PYO_VEC_NEON
+#ifndef USE_DOUBLE
+#define V_TYPE float32x4_t
+#define V_WIDTH 4
+#define V_LOAD vld1q_f32
+#define V_STORE vst1q_f32
+#define V_SET1 vdupq_n_f32
+#define V_MUL vmulq_f32
+#define V_ADD vaddq_f32
+#define V_SUB vsubq_f32
+#define V_DIV vdivq_f32
+#define V_MIN vminq_f32
+#define V_MAX vmaxq_f32
+#define V_ABS vabsq_f32
+static inline float32x4_t
+copysign_neon(float32x4_t x, float32x4_t s)
+{
+    return vbslq_f32(vdupq_n_u32(0x80000000), s, vabsq_f32(x));
+}
+static inline float32x4_t
+selgt_neon(float32x4_t a, float32x4_t b, float32x4_t t, float32x4_t f)
+{
+    return vbslq_f32(vcgtq_f32(a, b), t, f);
+}
+static inline float32x4_t
+pow2n_neon(float32x4_t n)
+{
+    return vreinterpretq_f32_u32(vshlq_n_u32(vreinterpretq_u32_f32(vaddq_f32(n, vdupq_n_f32(VM_EXP_BIAS))), VM_MANT_BITS));
+}
+#else
+#define V_TYPE float64x2_t
+#define V_WIDTH 2
+#define V_LOAD vld1q_f64
+#define V_STORE vst1q_f64
+#define V_SET1 vdupq_n_f64
+#define V_MUL vmulq_f64
+#define V_ADD vaddq_f64
+#define V_SUB vsubq_f64
+#define V_DIV vdivq_f64
+#define V_MIN vminq_f64
+#define V_MAX vmaxq_f64
+#define V_ABS vabsq_f64
+static inline float64x2_t
+copysign_neon(float64x2_t x, float64x2_t s)
+{
+    return vbslq_f64(vdupq_n_u64(0x8000000000000000ULL), s, vabsq_f64(x));
+}
+static inline float64x2_t
+selgt_neon(float64x2_t a, float64x2_t b, float64x2_t t, float64x2_t f)
+{
+    return vbslq_f64(vcgtq_f64(a, b), t, f);
+}
+static inline float64x2_t
+pow2n_neon(float64x2_t n)
+{
+    return vreinterpretq_f64_u64(vshlq_n_u64(vreinterpretq_u64_f64(vaddq_f64(n, vdupq_n_f64(VM_EXP_BIAS))), VM_MANT_BITS));
+}
+#endif
+#define V_COPYSIGN copysign_neon
+#define V_SELGT selgt_neon
+#define V_POW2N pow2n_neon
+VEC_MATH_KERNELS(neon, )
+#undef V_TYPE
+#undef V_WIDTH
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_MUL
+#undef V_ADD
+#undef V_SUB
+#undef V_DIV
+#undef V_MIN
+#undef V_MAX
+#undef V_ABS
+#undef V_COPYSIGN
+#undef V_SELGT
+#undef V_POW2N
+#endif
+
+/*** Dispatch ***/
+void (*pyo_vec_sin)(MYFLT *out, MYFLT *in, int size) = sin_c;
+void (*pyo_vec_cos)(MYFLT *out, MYFLT *in, int size) = cos_c;
+void (*pyo_vec_sincos)(MYFLT *s, MYFLT *c, MYFLT *in, int size) = sincos_c;
+void (*pyo_vec_exp)(MYFLT *out, MYFLT *in, int size) = exp_c;
+void (*pyo_vec_pow)(MYFLT *out, MYFLT base, MYFLT *in, int size) = pow_c;
+void (*pyo_vec_tanh)(MYFLT *out, MYFLT *in, int size) = tanh_c;
+void (*pyo_vec_atan2)(MYFLT *out, MYFLT *y, MYFLT *x, int size) = atan2_c;
+
+static int pyo_vec_math_accuracy = PYO_MATH_EXACT;
+
+void
+pyo_vec_set_math_accuracy(int accuracy)
+{
+    if (accuracy != PYO_MATH_FAST) {
+        VEC_MATH_SELECT(c);
+        pyo_vec_math_accuracy = PYO_MATH_EXACT;
+        return;
+    }
+    VEC_MATH_SELECT(fast_c);
+#ifdef PYO_VEC_SSE2
+    VEC_MATH_SELECT(fast_sse2);
+#endif
+#ifdef PYO_VEC_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        VEC_MATH_SELECT(fast_avx2);
+    }
+#endif
+#ifdef PYO_VEC_NEON
+    VEC_MATH_SELECT(fast_neon);
+#endif
+    pyo_vec_math_accuracy = PYO_MATH_FAST;
+}
+
+int
+pyo_vec_get_math_accuracy(void)
+{
+    return pyo_vec_math_accuracy;
+}
@@ -0,0 +1,925 @@
+/*************************************************************************
+ * Copyright 2010 Olivier Belanger                                        *                  
+ *                                                                        * 
+ * This file is part of pyo, a python module to help digital signal       *
+ * processing script creation.                                            *  
+ *                                                                        * 
+ * pyo is free software: you can redistribute it and/or modify            *
+ * it under the terms of the GNU General Public License as published by   *
+ * the Free Software Foundation, either version 3 of the License, or      *
+ * (at your option) any later version.                                    * 
+ *                                                                        *
+ * pyo is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of         *    
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the          *
+ * GNU General Public License for more details.                           *
+ *                                                                        *
+ * You should have received a copy of the GNU General Public License      *
+ * along with pyo.  If not, see <http://www.gnu.org/licenses/>.           *
+ *************************************************************************/
+
+#include "pyomodule.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#if defined(__SSE2__)
+#define PYO_VEC_SSE2
+#endif
+#if defined(__clang__) || (__GNUC__ > 4) || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#define PYO_VEC_AVX2
+#endif
+#if defined(PYO_VEC_SSE2) || defined(PYO_VEC_AVX2)
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+/* Only AArch64 has vector division and double precision NEON. */
+#define PYO_VEC_NEON
+#include <arm_neon.h>
+#endif
+
+#define VEC_DIV_EPSILON 0.00001
+
+/*** Scalar kernels, also used for the tail of the vector versions ***/
+static void
+mul_scalar_add_c(MYFLT *data, MYFLT mul, MYFLT add, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        data[i] = mul * data[i] + add;
+}
+
+static void
+mul_add_scalar_c(MYFLT *data, MYFLT *mul, MYFLT add, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        data[i] = mul[i] * data[i] + add;
+}
+
+static void
+scalar_mul_add_c(MYFLT *data, MYFLT mul, MYFLT *add, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        data[i] = mul * data[i] + add[i];
+}
+
+static void
+muladd_c(MYFLT *data, MYFLT *mul, MYFLT *add, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        data[i] = mul[i] * data[i] + add[i];
+}
+
+static void
+scalar_mul_sub_c(MYFLT *data, MYFLT mul, MYFLT *sub, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        data[i] = mul * data[i] - sub[i];
+}
+
+static void
+mulsub_c(MYFLT *data, MYFLT *mul, MYFLT *sub, int size)
+{
+    int i;
+    for (i=0; i<size; i++)
+        data[i] = mul[i] * data[i] - sub[i];
+}
+
+static void
+div_add_scalar_c(MYFLT *data, MYFLT *div, MYFLT add, int size)
+{
+    int i;
+    MYFLT tmp;
+    for (i=0; i<size; i++) {
+        tmp = div[i];
+        if (tmp < VEC_DIV_EPSILON && tmp > -VEC_DIV_EPSILON)
+            tmp = VEC_DIV_EPSILON;
+        data[i] = data[i] / tmp + add;
+    }
+}
+
+static void
+divadd_c(MYFLT *data, MYFLT *div, MYFLT *add, int size)
+{
+    int i;
+    MYFLT tmp;
+    for (i=0; i<size; i++) {
+        tmp = div[i];
+        if (tmp < VEC_DIV_EPSILON && tmp > -VEC_DIV_EPSILON)
+            tmp = VEC_DIV_EPSILON;
+        data[i] = data[i] / tmp + add[i];
+    }
+}
+
+static void
+divsub_c(MYFLT *data, MYFLT *div, MYFLT *sub, int size)
+{
+    int i;
+    MYFLT tmp;
+    for (i=0; i<size; i++) {
+        tmp = div[i];
+        if (tmp < VEC_DIV_EPSILON && tmp > -VEC_DIV_EPSILON)
+            tmp = VEC_DIV_EPSILON;
+        data[i] = data[i] / tmp - sub[i];
+    }
+}
+
+static void
+mix_c(MYFLT *out, MYFLT **ins, MYFLT *gains, int num, int size)
+{
+    int i, j = 0;
+    MYFLT *a, *b, *c, *d, ga, gb, gc, gd;
+    for (; j<=num-4; j+=4) {
+        a = ins[j]; b = ins[j+1]; c = ins[j+2]; d = ins[j+3];
+        ga = gains[j]; gb = gains[j+1]; gc = gains[j+2]; gd = gains[j+3];
+        for (i=0; i<size; i++)
+            out[i] += (a[i] * ga + b[i] * gb) + (c[i] * gc + d[i] * gd);
+    }
+    for (; j<num; j++) {
+        a = ins[j]; ga = gains[j];
+        for (i=0; i<size; i++)
+            out[i] += a[i] * ga;
+    }
+}
+
+/* Wraps a table position in [0, size[, with no integer division. */
+static inline MYFLT
+osc_wrap(MYFLT pos, int size)
+{
+    pos -= size * MYFLOOR(pos / size);
+    if (pos < 0)
+        pos += size;
+    if (pos >= size)
+        pos -= size;
+    return pos;
+}
+
+static void
+osc_bank_c(MYFLT *out, MYFLT *table, int size, MYFLT *pos, MYFLT *inc, MYFLT *amp, int num, int bufsize)
+{
+    int i, j, ipart;
+    MYFLT p, x, y;
+    for (j=0; j<num; j++) {
+        p = pos[j];
+        for (i=0; i<bufsize; i++) {
+            if (p < 0 || p >= size)
+                p = osc_wrap(p, size);
+            ipart = (int)p;
+            x = table[ipart];
+            y = table[ipart+1];
+            out[i] += (x + (y - x) * (p - ipart)) * amp[j];
+            p += inc[j];
+        }
+        pos[j] = p;
+    }
+}
+
+/* Processes the lanes first to num - 1 of a biquad bank (vector versions handle
+** the remaining lanes with it). */
+static void
+biquad_bank_lanes_c(MYFLT *out, int outstride, MYFLT *in, int instride, MYFLT *coeffs, MYFLT *state, int num, int first, int stages, int size)
+{
+    int i, j, k;
+    MYFLT x, y, s1, s2, *c, *z, *o, *src;
+    for (j=first; j<num; j++) {
+        o = out + j * outstride;
+        src = in + j * instride;
+        for (i=0; i<size; i++)
+            o[i] = src[i];
+        for (k=0; k<stages; k++) {
+            c = coeffs + k * 5 * num + j;
+            z = state + k * 2 * num + j;
+            s1 = z[0];
+            s2 = z[num];
+            for (i=0; i<size; i++) {
+                x = o[i];
+                y = c[0] * x + s1;
+                s1 = c[num] * x - c[3*num] * y + s2;
+                s2 = c[2*num] * x - c[4*num] * y;
+                o[i] = y;
+            }
+            z[0] = s1;
+            z[num] = s2;
+        }
+    }
+}
+
+static void
+biquad_bank_c(MYFLT *out, int outstride, MYFLT *in, int instride, MYFLT *coeffs, MYFLT *state, int num, int stages, int size)
+{
+    biquad_bank_lanes_c(out, outstride, in, instride, coeffs, state, num, 0, stages, size);
+}
+
+/* Processes the sub-transforms q to s - 1 of a Stockham pass (vector versions
+** handle the remaining ones, or the whole pass when s is smaller than a vector). */
+static void
+fft_pass_lanes_c(MYFLT *yr, MYFLT *yi, MYFLT *xr, MYFLT *xi, MYFLT *w, int l, int s, int first)
+{
+    int p, q, i0, i1, i2, i3, o, l4 = l >> 2;
+    MYFLT ar, ai, br, bi, cr, ci, dr, di, apcr, apci, amcr, amci, bpdr, bpdi, bmdr, bmdi, tr, ti;
+    if (l == 2) {
+        for (q=first; q<s; q++) {
+            ar = xr[q]; ai = xi[q];
+            br = xr[q+s]; bi = xi[q+s];
+            yr[q] = ar + br; yi[q] = ai + bi;
+            yr[q+s] = ar - br; yi[q+s] = ai - bi;
+        }
+        return;
+    }
+    for (p=0; p<l4; p++, w+=6) {
+        for (q=first; q<s; q++) {
+            i0 = q + s * p; i1 = i0 + s * l4; i2 = i1 + s * l4; i3 = i2 + s * l4;
+            o = q + s * 4 * p;
+            ar = xr[i0]; ai = xi[i0]; br = xr[i1]; bi = xi[i1];
+            cr = xr[i2]; ci = xi[i2]; dr = xr[i3]; di = xi[i3];
+            apcr = ar + cr; apci = ai + ci; amcr = ar - cr; amci = ai - ci;
+            bpdr = br + dr; bpdi = bi + di; bmdr = br - dr; bmdi = bi - di;
+            yr[o] = apcr + bpdr; yi[o] = apci + bpdi;
+            tr = amcr + bmdi; ti = amci - bmdr;
+            yr[o+s] = w[0] * tr - w[1] * ti; yi[o+s] = w[0] * ti + w[1] * tr;
+            tr = apcr - bpdr; ti = apci - bpdi;
+            yr[o+2*s] = w[2] * tr - w[3] * ti; yi[o+2*s] = w[2] * ti + w[3] * tr;
+            tr = amcr - bmdi; ti = amci + bmdr;
+            yr[o+3*s] = w[4] * tr - w[5] * ti; yi[o+3*s] = w[4] * ti + w[5] * tr;
+        }
+    }
+}
+
+static void
+fft_pass_c(MYFLT *yr, MYFLT *yi, MYFLT *xr, MYFLT *xi, MYFLT *w, int l, int s)
+{
+    fft_pass_lanes_c(yr, yi, xr, xi, w, l, s, 0);
+}
+
+/* Renders the samples first to num - 1 of a grain (vector versions handle the remaining ones). */
+static void
+grain_lanes_c(MYFLT *out, int stride, int chnls, MYFLT *gains, MYFLT *table, MYFLT pos, MYFLT inc,
+              MYFLT *env, MYFLT epos, MYFLT einc, int first, int num)
+{
+    int i, c, ipart;
+    MYFLT p, val, amp;
+    for (i=first; i<num; i++) {
+        p = pos + inc * i;
+        ipart = (int)p;
+        val = table[ipart] + (table[ipart+1] - table[ipart]) * (p - ipart);
+        p = epos + einc * i;
+        ipart = (int)p;
+        amp = env[ipart] + (env[ipart+1] - env[ipart]) * (p - ipart);
+        val = val * amp;
+        for (c=0; c<chnls; c++)
+            out[c*stride+i] += val * gains[c];
+    }
+}
+
+static void
+grain_c(MYFLT *out, int stride, int chnls, MYFLT *gains, MYFLT *table, MYFLT pos, MYFLT inc,
+        MYFLT *env, MYFLT epos, MYFLT einc, int num)
+{
+    grain_lanes_c(out, stride, chnls, gains, table, pos, inc, env, epos, einc, 0, num);
+}
+
+/* Builds the ten vector kernels of an instruction set from its V_* operations.
+** V_CLAMP(x) must replace the lanes of x in ]-epsilon, epsilon[ by epsilon. */
+#define VEC_KERNELS(SFX, ATTR) \
+ATTR static void \
+mul_scalar_add_##SFX(MYFLT *data, MYFLT mul, MYFLT add, int size) \
+{ \
+    int i = 0; \
+    V_TYPE m = V_SET1(mul), a = V_SET1(add); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_ADD(V_MUL(m, V_LOAD(data+i)), a)); \
+    mul_scalar_add_c(data+i, mul, add, size-i); \
+} \
+ATTR static void \
+mul_add_scalar_##SFX(MYFLT *data, MYFLT *mul, MYFLT add, int size) \
+{ \
+    int i = 0; \
+    V_TYPE a = V_SET1(add); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_ADD(V_MUL(V_LOAD(mul+i), V_LOAD(data+i)), a)); \
+    mul_add_scalar_c(data+i, mul+i, add, size-i); \
+} \
+ATTR static void \
+scalar_mul_add_##SFX(MYFLT *data, MYFLT mul, MYFLT *add, int size) \
+{ \
+    int i = 0; \
+    V_TYPE m = V_SET1(mul); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_ADD(V_MUL(m, V_LOAD(data+i)), V_LOAD(add+i))); \
+    scalar_mul_add_c(data+i, mul, add+i, size-i); \
+} \
+ATTR static void \
+muladd_##SFX(MYFLT *data, MYFLT *mul, MYFLT *add, int size) \
+{ \
+    int i = 0; \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_ADD(V_MUL(V_LOAD(mul+i), V_LOAD(data+i)), V_LOAD(add+i))); \
+    muladd_c(data+i, mul+i, add+i, size-i); \
+} \
+ATTR static void \
+scalar_mul_sub_##SFX(MYFLT *data, MYFLT mul, MYFLT *sub, int size) \
+{ \
+    int i = 0; \
+    V_TYPE m = V_SET1(mul); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_SUB(V_MUL(m, V_LOAD(data+i)), V_LOAD(sub+i))); \
+    scalar_mul_sub_c(data+i, mul, sub+i, size-i); \
+} \
+ATTR static void \
+mulsub_##SFX(MYFLT *data, MYFLT *mul, MYFLT *sub, int size) \
+{ \
+    int i = 0; \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_SUB(V_MUL(V_LOAD(mul+i), V_LOAD(data+i)), V_LOAD(sub+i))); \
+    mulsub_c(data+i, mul+i, sub+i, size-i); \
+} \
+ATTR static void \
+div_add_scalar_##SFX(MYFLT *data, MYFLT *div, MYFLT add, int size) \
+{ \
+    int i = 0; \
+    V_TYPE a = V_SET1(add); \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_ADD(V_DIV(V_LOAD(data+i), V_CLAMP(V_LOAD(div+i))), a)); \
+    div_add_scalar_c(data+i, div+i, add, size-i); \
+} \
+ATTR static void \
+divadd_##SFX(MYFLT *data, MYFLT *div, MYFLT *add, int size) \
+{ \
+    int i = 0; \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_ADD(V_DIV(V_LOAD(data+i), V_CLAMP(V_LOAD(div+i))), V_LOAD(add+i))); \
+    divadd_c(data+i, div+i, add+i, size-i); \
+} \
+ATTR static void \
+divsub_##SFX(MYFLT *data, MYFLT *div, MYFLT *sub, int size) \
+{ \
+    int i = 0; \
+    for (; i<=size-V_WIDTH; i+=V_WIDTH) \
+        V_STORE(data+i, V_SUB(V_DIV(V_LOAD(data+i), V_CLAMP(V_LOAD(div+i))), V_LOAD(sub+i))); \
+    divsub_c(data+i, div+i, sub+i, size-i); \
+} \
+ATTR static void \
+mix_##SFX(MYFLT *out, MYFLT **ins, MYFLT *gains, int num, int size) \
+{ \
+    int i, j = 0; \
+    MYFLT *a, *b, *c, *d; \
+    V_TYPE ga, gb, gc, gd, acc; \
+    for (; j<=num-4; j+=4) { \
+        a = ins[j]; b = ins[j+1]; c = ins[j+2]; d = ins[j+3]; \
+        ga = V_SET1(gains[j]); gb = V_SET1(gains[j+1]); gc = V_SET1(gains[j+2]); gd = V_SET1(gains[j+3]); \
+        for (i=0; i<=size-V_WIDTH; i+=V_WIDTH) { \
+            acc = V_ADD(V_ADD(V_MUL(V_LOAD(a+i), ga), V_MUL(V_LOAD(b+i), gb)), \
+                        V_ADD(V_MUL(V_LOAD(c+i), gc), V_MUL(V_LOAD(d+i), gd))); \
+            V_STORE(out+i, V_ADD(V_LOAD(out+i), acc)); \
+        } \
+        for (; i<size; i++) \
+            out[i] += (a[i] * gains[j] + b[i] * gains[j+1]) + (c[i] * gains[j+2] + d[i] * gains[j+3]); \
+    } \
+    for (; j<num; j++) { \
+        a = ins[j]; \
+        ga = V_SET1(gains[j]); \
+        for (i=0; i<=size-V_WIDTH; i+=V_WIDTH) \
+            V_STORE(out+i, V_ADD(V_LOAD(out+i), V_MUL(V_LOAD(a+i), ga))); \
+        for (; i<size; i++) \
+            out[i] += a[i] * gains[j]; \
+    } \
+}
+
+/* Builds the oscillator bank kernel, one partial per lane, two vectors of partials
+** per pass so the horizontal sum of the lanes is shared. V_WRAP(p, size, 1/size)
+** wraps the positions in [0, size[, V_LOOKUP(table, p) returns the interpolated
+** table values and V_HSUM(x) returns the sum of the lanes. */
+#define VEC_OSC_BANK(SFX, ATTR) \
+ATTR static void \
+osc_bank_##SFX(MYFLT *out, MYFLT *table, int size, MYFLT *pos, MYFLT *inc, MYFLT *amp, int num, int bufsize) \
+{ \
+    int i, j = 0; \
+    V_TYPE p, n, a, p2, n2, a2, s = V_SET1((MYFLT)size), is = V_SET1((MYFLT)1.0 / size); \
+    for (; j<=num-2*V_WIDTH; j+=2*V_WIDTH) { \
+        p = V_LOAD(pos+j); \
+        n = V_LOAD(inc+j); \
+        a = V_LOAD(amp+j); \
+        p2 = V_LOAD(pos+j+V_WIDTH); \
+        n2 = V_LOAD(inc+j+V_WIDTH); \
+        a2 = V_LOAD(amp+j+V_WIDTH); \
+        for (i=0; i<bufsize; i++) { \
+            p = V_WRAP(p, s, is); \
+            p2 = V_WRAP(p2, s, is); \
+            out[i] += V_HSUM(V_ADD(V_MUL(V_LOOKUP(table, p), a), V_MUL(V_LOOKUP(table, p2), a2))); \
+            p = V_ADD(p, n); \
+            p2 = V_ADD(p2, n2); \
+        } \
+        V_STORE(pos+j, p); \
+        V_STORE(pos+j+V_WIDTH, p2); \
+    } \
+    for (; j<=num-V_WIDTH; j+=V_WIDTH) { \
+        p = V_LOAD(pos+j); \
+        n = V_LOAD(inc+j); \
+        a = V_LOAD(amp+j); \
+        for (i=0; i<bufsize; i++) { \
+            p = V_WRAP(p, s, is); \
+            out[i] += V_HSUM(V_MUL(V_LOOKUP(table, p), a)); \
+            p = V_ADD(p, n); \
+        } \
+        V_STORE(pos+j, p); \
+    } \
+    osc_bank_c(out, table, size, pos+j, inc+j, amp+j, num-j, bufsize); \
+}
+
+/* Builds the biquad bank kernel, one cascade per lane. The inputs of the lanes
+** are interleaved in a small buffer, which every stage filters in place, then
+** copied back to the lanes outputs. */
+#define VEC_BQ_CHUNK 64
+#define VEC_BIQUAD_BANK(SFX, ATTR) \
+ATTR static void \
+biquad_bank_##SFX(MYFLT *out, int outstride, MYFLT *in, int instride, MYFLT *coeffs, MYFLT *state, int num, int stages, int size) \
+{ \
+    int i, j = 0, k, l, n, start; \
+    MYFLT work[VEC_BQ_CHUNK * V_WIDTH], *c, *z; \
+    V_TYPE x, y, b0, b1, b2, a1, a2, s1, s2; \
+    for (; j<=num-V_WIDTH; j+=V_WIDTH) { \
+        for (start=0; start<size; start+=VEC_BQ_CHUNK) { \
+            n = size - start < VEC_BQ_CHUNK ? size - start : VEC_BQ_CHUNK; \
+            for (i=0; i<n; i++) { \
+                for (l=0; l<V_WIDTH; l++) \
+                    work[i*V_WIDTH+l] = in[(j+l)*instride+start+i]; \
+            } \
+            for (k=0; k<stages; k++) { \
+                c = coeffs + k * 5 * num + j; \
+                z = state + k * 2 * num + j; \
+                b0 = V_LOAD(c); \
+                b1 = V_LOAD(c+num); \
+                b2 = V_LOAD(c+2*num); \
+                a1 = V_LOAD(c+3*num); \
+                a2 = V_LOAD(c+4*num); \
+                s1 = V_LOAD(z); \
+                s2 = V_LOAD(z+num); \
+                for (i=0; i<n; i++) { \
+                    x = V_LOAD(work+i*V_WIDTH); \
+                    y = V_ADD(V_MUL(b0, x), s1); \
+                    s1 = V_ADD(V_SUB(V_MUL(b1, x), V_MUL(a1, y)), s2); \
+                    s2 = V_SUB(V_MUL(b2, x), V_MUL(a2, y)); \
+                    V_STORE(work+i*V_WIDTH, y); \
+                } \
+                V_STORE(z, s1); \
+                V_STORE(z+num, s2); \
+            } \
+            for (i=0; i<n; i++) { \
+                for (l=0; l<V_WIDTH; l++) \
+                    out[(j+l)*outstride+start+i] = work[i*V_WIDTH+l]; \
+            } \
+        } \
+    } \
+    biquad_bank_lanes_c(out, outstride, in, instride, coeffs, state, num, j, stages, size); \
+}
+
+/* Builds the Stockham fft pass kernel, one sub-transform per lane. */
+#define VEC_FFT_PASS(SFX, ATTR) \
+ATTR static void \
+fft_pass_##SFX(MYFLT *yr, MYFLT *yi, MYFLT *xr, MYFLT *xi, MYFLT *w, int l, int s) \
+{ \
+    int p, q, i0, i1, i2, i3, o, l4 = l >> 2; \
+    V_TYPE ar, ai, br, bi, cr, ci, dr, di, apcr, apci, amcr, amci, bpdr, bpdi, bmdr, bmdi, tr, ti; \
+    V_TYPE w1r, w1i, w2r, w2i, w3r, w3i; \
+    if (s < V_WIDTH) { \
+        fft_pass_lanes_c(yr, yi, xr, xi, w, l, s, 0); \
+        return; \
+    } \
+    if (l == 2) { \
+        for (q=0; q<s; q+=V_WIDTH) { \
+            ar = V_LOAD(xr+q); ai = V_LOAD(xi+q); \
+            br = V_LOAD(xr+q+s); bi = V_LOAD(xi+q+s); \
+            V_STORE(yr+q, V_ADD(ar, br)); V_STORE(yi+q, V_ADD(ai, bi)); \
+            V_STORE(yr+q+s, V_SUB(ar, br)); V_STORE(yi+q+s, V_SUB(ai, bi)); \
+        } \
+        return; \
+    } \
+    for (p=0; p<l4; p++, w+=6) { \
+        w1r = V_SET1(w[0]); w1i = V_SET1(w[1]); \
+        w2r = V_SET1(w[2]); w2i = V_SET1(w[3]); \
+        w3r = V_SET1(w[4]); w3i = V_SET1(w[5]); \
+        for (q=0; q<s; q+=V_WIDTH) { \
+            i0 = q + s * p; i1 = i0 + s * l4; i2 = i1 + s * l4; i3 = i2 + s * l4; \
+            o = q + s * 4 * p; \
+            ar = V_LOAD(xr+i0); ai = V_LOAD(xi+i0); br = V_LOAD(xr+i1); bi = V_LOAD(xi+i1); \
+            cr = V_LOAD(xr+i2); ci = V_LOAD(xi+i2); dr = V_LOAD(xr+i3); di = V_LOAD(xi+i3); \
+            apcr = V_ADD(ar, cr); apci = V_ADD(ai, ci); amcr = V_SUB(ar, cr); amci = V_SUB(ai, ci); \
+            bpdr = V_ADD(br, dr); bpdi = V_ADD(bi, di); bmdr = V_SUB(br, dr); bmdi = V_SUB(bi, di); \
+            V_STORE(yr+o, V_ADD(apcr, bpdr)); V_STORE(yi+o, V_ADD(apci, bpdi)); \
+            tr = V_ADD(amcr, bmdi); ti = V_SUB(amci, bmdr); \
+            V_STORE(yr+o+s, V_SUB(V_MUL(w1r, tr), V_MUL(w1i, ti))); \
+            V_STORE(yi+o+s, V_ADD(V_MUL(w1r, ti), V_MUL(w1i, tr))); \
+            tr = V_SUB(apcr, bpdr); ti = V_SUB(apci, bpdi); \
+            V_STORE(yr+o+2*s, V_SUB(V_MUL(w2r, tr), V_MUL(w2i, ti))); \
+            V_STORE(yi+o+2*s, V_ADD(V_MUL(w2r, ti), V_MUL(w2i, tr))); \
+            tr = V_SUB(amcr, bmdi); ti = V_ADD(amci, bmdr); \
+            V_STORE(yr+o+3*s, V_SUB(V_MUL(w3r, tr), V_MUL(w3i, ti))); \
+            V_STORE(yi+o+3*s, V_ADD(V_MUL(w3r, ti), V_MUL(w3i, tr))); \
+        } \
+    } \
+}
+
+/* Builds the grain kernel, one sample per lane. The table and envelope
+** positions are computed from the index of the sample, as in the scalar
+** loop, so both give the same output. */
+#define VEC_GRAIN(SFX, ATTR) \
+ATTR static void \
+grain_##SFX(MYFLT *out, int stride, int chnls, MYFLT *gains, MYFLT *table, MYFLT pos, MYFLT inc, \
+            MYFLT *env, MYFLT epos, MYFLT einc, int num) \
+{ \
+    int i = 0, c, l; \
+    MYFLT ramp[V_WIDTH], *o; \
+    V_TYPE idx, val, vpos = V_SET1(pos), vinc = V_SET1(inc), vepos = V_SET1(epos), veinc = V_SET1(einc); \
+    for (l=0; l<V_WIDTH; l++) \
+        ramp[l] = (MYFLT)l; \
+    for (; i<=num-V_WIDTH; i+=V_WIDTH) { \
+        idx = V_ADD(V_SET1((MYFLT)i), V_LOAD(ramp)); \
+        val = V_LOOKUP(table, V_ADD(vpos, V_MUL(vinc, idx))); \
+        val = V_MUL(val, V_LOOKUP(env, V_ADD(vepos, V_MUL(veinc, idx)))); \
+        for (c=0; c<chnls; c++) { \
+            o = out + c * stride + i; \
+            V_STORE(o, V_ADD(V_LOAD(o), V_MUL(val, V_SET1(gains[c])))); \
+        } \
+    } \
+    grain_lanes_c(out, stride, chnls, gains, table, pos, inc, env, epos, einc, i, num); \
+}
+
+#define VEC_SELECT(SFX) \
+    pyo_vec_mul_scalar_add = mul_scalar_add_##SFX; \
+    pyo_vec_mul_add_scalar = mul_add_scalar_##SFX; \
+    pyo_vec_scalar_mul_add = scalar_mul_add_##SFX; \
+    pyo_vec_muladd = muladd_##SFX; \
+    pyo_vec_scalar_mul_sub = scalar_mul_sub_##SFX; \
+    pyo_vec_mulsub = mulsub_##SFX; \
+    pyo_vec_div_add_scalar = div_add_scalar_##SFX; \
+    pyo_vec_divadd = divadd_##SFX; \
+    pyo_vec_divsub = divsub_##SFX; \
+    pyo_vec_mix = mix_##SFX; \
+    pyo_vec_osc_bank = osc_bank_##SFX; \
+    pyo_vec_biquad_bank = biquad_bank_##SFX; \
+    pyo_vec_fft_pass = fft_pass_##SFX; \
+    pyo_vec_grain = grain_##SFX; \
+    pyo_vec_isa = #SFX
+
+/*** SSE2 ***/
+#ifdef PYO_VEC_SSE2
+#ifndef USE_DOUBLE
+#define V_TYPE __m128
+#define V_WIDTH 4
+#define V_LOAD _mm_loadu_ps
+#define V_STORE _mm_storeu_ps
+#define V_SET1 _mm_set1_ps
+#define V_MUL _mm_mul_ps
+#define V_ADD _mm_add_ps
+#define V_SUB _mm_sub_ps
+#define V_DIV _mm_div_ps
+static inline __m128
+clamp_sse2(__m128 x)
+{
+    __m128 eps = _mm_set1_ps(VEC_DIV_EPSILON);
+    __m128 mask = _mm_and_ps(_mm_cmplt_ps(x, eps), _mm_cmpgt_ps(x, _mm_set1_ps(-VEC_DIV_EPSILON)));
+    return _mm_or_ps(_mm_and_ps(mask, eps), _mm_andnot_ps(mask, x));
+}
+static inline __m128
+wrap_sse2(__m128 p, __m128 s, __m128 is)
+{
+    __m128 t = _mm_mul_ps(p, is);
+    __m128 f = _mm_cvtepi32_ps(_mm_cvttps_epi32(t));
+    f = _mm_sub_ps(f, _mm_and_ps(_mm_cmpgt_ps(f, t), _mm_set1_ps(1.0f)));
+    p = _mm_sub_ps(p, _mm_mul_ps(f, s));
+    p = _mm_add_ps(p, _mm_and_ps(_mm_cmplt_ps(p, _mm_setzero_ps()), s));
+    return _mm_sub_ps(p, _mm_and_ps(_mm_cmpge_ps(p, s), s));
+}
+static inline __m128
+lookup_sse2(MYFLT *table, __m128 p)
+{
+    int idx[4];
+    __m128 x, y;
+    __m128i ip = _mm_cvttps_epi32(p);
+    _mm_storeu_si128((__m128i *)idx, ip);
+    x = _mm_set_ps(table[idx[3]], table[idx[2]], table[idx[1]], table[idx[0]]);
+    y = _mm_set_ps(table[idx[3]+1], table[idx[2]+1], table[idx[1]+1], table[idx[0]+1]);
+    return _mm_add_ps(x, _mm_mul_ps(_mm_sub_ps(y, x), _mm_sub_ps(p, _mm_cvtepi32_ps(ip))));
+}
+static inline MYFLT
+hsum_sse2(__m128 x)
+{
+    x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+    return _mm_cvtss_f32(_mm_add_ss(x, _mm_shuffle_ps(x, x, 1)));
+}
+#else
+#define V_TYPE __m128d
+#define V_WIDTH 2
+#define V_LOAD _mm_loadu_pd
+#define V_STORE _mm_storeu_pd
+#define V_SET1 _mm_set1_pd
+#define V_MUL _mm_mul_pd
+#define V_ADD _mm_add_pd
+#define V_SUB _mm_sub_pd
+#define V_DIV _mm_div_pd
+static inline __m128d
+clamp_sse2(__m128d x)
+{
+    __m128d eps = _mm_set1_pd(VEC_DIV_EPSILON);
+    __m128d mask = _mm_and_pd(_mm_cmplt_pd(x, eps), _mm_cmpgt_pd(x, _mm_set1_pd(-VEC_DIV_EPSILON)));
+    return _mm_or_pd(_mm_and_pd(mask, eps), _mm_andnot_pd(mask, x));
+}
+static inline __m128d
+wrap_sse2(__m128d p, __m128d s, __m128d is)
+{
+    __m128d t = _mm_mul_pd(p, is);
+    __m128d f = _mm_cvtepi32_pd(_mm_cvttpd_epi32(t));
+    f = _mm_sub_pd(f, _mm_and_pd(_mm_cmpgt_pd(f, t), _mm_set1_pd(1.0)));
+    p = _mm_sub_pd(p, _mm_mul_pd(f, s));
+    p = _mm_add_pd(p, _mm_and_pd(_mm_cmplt_pd(p, _mm_setzero_pd()), s));
+    return _mm_sub_pd(p, _mm_and_pd(_mm_cmpge_pd(p, s), s));
+}
+static inline __m128d
+lookup_sse2(MYFLT *table, __m128d p)
+{
+    int idx[4];
+    __m128d x, y;
+    __m128i ip = _mm_cvttpd_epi32(p);
+    _mm_storeu_si128((__m128i *)idx, ip);
+    x = _mm_set_pd(table[idx[1]], table[idx[0]]);
+    y = _mm_set_pd(table[idx[1]+1], table[idx[0]+1]);
+    return _mm_add_pd(x, _mm_mul_pd(_mm_sub_pd(y, x), _mm_sub_pd(p, _mm_cvtepi32_pd(ip))));
+}
+static inline MYFLT
+hsum_sse2(__m128d x)
+{
+    return _mm_cvtsd_f64(_mm_add_sd(x, _mm_unpackhi_pd(x, x)));
+}
+#endif
+#define V_CLAMP clamp_sse2
+#define V_WRAP wrap_sse2
+#define V_LOOKUP lookup_sse2
+#define V_HSUM hsum_sse2
+VEC_KERNELS(sse2, )
+VEC_OSC_BANK(sse2, )
+VEC_BIQUAD_BANK(sse2, )
+VEC_FFT_PASS(sse2, )
+VEC_GRAIN(sse2, )
+#undef V_TYPE
+#undef V_WIDTH
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_MUL
+#undef V_ADD
+#undef V_SUB
+#undef V_DIV
+#undef V_CLAMP
+#undef V_WRAP
+#undef V_LOOKUP
+#undef V_HSUM
+#endif
+
+/*** AVX2, compiled for the target and only selected if the cpu supports it ***/
+#ifdef PYO_VEC_AVX2
+#define VEC_AVX2_ATTR __attribute__((target("avx2")))
+#ifndef USE_DOUBLE
+#define V_TYPE __m256
+#define V_WIDTH 8
+#define V_LOAD _mm256_loadu_ps
+#define V_STORE _mm256_storeu_ps
+#define V_SET1 _mm256_set1_ps
+#define V_MUL _mm256_mul_ps
+#define V_ADD _mm256_add_ps
+#define V_SUB _mm256_sub_ps
+#define V_DIV _mm256_div_ps
+VEC_AVX2_ATTR static inline __m256
+clamp_avx2(__m256 x)
+{
+    __m256 eps = _mm256_set1_ps(VEC_DIV_EPSILON);
+    __m256 mask = _mm256_and_ps(_mm256_cmp_ps(x, eps, _CMP_LT_OQ),
+                                _mm256_cmp_ps(x, _mm256_set1_ps(-VEC_DIV_EPSILON), _CMP_GT_OQ));
+    return _mm256_blendv_ps(x, eps, mask);
+}
+VEC_AVX2_ATTR static inline __m256
+wrap_avx2(__m256 p, __m256 s, __m256 is)
+{
+    p = _mm256_sub_ps(p, _mm256_mul_ps(_mm256_floor_ps(_mm256_mul_ps(p, is)), s));
+    p = _mm256_add_ps(p, _mm256_and_ps(_mm256_cmp_ps(p, _mm256_setzero_ps(), _CMP_LT_OQ), s));
+    return _mm256_sub_ps(p, _mm256_and_ps(_mm256_cmp_ps(p, s, _CMP_GE_OQ), s));
+}
+VEC_AVX2_ATTR static inline __m256
+lookup_avx2(MYFLT *table, __m256 p)
+{
+    __m256i ip = _mm256_cvttps_epi32(p);
+    __m256 x = _mm256_i32gather_ps(table, ip, 4);
+    __m256 y = _mm256_i32gather_ps(table + 1, ip, 4);
+    return _mm256_add_ps(x, _mm256_mul_ps(_mm256_sub_ps(y, x), _mm256_sub_ps(p, _mm256_cvtepi32_ps(ip))));
+}
+VEC_AVX2_ATTR static inline MYFLT
+hsum_avx2(__m256 x)
+{
+    __m128 h = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+    h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+    return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 1)));
+}
+#else
+#define V_TYPE __m256d
+#define V_WIDTH 4
+#define V_LOAD _mm256_loadu_pd
+#define V_STORE _mm256_storeu_pd
+#define V_SET1 _mm256_set1_pd
+#define V_MUL _mm256_mul_pd
+#define V_ADD _mm256_add_pd
+#define V_SUB _mm256_sub_pd
+#define V_DIV _mm256_div_pd
+VEC_AVX2_ATTR static inline __m256d
+clamp_avx2(__m256d x)
+{
+    __m256d eps = _mm256_set1_pd(VEC_DIV_EPSILON);
+    __m256d mask = _mm256_and_pd(_mm256_cmp_pd(x, eps, _CMP_LT_OQ),
+                                 _mm256_cmp_pd(x, _mm256_set1_pd(-VEC_DIV_EPSILON), _CMP_GT_OQ));
+    return _mm256_blendv_pd(x, eps, mask);
+}
+VEC_AVX2_ATTR static inline __m256d
+wrap_avx2(__m256d p, __m256d s, __m256d is)
+{
+    p = _mm256_sub_pd(p, _mm256_mul_pd(_mm256_floor_pd(_mm256_mul_pd(p, is)), s));
+    p = _mm256_add_pd(p, _mm256_and_pd(_mm256_cmp_pd(p, _mm256_setzero_pd(), _CMP_LT_OQ), s));
+    return _mm256_sub_pd(p, _mm256_and_pd(_mm256_cmp_pd(p, s, _CMP_GE_OQ), s));
+}
+VEC_AVX2_ATTR static inline __m256d
+lookup_avx2(MYFLT *table, __m256d p)
+{
+    __m128i ip = _mm256_cvttpd_epi32(p);
+    __m256d x = _mm256_i32gather_pd(table, ip, 8);
+    __m256d y = _mm256_i32gather_pd(table + 1, ip, 8);
+    return _mm256_add_pd(x, _mm256_mul_pd(_mm256_sub_pd(y, x), _mm256_sub_pd(p, _mm256_cvtepi32_pd(ip))));
+}
+VEC_AVX2_ATTR static inline MYFLT
+hsum_avx2(__m256d x)
+{
+    __m128d h = _mm_add_pd(_mm256_castpd256_pd128(x), _mm256_extractf128_pd(x, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+}
+#endif
+#define V_CLAMP clamp_avx2
+#define V_WRAP wrap_avx2
+#define V_LOOKUP lookup_avx2
+#define V_HSUM hsum_avx2
+VEC_KERNELS(avx2, VEC_AVX2_ATTR)
+VEC_OSC_BANK(avx2, VEC_AVX2_ATTR)
+VEC_BIQUAD_BANK(avx2, VEC_AVX2_ATTR)
+VEC_FFT_PASS(avx2, VEC_AVX2_ATTR)
+VEC_GRAIN(avx2, VEC_AVX2_ATTR)
+#undef V_TYPE
+#undef V_WIDTH
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_MUL
+#undef V_ADD
+#undef V_SUB
+#undef V_DIV
+#undef V_CLAMP
+#undef V_WRAP
+#undef V_LOOKUP
+#undef V_HSUM
+#endif
+
+/*** NEON (AArch64) ***/
+#ifdef PYO_VEC_NEON
+#ifndef USE_DOUBLE
+#define V_TYPE float32x4_t
+#define V_WIDTH 4
+#define V_LOAD vld1q_f32
+#define V_STORE vst1q_f32
+#define V_SET1 vdupq_n_f32
+#define V_MUL vmulq_f32
+#define V_ADD vaddq_f32
+#define V_SUB vsubq_f32
+#define V_DIV vdivq_f32
+static inline float32x4_t
+clamp_neon(float32x4_t x)
+{
+    float32x4_t eps = vdupq_n_f32(VEC_DIV_EPSILON);
+    uint32x4_t mask = vandq_u32(vcltq_f32(x, eps), vcgtq_f32(x, vdupq_n_f32(-VEC_DIV_EPSILON)));
+    return vbslq_f32(mask, eps, x);
+}
+static inline float32x4_t
+wrap_neon(float32x4_t p, float32x4_t s, float32x4_t is)
+{
+    p = vsubq_f32(p, vmulq_f32(vrndmq_f32(vmulq_f32(p, is)), s));
+    p = vbslq_f32(vcltq_f32(p, vdupq_n_f32(0.0f)), vaddq_f32(p, s), p);
+    return vbslq_f32(vcgeq_f32(p, s), vsubq_f32(p, s), p);
+}
+static inline float32x4_t
+lookup_neon(MYFLT *table, float32x4_t p)
+{
+    int32_t idx[4];
+    MYFLT x[4], y[4];
+    int32x4_t ip = vcvtq_s32_f32(p);
+    vst1q_s32(idx, ip);
+    x[0] = table[idx[0]]; x[1] = table[idx[1]]; x[2] = table[idx[2]]; x[3] = table[idx[3]];
+    y[0] = table[idx[0]+1]; y[1] = table[idx[1]+1]; y[2] = table[idx[2]+1]; y[3] = table[idx[3]+1];
+    return vaddq_f32(vld1q_f32(x), vmulq_f32(vsubq_f32(vld1q_f32(y), vld1q_f32(x)), vsubq_f32(p, vcvtq_f32_s32(ip))));
+}
+#define V_HSUM vaddvq_f32
+#else
+#define V_TYPE float64x2_t
+#define V_WIDTH 2
+#define V_LOAD vld1q_f64
+#define V_STORE vst1q_f64
+#define V_SET1 vdupq_n_f64
+#define V_MUL vmulq_f64
+#define V_ADD vaddq_f64
+#define V_SUB vsubq_f64
+#define V_DIV vdivq_f64
+static inline float64x2_t
+clamp_neon(float64x2_t x)
+{
+    float64x2_t eps = vdupq_n_f64(VEC_DIV_EPSILON);
+    uint64x2_t mask = vandq_u64(vcltq_f64(x, eps), vcgtq_f64(x, vdupq_n_f64(-VEC_DIV_EPSILON)));
+    return vbslq_f64(mask, eps, x);
+}
+static inline float64x2_t
+wrap_neon(float64x2_t p, float64x2_t s, float64x2_t is)
+{
+    p = vsubq_f64(p, vmulq_f64(vrndmq_f64(vmulq_f64(p, is)), s));
+    p = vbslq_f64(vcltq_f64(p, vdupq_n_f64(0.0)), vaddq_f64(p, s), p);
+    return vbslq_f64(vcgeq_f64(p, s), vsubq_f64(p, s), p);
+}
+static inline float64x2_t
+lookup_neon(MYFLT *table, float64x2_t p)
+{
+    int64_t idx[2];
+    MYFLT x[2], y[2];
+    int64x2_t ip = vcvtq_s64_f64(p);
+    vst1q_s64(idx, ip);
+    x[0] = table[idx[0]]; x[1] = table[idx[1]];
+    y[0] = table[idx[0]+1]; y[1] = table[idx[1]+1];
+    return vaddq_f64(vld1q_f64(x), vmulq_f64(vsubq_f64(vld1q_f64(y), vld1q_f64(x)), vsubq_f64(p, vcvtq_f64_s64(ip))));
+}
+#define V_HSUM vaddvq_f64
+#endif
+#define V_CLAMP clamp_neon
+#define V_WRAP wrap_neon
+#define V_LOOKUP lookup_neon
+VEC_KERNELS(neon, )
+VEC_OSC_BANK(neon, )
+VEC_BIQUAD_BANK(neon, )
+VEC_FFT_PASS(neon, )
+VEC_GRAIN(neon, )
+#undef V_TYPE
+#undef V_WIDTH
+#undef V_LOAD
+#undef V_STORE
+#undef V_SET1
+#undef V_MUL
+#undef V_ADD
+#undef V_SUB
+#undef V_DIV
+#undef V_CLAMP
+#undef V_WRAP
+#undef V_LOOKUP
+#undef V_HSUM
+#endif
+
+/*** Dispatch ***/
+void (*pyo_vec_mul_scalar_add)(MYFLT *data, MYFLT mul, MYFLT add, int size) = mul_scalar_add_c;
+void (*pyo_vec_mul_add_scalar)(MYFLT *data, MYFLT *mul, MYFLT add, int size) = mul_add_scalar_c;
+void (*pyo_vec_scalar_mul_add)(MYFLT *data, MYFLT mul, MYFLT *add, int size) = scalar_mul_add_c;
+void (*pyo_vec_muladd)(MYFLT *data, MYFLT *mul, MYFLT *add, int size) = muladd_c;
+void (*pyo_vec_scalar_mul_sub)(MYFLT *data, MYFLT mul, MYFLT *sub, int size) = scalar_mul_sub_c;
+void (*pyo_vec_mulsub)(MYFLT *data, MYFLT *mul, MYFLT *sub, int size) = mulsub_c;
+void (*pyo_vec_div_add_scalar)(MYFLT *data, MYFLT *div, MYFLT add, int size) = div_add_scalar_c;
+void (*pyo_vec_divadd)(MYFLT *data, MYFLT *div, MYFLT *add, int size) = divadd_c;
+void (*pyo_vec_divsub)(MYFLT *data, MYFLT *div, MYFLT *sub, int size) = divsub_c;
+void (*pyo_vec_mix)(MYFLT *out, MYFLT **ins, MYFLT *gains, int num, int size) = mix_c;
+void (*pyo_vec_osc_bank)(MYFLT *out, MYFLT *table, int size, MYFLT *pos, MYFLT *inc, MYFLT *amp, int num, int bufsize) = osc_bank_c;
+void (*pyo_vec_biquad_bank)(MYFLT *out, int outstride, MYFLT *in, int instride, MYFLT *coeffs, MYFLT *state, int num, int stages, int size) = biquad_bank_c;
+void (*pyo_vec_fft_pass)(MYFLT *yr, MYFLT *yi, MYFLT *xr, MYFLT *xi, MYFLT *w, int l, int s) = fft_pass_c;
+void (*pyo_vec_grain)(MYFLT *out, int stride, int chnls, MYFLT *gains, MYFLT *table, MYFLT pos, MYFLT inc,
+                     MYFLT *env, MYFLT epos, MYFLT einc, int num) = grain_c;
+
+static const char *pyo_vec_isa = "scalar";
+
+void
+pyo_vec_init(void)
+{
+#ifdef PYO_VEC_SSE2
+    VEC_SELECT(sse2);
+#endif
+#ifdef PYO_VEC_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        VEC_SELECT(avx2);
+    }
+#endif
+#ifdef PYO_VEC_NEON
+    VEC_SELECT(neon);
+#endif
+}
+
+const char *
+pyo_vec_get_isa(void)
+{
+    return pyo_vec_isa;
+}
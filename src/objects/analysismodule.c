@@ -253,35 +253,7 @@ static PyObject * Follower_inplace_div(Follower *self, PyObject *arg) { INPLACE_
 static PyObject *
 Follower_setFreq(Follower *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }
 
 static PyMemberDef Follower_members[] = {
@@ -735,69 +707,13 @@ static PyObject * Follower2_inplace_div(Follower2 *self, PyObject *arg) { INPLAC
 static PyObject *
 Follower2_setRisetime(Follower2 *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->risetime);
-	if (isNumber == 1) {
-		self->risetime = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->risetime = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->risetime, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->risetime_stream);
-        self->risetime_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(risetime, 2)
 }
 
 static PyObject *
 Follower2_setFalltime(Follower2 *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->falltime);
-	if (isNumber == 1) {
-		self->falltime = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->falltime = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->falltime, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->falltime_stream);
-        self->falltime_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(falltime, 3)
 }
 
 static PyMemberDef Follower2_members[] = {
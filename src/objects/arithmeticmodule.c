@@ -2502,69 +2502,13 @@ static PyObject * M_Pow_inplace_div(M_Pow *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 M_Pow_setBase(M_Pow *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->base);
-	if (isNumber == 1) {
-		self->base = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->base = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->base, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->base_stream);
-        self->base_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(base, 2)
 }	
 
 static PyObject *
 M_Pow_setExponent(M_Pow *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->exponent);
-	if (isNumber == 1) {
-		self->exponent = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->exponent = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->exponent, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->exponent_stream);
-        self->exponent_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(exponent, 3)
 }	
 
 static PyMemberDef M_Pow_members[] = {
@@ -2917,69 +2861,13 @@ static PyObject * M_Atan2_inplace_div(M_Atan2 *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 M_Atan2_setB(M_Atan2 *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->b);
-	if (isNumber == 1) {
-		self->b = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->b = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->b, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->b_stream);
-        self->b_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(b, 2)
 }	
 
 static PyObject *
 M_Atan2_setA(M_Atan2 *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->a);
-	if (isNumber == 1) {
-		self->a = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->a = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->a, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->a_stream);
-        self->a_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(a, 3)
 }	
 
 static PyMemberDef M_Atan2_members[] = {
@@ -39,18 +39,12 @@ typedef struct {
     MYFLT halfSr;
     MYFLT TwoPiOnSr;
     MYFLT *band_freqs;
-    // sample memories
-    MYFLT *x1;
-    MYFLT *x2;
-    MYFLT *y1;
-    MYFLT *y2;
-    // coefficients
-    MYFLT *b0;
-    MYFLT *b1;
-    MYFLT *b2;
-    MYFLT *a0;
-    MYFLT *a1;
-    MYFLT *a2;
+    // cosine and sine of the bands center frequencies
+    MYFLT *band_cos;
+    MYFLT *band_sin;
+    // normalized coefficients and states, laid out for pyo_vec_biquad_bank
+    MYFLT *coeffs;
+    MYFLT *state;
     MYFLT *buffer_streams;
     int modebuffer[1];
 } BandSplitter;
@@ -59,24 +53,16 @@ typedef struct {
 static void
 BandSplitter_compute_variables(BandSplitter *self, MYFLT q)
 {    
-    int i;
-    MYFLT freq;
-    for (i=0; i<self->bands; i++) {
-        freq = self->band_freqs[i];
-        if (freq <= 1) 
-            freq = 1;
-        else if (freq >= self->halfSr)
-            freq = self->halfSr;
-    
-        MYFLT w0 = self->TwoPiOnSr * freq;
-        MYFLT c = MYCOS(w0);
-        MYFLT alpha = MYSIN(w0) / (2 * q);
-    
-        self->b0[i] = alpha;
-        self->b2[i] = -alpha;
-        self->a0[i] = 1 + alpha;
-        self->a1[i] = -2 * c;
-        self->a2[i] = 1 - alpha;
+    int i, n = self->bands;
+    MYFLT alpha, ia0;
+    for (i=0; i<n; i++) {
+        alpha = self->band_sin[i] / (2 * q);
+        ia0 = 1.0 / (1 + alpha);
+        self->coeffs[i] = alpha * ia0;
+        self->coeffs[n+i] = 0.0;
+        self->coeffs[2*n+i] = -alpha * ia0;
+        self->coeffs[3*n+i] = -2 * self->band_cos[i] * ia0;
+        self->coeffs[4*n+i] = (1 - alpha) * ia0;
     }    
 }
 
@@ -84,68 +70,86 @@ static void
 BandSplitter_setFrequencies(BandSplitter *self)
 {
     int i;
+    MYFLT freq, w0;
     MYFLT frac = 1. / self->bands;
     for (i=0; i<self->bands; i++) {        
         self->band_freqs[i] = MYPOW(MYPOW(self->max_freq/self->min_freq, frac), i) * self->min_freq;
+        freq = self->band_freqs[i];
+        if (freq <= 1) 
+            freq = 1;
+        else if (freq >= self->halfSr)
+            freq = self->halfSr;
+        w0 = self->TwoPiOnSr * freq;
+        self->band_cos[i] = MYCOS(w0);
+        self->band_sin[i] = MYSIN(w0);
     }
 }
 
+/* Transposed form equivalent of the direct form memories x1 = x2 = y1 = y2 = val,
+   the filters start as if their past inputs and outputs were all the first input sample. */
+static void
+BandSplitter_init_state(BandSplitter *self, MYFLT val)
+{
+    int j, n = self->bands;
+    MYFLT *c = self->coeffs;
+    for (j=0; j<n; j++) {
+        self->state[j] = (c[n+j] + c[2*n+j] - c[3*n+j] - c[4*n+j]) * val;
+        self->state[n+j] = (c[2*n+j] - c[4*n+j]) * val;
+    }
+    self->init = 0;
+}
+
 static void
 BandSplitter_filters_i(BandSplitter *self) {
-    MYFLT val;
-    int j, i;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
-    if (self->init == 1) {
-        for (j=0; j<self->bands; j++) {
-            self->x1[j] = self->x2[j] = self->y1[j] = self->y2[j] = in[0];
-        }    
-        self->init = 0;
-    }
+    if (self->init == 1)
+        BandSplitter_init_state(self, in[0]);
     
-    for (j=0; j<self->bands; j++) {
-        for (i=0; i<self->bufsize; i++) {        
-            val = ( (self->b0[j] * in[i]) + (self->b2[j] * self->x2[j]) - (self->a1[j] * self->y1[j]) - (self->a2[j] * self->y2[j]) ) / self->a0[j];
-            self->y2[j] = self->y1[j];
-            self->y1[j] = val;
-            self->x2[j] = self->x1[j];
-            self->x1[j] = in[i];
-            self->buffer_streams[i + j * self->bufsize] = val;
-        }    
-    }
+    pyo_vec_biquad_bank(self->buffer_streams, self->bufsize, in, 0, self->coeffs, self->state, self->bands, 1, self->bufsize);
 }
 
+/* Coefficients change every sample, so the bands are filtered in a scalar loop on the bank's states. */
 static void
 BandSplitter_filters_a(BandSplitter *self) {
-    MYFLT val;
-    int j, i;
+    int i, j, n = self->bands;
+    MYFLT x, y, s1, s2, alpha, ia0, b0, a1, a2, cosv, sinv;
+    MYFLT *out;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
-    
+    MYFLT *q = Stream_getData((Stream *)self->q_stream);
+
     if (self->init == 1) {
-        for (j=0; j<self->bands; j++) {
-            self->x1[j] = self->x2[j] = self->y1[j] = self->y2[j] = in[0];
-        }    
-        self->init = 0;
+        BandSplitter_compute_variables((BandSplitter *)self, q[0]);
+        BandSplitter_init_state(self, in[0]);
     }
 
-    MYFLT *q = Stream_getData((Stream *)self->q_stream);
-
-    for (i=0; i<self->bufsize; i++) {
-        BandSplitter_compute_variables((BandSplitter *)self, q[i]);
-        for (j=0; j<self->bands; j++) {
-            val = ( (self->b0[j] * in[i]) + (self->b2[j] * self->x2[j]) - (self->a1[j] * self->y1[j]) - (self->a2[j] * self->y2[j]) ) / self->a0[j];
-            self->y2[j] = self->y1[j];
-            self->y1[j] = val;
-            self->x2[j] = self->x1[j];
-            self->x1[j] = in[i];
-            self->buffer_streams[i + j * self->bufsize] = val;
-        }    
+    for (j=0; j<n; j++) {
+        out = self->buffer_streams + j * self->bufsize;
+        cosv = self->band_cos[j];
+        sinv = self->band_sin[j];
+        s1 = self->state[j];
+        s2 = self->state[n+j];
+        for (i=0; i<self->bufsize; i++) {
+            alpha = sinv / (2 * q[i]);
+            ia0 = 1.0 / (1 + alpha);
+            b0 = alpha * ia0;
+            a1 = -2 * cosv * ia0;
+            a2 = (1 - alpha) * ia0;
+            x = in[i];
+            y = b0 * x + s1;
+            s1 = s2 - a1 * y;
+            s2 = -b0 * x - a2 * y;
+            out[i] = y;
+        }
+        self->state[j] = s1;
+        self->state[n+j] = s2;
     }
 }
 
 MYFLT *
 BandSplitter_getSamplesBuffer(BandSplitter *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -194,16 +198,10 @@ BandSplitter_dealloc(BandSplitter* self)
 {
     free(self->data);
     free(self->band_freqs);
-    free(self->x1);
-    free(self->x2);
-    free(self->y1);
-    free(self->y2);
-    free(self->b0);
-    free(self->b1);
-    free(self->b2);
-    free(self->a0);
-    free(self->a1);
-    free(self->a2);
+    free(self->band_cos);
+    free(self->band_sin);
+    free(self->coeffs);
+    free(self->state);
     free(self->buffer_streams);
     BandSplitter_clear(self);
     self->ob_type->tp_free((PyObject*)self);
@@ -249,17 +247,10 @@ BandSplitter_init(BandSplitter *self, PyObject *args, PyObject *kwds)
     
     self->band_freqs = (MYFLT *)realloc(self->band_freqs, self->bands * sizeof(MYFLT));
     
-    self->x1 = (MYFLT *)realloc(self->x1, self->bands * sizeof(MYFLT));
-    self->x2 = (MYFLT *)realloc(self->x2, self->bands * sizeof(MYFLT));
-    self->y1 = (MYFLT *)realloc(self->y1, self->bands * sizeof(MYFLT));
-    self->y2 = (MYFLT *)realloc(self->y2, self->bands * sizeof(MYFLT));
-
-    self->b0 = (MYFLT *)realloc(self->b0, self->bands * sizeof(MYFLT));
-    self->b1 = (MYFLT *)realloc(self->b1, self->bands * sizeof(MYFLT));
-    self->b2 = (MYFLT *)realloc(self->b2, self->bands * sizeof(MYFLT));
-    self->a0 = (MYFLT *)realloc(self->a0, self->bands * sizeof(MYFLT));
-    self->a1 = (MYFLT *)realloc(self->a1, self->bands * sizeof(MYFLT));
-    self->a2 = (MYFLT *)realloc(self->a2, self->bands * sizeof(MYFLT));
+    self->band_cos = (MYFLT *)realloc(self->band_cos, self->bands * sizeof(MYFLT));
+    self->band_sin = (MYFLT *)realloc(self->band_sin, self->bands * sizeof(MYFLT));
+    self->coeffs = (MYFLT *)realloc(self->coeffs, 5 * self->bands * sizeof(MYFLT));
+    self->state = (MYFLT *)realloc(self->state, 2 * self->bands * sizeof(MYFLT));
 
     self->buffer_streams = (MYFLT *)realloc(self->buffer_streams, self->bands * self->bufsize * sizeof(MYFLT));
 
@@ -309,6 +300,8 @@ BandSplitter_setQ(BandSplitter *self, PyObject *arg)
 
     (*self->mode_func_ptr)(self);
 
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -666,70 +659,65 @@ typedef struct {
     MYFLT last_freq1;
     MYFLT last_freq2;
     MYFLT last_freq3;
-    // sample memories
-    MYFLT x1[6];
-    MYFLT x2[6];
-    MYFLT x3[6];
-    MYFLT x4[6];
-    MYFLT y1[6];
-    MYFLT y2[6];
-    MYFLT y3[6];
-    MYFLT y4[6];
-    // coefficients
-    MYFLT b1[3];
-    MYFLT b2[3];
-    MYFLT b3[3];
-    MYFLT b4[3];
-    MYFLT la0[3];
-    MYFLT la1[3];
-    MYFLT la2[3];
-    MYFLT ha0[3];
-    MYFLT ha1[3];
-    MYFLT ha2[3];
+    /* Each Linkwitz-Riley crossover filter is a cascade of two identical
+    ** Butterworth biquads. The split bank filters the input with
+    ** [LP(f1), HP(f1), HP(f2), HP(f3)], the join bank then filters the
+    ** second and third bands with [LP(f2), LP(f3)]. Coefficients and states
+    ** are laid out for pyo_vec_biquad_bank. */
+    MYFLT split_coeffs[40];
+    MYFLT split_state[16];
+    MYFLT join_coeffs[20];
+    MYFLT join_state[8];
     MYFLT *buffer_streams;
     int modebuffer[3];
 } FourBandMain;
 
+/* Writes lowpass (type = 0) or highpass (type = 1) butterworth coefficients in
+** both stages of a lane of a bank of num lanes. */
+static void
+FourBandMain_set_lane(MYFLT *coeffs, int num, int lane, MYFLT freq, MYFLT sr, int type)
+{
+    int k;
+    MYFLT *c;
+    MYFLT w0 = TWOPI * freq / sr;
+    MYFLT cw = MYCOS(w0);
+    MYFLT alpha = MYSIN(w0) / MYSQRT(2.0);
+    MYFLT ia0 = 1.0 / (1.0 + alpha);
+    MYFLT b0 = type == 0 ? (1.0 - cw) * 0.5 * ia0 : (1.0 + cw) * 0.5 * ia0;
+    MYFLT b1 = type == 0 ? 2.0 * b0 : -2.0 * b0;
+
+    for (k=0; k<2; k++) {
+        c = coeffs + k * 5 * num + lane;
+        c[0] = b0;
+        c[num] = b1;
+        c[2*num] = b0;
+        c[3*num] = -2.0 * cw * ia0;
+        c[4*num] = (1.0 - alpha) * ia0;
+    }
+}
 
 static void
 FourBandMain_compute_variables(FourBandMain *self, MYFLT freq, int band)
 {    
-    MYFLT wc = TWOPI * freq;
-    MYFLT wc2 = wc * wc;
-    MYFLT wc3 = wc2 * wc;
-    MYFLT wc4 = wc2 * wc2;
-    MYFLT k = wc / MYTAN(PI * freq / self->sr);
-    MYFLT k2 = k * k;
-    MYFLT k3 = k2 * k;
-    MYFLT k4 = k2 * k2;
-    MYFLT sqrt2 = MYSQRT(2.0);
-    MYFLT sq_tmp1 = sqrt2 * wc3 * k;
-    MYFLT sq_tmp2 = sqrt2 * wc * k3;
-    MYFLT a_tmp = 4.0 * wc2 * k2 + 2.0 * sq_tmp1 + k4 + 2.0 * sq_tmp2 + wc4;
-    MYFLT wc4_a_tmp = wc4 / a_tmp;
-    MYFLT k4_a_tmp = k4 / a_tmp;
-    
-    /* common */
-    self->b1[band] = (4.0 * (wc4 + sq_tmp1 - k4 - sq_tmp2)) / a_tmp;
-    self->b2[band] = (6.0 * wc4 - 8.0 * wc2 * k2 + 6.0 * k4) / a_tmp;
-    self->b3[band] = (4.0 * (wc4 - sq_tmp1 + sq_tmp2 - k4)) / a_tmp;
-    self->b4[band] = (k4 - 2.0 * sq_tmp1 + wc4 - 2.0 * sq_tmp2 + 4.0 * wc2 * k2) / a_tmp;
-    
-    /* lowpass */
-    self->la0[band] = wc4_a_tmp;
-    self->la1[band] = 4.0 * wc4_a_tmp;
-    self->la2[band] = 6.0 * wc4_a_tmp;
-    
-    /* highpass */
-    self->ha0[band] = k4_a_tmp;
-    self->ha1[band] = -4.0 * k4_a_tmp;
-    self->ha2[band] = 6.0 * k4_a_tmp;    
+    switch (band) {
+        case 0:
+            FourBandMain_set_lane(self->split_coeffs, 4, 0, freq, self->sr, 0);
+            FourBandMain_set_lane(self->split_coeffs, 4, 1, freq, self->sr, 1);
+            break;
+        case 1:
+            FourBandMain_set_lane(self->split_coeffs, 4, 2, freq, self->sr, 1);
+            FourBandMain_set_lane(self->join_coeffs, 2, 0, freq, self->sr, 0);
+            break;
+        case 2:
+            FourBandMain_set_lane(self->split_coeffs, 4, 3, freq, self->sr, 1);
+            FourBandMain_set_lane(self->join_coeffs, 2, 1, freq, self->sr, 0);
+            break;
+    }
 }
 
 static void
 FourBandMain_filters(FourBandMain *self) {
-    MYFLT val, inval, tmp, f1, f2, f3;
-    int i, j, j1, ind, ind1;
+    MYFLT f1, f2, f3;
     
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
@@ -761,69 +749,15 @@ FourBandMain_filters(FourBandMain *self) {
         FourBandMain_compute_variables(self, f3, 2);
     }
     
-    
-    for (i=0; i<self->bufsize; i++) {   
-        inval = in[i];
-        /* First band */
-        val = self->la0[0] * inval + self->la1[0] * self->x1[0] + self->la2[0] * self->x2[0] + self->la1[0] * self->x3[0] + self->la0[0] * self->x4[0] - 
-              self->b1[0] * self->y1[0] - self->b2[0] * self->y2[0] - self->b3[0] * self->y3[0] - self->b4[0] * self->y4[0];
-        self->y4[0] = self->y3[0];
-        self->y3[0] = self->y2[0];
-        self->y2[0] = self->y1[0];
-        self->y1[0] = val;
-        self->x4[0] = self->x3[0];
-        self->x3[0] = self->x2[0];
-        self->x2[0] = self->x1[0];
-        self->x1[0] = inval;
-        self->buffer_streams[i] = val;
-        
-        /* Second and third bands */
-        for (j=0; j<2; j++) {
-            j1 = j + 1;
-            ind = j * 2 + 1;
-            ind1 = ind + 1;
-            tmp = self->ha0[j] * inval + self->ha1[j] * self->x1[ind] + self->ha2[j] * self->x2[ind] + self->ha1[j] * self->x3[ind] + self->ha0[j] * self->x4[ind] - 
-                  self->b1[j] * self->y1[ind] - self->b2[j] * self->y2[ind] - self->b3[j] * self->y3[ind] - self->b4[j] * self->y4[ind];
-            self->y4[ind] = self->y3[ind];
-            self->y3[ind] = self->y2[ind];
-            self->y2[ind] = self->y1[ind];
-            self->y1[ind] = tmp;
-            self->x4[ind] = self->x3[ind];
-            self->x3[ind] = self->x2[ind];
-            self->x2[ind] = self->x1[ind];
-            self->x1[ind] = inval;
-            
-            val = self->la0[j1] * tmp + self->la1[j1] * self->x1[ind1] + self->la2[j1] * self->x2[ind1] + self->la1[j1] * self->x3[ind1] + self->la0[j1] * self->x4[ind1] - 
-                  self->b1[j1] * self->y1[ind1] - self->b2[j1] * self->y2[ind1] - self->b3[j1] * self->y3[ind1] - self->b4[j1] * self->y4[ind1];
-            self->y4[ind1] = self->y3[ind1];
-            self->y3[ind1] = self->y2[ind1];
-            self->y2[ind1] = self->y1[ind1];
-            self->y1[ind1] = val;
-            self->x4[ind1] = self->x3[ind1];
-            self->x3[ind1] = self->x2[ind1];
-            self->x2[ind1] = self->x1[ind1];
-            self->x1[ind1] = tmp;
-            
-            self->buffer_streams[i + j1 * self->bufsize] = val;            
-        }
-
-        val = self->ha0[2] * inval + self->ha1[2] * self->x1[5] + self->ha2[2] * self->x2[5] + self->ha1[2] * self->x3[5] + self->ha0[2] * self->x4[5] - 
-              self->b1[2] * self->y1[5] - self->b2[2] * self->y2[5] - self->b3[2] * self->y3[5] - self->b4[2] * self->y4[5];
-        self->y4[5] = self->y3[5];
-        self->y3[5] = self->y2[5];
-        self->y2[5] = self->y1[5];
-        self->y1[5] = val;
-        self->x4[5] = self->x3[5];
-        self->x3[5] = self->x2[5];
-        self->x2[5] = self->x1[5];
-        self->x1[5] = inval;
-        self->buffer_streams[i + 3 * self->bufsize] = val;
-    }    
+    pyo_vec_biquad_bank(self->buffer_streams, self->bufsize, in, 0, self->split_coeffs, self->split_state, 4, 2, self->bufsize);
+    pyo_vec_biquad_bank(self->buffer_streams + self->bufsize, self->bufsize, self->buffer_streams + self->bufsize, self->bufsize, 
+                        self->join_coeffs, self->join_state, 2, 2, self->bufsize);
 }
 
 MYFLT *
 FourBandMain_getSamplesBuffer(FourBandMain *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -919,8 +853,11 @@ FourBandMain_init(FourBandMain *self, PyObject *args, PyObject *kwds)
     Py_INCREF(self->stream);
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
     
-    for (i=0; i<6; i++) {
-        self->x1[i] = self->x2[i] = self->x3[i] = self->x4[i] = self->y1[i] = self->y2[i] = self->y3[i] = self->y4[i] = 0.0;
+    for (i=0; i<16; i++) {
+        self->split_state[i] = 0.0;
+    }
+    for (i=0; i<8; i++) {
+        self->join_state[i] = 0.0;
     }
 
     self->buffer_streams = (MYFLT *)realloc(self->buffer_streams, 4 * self->bufsize * sizeof(MYFLT));
@@ -950,97 +887,19 @@ FourBandMain_init(FourBandMain *self, PyObject *args, PyObject *kwds)
 static PyObject *
 FourBandMain_setFreq1(FourBandMain *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq1);
-	if (isNumber == 1) {
-		self->freq1 = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->freq1 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq1, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq1_stream);
-        self->freq1_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq1, 0)
 }	
 
 static PyObject *
 FourBandMain_setFreq2(FourBandMain *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq2);
-	if (isNumber == 1) {
-		self->freq2 = PyNumber_Float(tmp);
-        self->modebuffer[1] = 0;
-	}
-	else {
-		self->freq2 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq2, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq2_stream);
-        self->freq2_stream = (Stream *)streamtmp;
-		self->modebuffer[1] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq2, 1)
 }	
 
 static PyObject *
 FourBandMain_setFreq3(FourBandMain *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq3);
-	if (isNumber == 1) {
-		self->freq3 = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq3 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq3, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq3_stream);
-        self->freq3_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq3, 2)
 }	
 
 static PyObject * FourBandMain_getServer(FourBandMain* self) { GET_SERVER };
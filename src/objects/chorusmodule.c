@@ -531,103 +531,19 @@ static PyObject * Chorus_inplace_div(Chorus *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Chorus_setDepth(Chorus *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->depth);
-	if (isNumber == 1) {
-		self->depth = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->depth = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->depth, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->depth_stream);
-        self->depth_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(depth, 2)
 }
 
 static PyObject *
 Chorus_setFeedback(Chorus *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->feedback);
-	if (isNumber == 1) {
-		self->feedback = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->feedback = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->feedback, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->feedback_stream);
-        self->feedback_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(feedback, 3)
 }	
 
 static PyObject *
 Chorus_setMix(Chorus *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->mix);
-	if (isNumber == 1) {
-		self->mix = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->mix = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->mix, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->mix_stream);
-        self->mix_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(mix, 4)
 }	
 
 static PyMemberDef Chorus_members[] = {
@@ -356,129 +356,25 @@ static PyObject * Compress_inplace_div(Compress *self, PyObject *arg) { INPLACE_
 static PyObject *
 Compress_setThresh(Compress *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->thresh);
-	if (isNumber == 1) {
-		self->thresh = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->thresh = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->thresh, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->thresh_stream);
-        self->thresh_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-        
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(thresh, 4)
 }	
 
 static PyObject *
 Compress_setRatio(Compress *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->ratio);
-	if (isNumber == 1) {
-		self->ratio = PyNumber_Float(tmp);
-        self->modebuffer[5] = 0;
-	}
-	else {
-		self->ratio = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->ratio, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->ratio_stream);
-        self->ratio_stream = (Stream *)streamtmp;
-		self->modebuffer[5] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(ratio, 5)
 }	
 
 static PyObject *
 Compress_setRiseTime(Compress *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->risetime);
-	if (isNumber == 1) {
-		self->risetime = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->risetime = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->risetime, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->risetime_stream);
-        self->risetime_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(risetime, 2)
 }	
 
 static PyObject *
 Compress_setFallTime(Compress *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->falltime);
-	if (isNumber == 1) {
-		self->falltime = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->falltime = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->falltime, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->falltime_stream);
-        self->falltime_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(falltime, 3)
 }	
 
 static PyObject *
@@ -1359,103 +1255,19 @@ static PyObject * Gate_inplace_div(Gate *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Gate_setThresh(Gate *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->thresh);
-	if (isNumber == 1) {
-		self->thresh = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->thresh = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->thresh, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->thresh_stream);
-        self->thresh_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(thresh, 2)
 }
 
 static PyObject *
 Gate_setRiseTime(Gate *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->risetime);
-	if (isNumber == 1) {
-		self->risetime = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->risetime = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->risetime, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->risetime_stream);
-        self->risetime_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(risetime, 3)
 }
 
 static PyObject *
 Gate_setFallTime(Gate *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->falltime);
-	if (isNumber == 1) {
-		self->falltime = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->falltime = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->falltime, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->falltime_stream);
-        self->falltime_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(falltime, 4)
 }
 
 static PyObject *
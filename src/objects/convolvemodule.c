@@ -25,6 +25,128 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 #include "tablemodule.h"
+#include "fft.h"
+#include "fftcache.h"
+#include <pthread.h>
+
+
+/* Impulse responses longer than this are convolved in the frequency domain */
+#define CONVOLVE_DIRECT_MAX_SIZE 64
+
+/* Spectra of the impulse response partitions. They are computed once per
+   (table, size, partition size) and shared by all Convolve objects using
+   the same table. Spectra are stored as separated real and imaginary arrays
+   of bsize+1 bins per partition and are recomputed when the table changes. */
+typedef struct _ConvolveIR {
+    PyObject *table; /* TableStream */
+    int version;
+    int size;
+    int bsize;
+    int parts;
+    MYFLT *real;
+    MYFLT *imag;
+    int refcount;
+    pthread_mutex_t lock;
+    struct _ConvolveIR *next;
+} ConvolveIR;
+
+static ConvolveIR *convolve_irs = NULL;
+
+/* Must be called with the GIL */
+static ConvolveIR *
+ConvolveIR_acquire(PyObject *table, int size, int bsize)
+{
+    int nbins = bsize + 1;
+    ConvolveIR *ir;
+
+    for (ir=convolve_irs; ir!=NULL; ir=ir->next) {
+        if (ir->table == table && ir->size == size && ir->bsize == bsize) {
+            ir->refcount++;
+            return ir;
+        }
+    }
+
+    ir = (ConvolveIR *)malloc(sizeof(ConvolveIR));
+    Py_INCREF(table);
+    ir->table = table;
+    ir->version = TableStream_getVersion(table) - 1; /* forces the first computation */
+    ir->size = size;
+    ir->bsize = bsize;
+    ir->parts = (size + bsize - 1) / bsize;
+    ir->real = (MYFLT *)calloc(ir->parts * nbins, sizeof(MYFLT));
+    ir->imag = (MYFLT *)calloc(ir->parts * nbins, sizeof(MYFLT));
+    ir->refcount = 1;
+    pthread_mutex_init(&ir->lock, NULL);
+    ir->next = convolve_irs;
+    convolve_irs = ir;
+    return ir;
+}
+
+/* Must be called with the GIL */
+static void
+ConvolveIR_release(ConvolveIR *ir)
+{
+    ConvolveIR **prev;
+
+    if (ir == NULL || --ir->refcount > 0)
+        return;
+
+    for (prev=&convolve_irs; *prev!=NULL; prev=&(*prev)->next) {
+        if (*prev == ir) {
+            *prev = ir->next;
+            break;
+        }
+    }
+    pthread_mutex_destroy(&ir->lock);
+    Py_DECREF(ir->table);
+    free(ir->real);
+    free(ir->imag);
+    free(ir);
+}
+
+/* Recomputes the partition spectra if the table has changed. `frame` and
+   `outframe` are scratch buffers of 2*bsize samples. Several objects may call
+   this concurrently from the scheduler threads, the first one does the job. */
+static void
+ConvolveIR_update(ConvolveIR *ir, MYFLT *frame, MYFLT *outframe, PyoFFTTables *tables)
+{
+    int i, j, p, start, len, tsize;
+    int bsize = ir->bsize;
+    int n = bsize * 2;
+    MYFLT *impulse, *real, *imag;
+
+    pthread_mutex_lock(&ir->lock);
+    if (ir->version != TableStream_getVersion(ir->table)) {
+        impulse = TableStream_getData(ir->table);
+        tsize = TableStream_getSize(ir->table);
+        if (tsize > ir->size)
+            tsize = ir->size;
+        for (p=0; p<ir->parts; p++) {
+            start = p * bsize;
+            len = tsize - start;
+            if (len > bsize)
+                len = bsize;
+            for (i=0; i<len; i++)
+                frame[i] = impulse[start+i];
+            for (i=(len<0 ? 0 : len); i<n; i++)
+                frame[i] = 0.0;
+            PyoFFTTables_forward(tables, frame, outframe);
+            /* the forward transform normalizes by n, the impulse spectra are kept unnormalized */
+            real = ir->real + p * (bsize + 1);
+            imag = ir->imag + p * (bsize + 1);
+            real[0] = outframe[0] * n;
+            imag[0] = 0.0;
+            for (j=1; j<bsize; j++) {
+                real[j] = outframe[j] * n;
+                imag[j] = outframe[n-j] * n;
+            }
+            real[bsize] = outframe[bsize] * n;
+            imag[bsize] = 0.0;
+        }
+        ir->version = TableStream_getVersion(ir->table);
+    }
+    pthread_mutex_unlock(&ir->lock);
+}
 
 /************/
 /* Convolve */
@@ -38,6 +160,19 @@ typedef struct {
     MYFLT *input_tmp;
     int size;
     int count;
+    /* uniformly partitioned overlap-save convolution */
+    ConvolveIR *ir;
+    int bsize;
+    int fdlpos;
+    MYFLT last;
+    MYFLT *inframe; /* last two blocks of input */
+    MYFLT *frame;
+    MYFLT *outframe;
+    MYFLT *fdl_real; /* frequency-domain delay line, one spectrum per partition */
+    MYFLT *fdl_imag;
+    MYFLT *acc_real;
+    MYFLT *acc_imag;
+    PyoFFTTables *tables; /* twiddle factors and fft plan, shared */
 } Convolve;
 
 static void
@@ -63,6 +198,77 @@ Convolve_filters(Convolve *self) {
     }
 }
 
+/* Same result as Convolve_filters (including its one sample delay) for bufsize
+   partitions: the spectrum of the last two input blocks is pushed in the delay
+   line and the block output is the inverse transform of the sum of the products
+   of the delayed spectra with the impulse partitions. */
+static void
+Convolve_filters_partitioned(Convolve *self) {
+    int i, j, p, slot, bsize, nbins, n, parts;
+    MYFLT re, im, *xr, *xi, *hr, *hi;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+    ConvolveIR *ir = self->ir;
+
+    bsize = self->bsize;
+    nbins = bsize + 1;
+    n = bsize * 2;
+    parts = ir->parts;
+
+    ConvolveIR_update(ir, self->frame, self->outframe, self->tables);
+
+    for (i=0; i<bsize; i++)
+        self->inframe[i] = self->inframe[i+bsize];
+    self->inframe[bsize] = self->last;
+    for (i=1; i<bsize; i++)
+        self->inframe[bsize+i] = in[i-1];
+    self->last = in[bsize-1];
+
+    for (i=0; i<n; i++)
+        self->frame[i] = self->inframe[i];
+    PyoFFTTables_forward(self->tables, self->frame, self->outframe);
+    xr = self->fdl_real + self->fdlpos * nbins;
+    xi = self->fdl_imag + self->fdlpos * nbins;
+    xr[0] = self->outframe[0];
+    xi[0] = 0.0;
+    for (j=1; j<bsize; j++) {
+        xr[j] = self->outframe[j];
+        xi[j] = self->outframe[n-j];
+    }
+    xr[bsize] = self->outframe[bsize];
+    xi[bsize] = 0.0;
+
+    for (j=0; j<nbins; j++)
+        self->acc_real[j] = self->acc_imag[j] = 0.0;
+    slot = self->fdlpos;
+    for (p=0; p<parts; p++) {
+        xr = self->fdl_real + slot * nbins;
+        xi = self->fdl_imag + slot * nbins;
+        hr = ir->real + p * nbins;
+        hi = ir->imag + p * nbins;
+        for (j=0; j<nbins; j++) {
+            re = xr[j] * hr[j] - xi[j] * hi[j];
+            im = xr[j] * hi[j] + xi[j] * hr[j];
+            self->acc_real[j] += re;
+            self->acc_imag[j] += im;
+        }
+        if (--slot < 0)
+            slot = parts - 1;
+    }
+    if (++self->fdlpos == parts)
+        self->fdlpos = 0;
+
+    self->frame[0] = self->acc_real[0];
+    for (j=1; j<bsize; j++) {
+        self->frame[j] = self->acc_real[j];
+        self->frame[n-j] = self->acc_imag[j];
+    }
+    self->frame[bsize] = self->acc_real[bsize];
+    PyoFFTTables_inverse(self->tables, self->frame, self->outframe);
+
+    for (i=0; i<bsize; i++)
+        self->data[i] = self->outframe[bsize+i];
+}
+
 static void Convolve_postprocessing_ii(Convolve *self) { POST_PROCESSING_II };
 static void Convolve_postprocessing_ai(Convolve *self) { POST_PROCESSING_AI };
 static void Convolve_postprocessing_ia(Convolve *self) { POST_PROCESSING_IA };
@@ -79,7 +285,12 @@ Convolve_setProcMode(Convolve *self)
     int muladdmode;
     muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
     
-    self->proc_func_ptr = Convolve_filters;
+    if (self->ir != NULL) {
+        self->proc_func_ptr = Convolve_filters_partitioned;
+    }
+    else {
+        self->proc_func_ptr = Convolve_filters;
+    }
     
 	switch (muladdmode) {
         case 0:        
@@ -142,6 +353,15 @@ Convolve_dealloc(Convolve* self)
 {
     free(self->data);
     free(self->input_tmp);
+    ConvolveIR_release(self->ir);
+    free(self->inframe);
+    free(self->frame);
+    free(self->outframe);
+    free(self->fdl_real);
+    free(self->fdl_imag);
+    free(self->acc_real);
+    free(self->acc_imag);
+    PyoFFTTables_release(self->tables);
     Convolve_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -165,6 +385,32 @@ Convolve_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     return (PyObject *)self;
 }
 
+/* Uses the partitioned convolution if the buffer size is a power-of-two */
+static void
+Convolve_alloc_partitions(Convolve *self)
+{
+    int n, nbins, parts;
+    int bsize = self->bufsize;
+
+    if (self->size <= CONVOLVE_DIRECT_MAX_SIZE || bsize < 8 || (bsize & (bsize - 1)) != 0)
+        return;
+
+    n = bsize * 2;
+    nbins = bsize + 1;
+    self->bsize = bsize;
+    self->ir = ConvolveIR_acquire(self->table, self->size, bsize);
+    parts = self->ir->parts;
+
+    self->inframe = (MYFLT *)calloc(n, sizeof(MYFLT));
+    self->frame = (MYFLT *)calloc(n, sizeof(MYFLT));
+    self->outframe = (MYFLT *)calloc(n, sizeof(MYFLT));
+    self->fdl_real = (MYFLT *)calloc(parts * nbins, sizeof(MYFLT));
+    self->fdl_imag = (MYFLT *)calloc(parts * nbins, sizeof(MYFLT));
+    self->acc_real = (MYFLT *)calloc(nbins, sizeof(MYFLT));
+    self->acc_imag = (MYFLT *)calloc(nbins, sizeof(MYFLT));
+    self->tables = PyoFFTTables_acquire(n, -1);
+}
+
 static int
 Convolve_init(Convolve *self, PyObject *args, PyObject *kwds)
 {
@@ -192,12 +438,14 @@ Convolve_init(Convolve *self, PyObject *args, PyObject *kwds)
     Py_INCREF(self->stream);
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
     
-    (*self->mode_func_ptr)(self);
-
     self->input_tmp = (MYFLT *)realloc(self->input_tmp, self->size * sizeof(MYFLT));
     for (i=0; i<self->size; i++) {
         self->input_tmp[i] = 0.0;
     }
+
+    Convolve_alloc_partitions(self);
+
+    (*self->mode_func_ptr)(self);
         
     Py_INCREF(self);
     return 0;
@@ -234,6 +482,7 @@ static PyObject *
 Convolve_setTable(Convolve *self, PyObject *arg)
 {
 	PyObject *tmp;
+    ConvolveIR *ir;
 	
 	if (arg == NULL) {
 		Py_INCREF(Py_None);
@@ -241,8 +490,13 @@ Convolve_setTable(Convolve *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
+
+    if (self->ir != NULL) {
+        ir = self->ir;
+        self->ir = ConvolveIR_acquire(self->table, self->size, self->bsize);
+        ConvolveIR_release(ir);
+    }
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -719,65 +973,13 @@ static PyObject * IRWinSinc_inplace_div(IRWinSinc *self, PyObject *arg) { INPLAC
 static PyObject *
 IRWinSinc_setFreq(IRWinSinc *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 IRWinSinc_setBandwidth(IRWinSinc *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->bandwidth);
-	if (isNumber == 1) {
-		self->bandwidth = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->bandwidth = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->bandwidth, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->bandwidth_stream);
-        self->bandwidth_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(bandwidth, 3)
 }	
 
 static PyObject *
@@ -1614,65 +1816,13 @@ static PyObject * IRPulse_inplace_div(IRPulse *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 IRPulse_setFreq(IRPulse *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 IRPulse_setBandwidth(IRPulse *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->bandwidth);
-	if (isNumber == 1) {
-		self->bandwidth = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->bandwidth = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->bandwidth, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->bandwidth_stream);
-        self->bandwidth_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(bandwidth, 3)
 }	
 
 static PyObject *
@@ -2122,97 +2272,19 @@ static PyObject * IRFM_inplace_div(IRFM *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 IRFM_setCarrier(IRFM *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->carrier);
-	if (isNumber == 1) {
-		self->carrier = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->carrier = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->carrier, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->carrier_stream);
-        self->carrier_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(carrier, 2)
 }	
 
 static PyObject *
 IRFM_setRatio(IRFM *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->ratio);
-	if (isNumber == 1) {
-		self->ratio = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->ratio = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->ratio, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->ratio_stream);
-        self->ratio_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(ratio, 3)
 }	
 
 static PyObject *
 IRFM_setIndex(IRFM *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->index);
-	if (isNumber == 1) {
-		self->index = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->index = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->index, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->index_stream);
-        self->index_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(index, 4)
 }	
 
 static PyMemberDef IRFM_members[] = {
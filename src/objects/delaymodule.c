@@ -400,69 +400,13 @@ static PyObject * Delay_inplace_div(Delay *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Delay_setDelay(Delay *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->delay);
-	if (isNumber == 1) {
-		self->delay = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->delay = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->delay, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->delay_stream);
-        self->delay_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(delay, 2)
 }	
 
 static PyObject *
 Delay_setFeedback(Delay *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->feedback);
-	if (isNumber == 1) {
-		self->feedback = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->feedback = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->feedback, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->feedback_stream);
-        self->feedback_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(feedback, 3)
 }	
 
 static PyMemberDef Delay_members[] = {
@@ -825,35 +769,7 @@ static PyObject * SDelay_inplace_div(SDelay *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 SDelay_setDelay(SDelay *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->delay);
-	if (isNumber == 1) {
-		self->delay = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->delay = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->delay, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->delay_stream);
-        self->delay_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(delay, 2)
 }	
 
 static PyMemberDef SDelay_members[] = {
@@ -1518,69 +1434,13 @@ static PyObject * Waveguide_inplace_div(Waveguide *self, PyObject *arg) { INPLAC
 static PyObject *
 Waveguide_setFreq(Waveguide *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Waveguide_setDur(Waveguide *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->dur);
-	if (isNumber == 1) {
-		self->dur = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->dur = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->dur, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->dur_stream);
-        self->dur_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(dur, 3)
 }	
 
 static PyMemberDef Waveguide_members[] = {
@@ -2532,103 +2392,19 @@ static PyObject * AllpassWG_inplace_div(AllpassWG *self, PyObject *arg) { INPLAC
 static PyObject *
 AllpassWG_setFreq(AllpassWG *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 AllpassWG_setFeed(AllpassWG *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->feed);
-	if (isNumber == 1) {
-		self->feed = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->feed = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->feed, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->feed_stream);
-        self->feed_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(feed, 3)
 }	
 
 static PyObject *
 AllpassWG_setDetune(AllpassWG *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->detune);
-	if (isNumber == 1) {
-		self->detune = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->detune = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->detune, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->detune_stream);
-        self->detune_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(detune, 4)
 }	
 
 static PyMemberDef AllpassWG_members[] = {
@@ -60,9 +60,9 @@ Disto_transform_ii(Disto *self) {
     MYFLT slp = _clip(PyFloat_AS_DOUBLE(self->slope));
     
     for (i=0; i<self->bufsize; i++) {
-        val = MYATAN2(in[i], drv);
-        self->data[i] = val;
+        self->data[i] = drv;
     }
+    pyo_vec_atan2(self->data, in, self->data, self->bufsize);
     coeff = 1.0 - slp;
     for (i=0; i<self->bufsize; i++) {
         val = self->data[i] * coeff + self->y1 * slp;
@@ -73,7 +73,7 @@ Disto_transform_ii(Disto *self) {
 
 static void
 Disto_transform_ai(Disto *self) {
-    MYFLT val, drv, coeff;
+    MYFLT val, coeff;
     int i;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
 
@@ -81,10 +81,9 @@ Disto_transform_ai(Disto *self) {
     MYFLT slp = _clip(PyFloat_AS_DOUBLE(self->slope));
     
     for (i=0; i<self->bufsize; i++) {
-        drv = .4 - _clip(drive[i]) * .3999;
-        val = MYATAN2(in[i], drv);
-        self->data[i] = val;
+        self->data[i] = .4 - _clip(drive[i]) * .3999;
     }
+    pyo_vec_atan2(self->data, in, self->data, self->bufsize);
     
     coeff = 1.0 - slp;
     for (i=0; i<self->bufsize; i++) {
@@ -104,9 +103,9 @@ Disto_transform_ia(Disto *self) {
     MYFLT *slope = Stream_getData((Stream *)self->slope_stream);
     
     for (i=0; i<self->bufsize; i++) {
-        val = MYATAN2(in[i], drv);
-        self->data[i] = val;
+        self->data[i] = drv;
     }
+    pyo_vec_atan2(self->data, in, self->data, self->bufsize);
     for (i=0; i<self->bufsize; i++) {
         slp = _clip(slope[i]);
         coeff = 1.0 - slp;
@@ -118,7 +117,7 @@ Disto_transform_ia(Disto *self) {
 
 static void
 Disto_transform_aa(Disto *self) {
-    MYFLT val, drv, coeff, slp;
+    MYFLT val, coeff, slp;
     int i;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
@@ -126,10 +125,9 @@ Disto_transform_aa(Disto *self) {
     MYFLT *slope = Stream_getData((Stream *)self->slope_stream);
     
     for (i=0; i<self->bufsize; i++) {
-        drv = .4 - _clip(drive[i]) * .3999;
-        val = MYATAN2(in[i], drv);
-        self->data[i] = val;
+        self->data[i] = .4 - _clip(drive[i]) * .3999;
     }
+    pyo_vec_atan2(self->data, in, self->data, self->bufsize);
     for (i=0; i<self->bufsize; i++) {
         slp = _clip(slope[i]);
         coeff = 1.0 - slp;
@@ -326,69 +324,13 @@ static PyObject * Disto_inplace_div(Disto *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Disto_setDrive(Disto *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->drive);
-	if (isNumber == 1) {
-		self->drive = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->drive = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->drive, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->drive_stream);
-        self->drive_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(drive, 2)
 }	
 
 static PyObject *
 Disto_setSlope(Disto *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->slope);
-	if (isNumber == 1) {
-		self->slope = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->slope = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->slope, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->slope_stream);
-        self->slope_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(slope, 3)
 }	
 
 static PyMemberDef Disto_members[] = {
@@ -783,69 +725,13 @@ static PyObject * Clip_inplace_div(Clip *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Clip_setMin(Clip *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->min);
-	if (isNumber == 1) {
-		self->min = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->min = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->min, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->min_stream);
-        self->min_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(min, 2)
 }	
 
 static PyObject *
 Clip_setMax(Clip *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->max);
-	if (isNumber == 1) {
-		self->max = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->max = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->max, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->max_stream);
-        self->max_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(max, 3)
 }	
 
 static PyMemberDef Clip_members[] = {
@@ -1270,69 +1156,13 @@ static PyObject * Mirror_inplace_div(Mirror *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Mirror_setMin(Mirror *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->min);
-	if (isNumber == 1) {
-		self->min = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->min = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->min, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->min_stream);
-        self->min_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(min, 2)
 }	
 
 static PyObject *
 Mirror_setMax(Mirror *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->max);
-	if (isNumber == 1) {
-		self->max = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->max = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->max, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->max_stream);
-        self->max_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(max, 3)
 }	
 
 static PyMemberDef Mirror_members[] = {
@@ -1773,69 +1603,13 @@ static PyObject * Wrap_inplace_div(Wrap *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Wrap_setMin(Wrap *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->min);
-	if (isNumber == 1) {
-		self->min = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->min = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->min, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->min_stream);
-        self->min_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(min, 2)
 }	
 
 static PyObject *
 Wrap_setMax(Wrap *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->max);
-	if (isNumber == 1) {
-		self->max = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->max = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->max, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->max_stream);
-        self->max_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(max, 3)
 }	
 
 static PyMemberDef Wrap_members[] = {
@@ -2025,11 +1799,16 @@ Degrade_transform_ai(Degrade *self) {
     newsr = self->sr * srscale;
     nsamps = (int)(self->sr / newsr);
     
+    for (i=0; i<self->bufsize; i++) {
+        self->data[i] = _bit_clip(bitdepth[i]) - 1;
+    }
+    pyo_vec_pow(self->data, 2.0, self->data, self->bufsize);
+
     for (i=0; i<self->bufsize; i++) {
         self->sampsCount++;
         if (self->sampsCount >= nsamps) {
             self->sampsCount = 0;
-            bitscl = MYPOW(2.0, _bit_clip(bitdepth[i])-1);
+            bitscl = self->data[i];
             ibitscl = 1.0 / bitscl;
             tmp = (int)(in[i] * bitscl + 0.5);
             self->value = tmp * ibitscl;    
@@ -2072,13 +1851,18 @@ Degrade_transform_aa(Degrade *self) {
     MYFLT *bitdepth = Stream_getData((Stream *)self->bitdepth_stream);
     MYFLT *srscale = Stream_getData((Stream *)self->srscale_stream);
 
+    for (i=0; i<self->bufsize; i++) {
+        self->data[i] = _bit_clip(bitdepth[i]) - 1;
+    }
+    pyo_vec_pow(self->data, 2.0, self->data, self->bufsize);
+
     for (i=0; i<self->bufsize; i++) {
         newsr = self->sr * _sr_clip(srscale[i]);
         nsamps = (int)(self->sr / newsr);
         self->sampsCount++;
         if (self->sampsCount >= nsamps) {
             self->sampsCount = 0;
-            bitscl = MYPOW(2.0, _bit_clip(bitdepth[i])-1);
+            bitscl = self->data[i];
             ibitscl = 1.0 / bitscl;
             tmp = (int)(in[i] * bitscl + 0.5);
             self->value = tmp * ibitscl;    
@@ -2275,69 +2059,13 @@ static PyObject * Degrade_inplace_div(Degrade *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 Degrade_setBitdepth(Degrade *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->bitdepth);
-	if (isNumber == 1) {
-		self->bitdepth = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->bitdepth = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->bitdepth, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->bitdepth_stream);
-        self->bitdepth_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(bitdepth, 2)
 }	
 
 static PyObject *
 Degrade_setSrscale(Degrade *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->srscale);
-	if (isNumber == 1) {
-		self->srscale = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->srscale = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->srscale, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->srscale_stream);
-        self->srscale_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(srscale, 3)
 }	
 
 static PyMemberDef Degrade_members[] = {
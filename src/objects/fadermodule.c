@@ -977,6 +977,8 @@ Linseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[1] = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, Linseg_compute_next_data_frame);
     self->mode_func_ptr = Linseg_setProcMode;
     
@@ -1393,6 +1395,8 @@ Expseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[1] = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, Expseg_compute_next_data_frame);
     self->mode_func_ptr = Expseg_setProcMode;
     
@@ -27,6 +27,8 @@
 #include "dummymodule.h"
 #include "fft.h"
 #include "wind.h"
+#include "fftcache.h"
+#include "framepool.h"
 
 int isPowerOfTwo(int x) {
     return (x != 0) && ((x & (x - 1)) == 0);
@@ -43,45 +45,62 @@ typedef struct {
     int incount;
     MYFLT *inframe;
     MYFLT *outframe;    
-    MYFLT *window;
-    MYFLT **twiddle;
-    MYFLT *twiddle2;
+    PyoFFTTables *tables; /* twiddle factors, window and fft plan, shared */
     MYFLT *buffer_streams;
+    /* With a frame pool, frames are transformed by the pool and output one buffer later */
+    int latency;
+    int outcount;
+    MYFLT *jobframe; /* frame given to the pool */
+    MYFLT *nextframe; /* its spectrum */
+    PyoFrameJob job;
 } FFTMain;
 
+/* Frame pool side. */
+static void
+FFTMain_transform(void *arg)
+{
+    FFTMain *self = (FFTMain *)arg;
+    PyoFFTTables_forward(self->tables, self->jobframe, self->nextframe);
+}
+
 static void
 FFTMain_realloc_memories(FFTMain *self) {
-    int i, n8;
+    int i;
+    PyoFFTTables *tables;
+    /* The pool may still be computing a frame with the old memories. */
+    PyoFrameJob_release(&self->job);
     self->hsize = self->size / 2;
-    n8 = self->size >> 3;
     self->inframe = (MYFLT *)realloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)realloc(self->outframe, self->size * sizeof(MYFLT));    
+    self->jobframe = (MYFLT *)realloc(self->jobframe, self->size * sizeof(MYFLT));
+    self->nextframe = (MYFLT *)realloc(self->nextframe, self->size * sizeof(MYFLT));    
     for (i=0; i<self->size; i++)
-        self->inframe[i] = self->outframe[i] = 0.0;
+        self->inframe[i] = self->outframe[i] = self->jobframe[i] = self->nextframe[i] = 0.0;
     self->buffer_streams = (MYFLT *)realloc(self->buffer_streams, 3 * self->bufsize * sizeof(MYFLT));
     for (i=0; i<(self->bufsize*3); i++)
         self->buffer_streams[i] = 0.0;
-    self->twiddle = (MYFLT **)realloc(self->twiddle, 4 * sizeof(MYFLT));
-    for(i=0; i<4; i++)
-        self->twiddle[i] = (MYFLT *)malloc(n8 * sizeof(MYFLT));
-    fft_compute_split_twiddle(self->twiddle, self->size);
-    self->twiddle2 = (MYFLT *)realloc(self->twiddle2, self->size * sizeof(MYFLT));
-    fft_compute_radix2_twiddle(self->twiddle2, self->size);
-    self->window = (MYFLT *)realloc(self->window, self->size * sizeof(MYFLT));
-    gen_window(self->window, self->size, self->wintype);
+    tables = PyoFFTTables_acquire(self->size, self->wintype);
+    PyoFFTTables_release(self->tables);
+    self->tables = tables;
     self->incount = -self->hopsize;
+    if (Server_getFramePool(self->server) != NULL && self->bufsize <= self->size)
+        self->latency = self->bufsize;
+    else
+        self->latency = 0;
+    self->outcount = self->incount - self->latency;
 }
 
 static void
 FFTMain_filters(FFTMain *self) {
     int i, incount;
+    MYFLT *window = self->tables->window;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
    
     incount = self->incount;
 
     for (i=0; i<self->bufsize; i++) {
         if (incount >= 0) {
-            self->inframe[incount] = in[i] * self->window[incount];
+            self->inframe[incount] = in[i] * window[incount];
             if (incount < self->hsize) {
                 self->buffer_streams[i] = self->outframe[incount];
                 if (incount)
@@ -98,14 +117,14 @@ FFTMain_filters(FFTMain *self) {
         incount++;
         if (incount >= self->size) {
             incount -= self->size;      
-            realfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            PyoFFTTables_forward(self->tables, self->inframe, self->outframe);
         }
     } 
 
     /*
     for (i=0; i<self->bufsize; i++) {
         if (incount >= 0) {
-            self->inframe[incount] = in[i] * self->window[incount];
+            self->inframe[incount] = in[i] * window[incount];
             if (incount < self->hsize) {
                 self->buffer_streams[i] = self->outframe[incount*2];
                 self->buffer_streams[i+self->bufsize] = self->outframe[incount*2+1];
@@ -117,23 +136,78 @@ FFTMain_filters(FFTMain *self) {
         incount++;
         if (incount >= self->size) {
             incount -= self->size;      
-            realfft_packed(self->inframe, self->outframe, self->size, self->twiddle2);
+            realfft_packed(self->inframe, self->outframe, self->size, self->tables->twiddle2);
         }
     }
     */
     self->incount = incount;
 }
 
+/* Same output as FFTMain_filters, `latency` samples later. The frame completed
+   at a given sample is transformed by the pool and read from the same sample
+   of the next buffer. */
+static void
+FFTMain_filters_deferred(FFTMain *self) {
+    int i, incount, outcount;
+    MYFLT *tmp;
+    MYFLT *window = self->tables->window;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+   
+    incount = self->incount;
+    outcount = self->outcount;
+
+    for (i=0; i<self->bufsize; i++) {
+        if (incount >= 0)
+            self->inframe[incount] = in[i] * window[incount];
+        if (outcount >= 0) {
+            if (outcount < self->hsize) {
+                self->buffer_streams[i] = self->outframe[outcount];
+                if (outcount)
+                    self->buffer_streams[i+self->bufsize] = self->outframe[self->size - outcount];
+                else
+                    self->buffer_streams[i+self->bufsize] = 0.0;
+            }
+            else if (outcount == self->hsize)
+                self->buffer_streams[i] = self->outframe[outcount];
+            else
+                self->buffer_streams[i] = self->buffer_streams[i+self->bufsize] = 0.0;
+            self->buffer_streams[i+self->bufsize*2] = (MYFLT)outcount;
+        }
+        incount++;
+        outcount++;
+        if (outcount >= self->size) {
+            outcount -= self->size;
+            PyoFrameJob_wait(&self->job);
+            tmp = self->outframe;
+            self->outframe = self->nextframe;
+            self->nextframe = tmp;
+        }
+        if (incount >= self->size) {
+            incount -= self->size;
+            tmp = self->inframe;
+            self->inframe = self->jobframe;
+            self->jobframe = tmp;
+            PyoFramePool_submit(Server_getFramePool(self->server), &self->job);
+        }
+    } 
+    self->incount = incount;
+    self->outcount = outcount;
+}
+
 MYFLT *
 FFTMain_getSamplesBuffer(FFTMain *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
 static void
 FFTMain_setProcMode(FFTMain *self)
 {        
-    self->proc_func_ptr = FFTMain_filters;  
+    if (self->latency)
+        self->proc_func_ptr = FFTMain_filters_deferred;  
+    else
+        self->proc_func_ptr = FFTMain_filters;  
 }
 
 static void
@@ -163,17 +237,14 @@ FFTMain_clear(FFTMain *self)
 static void
 FFTMain_dealloc(FFTMain* self)
 {
-    int i;
+    PyoFrameJob_release(&self->job);
     free(self->data);
     free(self->inframe);
     free(self->outframe);
-    free(self->window);
+    free(self->jobframe);
+    free(self->nextframe);
     free(self->buffer_streams);
-    for(i=0; i<4; i++) {
-        free(self->twiddle[i]);
-    }
-    free(self->twiddle);
-    free(self->twiddle2);
+    PyoFFTTables_release(self->tables);
     FFTMain_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -189,6 +260,7 @@ FFTMain_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     
     self->size = 1024;
     self->wintype = 2;
+    PyoFrameJob_init(&self->job, FFTMain_transform, self);
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, FFTMain_compute_next_data_frame);
     self->mode_func_ptr = FFTMain_setProcMode;
@@ -228,7 +300,7 @@ static PyObject * FFTMain_stop(FFTMain *self) { STOP };
 static PyObject *
 FFTMain_setSize(FFTMain *self, PyObject *args, PyObject *kwds)
 {
-    int size, hopsize;    
+    int size, hopsize, locked;    
 
     static char *kwlist[] = {"size", "hopsize", NULL};
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "ii", kwlist, &size, &hopsize)) {
@@ -237,9 +309,12 @@ FFTMain_setSize(FFTMain *self, PyObject *args, PyObject *kwds)
     }
 
     if (isPowerOfTwo(size)) {
+        locked = Server_lockBlocks(self->server);
         self->size = size;
         self->hopsize = hopsize;
         FFTMain_realloc_memories(self);
+        (*self->mode_func_ptr)(self);
+        Server_unlockBlocks(self->server, locked);
     }
     else
         printf("FFT size must be a power of two!\n");
@@ -251,9 +326,17 @@ FFTMain_setSize(FFTMain *self, PyObject *args, PyObject *kwds)
 static PyObject *
 FFTMain_setWinType(FFTMain *self, PyObject *arg)
 {	
+    int locked;
+    PyoFFTTables *tables;
+
 	if (PyLong_Check(arg) || PyInt_Check(arg)) {
+        locked = Server_lockBlocks(self->server);
+        PyoFrameJob_release(&self->job);
         self->wintype = PyLong_AsLong(arg);
-        gen_window(self->window, self->size, self->wintype);
+        tables = PyoFFTTables_acquire(self->size, self->wintype);
+        PyoFFTTables_release(self->tables);
+        self->tables = tables;
+        Server_unlockBlocks(self->server, locked);
     }    
     
 	Py_INCREF(Py_None);
@@ -601,36 +684,54 @@ typedef struct {
     int incount;
     MYFLT *inframe;
     MYFLT *outframe;    
-    MYFLT *window;
-    MYFLT **twiddle;
-    MYFLT *twiddle2;
+    PyoFFTTables *tables; /* twiddle factors, window and fft plan, shared */
+    /* With a frame pool, frames are transformed by the pool and output one buffer later */
+    int latency;
+    int outcount;
+    MYFLT *jobframe; /* spectrum given to the pool */
+    MYFLT *nextframe; /* its frame */
+    PyoFrameJob job;
     int modebuffer[2];
 } IFFT;
 
+/* Frame pool side. */
+static void
+IFFT_transform(void *arg)
+{
+    IFFT *self = (IFFT *)arg;
+    PyoFFTTables_inverse(self->tables, self->jobframe, self->nextframe);
+}
+
 static void
 IFFT_realloc_memories(IFFT *self) {
-    int i, n8;
+    int i;
+    PyoFFTTables *tables;
+    /* The pool may still be computing a frame with the old memories. */
+    PyoFrameJob_release(&self->job);
     self->hsize = self->size / 2;
-    n8 = self->size >> 3;
     self->inframe = (MYFLT *)realloc(self->inframe, self->size * sizeof(MYFLT));
     self->outframe = (MYFLT *)realloc(self->outframe, self->size * sizeof(MYFLT));    
+    self->jobframe = (MYFLT *)realloc(self->jobframe, self->size * sizeof(MYFLT));
+    self->nextframe = (MYFLT *)realloc(self->nextframe, self->size * sizeof(MYFLT));    
     for (i=0; i<self->size; i++)
-        self->inframe[i] = self->outframe[i] = 0.0;
-    self->twiddle = (MYFLT **)realloc(self->twiddle, 4 * sizeof(MYFLT));
-    for(i=0; i<4; i++)
-        self->twiddle[i] = (MYFLT *)malloc(n8 * sizeof(MYFLT));
-    fft_compute_split_twiddle(self->twiddle, self->size);
-    self->twiddle2 = (MYFLT *)realloc(self->twiddle2, self->size * sizeof(MYFLT));
-    fft_compute_radix2_twiddle(self->twiddle2, self->size);
-    self->window = (MYFLT *)realloc(self->window, self->size * sizeof(MYFLT));
-    gen_window(self->window, self->size, self->wintype);
-    self->incount = -self->hopsize;
+        self->inframe[i] = self->outframe[i] = self->jobframe[i] = self->nextframe[i] = 0.0;
+    tables = PyoFFTTables_acquire(self->size, self->wintype);
+    PyoFFTTables_release(self->tables);
+    self->tables = tables;
+    if (Server_getFramePool(self->server) != NULL && self->bufsize <= self->size)
+        self->latency = self->bufsize;
+    else
+        self->latency = 0;
+    /* The frames of the FFT objects feeding us are late too. */
+    self->incount = -self->hopsize - self->latency;
+    self->outcount = self->incount - self->latency;
 }
 
 static void
 IFFT_filters(IFFT *self) {
     int i, incount;
     MYFLT data;
+    MYFLT *window = self->tables->window;
     MYFLT *inreal = Stream_getData((Stream *)self->inreal_stream);
     MYFLT *inimag = Stream_getData((Stream *)self->inimag_stream);
 
@@ -644,13 +745,13 @@ IFFT_filters(IFFT *self) {
             }
             else if (incount == self->hsize)
                 self->inframe[incount] = inreal[i];
-            data = self->outframe[incount] * self->window[incount];
+            data = self->outframe[incount] * window[incount];
             self->data[i] = data;
         }
         incount++;
         if (incount >= self->size) {
             incount -= self->size;      
-            irealfft_split(self->inframe, self->outframe, self->size, self->twiddle);
+            PyoFFTTables_inverse(self->tables, self->inframe, self->outframe);
         }
     }
     /*
@@ -660,18 +761,62 @@ IFFT_filters(IFFT *self) {
                 self->inframe[incount*2] = inreal[i];
                 self->inframe[incount*2+1] = inimag[i];
             }
-            self->data[i] = self->outframe[incount] * self->window[incount];
+            self->data[i] = self->outframe[incount] * window[incount];
         }
         incount++;
         if (incount >= self->size) {
             incount -= self->size;      
-            irealfft_packed(self->inframe, self->outframe, self->size, self->twiddle2);
+            irealfft_packed(self->inframe, self->outframe, self->size, self->tables->twiddle2);
         }
     }
     */ 
     self->incount = incount;
 }
 
+/* Same output as IFFT_filters, `latency` samples later, see FFTMain_filters_deferred. */
+static void
+IFFT_filters_deferred(IFFT *self) {
+    int i, incount, outcount;
+    MYFLT *tmp;
+    MYFLT *window = self->tables->window;
+    MYFLT *inreal = Stream_getData((Stream *)self->inreal_stream);
+    MYFLT *inimag = Stream_getData((Stream *)self->inimag_stream);
+
+    incount = self->incount;
+    outcount = self->outcount;
+    for (i=0; i<self->bufsize; i++) {
+        if (incount >= 0) {
+            if (incount < self->hsize) {
+                self->inframe[incount] = inreal[i];
+                if (incount)
+                    self->inframe[self->size - incount] = inimag[i];
+            }
+            else if (incount == self->hsize)
+                self->inframe[incount] = inreal[i];
+        }
+        if (outcount >= 0)
+            self->data[i] = self->outframe[outcount] * window[outcount];
+        incount++;
+        outcount++;
+        if (outcount >= self->size) {
+            outcount -= self->size;
+            PyoFrameJob_wait(&self->job);
+            tmp = self->outframe;
+            self->outframe = self->nextframe;
+            self->nextframe = tmp;
+        }
+        if (incount >= self->size) {
+            incount -= self->size;
+            tmp = self->inframe;
+            self->inframe = self->jobframe;
+            self->jobframe = tmp;
+            PyoFramePool_submit(Server_getFramePool(self->server), &self->job);
+        }
+    }
+    self->incount = incount;
+    self->outcount = outcount;
+}
+
 static void IFFT_postprocessing_ii(IFFT *self) { POST_PROCESSING_II };
 static void IFFT_postprocessing_ai(IFFT *self) { POST_PROCESSING_AI };
 static void IFFT_postprocessing_ia(IFFT *self) { POST_PROCESSING_IA };
@@ -688,7 +833,10 @@ IFFT_setProcMode(IFFT *self)
     int muladdmode;
     muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
 
-    self->proc_func_ptr = IFFT_filters;
+    if (self->latency)
+        self->proc_func_ptr = IFFT_filters_deferred;
+    else
+        self->proc_func_ptr = IFFT_filters;
     
 	switch (muladdmode) {
         case 0:        
@@ -753,16 +901,13 @@ IFFT_clear(IFFT *self)
 static void
 IFFT_dealloc(IFFT* self)
 {
-    int i;
+    PyoFrameJob_release(&self->job);
     free(self->data);
     free(self->inframe);
     free(self->outframe);
-    free(self->window);
-    for(i=0; i<4; i++) {
-        free(self->twiddle[i]);
-    }
-    free(self->twiddle);
-    free(self->twiddle2);
+    free(self->jobframe);
+    free(self->nextframe);
+    PyoFFTTables_release(self->tables);
 
     IFFT_clear(self);
     self->ob_type->tp_free((PyObject*)self);
@@ -781,6 +926,7 @@ IFFT_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->wintype = 2;
 	self->modebuffer[0] = 0;
 	self->modebuffer[1] = 0;
+    PyoFrameJob_init(&self->job, IFFT_transform, self);
 
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, IFFT_compute_next_data_frame);
@@ -855,7 +1001,7 @@ static PyObject * IFFT_inplace_div(IFFT *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 IFFT_setSize(IFFT *self, PyObject *args, PyObject *kwds)
 {
-    int size, hopsize;    
+    int size, hopsize, locked;    
 
     static char *kwlist[] = {"size", "hopsize", NULL};
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "ii", kwlist, &size, &hopsize)) {
@@ -864,9 +1010,12 @@ IFFT_setSize(IFFT *self, PyObject *args, PyObject *kwds)
     }
 
     if (isPowerOfTwo(size)) {
+        locked = Server_lockBlocks(self->server);
         self->size = size;
         self->hopsize = hopsize;
         IFFT_realloc_memories(self);
+        (*self->mode_func_ptr)(self);
+        Server_unlockBlocks(self->server, locked);
     }
     else
         printf("IFFT size must be a power of two!\n");
@@ -878,9 +1027,17 @@ IFFT_setSize(IFFT *self, PyObject *args, PyObject *kwds)
 static PyObject *
 IFFT_setWinType(IFFT *self, PyObject *arg)
 {	
+    int locked;
+    PyoFFTTables *tables;
+
 	if (PyLong_Check(arg) || PyInt_Check(arg)) {
+        locked = Server_lockBlocks(self->server);
+        PyoFrameJob_release(&self->job);
         self->wintype = PyLong_AsLong(arg);
-        gen_window(self->window, self->size, self->wintype);
+        tables = PyoFFTTables_acquire(self->size, self->wintype);
+        PyoFFTTables_release(self->tables);
+        self->tables = tables;
+        Server_unlockBlocks(self->server, locked);
     }    
     
 	Py_INCREF(Py_None);
@@ -1590,6 +1747,7 @@ PyTypeObject PolToCarType = {
 typedef struct {
     pyo_audio_HEAD
     PyObject *input; 
+    PyObject *input_streams;
     int inputSize;
     int modebuffer[2];
     int frameSize; 
@@ -1607,7 +1765,7 @@ FrameDeltaMain_generate(FrameDeltaMain *self) {
 
     MYFLT ins[self->overlaps][self->bufsize];
     for (j=0; j<self->overlaps; j++) {
-        MYFLT *in = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, j), "_getStream", NULL));
+        MYFLT *in = Stream_getData((Stream *)PyList_GET_ITEM(self->input_streams, j));
         for (i=0; i<self->bufsize; i++) {
             ins[j][i] = in[i];
         }
@@ -1641,6 +1799,7 @@ FrameDeltaMain_generate(FrameDeltaMain *self) {
 MYFLT *
 FrameDeltaMain_getSamplesBuffer(FrameDeltaMain *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -1661,6 +1820,7 @@ FrameDeltaMain_traverse(FrameDeltaMain *self, visitproc visit, void *arg)
 {
     pyo_VISIT
     Py_VISIT(self->input);
+    Py_VISIT(self->input_streams);
     return 0;
 }
 
@@ -1669,6 +1829,7 @@ FrameDeltaMain_clear(FrameDeltaMain *self)
 {
     pyo_CLEAR
     Py_CLEAR(self->input);
+    Py_CLEAR(self->input_streams);
     return 0;
 }
 
@@ -1723,7 +1884,7 @@ FrameDeltaMain_init(FrameDeltaMain *self, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
     
     self->hopsize = self->frameSize / self->overlaps;
-    self->frameBuffer = (MYFLT **)realloc(self->frameBuffer, self->overlaps * sizeof(MYFLT));
+    self->frameBuffer = (MYFLT **)realloc(self->frameBuffer, self->overlaps * sizeof(MYFLT *));
     for(i=0; i<self->overlaps; i++) {
         self->frameBuffer[i] = (MYFLT *)malloc(self->frameSize * sizeof(MYFLT));
         for (j=0; j<self->frameSize; j++) {
@@ -1750,6 +1911,7 @@ static PyObject * FrameDeltaMain_stop(FrameDeltaMain *self) { STOP };
 static PyObject *
 FrameDeltaMain_setInput(FrameDeltaMain *self, PyObject *arg)
 {
+    int i;
 	PyObject *tmp;
 	
 	if (! PyList_Check(arg)) {
@@ -1763,7 +1925,14 @@ FrameDeltaMain_setInput(FrameDeltaMain *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_XDECREF(self->input);
     self->input = tmp;
+    Py_XDECREF(self->input_streams);
+    self->input_streams = PyList_New(self->inputSize);
+    for (i=0; i<self->inputSize; i++) {
+        PyList_SET_ITEM(self->input_streams, i, PyObject_CallMethod(PyList_GET_ITEM(self->input, i), "_getStream", NULL));
+    }
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -1779,7 +1948,7 @@ FrameDeltaMain_setFrameSize(FrameDeltaMain *self, PyObject *arg)
             self->frameSize = tmp;
             self->hopsize = self->frameSize / self->overlaps;
 
-            self->frameBuffer = (MYFLT **)realloc(self->frameBuffer, self->overlaps * sizeof(MYFLT));
+            self->frameBuffer = (MYFLT **)realloc(self->frameBuffer, self->overlaps * sizeof(MYFLT *));
             for(i=0; i<self->overlaps; i++) {
                 self->frameBuffer[i] = (MYFLT *)malloc(self->frameSize * sizeof(MYFLT));
                 for (j=0; j<self->frameSize; j++) {
@@ -2130,6 +2299,7 @@ PyTypeObject FrameDeltaType = {
 typedef struct {
     pyo_audio_HEAD
     PyObject *input; 
+    PyObject *input_streams;
     int inputSize;
     int modebuffer[2];
     int frameSize; 
@@ -2147,7 +2317,7 @@ FrameAccumMain_generate(FrameAccumMain *self) {
     
     MYFLT ins[self->overlaps][self->bufsize];
     for (j=0; j<self->overlaps; j++) {
-        MYFLT *in = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->input, j), "_getStream", NULL));
+        MYFLT *in = Stream_getData((Stream *)PyList_GET_ITEM(self->input_streams, j));
         for (i=0; i<self->bufsize; i++) {
             ins[j][i] = in[i];
         }
@@ -2175,6 +2345,7 @@ FrameAccumMain_generate(FrameAccumMain *self) {
 MYFLT *
 FrameAccumMain_getSamplesBuffer(FrameAccumMain *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -2195,6 +2366,7 @@ FrameAccumMain_traverse(FrameAccumMain *self, visitproc visit, void *arg)
 {
     pyo_VISIT
     Py_VISIT(self->input);
+    Py_VISIT(self->input_streams);
     return 0;
 }
 
@@ -2203,6 +2375,7 @@ FrameAccumMain_clear(FrameAccumMain *self)
 {
     pyo_CLEAR
     Py_CLEAR(self->input);
+    Py_CLEAR(self->input_streams);
     return 0;
 }
 
@@ -2257,7 +2430,7 @@ FrameAccumMain_init(FrameAccumMain *self, PyObject *args, PyObject *kwds)
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
     
     self->hopsize = self->frameSize / self->overlaps;
-    self->frameBuffer = (MYFLT **)realloc(self->frameBuffer, self->overlaps * sizeof(MYFLT));
+    self->frameBuffer = (MYFLT **)realloc(self->frameBuffer, self->overlaps * sizeof(MYFLT *));
     for(i=0; i<self->overlaps; i++) {
         self->frameBuffer[i] = (MYFLT *)malloc(self->frameSize * sizeof(MYFLT));
         for (j=0; j<self->frameSize; j++) {
@@ -2284,6 +2457,7 @@ static PyObject * FrameAccumMain_stop(FrameAccumMain *self) { STOP };
 static PyObject *
 FrameAccumMain_setInput(FrameAccumMain *self, PyObject *arg)
 {
+    int i;
 	PyObject *tmp;
 	
 	if (! PyList_Check(arg)) {
@@ -2297,7 +2471,14 @@ FrameAccumMain_setInput(FrameAccumMain *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_XDECREF(self->input);
     self->input = tmp;
+    Py_XDECREF(self->input_streams);
+    self->input_streams = PyList_New(self->inputSize);
+    for (i=0; i<self->inputSize; i++) {
+        PyList_SET_ITEM(self->input_streams, i, PyObject_CallMethod(PyList_GET_ITEM(self->input, i), "_getStream", NULL));
+    }
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -2313,7 +2494,7 @@ FrameAccumMain_setFrameSize(FrameAccumMain *self, PyObject *arg)
             self->frameSize = tmp;
             self->hopsize = self->frameSize / self->overlaps;
             
-            self->frameBuffer = (MYFLT **)realloc(self->frameBuffer, self->overlaps * sizeof(MYFLT));
+            self->frameBuffer = (MYFLT **)realloc(self->frameBuffer, self->overlaps * sizeof(MYFLT *));
             for(i=0; i<self->overlaps; i++) {
                 self->frameBuffer[i] = (MYFLT *)malloc(self->frameSize * sizeof(MYFLT));
                 for (j=0; j<self->frameSize; j++) {
@@ -47,6 +47,16 @@ typedef struct {
     MYFLT c;
     MYFLT w0;
     MYFLT alpha;
+    // cos(w0) and sin(w0) of an audio rate frequency, computed a block at a time
+    MYFLT *cosbuf;
+    MYFLT *sinbuf;
+    // control rate coefficients: update interval in samples, samples left before
+    // the next update, normalized coefficients (b0, b1, b2, a1, a2) and their ramps
+    int interval;
+    int ctlcount;
+    int ctlinit;
+    MYFLT ncoeffs[5];
+    MYFLT dcoeffs[5];
     // coefficients
     MYFLT b0;
     MYFLT b1;
@@ -120,6 +130,47 @@ Biquad_compute_variables(Biquad *self, MYFLT freq, MYFLT q)
     (*self->coeffs_func_ptr)(self);
 }
 
+static void
+Biquad_compute_angles(Biquad *self, MYFLT *fr)
+{
+    MYFLT freq;
+    int i;
+
+    for (i=0; i<self->bufsize; i++) {
+        freq = fr[i];
+        if (freq <= 1) 
+            freq = 1;
+        else if (freq >= self->sr)
+            freq = self->sr;
+        self->sinbuf[i] = TWOPI * freq / self->sr;
+    }
+    pyo_vec_sincos(self->sinbuf, self->cosbuf, self->sinbuf, self->bufsize);
+}
+
+static void
+Biquad_start_ramp(Biquad *self)
+{
+    int j;
+    MYFLT target[5];
+    MYFLT ia0 = 1.0 / self->a0;
+
+    target[0] = self->b0 * ia0;
+    target[1] = self->b1 * ia0;
+    target[2] = self->b2 * ia0;
+    target[3] = self->a1 * ia0;
+    target[4] = self->a2 * ia0;
+    for (j=0; j<5; j++) {
+        if (self->ctlinit == 1) {
+            self->ncoeffs[j] = target[j];
+            self->dcoeffs[j] = 0.0;
+        }
+        else
+            self->dcoeffs[j] = (target[j] - self->ncoeffs[j]) / self->interval;
+    }
+    self->ctlinit = 0;
+    self->ctlcount = self->interval;
+}
+
 static void
 Biquad_filters_ii(Biquad *self) {
     MYFLT val;
@@ -154,9 +205,12 @@ Biquad_filters_ai(Biquad *self) {
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
+    Biquad_compute_angles(self, fr);
     
     for (i=0; i<self->bufsize; i++) {
-        Biquad_compute_variables(self, fr[i], q);
+        self->c = self->cosbuf[i];
+        self->alpha = self->sinbuf[i] / (2 * q);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -168,7 +222,7 @@ Biquad_filters_ai(Biquad *self) {
 
 static void
 Biquad_filters_ia(Biquad *self) {
-    MYFLT val, fr;
+    MYFLT val, fr, sw0;
     int i;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
@@ -179,9 +233,12 @@ Biquad_filters_ia(Biquad *self) {
     
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
+    Biquad_compute_variables(self, fr, q[0]);
+    sw0 = MYSIN(self->w0);
     
     for (i=0; i<self->bufsize; i++) {
-        Biquad_compute_variables(self, fr, q[i]);
+        self->alpha = sw0 / (2 * q[i]);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -204,9 +261,12 @@ Biquad_filters_aa(Biquad *self) {
 
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
+    Biquad_compute_angles(self, fr);
 
     for (i=0; i<self->bufsize; i++) {
-        Biquad_compute_variables(self, fr[i], q[i]);
+        self->c = self->cosbuf[i];
+        self->alpha = self->sinbuf[i] / (2 * q[i]);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -216,6 +276,47 @@ Biquad_filters_aa(Biquad *self) {
     }
 }
 
+/* Audio rate parameters with an update interval greater than 1: the coefficients
+** are computed every `interval` samples and linearly interpolated in between. */
+static void
+Biquad_filters_ctl(Biquad *self) {
+    MYFLT val, fr, q;
+    int i, j;
+    MYFLT *frs = NULL, *qs = NULL;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+
+    if (self->init == 1) {
+        self->x1 = self->x2 = self->y1 = self->y2 = in[0];
+        self->init = 0;
+    }
+
+    fr = q = 0.0;
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+
+    for (i=0; i<self->bufsize; i++) {
+        if (self->ctlcount == 0) {
+            Biquad_compute_variables(self, frs == NULL ? fr : frs[i], qs == NULL ? q : qs[i]);
+            Biquad_start_ramp(self);
+        }
+        self->ctlcount--;
+        for (j=0; j<5; j++)
+            self->ncoeffs[j] += self->dcoeffs[j];
+        val = (self->ncoeffs[0] * in[i]) + (self->ncoeffs[1] * self->x1) + (self->ncoeffs[2] * self->x2) - (self->ncoeffs[3] * self->y1) - (self->ncoeffs[4] * self->y2);
+        self->y2 = self->y1;
+        self->y1 = val;
+        self->x2 = self->x1;
+        self->x1 = in[i];
+        self->data[i] = val;
+    }
+}
+
 static void Biquad_postprocessing_ii(Biquad *self) { POST_PROCESSING_II };
 static void Biquad_postprocessing_ai(Biquad *self) { POST_PROCESSING_AI };
 static void Biquad_postprocessing_ia(Biquad *self) { POST_PROCESSING_IA };
@@ -266,6 +367,10 @@ Biquad_setProcMode(Biquad *self)
             self->proc_func_ptr = Biquad_filters_aa;
             break;
     } 
+    if (procmode != 0 && self->interval > 1) {
+        self->proc_func_ptr = Biquad_filters_ctl;
+    }
+
 	switch (muladdmode) {
         case 0:        
             self->muladd_func_ptr = Biquad_postprocessing_ii;
@@ -334,6 +439,8 @@ static void
 Biquad_dealloc(Biquad* self)
 {
     free(self->data);
+    free(self->cosbuf);
+    free(self->sinbuf);
     Biquad_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -355,8 +462,12 @@ Biquad_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[2] = 0;
 	self->modebuffer[3] = 0;
     self->init = 1;
+    self->interval = 1;
+    self->ctlinit = 1;
 
     INIT_OBJECT_COMMON
+    self->cosbuf = (MYFLT *)realloc(self->cosbuf, self->bufsize * sizeof(MYFLT));
+    self->sinbuf = (MYFLT *)realloc(self->sinbuf, self->bufsize * sizeof(MYFLT));
     Stream_setFunctionPtr(self->stream, Biquad_compute_next_data_frame);
     self->mode_func_ptr = Biquad_setProcMode;
     return (PyObject *)self;
@@ -422,65 +533,30 @@ static PyObject * Biquad_inplace_div(Biquad *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Biquad_setFreq(Biquad *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Biquad_setQ(Biquad *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
+    SET_PARAM(q, 3)
+}	
+
+static PyObject *
+Biquad_setType(Biquad *self, PyObject *arg)
+{
 	
 	if (arg == NULL) {
 		Py_INCREF(Py_None);
 		return Py_None;
 	}
-    
-	int isNumber = PyNumber_Check(arg);
 	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->q);
-	if (isNumber == 1) {
-		self->q = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->q = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->q, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->q_stream);
-        self->q_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
+	int isInt = PyInt_Check(arg);
     
+	if (isInt == 1) {
+		self->filtertype = PyInt_AsLong(arg);
+	}
+
     (*self->mode_func_ptr)(self);
     
 	Py_INCREF(Py_None);
@@ -488,7 +564,7 @@ Biquad_setQ(Biquad *self, PyObject *arg)
 }	
 
 static PyObject *
-Biquad_setType(Biquad *self, PyObject *arg)
+Biquad_setInterval(Biquad *self, PyObject *arg)
 {
 	
 	if (arg == NULL) {
@@ -499,7 +575,11 @@ Biquad_setType(Biquad *self, PyObject *arg)
 	int isInt = PyInt_Check(arg);
     
 	if (isInt == 1) {
-		self->filtertype = PyInt_AsLong(arg);
+		self->interval = PyInt_AsLong(arg);
+        if (self->interval < 1)
+            self->interval = 1;
+        self->ctlcount = 0;
+        self->ctlinit = 1;
 	}
 
     (*self->mode_func_ptr)(self);
@@ -529,6 +609,7 @@ static PyMethodDef Biquad_methods[] = {
 	{"setFreq", (PyCFunction)Biquad_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setQ", (PyCFunction)Biquad_setQ, METH_O, "Sets filter Q factor."},
     {"setType", (PyCFunction)Biquad_setType, METH_O, "Sets filter type factor."},
+    {"setInterval", (PyCFunction)Biquad_setInterval, METH_O, "Sets the coefficients update interval, in samples, for audio rate parameters."},
 	{"setMul", (PyCFunction)Biquad_setMul, METH_O, "Sets oscillator mul factor."},
 	{"setAdd", (PyCFunction)Biquad_setAdd, METH_O, "Sets oscillator add factor."},
     {"setSub", (PyCFunction)Biquad_setSub, METH_O, "Sets inverse add factor."},
@@ -642,6 +723,16 @@ typedef struct {
     MYFLT c;
     MYFLT w0;
     MYFLT alpha;
+    // cos(w0) and sin(w0) of an audio rate frequency, computed a block at a time
+    MYFLT *cosbuf;
+    MYFLT *sinbuf;
+    // control rate coefficients: update interval in samples, samples left before
+    // the next update, normalized coefficients (b0, b1, b2, a1, a2) and their ramps
+    int interval;
+    int ctlcount;
+    int ctlinit;
+    MYFLT ncoeffs[5];
+    MYFLT dcoeffs[5];
     // coefficients
     MYFLT b0;
     MYFLT b1;
@@ -725,6 +816,47 @@ Biquadx_compute_variables(Biquadx *self, MYFLT freq, MYFLT q)
     (*self->coeffs_func_ptr)(self);
 }
 
+static void
+Biquadx_compute_angles(Biquadx *self, MYFLT *fr)
+{
+    MYFLT freq;
+    int i;
+
+    for (i=0; i<self->bufsize; i++) {
+        freq = fr[i];
+        if (freq <= 1) 
+            freq = 1;
+        else if (freq >= self->sr)
+            freq = self->sr;
+        self->sinbuf[i] = TWOPI * freq / self->sr;
+    }
+    pyo_vec_sincos(self->sinbuf, self->cosbuf, self->sinbuf, self->bufsize);
+}
+
+static void
+Biquadx_start_ramp(Biquadx *self)
+{
+    int j;
+    MYFLT target[5];
+    MYFLT ia0 = 1.0 / self->a0;
+
+    target[0] = self->b0 * ia0;
+    target[1] = self->b1 * ia0;
+    target[2] = self->b2 * ia0;
+    target[3] = self->a1 * ia0;
+    target[4] = self->a2 * ia0;
+    for (j=0; j<5; j++) {
+        if (self->ctlinit == 1) {
+            self->ncoeffs[j] = target[j];
+            self->dcoeffs[j] = 0.0;
+        }
+        else
+            self->dcoeffs[j] = (target[j] - self->ncoeffs[j]) / self->interval;
+    }
+    self->ctlinit = 0;
+    self->ctlcount = self->interval;
+}
+
 static void
 Biquadx_filters_ii(Biquadx *self) {
     MYFLT vin, vout;
@@ -767,10 +899,13 @@ Biquadx_filters_ai(Biquadx *self) {
     
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
+    Biquadx_compute_angles(self, fr);
     
     vout = 0.0;
     for (i=0; i<self->bufsize; i++) {
-        Biquadx_compute_variables(self, fr[i], q);
+        self->c = self->cosbuf[i];
+        self->alpha = self->sinbuf[i] / (2 * q);
+        (*self->coeffs_func_ptr)(self);
         vin = in[i];
         for (j=0; j<self->stages; j++) {   
             vout = ( (self->b0 * vin) + (self->b1 * self->x1[j]) + (self->b2 * self->x2[j]) - (self->a1 * self->y1[j]) - (self->a2 * self->y2[j]) ) / self->a0;
@@ -785,7 +920,7 @@ Biquadx_filters_ai(Biquadx *self) {
 
 static void
 Biquadx_filters_ia(Biquadx *self) {
-    MYFLT vin, vout, fr;
+    MYFLT vin, vout, fr, sw0;
     int i, j;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
@@ -798,10 +933,13 @@ Biquadx_filters_ia(Biquadx *self) {
     
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
+    Biquadx_compute_variables(self, fr, q[0]);
+    sw0 = MYSIN(self->w0);
     
     vout = 0.0;
     for (i=0; i<self->bufsize; i++) {
-        Biquadx_compute_variables(self, fr, q[i]);
+        self->alpha = sw0 / (2 * q[i]);
+        (*self->coeffs_func_ptr)(self);
         vin = in[i];
         for (j=0; j<self->stages; j++) {   
             vout = ( (self->b0 * vin) + (self->b1 * self->x1[j]) + (self->b2 * self->x2[j]) - (self->a1 * self->y1[j]) - (self->a2 * self->y2[j]) ) / self->a0;
@@ -829,10 +967,13 @@ Biquadx_filters_aa(Biquadx *self) {
     
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
+    Biquadx_compute_angles(self, fr);
     
     vout = 0.0;
     for (i=0; i<self->bufsize; i++) {
-        Biquadx_compute_variables(self, fr[i], q[i]);
+        self->c = self->cosbuf[i];
+        self->alpha = self->sinbuf[i] / (2 * q[i]);
+        (*self->coeffs_func_ptr)(self);
         vin = in[i];
         for (j=0; j<self->stages; j++) {   
             vout = ( (self->b0 * vin) + (self->b1 * self->x1[j]) + (self->b2 * self->x2[j]) - (self->a1 * self->y1[j]) - (self->a2 * self->y2[j]) ) / self->a0;
@@ -845,6 +986,53 @@ Biquadx_filters_aa(Biquadx *self) {
     }
 }
 
+/* Audio rate parameters with an update interval greater than 1: the coefficients
+** are computed every `interval` samples and linearly interpolated in between. */
+static void
+Biquadx_filters_ctl(Biquadx *self) {
+    MYFLT vin, vout, fr, q;
+    int i, j;
+    MYFLT *frs = NULL, *qs = NULL;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+
+    if (self->init == 1) {
+        for (i=0; i<self->stages; i++) {
+            self->x1[i] = self->x2[i] = self->y1[i] = self->y2[i] = in[0];
+        }    
+        self->init = 0;
+    }
+
+    fr = q = 0.0;
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+
+    vout = 0.0;
+    for (i=0; i<self->bufsize; i++) {
+        if (self->ctlcount == 0) {
+            Biquadx_compute_variables(self, frs == NULL ? fr : frs[i], qs == NULL ? q : qs[i]);
+            Biquadx_start_ramp(self);
+        }
+        self->ctlcount--;
+        for (j=0; j<5; j++)
+            self->ncoeffs[j] += self->dcoeffs[j];
+        vin = in[i];
+        for (j=0; j<self->stages; j++) {   
+            vout = (self->ncoeffs[0] * vin) + (self->ncoeffs[1] * self->x1[j]) + (self->ncoeffs[2] * self->x2[j]) - (self->ncoeffs[3] * self->y1[j]) - (self->ncoeffs[4] * self->y2[j]);
+            self->x2[j] = self->x1[j];
+            self->x1[j] = vin;
+            self->y2[j] = self->y1[j];
+            self->y1[j] = vin = vout;
+        }
+        self->data[i] = vout;
+    }
+}
+
 static void Biquadx_postprocessing_ii(Biquadx *self) { POST_PROCESSING_II };
 static void Biquadx_postprocessing_ai(Biquadx *self) { POST_PROCESSING_AI };
 static void Biquadx_postprocessing_ia(Biquadx *self) { POST_PROCESSING_IA };
@@ -895,6 +1083,10 @@ Biquadx_setProcMode(Biquadx *self)
             self->proc_func_ptr = Biquadx_filters_aa;
             break;
     } 
+    if (procmode != 0 && self->interval > 1) {
+        self->proc_func_ptr = Biquadx_filters_ctl;
+    }
+
 	switch (muladdmode) {
         case 0:        
             self->muladd_func_ptr = Biquadx_postprocessing_ii;
@@ -963,6 +1155,8 @@ static void
 Biquadx_dealloc(Biquadx* self)
 {
     free(self->data);
+    free(self->cosbuf);
+    free(self->sinbuf);
     free(self->x1);
     free(self->x2);
     free(self->y1);
@@ -989,8 +1183,12 @@ Biquadx_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[2] = 0;
 	self->modebuffer[3] = 0;
     self->init = 1;
+    self->interval = 1;
+    self->ctlinit = 1;
     
     INIT_OBJECT_COMMON
+    self->cosbuf = (MYFLT *)realloc(self->cosbuf, self->bufsize * sizeof(MYFLT));
+    self->sinbuf = (MYFLT *)realloc(self->sinbuf, self->bufsize * sizeof(MYFLT));
     Stream_setFunctionPtr(self->stream, Biquadx_compute_next_data_frame);
     self->mode_func_ptr = Biquadx_setProcMode;
     return (PyObject *)self;
@@ -1058,63 +1256,28 @@ static PyObject * Biquadx_inplace_div(Biquadx *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 Biquadx_setFreq(Biquadx *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Biquadx_setQ(Biquadx *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
+    SET_PARAM(q, 3)
+}	
+
+static PyObject *
+Biquadx_setType(Biquadx *self, PyObject *arg)
+{
 	
 	if (arg == NULL) {
 		Py_INCREF(Py_None);
 		return Py_None;
 	}
-    
-	int isNumber = PyNumber_Check(arg);
 	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->q);
-	if (isNumber == 1) {
-		self->q = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->q = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->q, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->q_stream);
-        self->q_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
+	int isInt = PyInt_Check(arg);
+    
+	if (isInt == 1) {
+		self->filtertype = PyInt_AsLong(arg);
 	}
     
     (*self->mode_func_ptr)(self);
@@ -1124,7 +1287,7 @@ Biquadx_setQ(Biquadx *self, PyObject *arg)
 }	
 
 static PyObject *
-Biquadx_setType(Biquadx *self, PyObject *arg)
+Biquadx_setInterval(Biquadx *self, PyObject *arg)
 {
 	
 	if (arg == NULL) {
@@ -1135,9 +1298,13 @@ Biquadx_setType(Biquadx *self, PyObject *arg)
 	int isInt = PyInt_Check(arg);
     
 	if (isInt == 1) {
-		self->filtertype = PyInt_AsLong(arg);
+		self->interval = PyInt_AsLong(arg);
+        if (self->interval < 1)
+            self->interval = 1;
+        self->ctlcount = 0;
+        self->ctlinit = 1;
 	}
-    
+
     (*self->mode_func_ptr)(self);
     
 	Py_INCREF(Py_None);
@@ -1185,6 +1352,7 @@ static PyMethodDef Biquadx_methods[] = {
 	{"setFreq", (PyCFunction)Biquadx_setFreq, METH_O, "Sets filter cutoff frequency in cycle per second."},
     {"setQ", (PyCFunction)Biquadx_setQ, METH_O, "Sets filter Q factor."},
     {"setType", (PyCFunction)Biquadx_setType, METH_O, "Sets filter type factor."},
+    {"setInterval", (PyCFunction)Biquadx_setInterval, METH_O, "Sets the coefficients update interval, in samples, for audio rate parameters."},
     {"setStages", (PyCFunction)Biquadx_setStages, METH_O, "Sets the number of filtering stages."},
 	{"setMul", (PyCFunction)Biquadx_setMul, METH_O, "Sets oscillator mul factor."},
 	{"setAdd", (PyCFunction)Biquadx_setAdd, METH_O, "Sets oscillator add factor."},
@@ -1302,6 +1470,17 @@ typedef struct {
     MYFLT c;
     MYFLT w0;
     MYFLT alpha;
+    // cos(w0), sin(w0) and A of audio rate frequency and boost, computed a block at a time
+    MYFLT *cosbuf;
+    MYFLT *sinbuf;
+    MYFLT *gainbuf;
+    // control rate coefficients: update interval in samples, samples left before
+    // the next update, normalized coefficients (b0, b1, b2, a1, a2) and their ramps
+    int interval;
+    int ctlcount;
+    int ctlinit;
+    MYFLT ncoeffs[5];
+    MYFLT dcoeffs[5];
     // coefficients
     MYFLT b0;
     MYFLT b1;
@@ -1369,6 +1548,58 @@ EQ_compute_variables(EQ *self, MYFLT freq, MYFLT q, MYFLT boost)
     (*self->coeffs_func_ptr)(self);
 }
 
+static void
+EQ_compute_angles(EQ *self, MYFLT *fr)
+{
+    MYFLT freq;
+    int i;
+
+    for (i=0; i<self->bufsize; i++) {
+        freq = fr[i];
+        if (freq <= 1) 
+            freq = 1;
+        else if (freq >= self->sr)
+            freq = self->sr;
+        self->sinbuf[i] = TWOPI * freq / self->sr;
+    }
+    pyo_vec_sincos(self->sinbuf, self->cosbuf, self->sinbuf, self->bufsize);
+}
+
+static void
+EQ_compute_gains(EQ *self, MYFLT *boost)
+{
+    int i;
+
+    for (i=0; i<self->bufsize; i++) {
+        self->gainbuf[i] = boost[i] / 40.0;
+    }
+    pyo_vec_pow(self->gainbuf, 10.0, self->gainbuf, self->bufsize);
+}
+
+static void
+EQ_start_ramp(EQ *self)
+{
+    int j;
+    MYFLT target[5];
+    MYFLT ia0 = 1.0 / self->a0;
+
+    target[0] = self->b0 * ia0;
+    target[1] = self->b1 * ia0;
+    target[2] = self->b2 * ia0;
+    target[3] = self->a1 * ia0;
+    target[4] = self->a2 * ia0;
+    for (j=0; j<5; j++) {
+        if (self->ctlinit == 1) {
+            self->ncoeffs[j] = target[j];
+            self->dcoeffs[j] = 0.0;
+        }
+        else
+            self->dcoeffs[j] = (target[j] - self->ncoeffs[j]) / self->interval;
+    }
+    self->ctlinit = 0;
+    self->ctlcount = self->interval;
+}
+
 static void
 EQ_filters_iii(EQ *self) {
     MYFLT val;
@@ -1404,9 +1635,13 @@ EQ_filters_aii(EQ *self) {
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
     boost = PyFloat_AS_DOUBLE(self->boost);
+    self->A = MYPOW(10.0, boost/40.0);
+    EQ_compute_angles(self, fr);
     
     for (i=0; i<self->bufsize; i++) {
-        EQ_compute_variables(self, fr[i], q, boost);
+        self->c = self->cosbuf[i];
+        self->alpha = self->sinbuf[i] / (2 * q);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -1418,7 +1653,7 @@ EQ_filters_aii(EQ *self) {
 
 static void
 EQ_filters_iai(EQ *self) {
-    MYFLT val, fr, boost;
+    MYFLT val, fr, boost, sw0;
     int i;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
@@ -1430,9 +1665,12 @@ EQ_filters_iai(EQ *self) {
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
     boost = PyFloat_AS_DOUBLE(self->boost);
+    EQ_compute_variables(self, fr, q[0], boost);
+    sw0 = MYSIN(self->w0);
     
     for (i=0; i<self->bufsize; i++) {
-        EQ_compute_variables(self, fr, q[i], boost);
+        self->alpha = sw0 / (2 * q[i]);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -1456,9 +1694,13 @@ EQ_filters_aai(EQ *self) {
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
     boost = PyFloat_AS_DOUBLE(self->boost);
+    self->A = MYPOW(10.0, boost/40.0);
+    EQ_compute_angles(self, fr);
     
     for (i=0; i<self->bufsize; i++) {
-        EQ_compute_variables(self, fr[i], q[i], boost);
+        self->c = self->cosbuf[i];
+        self->alpha = self->sinbuf[i] / (2 * q[i]);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -1470,7 +1712,7 @@ EQ_filters_aai(EQ *self) {
 
 static void
 EQ_filters_iia(EQ *self) {
-    MYFLT val, fr, q;
+    MYFLT val, fr, q, sw0;
     int i;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
@@ -1482,9 +1724,14 @@ EQ_filters_iia(EQ *self) {
     fr = PyFloat_AS_DOUBLE(self->freq);
     q = PyFloat_AS_DOUBLE(self->q);
     MYFLT *boost = Stream_getData((Stream *)self->boost_stream);
+    EQ_compute_variables(self, fr, q, boost[0]);
+    sw0 = MYSIN(self->w0);
+    EQ_compute_gains(self, boost);
 
     for (i=0; i<self->bufsize; i++) {
-        EQ_compute_variables(self, fr, q, boost[i]);
+        self->A = self->gainbuf[i];
+        self->alpha = sw0 / (2 * q);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -1508,9 +1755,14 @@ EQ_filters_aia(EQ *self) {
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     q = PyFloat_AS_DOUBLE(self->q);
     MYFLT *boost = Stream_getData((Stream *)self->boost_stream);
+    EQ_compute_angles(self, fr);
+    EQ_compute_gains(self, boost);
     
     for (i=0; i<self->bufsize; i++) {
-        EQ_compute_variables(self, fr[i], q, boost[i]);
+        self->A = self->gainbuf[i];
+        self->c = self->cosbuf[i];
+        self->alpha = self->sinbuf[i] / (2 * q);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -1522,7 +1774,7 @@ EQ_filters_aia(EQ *self) {
 
 static void
 EQ_filters_iaa(EQ *self) {
-    MYFLT val, fr;
+    MYFLT val, fr, sw0;
     int i;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
@@ -1534,9 +1786,14 @@ EQ_filters_iaa(EQ *self) {
     fr = PyFloat_AS_DOUBLE(self->freq);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
     MYFLT *boost = Stream_getData((Stream *)self->boost_stream);
+    EQ_compute_variables(self, fr, q[0], boost[0]);
+    sw0 = MYSIN(self->w0);
+    EQ_compute_gains(self, boost);
     
     for (i=0; i<self->bufsize; i++) {
-        EQ_compute_variables(self, fr, q[i], boost[i]);
+        self->A = self->gainbuf[i];
+        self->alpha = sw0 / (2 * q[i]);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -1560,9 +1817,14 @@ EQ_filters_aaa(EQ *self) {
     MYFLT *fr = Stream_getData((Stream *)self->freq_stream);
     MYFLT *q = Stream_getData((Stream *)self->q_stream);
     MYFLT *boost = Stream_getData((Stream *)self->boost_stream);
+    EQ_compute_angles(self, fr);
+    EQ_compute_gains(self, boost);
     
     for (i=0; i<self->bufsize; i++) {
-        EQ_compute_variables(self, fr[i], q[i], boost[i]);
+        self->A = self->gainbuf[i];
+        self->c = self->cosbuf[i];
+        self->alpha = self->sinbuf[i] / (2 * q[i]);
+        (*self->coeffs_func_ptr)(self);
         val = ( (self->b0 * in[i]) + (self->b1 * self->x1) + (self->b2 * self->x2) - (self->a1 * self->y1) - (self->a2 * self->y2) ) / self->a0;
         self->y2 = self->y1;
         self->y1 = val;
@@ -1572,6 +1834,51 @@ EQ_filters_aaa(EQ *self) {
     }
 }
 
+/* Audio rate parameters with an update interval greater than 1: the coefficients
+** are computed every `interval` samples and linearly interpolated in between. */
+static void
+EQ_filters_ctl(EQ *self) {
+    MYFLT val, fr, q, boost;
+    int i, j;
+    MYFLT *frs = NULL, *qs = NULL, *boosts = NULL;
+    MYFLT *in = Stream_getData((Stream *)self->input_stream);
+
+    if (self->init == 1) {
+        self->x1 = self->x2 = self->y1 = self->y2 = in[0];
+        self->init = 0;
+    }
+
+    fr = q = boost = 0.0;
+    if (self->modebuffer[2] == 0)
+        fr = PyFloat_AS_DOUBLE(self->freq);
+    else
+        frs = Stream_getData((Stream *)self->freq_stream);
+    if (self->modebuffer[3] == 0)
+        q = PyFloat_AS_DOUBLE(self->q);
+    else
+        qs = Stream_getData((Stream *)self->q_stream);
+    if (self->modebuffer[4] == 0)
+        boost = PyFloat_AS_DOUBLE(self->boost);
+    else
+        boosts = Stream_getData((Stream *)self->boost_stream);
+
+    for (i=0; i<self->bufsize; i++) {
+        if (self->ctlcount == 0) {
+            EQ_compute_variables(self, frs == NULL ? fr : frs[i], qs == NULL ? q : qs[i], boosts == NULL ? boost : boosts[i]);
+            EQ_start_ramp(self);
+        }
+        self->ctlcount--;
+        for (j=0; j<5; j++)
+            self->ncoeffs[j] += self->dcoeffs[j];
+        val = (self->ncoeffs[0] * in[i]) + (self->ncoeffs[1] * self->x1) + (self->ncoeffs[2] * self->x2) - (self->ncoeffs[3] * self->y1) - (self->ncoeffs[4] * self->y2);
+        self->y2 = self->y1;
+        self->y1 = val;
+        self->x2 = self->x1;
+        self->x1 = in[i];
+        self->data[i] = val;
+    }
+}
+
 static void EQ_postprocessing_ii(EQ *self) { POST_PROCESSING_II };
 static void EQ_postprocessing_ai(EQ *self) { POST_PROCESSING_AI };
 static void EQ_postprocessing_ia(EQ *self) { POST_PROCESSING_IA };
@@ -1628,6 +1935,10 @@ EQ_setProcMode(EQ *self)
             self->proc_func_ptr = EQ_filters_aaa;
             break;
     } 
+    if (procmode != 0 && self->interval > 1) {
+        self->proc_func_ptr = EQ_filters_ctl;
+    }
+
 	switch (muladdmode) {
         case 0:        
             self->muladd_func_ptr = EQ_postprocessing_ii;
@@ -1700,6 +2011,9 @@ static void
 EQ_dealloc(EQ* self)
 {
     free(self->data);
+    free(self->cosbuf);
+    free(self->sinbuf);
+    free(self->gainbuf);
     EQ_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -1723,8 +2037,13 @@ EQ_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[3] = 0;
 	self->modebuffer[4] = 0;
     self->init = 1;
+    self->interval = 1;
+    self->ctlinit = 1;
     
     INIT_OBJECT_COMMON
+    self->cosbuf = (MYFLT *)realloc(self->cosbuf, self->bufsize * sizeof(MYFLT));
+    self->sinbuf = (MYFLT *)realloc(self->sinbuf, self->bufsize * sizeof(MYFLT));
+    self->gainbuf = (MYFLT *)realloc(self->gainbuf, self->bufsize * sizeof(MYFLT));
     Stream_setFunctionPtr(self->stream, EQ_compute_next_data_frame);
     self->mode_func_ptr = EQ_setProcMode;
     return (PyObject *)self;
@@ -1794,97 +2113,34 @@ static PyObject * EQ_inplace_div(EQ *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 EQ_setFreq(EQ *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 EQ_setQ(EQ *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->q);
-	if (isNumber == 1) {
-		self->q = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->q = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->q, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->q_stream);
-        self->q_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(q, 3)
 }	
 
 static PyObject *
 EQ_setBoost(EQ *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
+    SET_PARAM(boost, 4)
+}	
+
+static PyObject *
+EQ_setType(EQ *self, PyObject *arg)
+{
 	
 	if (arg == NULL) {
 		Py_INCREF(Py_None);
 		return Py_None;
 	}
-    
-	int isNumber = PyNumber_Check(arg);
 	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->boost);
-	if (isNumber == 1) {
-		self->boost = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->boost = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->boost, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->boost_stream);
-        self->boost_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
+	int isInt = PyInt_Check(arg);
+    
+	if (isInt == 1) {
+		self->filtertype = PyInt_AsLong(arg);
 	}
     
     (*self->mode_func_ptr)(self);
@@ -1894,7 +2150,7 @@ EQ_setBoost(EQ *self, PyObject *arg)
 }	
 
 static PyObject *
-EQ_setType(EQ *self, PyObject *arg)
+EQ_setInterval(EQ *self, PyObject *arg)
 {
 	
 	if (arg == NULL) {
@@ -1905,9 +2161,13 @@ EQ_setType(EQ *self, PyObject *arg)
 	int isInt = PyInt_Check(arg);
     
 	if (isInt == 1) {
-		self->filtertype = PyInt_AsLong(arg);
+		self->interval = PyInt_AsLong(arg);
+        if (self->interval < 1)
+            self->interval = 1;
+        self->ctlcount = 0;
+        self->ctlinit = 1;
 	}
-    
+
     (*self->mode_func_ptr)(self);
     
 	Py_INCREF(Py_None);
@@ -1937,6 +2197,7 @@ static PyMethodDef EQ_methods[] = {
 {"setQ", (PyCFunction)EQ_setQ, METH_O, "Sets filter Q factor."},
 {"setBoost", (PyCFunction)EQ_setBoost, METH_O, "Sets filter boost factor."},
 {"setType", (PyCFunction)EQ_setType, METH_O, "Sets filter type factor."},
+{"setInterval", (PyCFunction)EQ_setInterval, METH_O, "Sets the coefficients update interval, in samples, for audio rate parameters."},
 {"setMul", (PyCFunction)EQ_setMul, METH_O, "Sets oscillator mul factor."},
 {"setAdd", (PyCFunction)EQ_setAdd, METH_O, "Sets oscillator add factor."},
 {"setSub", (PyCFunction)EQ_setSub, METH_O, "Sets inverse add factor."},
@@ -2329,69 +2590,13 @@ static PyObject * Port_inplace_div(Port *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Port_setRiseTime(Port *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->risetime);
-	if (isNumber == 1) {
-		self->risetime = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->risetime = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->risetime, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->risetime_stream);
-        self->risetime_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(risetime, 2)
 }	
 
 static PyObject *
 Port_setFallTime(Port *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->falltime);
-	if (isNumber == 1) {
-		self->falltime = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->falltime = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->falltime, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->falltime_stream);
-        self->falltime_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(falltime, 3)
 }	
 
 static PyMemberDef Port_members[] = {
@@ -2736,35 +2941,7 @@ static PyObject * Tone_inplace_div(Tone *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Tone_setFreq(Tone *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }
 
 static PyMemberDef Tone_members[] = {
@@ -3528,69 +3705,13 @@ static PyObject * Allpass_inplace_div(Allpass *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 Allpass_setDelay(Allpass *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->delay);
-	if (isNumber == 1) {
-		self->delay = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->delay = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->delay, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->delay_stream);
-        self->delay_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(delay, 2)
 }	
 
 static PyObject *
 Allpass_setFeedback(Allpass *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->feedback);
-	if (isNumber == 1) {
-		self->feedback = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->feedback = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->feedback, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->feedback_stream);
-        self->feedback_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(feedback, 3)
 }	
 
 static PyMemberDef Allpass_members[] = {
@@ -4017,69 +4138,13 @@ static PyObject * Allpass2_inplace_div(Allpass2 *self, PyObject *arg) { INPLACE_
 static PyObject *
 Allpass2_setFreq(Allpass2 *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Allpass2_setBw(Allpass2 *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->bw);
-	if (isNumber == 1) {
-		self->bw = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->bw = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->bw, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->bw_stream);
-        self->bw_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(bw, 3)
 }	
 
 static PyMemberDef Allpass2_members[] = {
@@ -4811,135 +4876,25 @@ static PyObject * Phaser_inplace_div(Phaser *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Phaser_setFreq(Phaser *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Phaser_setSpread(Phaser *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->spread);
-	if (isNumber == 1) {
-		self->spread = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->spread = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->spread, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->spread_stream);
-        self->spread_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(spread, 3)
 }	
 
 static PyObject *
 Phaser_setQ(Phaser *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->q);
-	if (isNumber == 1) {
-		self->q = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->q = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->q, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->q_stream);
-        self->q_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(q, 4)
 }	
 
 static PyObject *
 Phaser_setFeedback(Phaser *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->feedback);
-	if (isNumber == 1) {
-		self->feedback = PyNumber_Float(tmp);
-        self->modebuffer[5] = 0;
-	}
-	else {
-		self->feedback = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->feedback, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->feedback_stream);
-        self->feedback_stream = (Stream *)streamtmp;
-		self->modebuffer[5] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(feedback, 5)
 }	
 
 static PyMemberDef Phaser_members[] = {
@@ -731,103 +731,19 @@ static PyObject * Freeverb_inplace_div(Freeverb *self, PyObject *arg) { INPLACE_
 static PyObject *
 Freeverb_setSize(Freeverb *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->size);
-	if (isNumber == 1) {
-		self->size = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->size = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->size, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->size_stream);
-        self->size_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(size, 2)
 }	
 
 static PyObject *
 Freeverb_setDamp(Freeverb *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->damp);
-	if (isNumber == 1) {
-		self->damp = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->damp = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->damp, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->damp_stream);
-        self->damp_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(damp, 3)
 }	
 
 static PyObject *
 Freeverb_setMix(Freeverb *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->mix);
-	if (isNumber == 1) {
-		self->mix = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->mix = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->mix, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->mix_stream);
-        self->mix_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(mix, 4)
 }
 static PyMemberDef Freeverb_members[] = {
     {"server", T_OBJECT_EX, offsetof(Freeverb, server), 0, "Pyo server."},
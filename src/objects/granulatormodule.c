@@ -27,6 +27,7 @@
 #include "dummymodule.h"
 #include "tablemodule.h"
 #include "interpolation.h"
+#include "framepool.h"
 
 typedef struct {
     pyo_audio_HEAD
@@ -774,103 +775,19 @@ static PyObject * Granulator_inplace_div(Granulator *self, PyObject *arg) { INPL
 static PyObject *
 Granulator_setPitch(Granulator *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->pitch);
-	if (isNumber == 1) {
-		self->pitch = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->pitch = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->pitch, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->pitch_stream);
-        self->pitch_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(pitch, 2)
 }	
 
 static PyObject *
 Granulator_setPos(Granulator *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->pos);
-	if (isNumber == 1) {
-		self->pos = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->pos = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->pos, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->pos_stream);
-        self->pos_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(pos, 3)
 }	
 
 static PyObject *
 Granulator_setDur(Granulator *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->dur);
-	if (isNumber == 1) {
-		self->dur = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->dur = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->dur, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->dur_stream);
-        self->dur_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(dur, 4)
 }
 
 static PyObject *
@@ -891,8 +808,7 @@ Granulator_setTable(Granulator *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -916,8 +832,7 @@ Granulator_setEnv(Granulator *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->env);
-    self->env = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(env, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1833,6 +1748,8 @@ Looper_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[4] = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, Looper_compute_next_data_frame);
     self->mode_func_ptr = Looper_setProcMode;
     
@@ -1915,131 +1832,25 @@ static PyObject * Looper_inplace_div(Looper *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Looper_setPitch(Looper *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->pitch);
-	if (isNumber == 1) {
-		self->pitch = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->pitch = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->pitch, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->pitch_stream);
-        self->pitch_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(pitch, 2)
 }	
 
 static PyObject *
 Looper_setStart(Looper *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->start);
-	if (isNumber == 1) {
-		self->start = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->start = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->start, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->start_stream);
-        self->start_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(start, 3)
 }	
 
 static PyObject *
 Looper_setDur(Looper *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->dur);
-	if (isNumber == 1) {
-		self->dur = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->dur = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->dur, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->dur_stream);
-        self->dur_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(dur, 4)
 }
 
 static PyObject *
 Looper_setXfade(Looper *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->xfade);
-	if (isNumber == 1) {
-		self->xfade = PyNumber_Float(tmp);
-        self->modebuffer[5] = 0;
-	}
-	else {
-		self->xfade = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->xfade, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->xfade_stream);
-        self->xfade_stream = (Stream *)streamtmp;
-		self->modebuffer[5] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(xfade, 5)
 }
 
 static PyObject *
@@ -2060,8 +1871,7 @@ Looper_setTable(Looper *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -2284,3 +2094,879 @@ PyTypeObject LooperType = {
 };
 
 
+/************************************************************************************************/
+/* Particle main object */
+/************************************************************************************************/
+
+/* Grains are kept in a preallocated pool, the finished ones are replaced by
+** the last grain of the list at the end of every block. The active grains are
+** split in batches of at least PARTICLE_BATCH_GRAINS grains, batches after the
+** first are computed on the server's frame threads (when there are some) in
+** their own buffers, then summed. The split only depends on the number of
+** grains, so the output does not change with the number of threads. */
+#define PARTICLE_MAX_GRAINS 4096
+#define PARTICLE_MAX_BATCHES 8
+#define PARTICLE_BATCH_GRAINS 256
+
+typedef struct {
+    PyoFrameJob job;
+    struct _MainParticle *main;
+    int first;
+    int last;
+    MYFLT *buffer;
+} ParticleBatch;
+
+typedef struct _MainParticle {
+    pyo_audio_HEAD
+    PyObject *table;
+    PyObject *env;
+    PyObject *dens;
+    Stream *dens_stream;
+    PyObject *pitch;
+    Stream *pitch_stream;
+    PyObject *pos;
+    Stream *pos_stream;
+    PyObject *dur;
+    Stream *dur_stream;
+    PyObject *dev;
+    Stream *dev_stream;
+    PyObject *pan;
+    Stream *pan_stream;
+    int modebuffer[6];
+    int chnls;
+    MYFLT timer;
+    MYFLT *tablelist;
+    int tablesize;
+    MYFLT *envlist;
+    int envsize;
+    int ngrains;
+    MYFLT *gpos; /* table position */
+    MYFLT *ginc; /* table increment (pitch) */
+    MYFLT *gepos; /* envelope position */
+    MYFLT *geinc; /* envelope increment */
+    MYFLT *ggains; /* chnls gains per grain */
+    int *goffset; /* first sample of the grain in the current block */
+    int *gdone;
+    MYFLT *buffer_streams;
+    MYFLT *batch_buffers;
+    ParticleBatch batches[PARTICLE_MAX_BATCHES];
+} MainParticle;
+
+static MYFLT
+MainParticle_getValue(PyObject *param, Stream *stream, int audio, int i)
+{
+    if (audio == 0)
+        return PyFloat_AS_DOUBLE(param);
+    else
+        return Stream_getData(stream)[i];
+}
+
+#define PARTICLE_VALUE(param, modeindex, i) \
+    MainParticle_getValue(self->param, self->param##_stream, self->modebuffer[modeindex], i)
+
+#define PARTICLE_INSIDE(x, size) ((x) >= 0.0 && (x) < (size))
+
+/* Returns how many of the num next samples read positions inside [0, size[,
+** computed as the grain kernel does (pos + inc * i). */
+static int
+MainParticle_span(MYFLT pos, MYFLT inc, int size, int num)
+{
+    int n;
+    MYFLT est;
+
+    if (!PARTICLE_INSIDE(pos, size))
+        return 0;
+    if (inc > 0.0)
+        est = (size - pos) / inc + 1.0;
+    else if (inc < 0.0)
+        est = pos / -inc + 1.0;
+    else
+        return num;
+
+    n = est < num ? (int)est : num;
+    while (n > 0 && !PARTICLE_INSIDE(pos + inc * (n - 1), size))
+        n--;
+    while (n < num && PARTICLE_INSIDE(pos + inc * n, size))
+        n++;
+    return n;
+}
+
+static void
+MainParticle_spawn(MainParticle *self, int i)
+{
+    int j, g = self->ngrains;
+    MYFLT gsize, pos, pan, phase, *gains;
+
+    if (g >= PARTICLE_MAX_GRAINS)
+        return;
+
+    gsize = PARTICLE_VALUE(dur, 3, i) * self->sr;
+    pos = PARTICLE_VALUE(pos, 2, i);
+    if (gsize < 1.0 || !PARTICLE_INSIDE(pos, self->tablesize))
+        return;
+
+    self->gpos[g] = pos;
+    self->ginc[g] = PARTICLE_VALUE(pitch, 1, i);
+    self->gepos[g] = 0.0;
+    self->geinc[g] = self->envsize / gsize;
+    self->goffset[g] = i;
+    self->gdone[g] = 0;
+
+    pan = PARTICLE_VALUE(pan, 5, i);
+    if (pan < 0.0)
+        pan = 0.0;
+    else if (pan > 1.0)
+        pan = 1.0;
+
+    gains = self->ggains + g * self->chnls;
+    if (self->chnls == 1)
+        gains[0] = 1.0;
+    else if (self->chnls == 2) {
+        gains[0] = MYSQRT(1.0 - pan);
+        gains[1] = MYSQRT(pan);
+    }
+    else {
+        /* Pan's cosine law, spread of 0.5 */
+        for (j=0; j<self->chnls; j++) {
+            phase = j / (MYFLT)self->chnls;
+            gains[j] = MYPOW(MYCOS((pan - phase) * TWOPI) * 0.5 + 0.5, 20.0 - (MYSQRT(0.5) * 20.0) + 0.1);
+        }
+    }
+
+    self->ngrains++;
+}
+
+/* Adds the grains first to last - 1 to out, chnls blocks of bufsize samples. */
+static void
+MainParticle_render(MainParticle *self, int first, int last, MYFLT *out)
+{
+    int g, num, n;
+
+    for (g=first; g<last; g++) {
+        num = self->bufsize - self->goffset[g];
+        n = MainParticle_span(self->gepos[g], self->geinc[g], self->envsize, num);
+        n = MainParticle_span(self->gpos[g], self->ginc[g], self->tablesize, n);
+        pyo_vec_grain(out + self->goffset[g], self->bufsize, self->chnls, self->ggains + g * self->chnls,
+                      self->tablelist, self->gpos[g], self->ginc[g], self->envlist, self->gepos[g], self->geinc[g], n);
+        if (n < num)
+            self->gdone[g] = 1;
+        else {
+            self->gpos[g] += self->ginc[g] * n;
+            self->gepos[g] += self->geinc[g] * n;
+            self->goffset[g] = 0;
+        }
+    }
+}
+
+static void
+ParticleBatch_render(void *arg)
+{
+    int i;
+    ParticleBatch *batch = (ParticleBatch *)arg;
+    MainParticle *self = batch->main;
+
+    for (i=0; i<(self->chnls*self->bufsize); i++)
+        batch->buffer[i] = 0.0;
+    MainParticle_render(self, batch->first, batch->last, batch->buffer);
+}
+
+static void
+MainParticle_generate(MainParticle *self)
+{
+    int i, j, b, nbatches;
+    MYFLT dens, dev, gains[PARTICLE_MAX_BATCHES];
+    MYFLT *ins[PARTICLE_MAX_BATCHES];
+    PyoFramePool *pool;
+
+    self->tablelist = TableStream_getData(self->table);
+    self->tablesize = TableStream_getSize(self->table);
+    self->envlist = TableStream_getData(self->env);
+    self->envsize = TableStream_getSize(self->env);
+
+    for (i=0; i<self->bufsize; i++) {
+        dens = PARTICLE_VALUE(dens, 0, i);
+        if (dens < 0.0)
+            dens = 0.0;
+        else if (dens > self->sr)
+            dens = self->sr;
+        self->timer += dens / self->sr;
+        while (self->timer >= 1.0) {
+            dev = PARTICLE_VALUE(dev, 4, i);
+            if (dev <= 0.0)
+                self->timer -= 1.0;
+            else {
+                if (dev > 1.0)
+                    dev = 1.0;
+                self->timer -= 1.0 + dev * (RANDOM_UNIFORM - 0.5);
+            }
+            MainParticle_spawn(self, i);
+        }
+    }
+
+    nbatches = (self->ngrains + PARTICLE_BATCH_GRAINS - 1) / PARTICLE_BATCH_GRAINS;
+    if (nbatches < 1)
+        nbatches = 1;
+    else if (nbatches > PARTICLE_MAX_BATCHES)
+        nbatches = PARTICLE_MAX_BATCHES;
+    for (b=0; b<nbatches; b++) {
+        self->batches[b].first = self->ngrains * b / nbatches;
+        self->batches[b].last = self->ngrains * (b + 1) / nbatches;
+    }
+
+    pool = Server_getFramePool(self->server);
+    for (b=1; b<nbatches; b++)
+        PyoFramePool_submit(pool, &self->batches[b].job);
+
+    for (i=0; i<(self->chnls*self->bufsize); i++)
+        self->buffer_streams[i] = 0.0;
+    MainParticle_render(self, self->batches[0].first, self->batches[0].last, self->buffer_streams);
+
+    for (b=1; b<nbatches; b++) {
+        PyoFrameJob_wait(&self->batches[b].job);
+        ins[b-1] = self->batches[b].buffer;
+        gains[b-1] = 1.0;
+    }
+    if (nbatches > 1)
+        pyo_vec_mix(self->buffer_streams, ins, gains, nbatches - 1, self->chnls * self->bufsize);
+
+    /* Active-list compaction, the last grain takes the place of a finished one. */
+    for (i=0; i<self->ngrains; ) {
+        if (self->gdone[i]) {
+            b = --self->ngrains;
+            self->gpos[i] = self->gpos[b];
+            self->ginc[i] = self->ginc[b];
+            self->gepos[i] = self->gepos[b];
+            self->geinc[i] = self->geinc[b];
+            self->goffset[i] = self->goffset[b];
+            self->gdone[i] = self->gdone[b];
+            for (j=0; j<self->chnls; j++)
+                self->ggains[i*self->chnls+j] = self->ggains[b*self->chnls+j];
+        }
+        else
+            i++;
+    }
+}
+
+MYFLT *
+MainParticle_getSamplesBuffer(MainParticle *self)
+{
+    Stream_touch(self->stream);
+    return (MYFLT *)self->buffer_streams;
+}    
+
+static void
+MainParticle_setProcMode(MainParticle *self)
+{
+    self->proc_func_ptr = MainParticle_generate;
+}
+
+static void
+MainParticle_compute_next_data_frame(MainParticle *self)
+{
+    (*self->proc_func_ptr)(self); 
+}
+
+static int
+MainParticle_traverse(MainParticle *self, visitproc visit, void *arg)
+{
+    pyo_VISIT
+    Py_VISIT(self->table);
+    Py_VISIT(self->env);
+    Py_VISIT(self->dens);    
+    Py_VISIT(self->dens_stream);    
+    Py_VISIT(self->pitch);    
+    Py_VISIT(self->pitch_stream);    
+    Py_VISIT(self->pos);    
+    Py_VISIT(self->pos_stream);    
+    Py_VISIT(self->dur);    
+    Py_VISIT(self->dur_stream);    
+    Py_VISIT(self->dev);    
+    Py_VISIT(self->dev_stream);    
+    Py_VISIT(self->pan);    
+    Py_VISIT(self->pan_stream);    
+    return 0;
+}
+
+static int 
+MainParticle_clear(MainParticle *self)
+{
+    pyo_CLEAR
+    Py_CLEAR(self->table);
+    Py_CLEAR(self->env);
+    Py_CLEAR(self->dens);    
+    Py_CLEAR(self->dens_stream);    
+    Py_CLEAR(self->pitch);    
+    Py_CLEAR(self->pitch_stream);    
+    Py_CLEAR(self->pos);    
+    Py_CLEAR(self->pos_stream);    
+    Py_CLEAR(self->dur);    
+    Py_CLEAR(self->dur_stream);    
+    Py_CLEAR(self->dev);    
+    Py_CLEAR(self->dev_stream);    
+    Py_CLEAR(self->pan);    
+    Py_CLEAR(self->pan_stream);    
+    return 0;
+}
+
+static void
+MainParticle_dealloc(MainParticle* self)
+{
+    int i;
+    for (i=0; i<PARTICLE_MAX_BATCHES; i++)
+        PyoFrameJob_release(&self->batches[i].job);
+    free(self->data);
+    free(self->gpos);
+    free(self->ginc);
+    free(self->gepos);
+    free(self->geinc);
+    free(self->ggains);
+    free(self->goffset);
+    free(self->gdone);
+    free(self->buffer_streams);
+    free(self->batch_buffers);
+    MainParticle_clear(self);
+    self->ob_type->tp_free((PyObject*)self);
+}
+
+static PyObject * MainParticle_deleteStream(MainParticle *self) { DELETE_STREAM };
+
+static PyObject *
+MainParticle_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    MainParticle *self;
+    self = (MainParticle *)type->tp_alloc(type, 0);
+
+    self->dens = PyFloat_FromDouble(50.0);
+    self->pitch = PyFloat_FromDouble(1.0);
+    self->pos = PyFloat_FromDouble(0.0);
+    self->dur = PyFloat_FromDouble(0.1);
+    self->dev = PyFloat_FromDouble(0.01);
+    self->pan = PyFloat_FromDouble(0.5);
+    self->chnls = 1;
+    self->timer = 1.0;
+    self->ngrains = 0;
+    for (i=0; i<6; i++)
+        self->modebuffer[i] = 0;
+    for (i=0; i<PARTICLE_MAX_BATCHES; i++) {
+        self->batches[i].main = self;
+        PyoFrameJob_init(&self->batches[i].job, ParticleBatch_render, &self->batches[i]);
+    }
+
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, MainParticle_compute_next_data_frame);
+    self->mode_func_ptr = MainParticle_setProcMode;
+
+    return (PyObject *)self;
+}
+
+static int
+MainParticle_init(MainParticle *self, PyObject *args, PyObject *kwds)
+{
+    int i;
+    PyObject *tabletmp, *envtmp, *denstmp=NULL, *pitchtmp=NULL, *postmp=NULL, *durtmp=NULL, *devtmp=NULL, *pantmp=NULL;
+
+    static char *kwlist[] = {"table", "env", "dens", "pitch", "pos", "dur", "dev", "pan", "chnls", NULL};
+
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOOOOOi", kwlist, &tabletmp, &envtmp, &denstmp, &pitchtmp, &postmp, &durtmp, &devtmp, &pantmp, &self->chnls))
+        return -1; 
+
+    if (self->chnls < 1)
+        self->chnls = 1;
+
+    Py_XDECREF(self->table);
+    self->table = PyObject_CallMethod((PyObject *)tabletmp, "getTableStream", "");
+
+    Py_XDECREF(self->env);
+    self->env = PyObject_CallMethod((PyObject *)envtmp, "getTableStream", "");
+
+    if (denstmp) {
+        PyObject_CallMethod((PyObject *)self, "setDens", "O", denstmp);
+    }
+
+    if (pitchtmp) {
+        PyObject_CallMethod((PyObject *)self, "setPitch", "O", pitchtmp);
+    }
+
+    if (postmp) {
+        PyObject_CallMethod((PyObject *)self, "setPos", "O", postmp);
+    }
+
+    if (durtmp) {
+        PyObject_CallMethod((PyObject *)self, "setDur", "O", durtmp);
+    }
+
+    if (devtmp) {
+        PyObject_CallMethod((PyObject *)self, "setDev", "O", devtmp);
+    }
+
+    if (pantmp) {
+        PyObject_CallMethod((PyObject *)self, "setPan", "O", pantmp);
+    }
+
+    Py_INCREF(self->stream);
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+
+    self->gpos = (MYFLT *)realloc(self->gpos, PARTICLE_MAX_GRAINS * sizeof(MYFLT));
+    self->ginc = (MYFLT *)realloc(self->ginc, PARTICLE_MAX_GRAINS * sizeof(MYFLT));
+    self->gepos = (MYFLT *)realloc(self->gepos, PARTICLE_MAX_GRAINS * sizeof(MYFLT));
+    self->geinc = (MYFLT *)realloc(self->geinc, PARTICLE_MAX_GRAINS * sizeof(MYFLT));
+    self->ggains = (MYFLT *)realloc(self->ggains, PARTICLE_MAX_GRAINS * self->chnls * sizeof(MYFLT));
+    self->goffset = (int *)realloc(self->goffset, PARTICLE_MAX_GRAINS * sizeof(int));
+    self->gdone = (int *)realloc(self->gdone, PARTICLE_MAX_GRAINS * sizeof(int));
+
+    self->buffer_streams = (MYFLT *)realloc(self->buffer_streams, self->chnls * self->bufsize * sizeof(MYFLT));
+    for (i=0; i<(self->chnls*self->bufsize); i++)
+        self->buffer_streams[i] = 0.0;
+    self->batch_buffers = (MYFLT *)realloc(self->batch_buffers, (PARTICLE_MAX_BATCHES - 1) * self->chnls * self->bufsize * sizeof(MYFLT));
+    self->batches[0].buffer = self->buffer_streams;
+    for (i=1; i<PARTICLE_MAX_BATCHES; i++)
+        self->batches[i].buffer = self->batch_buffers + (i - 1) * self->chnls * self->bufsize;
+
+    (*self->mode_func_ptr)(self);
+
+    Py_INCREF(self);
+    return 0;
+}
+
+static PyObject * MainParticle_getServer(MainParticle* self) { GET_SERVER };
+static PyObject * MainParticle_getStream(MainParticle* self) { GET_STREAM };
+
+static PyObject * MainParticle_play(MainParticle *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * MainParticle_stop(MainParticle *self) { STOP };
+
+static PyObject *
+MainParticle_setDens(MainParticle *self, PyObject *arg)
+{
+    SET_PARAM(dens, 0)
+}	
+
+static PyObject *
+MainParticle_setPitch(MainParticle *self, PyObject *arg)
+{
+    SET_PARAM(pitch, 1)
+}	
+
+static PyObject *
+MainParticle_setPos(MainParticle *self, PyObject *arg)
+{
+    SET_PARAM(pos, 2)
+}	
+
+static PyObject *
+MainParticle_setDur(MainParticle *self, PyObject *arg)
+{
+    SET_PARAM(dur, 3)
+}	
+
+static PyObject *
+MainParticle_setDev(MainParticle *self, PyObject *arg)
+{
+    SET_PARAM(dev, 4)
+}	
+
+static PyObject *
+MainParticle_setPan(MainParticle *self, PyObject *arg)
+{
+    SET_PARAM(pan, 5)
+}	
+
+static PyObject *
+MainParticle_getTable(MainParticle* self)
+{
+    Py_INCREF(self->table);
+    return self->table;
+};
+
+static PyObject *
+MainParticle_setTable(MainParticle *self, PyObject *arg)
+{
+	PyObject *tmp;
+	
+	if (arg == NULL) {
+		Py_INCREF(Py_None);
+		return Py_None;
+	}
+    
+	tmp = arg;
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
+    
+	Py_INCREF(Py_None);
+	return Py_None;
+}	
+
+static PyObject *
+MainParticle_getEnv(MainParticle* self)
+{
+    Py_INCREF(self->env);
+    return self->env;
+};
+
+static PyObject *
+MainParticle_setEnv(MainParticle *self, PyObject *arg)
+{
+	PyObject *tmp;
+	
+	if (arg == NULL) {
+		Py_INCREF(Py_None);
+		return Py_None;
+	}
+    
+	tmp = arg;
+    SWAP_FIELD(env, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
+    
+	Py_INCREF(Py_None);
+	return Py_None;
+}	
+
+static PyObject *
+MainParticle_getNumGrains(MainParticle* self)
+{
+    return PyInt_FromLong(self->ngrains);
+};
+
+static PyMemberDef MainParticle_members[] = {
+    {"server", T_OBJECT_EX, offsetof(MainParticle, server), 0, "Pyo server."},
+    {"stream", T_OBJECT_EX, offsetof(MainParticle, stream), 0, "Stream object."},
+    {"table", T_OBJECT_EX, offsetof(MainParticle, table), 0, "Sound table."},
+    {"env", T_OBJECT_EX, offsetof(MainParticle, env), 0, "Envelope table."},
+    {"dens", T_OBJECT_EX, offsetof(MainParticle, dens), 0, "Density of grains per second."},
+    {"pitch", T_OBJECT_EX, offsetof(MainParticle, pitch), 0, "Speed of the reading pointer of new grains."},
+    {"pos", T_OBJECT_EX, offsetof(MainParticle, pos), 0, "Position in the sound table of new grains."},
+    {"dur", T_OBJECT_EX, offsetof(MainParticle, dur), 0, "Duration of new grains."},
+    {"dev", T_OBJECT_EX, offsetof(MainParticle, dev), 0, "Deviation of the time between grains."},
+    {"pan", T_OBJECT_EX, offsetof(MainParticle, pan), 0, "Panning of new grains."},
+    {NULL}  /* Sentinel */
+};
+
+static PyMethodDef MainParticle_methods[] = {
+    {"getTable", (PyCFunction)MainParticle_getTable, METH_NOARGS, "Returns sound table object."},
+    {"getEnv", (PyCFunction)MainParticle_getEnv, METH_NOARGS, "Returns envelope table object."},
+    {"getServer", (PyCFunction)MainParticle_getServer, METH_NOARGS, "Returns server object."},
+    {"_getStream", (PyCFunction)MainParticle_getStream, METH_NOARGS, "Returns stream object."},
+    {"deleteStream", (PyCFunction)MainParticle_deleteStream, METH_NOARGS, "Remove stream from server and delete the object."},
+    {"play", (PyCFunction)MainParticle_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+    {"stop", (PyCFunction)MainParticle_stop, METH_NOARGS, "Stops computing."},
+    {"setTable", (PyCFunction)MainParticle_setTable, METH_O, "Sets sound table."},
+    {"setEnv", (PyCFunction)MainParticle_setEnv, METH_O, "Sets envelope table."},
+    {"setDens", (PyCFunction)MainParticle_setDens, METH_O, "Sets density of grains per second."},
+    {"setPitch", (PyCFunction)MainParticle_setPitch, METH_O, "Sets pitch factor of new grains."},
+    {"setPos", (PyCFunction)MainParticle_setPos, METH_O, "Sets position in the sound table of new grains."},
+    {"setDur", (PyCFunction)MainParticle_setDur, METH_O, "Sets duration of new grains."},
+    {"setDev", (PyCFunction)MainParticle_setDev, METH_O, "Sets deviation of the time between grains."},
+    {"setPan", (PyCFunction)MainParticle_setPan, METH_O, "Sets panning of new grains."},
+    {"getNumGrains", (PyCFunction)MainParticle_getNumGrains, METH_NOARGS, "Returns the number of active grains."},
+    {NULL}  /* Sentinel */
+};
+
+PyTypeObject MainParticleType = {
+    PyObject_HEAD_INIT(NULL)
+    0,                         /*ob_size*/
+    "_pyo.MainParticle_base",         /*tp_name*/
+    sizeof(MainParticle),         /*tp_basicsize*/
+    0,                         /*tp_itemsize*/
+    (destructor)MainParticle_dealloc, /*tp_dealloc*/
+    0,                         /*tp_print*/
+    0,                         /*tp_getattr*/
+    0,                         /*tp_setattr*/
+    0,                         /*tp_compare*/
+    0,                         /*tp_repr*/
+    0,                         /*tp_as_number*/
+    0,                         /*tp_as_sequence*/
+    0,                         /*tp_as_mapping*/
+    0,                         /*tp_hash */
+    0,                         /*tp_call*/
+    0,                         /*tp_str*/
+    0,                         /*tp_getattro*/
+    0,                         /*tp_setattro*/
+    0,                         /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES, /*tp_flags*/
+    "MainParticle objects. Pooled granular synthesis engine.",           /* tp_doc */
+    (traverseproc)MainParticle_traverse,   /* tp_traverse */
+    (inquiry)MainParticle_clear,           /* tp_clear */
+    0,		               /* tp_richcompare */
+    0,		               /* tp_weaklistoffset */
+    0,		               /* tp_iter */
+    0,		               /* tp_iternext */
+    MainParticle_methods,             /* tp_methods */
+    MainParticle_members,             /* tp_members */
+    0,                      /* tp_getset */
+    0,                         /* tp_base */
+    0,                         /* tp_dict */
+    0,                         /* tp_descr_get */
+    0,                         /* tp_descr_set */
+    0,                         /* tp_dictoffset */
+    (initproc)MainParticle_init,      /* tp_init */
+    0,                         /* tp_alloc */
+    MainParticle_new,                 /* tp_new */
+};
+
+/************************************************************************************************/
+/* Particle streamer object */
+/************************************************************************************************/
+typedef struct {
+    pyo_audio_HEAD
+    MainParticle *mainParticle;
+    int modebuffer[2];
+    int chnl;
+} Particle;
+
+static void Particle_postprocessing_ii(Particle *self) { POST_PROCESSING_II };
+static void Particle_postprocessing_ai(Particle *self) { POST_PROCESSING_AI };
+static void Particle_postprocessing_ia(Particle *self) { POST_PROCESSING_IA };
+static void Particle_postprocessing_aa(Particle *self) { POST_PROCESSING_AA };
+static void Particle_postprocessing_ireva(Particle *self) { POST_PROCESSING_IREVA };
+static void Particle_postprocessing_areva(Particle *self) { POST_PROCESSING_AREVA };
+static void Particle_postprocessing_revai(Particle *self) { POST_PROCESSING_REVAI };
+static void Particle_postprocessing_revaa(Particle *self) { POST_PROCESSING_REVAA };
+static void Particle_postprocessing_revareva(Particle *self) { POST_PROCESSING_REVAREVA };
+
+static void
+Particle_setProcMode(Particle *self)
+{
+    int muladdmode;
+    muladdmode = self->modebuffer[0] + self->modebuffer[1] * 10;
+    
+	switch (muladdmode) {
+        case 0:        
+            self->muladd_func_ptr = Particle_postprocessing_ii;
+            break;
+        case 1:    
+            self->muladd_func_ptr = Particle_postprocessing_ai;
+            break;
+        case 2:    
+            self->muladd_func_ptr = Particle_postprocessing_revai;
+            break;
+        case 10:        
+            self->muladd_func_ptr = Particle_postprocessing_ia;
+            break;
+        case 11:    
+            self->muladd_func_ptr = Particle_postprocessing_aa;
+            break;
+        case 12:    
+            self->muladd_func_ptr = Particle_postprocessing_revaa;
+            break;
+        case 20:        
+            self->muladd_func_ptr = Particle_postprocessing_ireva;
+            break;
+        case 21:    
+            self->muladd_func_ptr = Particle_postprocessing_areva;
+            break;
+        case 22:    
+            self->muladd_func_ptr = Particle_postprocessing_revareva;
+            break;
+    }
+}
+
+static void
+Particle_compute_next_data_frame(Particle *self)
+{
+    int i;
+    MYFLT *tmp;
+    int offset = self->chnl * self->bufsize;
+    tmp = MainParticle_getSamplesBuffer((MainParticle *)self->mainParticle);
+    for (i=0; i<self->bufsize; i++) {
+        self->data[i] = tmp[i + offset];
+    }    
+    (*self->muladd_func_ptr)(self);
+}
+
+static int
+Particle_traverse(Particle *self, visitproc visit, void *arg)
+{
+    pyo_VISIT
+    Py_VISIT(self->mainParticle);
+    return 0;
+}
+
+static int 
+Particle_clear(Particle *self)
+{
+    pyo_CLEAR
+    Py_CLEAR(self->mainParticle);    
+    return 0;
+}
+
+static void
+Particle_dealloc(Particle* self)
+{
+    free(self->data);
+    Particle_clear(self);
+    self->ob_type->tp_free((PyObject*)self);
+}
+
+static PyObject * Particle_deleteStream(Particle *self) { DELETE_STREAM };
+
+static PyObject *
+Particle_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    int i;
+    Particle *self;
+    self = (Particle *)type->tp_alloc(type, 0);
+    
+	self->modebuffer[0] = 0;
+	self->modebuffer[1] = 0;
+    
+    INIT_OBJECT_COMMON
+    Stream_setFunctionPtr(self->stream, Particle_compute_next_data_frame);
+    self->mode_func_ptr = Particle_setProcMode;
+    
+    return (PyObject *)self;
+}
+
+static int
+Particle_init(Particle *self, PyObject *args, PyObject *kwds)
+{
+    PyObject *maintmp=NULL, *multmp=NULL, *addtmp=NULL;
+    
+    static char *kwlist[] = {"mainParticle", "chnl", "mul", "add", NULL};
+    
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, "Oi|OO", kwlist, &maintmp, &self->chnl, &multmp, &addtmp))
+        return -1; 
+    
+    Py_XDECREF(self->mainParticle);
+    Py_INCREF(maintmp);
+    self->mainParticle = (MainParticle *)maintmp;
+    
+    if (multmp) {
+        PyObject_CallMethod((PyObject *)self, "setMul", "O", multmp);
+    }
+    
+    if (addtmp) {
+        PyObject_CallMethod((PyObject *)self, "setAdd", "O", addtmp);
+    }
+    
+    Py_INCREF(self->stream);
+    PyObject_CallMethod(self->server, "addStream", "O", self->stream);
+    
+    (*self->mode_func_ptr)(self);
+        
+    Py_INCREF(self);
+    return 0;
+}
+
+static PyObject * Particle_getServer(Particle* self) { GET_SERVER };
+static PyObject * Particle_getStream(Particle* self) { GET_STREAM };
+static PyObject * Particle_setMul(Particle *self, PyObject *arg) { SET_MUL };	
+static PyObject * Particle_setAdd(Particle *self, PyObject *arg) { SET_ADD };	
+static PyObject * Particle_setSub(Particle *self, PyObject *arg) { SET_SUB };	
+static PyObject * Particle_setDiv(Particle *self, PyObject *arg) { SET_DIV };	
+
+static PyObject * Particle_play(Particle *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * Particle_out(Particle *self, PyObject *args, PyObject *kwds) { OUT };
+static PyObject * Particle_stop(Particle *self) { STOP };
+
+static PyObject * Particle_multiply(Particle *self, PyObject *arg) { MULTIPLY };
+static PyObject * Particle_inplace_multiply(Particle *self, PyObject *arg) { INPLACE_MULTIPLY };
+static PyObject * Particle_add(Particle *self, PyObject *arg) { ADD };
+static PyObject * Particle_inplace_add(Particle *self, PyObject *arg) { INPLACE_ADD };
+static PyObject * Particle_sub(Particle *self, PyObject *arg) { SUB };
+static PyObject * Particle_inplace_sub(Particle *self, PyObject *arg) { INPLACE_SUB };
+static PyObject * Particle_div(Particle *self, PyObject *arg) { DIV };
+static PyObject * Particle_inplace_div(Particle *self, PyObject *arg) { INPLACE_DIV };
+
+static PyMemberDef Particle_members[] = {
+{"server", T_OBJECT_EX, offsetof(Particle, server), 0, "Pyo server."},
+{"stream", T_OBJECT_EX, offsetof(Particle, stream), 0, "Stream object."},
+{"mul", T_OBJECT_EX, offsetof(Particle, mul), 0, "Mul factor."},
+{"add", T_OBJECT_EX, offsetof(Particle, add), 0, "Add factor."},
+{NULL}  /* Sentinel */
+};
+
+static PyMethodDef Particle_methods[] = {
+{"getServer", (PyCFunction)Particle_getServer, METH_NOARGS, "Returns server object."},
+{"_getStream", (PyCFunction)Particle_getStream, METH_NOARGS, "Returns stream object."},
+{"deleteStream", (PyCFunction)Particle_deleteStream, METH_NOARGS, "Remove stream from server and delete the object."},
+{"play", (PyCFunction)Particle_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
+{"out", (PyCFunction)Particle_out, METH_VARARGS|METH_KEYWORDS, "Starts computing and sends sound to soundcard channel speficied by argument."},
+{"stop", (PyCFunction)Particle_stop, METH_NOARGS, "Stops computing."},
+{"setMul", (PyCFunction)Particle_setMul, METH_O, "Sets Particle mul factor."},
+{"setAdd", (PyCFunction)Particle_setAdd, METH_O, "Sets Particle add factor."},
+{"setSub", (PyCFunction)Particle_setSub, METH_O, "Sets inverse add factor."},
+{"setDiv", (PyCFunction)Particle_setDiv, METH_O, "Sets inverse mul factor."},
+{NULL}  /* Sentinel */
+};
+
+static PyNumberMethods Particle_as_number = {
+(binaryfunc)Particle_add,                      /*nb_add*/
+(binaryfunc)Particle_sub,                 /*nb_subtract*/
+(binaryfunc)Particle_multiply,                 /*nb_multiply*/
+(binaryfunc)Particle_div,                   /*nb_divide*/
+0,                /*nb_remainder*/
+0,                   /*nb_divmod*/
+0,                   /*nb_power*/
+0,                  /*nb_neg*/
+0,                /*nb_pos*/
+0,                  /*(unaryfunc)array_abs,*/
+0,                    /*nb_nonzero*/
+0,                    /*nb_invert*/
+0,               /*nb_lshift*/
+0,              /*nb_rshift*/
+0,              /*nb_and*/
+0,              /*nb_xor*/
+0,               /*nb_or*/
+0,                                          /*nb_coerce*/
+0,                       /*nb_int*/
+0,                      /*nb_long*/
+0,                     /*nb_float*/
+0,                       /*nb_oct*/
+0,                       /*nb_hex*/
+(binaryfunc)Particle_inplace_add,              /*inplace_add*/
+(binaryfunc)Particle_inplace_sub,         /*inplace_subtract*/
+(binaryfunc)Particle_inplace_multiply,         /*inplace_multiply*/
+(binaryfunc)Particle_inplace_div,           /*inplace_divide*/
+0,        /*inplace_remainder*/
+0,           /*inplace_power*/
+0,       /*inplace_lshift*/
+0,      /*inplace_rshift*/
+0,      /*inplace_and*/
+0,      /*inplace_xor*/
+0,       /*inplace_or*/
+0,             /*nb_floor_divide*/
+0,              /*nb_true_divide*/
+0,     /*nb_inplace_floor_divide*/
+0,      /*nb_inplace_true_divide*/
+0,                     /* nb_index */
+};
+
+PyTypeObject ParticleType = {
+PyObject_HEAD_INIT(NULL)
+0,                         /*ob_size*/
+"_pyo.Particle_base",         /*tp_name*/
+sizeof(Particle),         /*tp_basicsize*/
+0,                         /*tp_itemsize*/
+(destructor)Particle_dealloc, /*tp_dealloc*/
+0,                         /*tp_print*/
+0,                         /*tp_getattr*/
+0,                         /*tp_setattr*/
+0,                         /*tp_compare*/
+0,                         /*tp_repr*/
+&Particle_as_number,             /*tp_as_number*/
+0,                         /*tp_as_sequence*/
+0,                         /*tp_as_mapping*/
+0,                         /*tp_hash */
+0,                         /*tp_call*/
+0,                         /*tp_str*/
+0,                         /*tp_getattro*/
+0,                         /*tp_setattro*/
+0,                         /*tp_as_buffer*/
+Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE | Py_TPFLAGS_HAVE_GC | Py_TPFLAGS_CHECKTYPES,  /*tp_flags*/
+"Particle objects. Reads one channel from a MainParticle.",           /* tp_doc */
+(traverseproc)Particle_traverse,   /* tp_traverse */
+(inquiry)Particle_clear,           /* tp_clear */
+0,		               /* tp_richcompare */
+0,		               /* tp_weaklistoffset */
+0,		               /* tp_iter */
+0,		               /* tp_iternext */
+Particle_methods,             /* tp_methods */
+Particle_members,             /* tp_members */
+0,                      /* tp_getset */
+0,                         /* tp_base */
+0,                         /* tp_dict */
+0,                         /* tp_descr_get */
+0,                         /* tp_descr_set */
+0,                         /* tp_dictoffset */
+(initproc)Particle_init,      /* tp_init */
+0,                         /* tp_alloc */
+Particle_new,                 /* tp_new */
+};
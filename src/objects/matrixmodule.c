@@ -179,7 +179,8 @@ NewMatrix_clip(MYFLT val, MYFLT min, MYFLT max) {
     else return val;
 }
 
-static PyObject *
+/* Audio side, no Python API: MatrixRec runs without the GIL in GIL-free mode. */
+static void
 NewMatrix_recordChunkAllRow(NewMatrix *self, MYFLT *data, long datasize)
 {
     long i;
@@ -193,8 +194,6 @@ NewMatrix_recordChunkAllRow(NewMatrix *self, MYFLT *data, long datasize)
                 self->y_pointer = 0;
         }    
     }
-    Py_INCREF(Py_None);
-    return Py_None;
 }
 
 static int
@@ -233,6 +232,7 @@ NewMatrix_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (NewMatrix *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->x_pointer = self->y_pointer = 0;
     
@@ -251,7 +251,7 @@ NewMatrix_init(NewMatrix *self, PyObject *args, PyObject *kwds)
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "ii|O", kwlist, &self->width, &self->height, &inittmp))
         return -1; 
 
-    self->data = (MYFLT **)realloc(self->data, (self->height + 1) * sizeof(MYFLT));
+    self->data = (MYFLT **)realloc(self->data, (self->height + 1) * sizeof(MYFLT *));
 
     for (i=0; i<(self->height+1); i++) {
         self->data[i] = (MYFLT *)malloc((self->width + 1) * sizeof(MYFLT));
@@ -564,6 +564,7 @@ MatrixRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->delay = self->delayCount = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
     
     Stream_setFunctionPtr(self->stream, MatrixRec_compute_next_data_frame);
     Stream_setStreamActive(self->stream, 0);
@@ -648,6 +649,7 @@ MatrixRec_setMatrix(MatrixRec *self, PyObject *arg)
 MYFLT *
 MatrixRec_getTrigsBuffer(MatrixRec *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
@@ -957,6 +959,8 @@ MatrixMorph_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (MatrixMorph *)type->tp_alloc(type, 0);
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     
     Stream_setFunctionPtr(self->stream, MatrixMorph_compute_next_data_frame);
     
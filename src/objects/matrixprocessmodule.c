@@ -234,8 +234,7 @@ MatrixPointer_setMatrix(MatrixPointer *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->matrix);
-    self->matrix = PyObject_CallMethod((PyObject *)tmp, "getMatrixStream", "");
+    SWAP_FIELD(matrix, PyObject_CallMethod((PyObject *)tmp, "getMatrixStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -268,6 +267,8 @@ MatrixPointer_setX(MatrixPointer *self, PyObject *arg)
     Py_XDECREF(self->x_stream);
     self->x_stream = (Stream *)streamtmp;
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -299,6 +300,8 @@ MatrixPointer_setY(MatrixPointer *self, PyObject *arg)
     Py_XDECREF(self->y_stream);
     self->y_stream = (Stream *)streamtmp;
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
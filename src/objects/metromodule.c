@@ -255,35 +255,7 @@ static PyObject * Metro_inplace_div(Metro *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Metro_setTime(Metro *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->time);
-	if (isNumber == 1) {
-		self->time = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->time = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->time, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->time_stream);
-        self->time_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(time, 2)
 }	
 
 static PyMemberDef Metro_members[] = {
@@ -507,6 +479,7 @@ Seqer_generate_a(Seqer *self) {
 MYFLT *
 Seqer_getSamplesBuffer(Seqer *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -582,6 +555,8 @@ Seqer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[0] = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, Seqer_compute_next_data_frame);
     self->mode_func_ptr = Seqer_setProcMode;
     
@@ -631,35 +606,7 @@ static PyObject * Seqer_stop(Seqer *self) { STOP };
 static PyObject *
 Seqer_setTime(Seqer *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->time);
-	if (isNumber == 1) {
-		self->time = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->time = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->time, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->time_stream);
-        self->time_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(time, 0)
 }	
 
 static PyObject *
@@ -1077,6 +1024,7 @@ Clouder_generate_a(Clouder *self) {
 MYFLT *
 Clouder_getSamplesBuffer(Clouder *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -1186,35 +1134,7 @@ static PyObject * Clouder_stop(Clouder *self) { STOP };
 static PyObject *
 Clouder_setDensity(Clouder *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->density);
-	if (isNumber == 1) {
-		self->density = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->density = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->density, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->density_stream);
-        self->density_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(density, 0)
 }	
 
 static PyMemberDef Clouder_members[] = {
@@ -2171,30 +2091,35 @@ Beater_generate_a(Beater *self) {
 MYFLT *
 Beater_getSamplesBuffer(Beater *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
 MYFLT *
 Beater_getTapBuffer(Beater *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->tap_buffer_streams;
 }    
 
 MYFLT *
 Beater_getAmpBuffer(Beater *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->amp_buffer_streams;
 }    
 
 MYFLT *
 Beater_getDurBuffer(Beater *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->dur_buffer_streams;
 }    
 
 MYFLT *
 Beater_getEndBuffer(Beater *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->end_buffer_streams;
 }    
 
@@ -2371,6 +2296,8 @@ Beater_setTime(Beater *self, PyObject *arg)
     
     (*self->mode_func_ptr)(self);
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -31,15 +31,16 @@
 /***** OscBank ******/
 /*******************/
 
+/* Counter based random generator (an integer hash of seed + index), the values
+** of all partials are independent of each other so the loops vectorize. */
 static MYFLT
-OscBank_clip(MYFLT x, int size) {
-    if (x >= size) {
-        x -= (int)(x / size) * size;
-    }
-    else if (x < 0) {
-        x += ((int)(-x / size) + 1) * size;
-    }
-    return x;
+OscBank_random(unsigned int x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return (x >> 8) * 5.9604644775390625e-08;
 }
 
 typedef struct {
@@ -63,7 +64,10 @@ typedef struct {
     int fjit;
     int modebuffer[9];
     MYFLT *pointerPos;
+    MYFLT *increments;
+    MYFLT *amplitudes;
     MYFLT *frequencies;
+    unsigned int seed;
     MYFLT lastFreq;
     MYFLT lastSpread;
     int lastFjit;
@@ -84,31 +88,27 @@ typedef struct {
 
 static void
 OscBank_setFrequencies(OscBank *self, MYFLT freq, MYFLT spread) {
-    int i, seed;
-    MYFLT rnd;
+    int i;
+    unsigned int seed = self->seed;
     MYFLT scl = freq * spread;
     
     if (self->fjit == 1) {
-        srand((unsigned)(time(0)));
-        seed = rand();
         for (i=0; i<self->stages; i++) {
-            seed = (seed * 15625 + 1) & 0xFFFF;
-            rnd = seed * 1.52587890625e-07 - 0.005 + 1.0;
-            self->frequencies[i] = (freq + scl * i) * rnd;
-            /* printf("harm %d : %f Hz\n", i, self->frequencies[i]); */
+            self->frequencies[i] = (freq + scl * i) * (OscBank_random(seed + i) * 0.01 - 0.005 + 1.0);
         }
+        self->seed += self->stages;
     }
     else {
         for (i=0; i<self->stages; i++) {
             self->frequencies[i] = freq + scl * i;
-            /* printf("harm %d : %f Hz\n", i, self->frequencies[i]); */
         }
     }
 }
 
 static void
 OscBank_pickNewFrnds(OscBank *self, MYFLT frndf, MYFLT frnda) {
-    int i, seed;
+    int i;
+    unsigned int seed = self->seed;
     self->ftime -= 1.0;
     self->finc = frndf / self->sr * self->bufsize;
     if (frnda < 0)
@@ -116,18 +116,18 @@ OscBank_pickNewFrnds(OscBank *self, MYFLT frndf, MYFLT frnda) {
     else if (frnda > 1.0)
         frnda = 1.0;
 
-    seed = rand();
     for (i=0; i<self->stages; i++) {
         self->fOldValues[i] = self->fValues[i];
-        seed = (seed * 15625 + 1) & 0xFFFF;
-        self->fValues[i] = (seed - 0x8000) * 3.0517578125e-05 * frnda * self->frequencies[i];
+        self->fValues[i] = (OscBank_random(seed + i) * 2.0 - 1.0) * frnda * self->frequencies[i];
         self->fDiffs[i] = self->fValues[i] - self->fOldValues[i];
     }
+    self->seed += self->stages;
 }
 
 static void
 OscBank_pickNewArnds(OscBank *self, MYFLT arndf, MYFLT arnda) {
-    int i, seed;
+    int i;
+    unsigned int seed = self->seed;
     self->atime -= 1.0;
     self->ainc = arndf / self->sr * self->bufsize;
     if (arnda < 0)
@@ -135,19 +135,20 @@ OscBank_pickNewArnds(OscBank *self, MYFLT arndf, MYFLT arnda) {
     else if (arnda > 1.0)
         arnda = 1.0;
     
-    seed = rand();
     for (i=0; i<self->stages; i++) {
         self->aOldValues[i] = self->aValues[i];
-        seed = (seed * 15625 + 1) & 0xFFFF;
-        self->aValues[i] = seed * 1.52587890625e-05 * arnda;
+        self->aValues[i] = OscBank_random(seed + i) * arnda;
         self->aDiffs[i] = self->aValues[i] - self->aOldValues[i];
     }
+    self->seed += self->stages;
 }
 
+/* Computes the increment and the amplitude of every partial for the block, 
+   then the oscillators run in the vectorized bank kernel (see vecops.h). */
 static void
 OscBank_readframes(OscBank *self) {
-    MYFLT freq, spread, slope, frndf, frnda, arndf, arnda, amp, modamp, pos, inc, x, y, fpart;
-    int i, j, ipart;
+    MYFLT freq, spread, slope, frndf, frnda, arndf, arnda, amp, ftime, atime;
+    int i;
     MYFLT *tablelist = TableStream_getData(self->table);
     int size = TableStream_getSize(self->table);
     MYFLT tabscl = size / self->sr;
@@ -200,97 +201,41 @@ OscBank_readframes(OscBank *self) {
         }
     }
 
-    if (frnda == 0.0 && arnda == 0.0) {
-        amp = self->amplitude;
-        for (j=0; j<self->stages; j++) {          
-            inc = self->frequencies[j] * tabscl;
-            pos = self->pointerPos[j];
-            for (i=0; i<self->bufsize; i++) {
-                pos = OscBank_clip(pos, size);
-                ipart = (int)pos;
-                fpart = pos - ipart;
-                x = tablelist[ipart];
-                y = tablelist[ipart+1];
-                self->data[i] += (x + (y - x) * fpart) * amp;
-                pos += inc;
-            }
-            self->pointerPos[j] = pos;
-            amp *= slope;
+    if (frnda == 0.0) {
+        for (i=0; i<self->stages; i++) {
+            self->increments[i] = self->frequencies[i] * tabscl;
         }
     }
-    else if (frnda != 0.0 && arnda != 0.0) {
+    else {
         if (self->ftime >= 1.0) {
             OscBank_pickNewFrnds(self, frndf, frnda);
         }
-        if (self->atime >= 1.0) {
-            OscBank_pickNewArnds(self, arndf, arnda);
-        }
-        amp = self->amplitude;
-        for (j=0; j<self->stages; j++) {
-            inc = (self->frequencies[j] + (self->fOldValues[j] + self->fDiffs[j] * self->ftime)) * tabscl;
-            pos = self->pointerPos[j];
-            modamp = (1.0 - arnda) + (self->aOldValues[j] + self->aDiffs[j] * self->atime);
-            for (i=0; i<self->bufsize; i++) {
-                pos = OscBank_clip(pos, size);
-                ipart = (int)pos;
-                fpart = pos - ipart;
-                x = tablelist[ipart];
-                y = tablelist[ipart+1];
-                self->data[i] += (x + (y - x) * fpart) * amp * modamp;
-                pos += inc;
-            }
-            self->pointerPos[j] = pos;
-            amp *= slope;
+        ftime = self->ftime;
+        for (i=0; i<self->stages; i++) {
+            self->increments[i] = (self->frequencies[i] + (self->fOldValues[i] + self->fDiffs[i] * ftime)) * tabscl;
         }
         self->ftime += self->finc;
-        self->atime += self->ainc;
     }
-    else if (frnda != 0.0 && arnda == 0.0) {
-        if (self->ftime >= 1.0) {
-            OscBank_pickNewFrnds(self, frndf, frnda);
-        }
-        amp = self->amplitude;
-        for (j=0; j<self->stages; j++) {
-            inc = (self->frequencies[j] + (self->fOldValues[j] + self->fDiffs[j] * self->ftime)) * tabscl;
-            pos = self->pointerPos[j];
-            for (i=0; i<self->bufsize; i++) {
-                pos = OscBank_clip(pos, size);
-                ipart = (int)pos;
-                fpart = pos - ipart;
-                x = tablelist[ipart];
-                y = tablelist[ipart+1];
-                self->data[i] += (x + (y - x) * fpart) * amp;
-                pos += inc;
-            }
-            self->pointerPos[j] = pos;
-            amp *= slope;
-        }
-        self->ftime += self->finc;
+
+    amp = self->amplitude;
+    for (i=0; i<self->stages; i++) {
+        self->amplitudes[i] = amp;
+        amp *= slope;
     }
-    else if (frnda == 0.0 && arnda != 0.0) {
+    if (arnda != 0.0) {
         if (self->atime >= 1.0) {
             OscBank_pickNewArnds(self, arndf, arnda);
         }
-        amp = self->amplitude;
-        for (j=0; j<self->stages; j++) {
-            inc = self->frequencies[j] * tabscl;
-            pos = self->pointerPos[j];
-            modamp = (1.0 - arnda) + (self->aOldValues[j] + self->aDiffs[j] * self->atime);
-            for (i=0; i<self->bufsize; i++) {
-                pos = OscBank_clip(pos, size);
-                ipart = (int)pos;
-                fpart = pos - ipart;
-                x = tablelist[ipart];
-                y = tablelist[ipart+1];
-                self->data[i] += (x + (y - x) * fpart) * amp * modamp;
-                pos += inc;
-            }
-            self->pointerPos[j] = pos;
-            amp *= slope;
+        atime = self->atime;
+        for (i=0; i<self->stages; i++) {
+            self->amplitudes[i] *= (1.0 - arnda) + (self->aOldValues[i] + self->aDiffs[i] * atime);
         }
         self->atime += self->ainc;
     }
-    
+
+    /* The vector kernels add the partials lane by lane, the output may differ in the last bits
+       from the scalar loop and from versions before the kernel. */
+    pyo_vec_osc_bank(self->data, tablelist, size, self->pointerPos, self->increments, self->amplitudes, self->stages, self->bufsize);
 }
 
 static void OscBank_postprocessing_ii(OscBank *self) { POST_PROCESSING_II };
@@ -398,6 +343,8 @@ OscBank_dealloc(OscBank* self)
 {
     free(self->data);
     free(self->pointerPos);
+    free(self->increments);
+    free(self->amplitudes);
     free(self->frequencies);
     free(self->fOldValues);
     free(self->fValues);
@@ -504,6 +451,8 @@ OscBank_init(OscBank *self, PyObject *args, PyObject *kwds)
     (*self->mode_func_ptr)(self);
 
     self->pointerPos = (MYFLT *)realloc(self->pointerPos, self->stages * sizeof(MYFLT));
+    self->increments = (MYFLT *)realloc(self->increments, self->stages * sizeof(MYFLT));
+    self->amplitudes = (MYFLT *)realloc(self->amplitudes, self->stages * sizeof(MYFLT));
     self->frequencies = (MYFLT *)realloc(self->frequencies, self->stages * sizeof(MYFLT));
     self->fOldValues = (MYFLT *)realloc(self->fOldValues, self->stages * sizeof(MYFLT));
     self->fValues = (MYFLT *)realloc(self->fValues, self->stages * sizeof(MYFLT));
@@ -519,6 +468,7 @@ OscBank_init(OscBank *self, PyObject *args, PyObject *kwds)
     self->amplitude = 1. / self->stages;
 
     srand((unsigned)(time(0)));
+    self->seed = (unsigned int)rand();
 
     Py_INCREF(self);
     return 0;
@@ -562,8 +512,7 @@ OscBank_setTable(OscBank *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -572,225 +521,43 @@ OscBank_setTable(OscBank *self, PyObject *arg)
 static PyObject *
 OscBank_setFreq(OscBank *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 OscBank_setSpread(OscBank *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->spread);
-	if (isNumber == 1) {
-		self->spread = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->spread = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->spread, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->spread_stream);
-        self->spread_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(spread, 3)
 }	
 
 static PyObject *
 OscBank_setSlope(OscBank *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->slope);
-	if (isNumber == 1) {
-		self->slope = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->slope = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->slope, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->slope_stream);
-        self->slope_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(slope, 4)
 }	
 
 static PyObject *
 OscBank_setFrndf(OscBank *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->frndf);
-	if (isNumber == 1) {
-		self->frndf = PyNumber_Float(tmp);
-        self->modebuffer[5] = 0;
-	}
-	else {
-		self->frndf = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->frndf, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->frndf_stream);
-        self->frndf_stream = (Stream *)streamtmp;
-		self->modebuffer[5] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(frndf, 5)
 }	
 
 static PyObject *
 OscBank_setFrnda(OscBank *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->frnda);
-	if (isNumber == 1) {
-		self->frnda = PyNumber_Float(tmp);
-        self->modebuffer[6] = 0;
-	}
-	else {
-		self->frnda = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->frnda, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->frnda_stream);
-        self->frnda_stream = (Stream *)streamtmp;
-		self->modebuffer[6] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(frnda, 6)
 }	
 
 static PyObject *
 OscBank_setArndf(OscBank *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->arndf);
-	if (isNumber == 1) {
-		self->arndf = PyNumber_Float(tmp);
-        self->modebuffer[7] = 0;
-	}
-	else {
-		self->arndf = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->arndf, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->arndf_stream);
-        self->arndf_stream = (Stream *)streamtmp;
-		self->modebuffer[7] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(arndf, 7)
 }	
 
 static PyObject *
 OscBank_setArnda(OscBank *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->arnda);
-	if (isNumber == 1) {
-		self->arnda = PyNumber_Float(tmp);
-        self->modebuffer[8] = 0;
-	}
-	else {
-		self->arnda = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->arnda, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->arnda_stream);
-        self->arnda_stream = (Stream *)streamtmp;
-		self->modebuffer[8] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(arnda, 8)
 }	
 
 static PyObject *
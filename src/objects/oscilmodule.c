@@ -331,69 +331,13 @@ static PyObject * Sine_inplace_div(Sine *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Sine_setFreq(Sine *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Sine_setPhase(Sine *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->phase);
-	if (isNumber == 1) {
-		self->phase = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->phase = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->phase, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->phase_stream);
-        self->phase_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(phase, 3)
 }	
 
 static PyMemberDef Sine_members[] = {
@@ -782,69 +726,13 @@ static PyObject * SineLoop_inplace_div(SineLoop *self, PyObject *arg) { INPLACE_
 static PyObject *
 SineLoop_setFreq(SineLoop *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 SineLoop_setFeedback(SineLoop *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->feedback);
-	if (isNumber == 1) {
-		self->feedback = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->feedback = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->feedback, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->feedback_stream);
-        self->feedback_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(feedback, 3)
 }	
 
 static PyMemberDef SineLoop_members[] = {
@@ -1286,8 +1174,7 @@ Osc_setTable(Osc *self, PyObject *arg)
 	}
 
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1296,69 +1183,13 @@ Osc_setTable(Osc *self, PyObject *arg)
 static PyObject *
 Osc_setFreq(Osc *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Osc_setPhase(Osc *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->phase);
-	if (isNumber == 1) {
-		self->phase = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->phase = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->phase, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->phase_stream);
-        self->phase_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(phase, 3)
 }	
 
 static PyObject *
@@ -1815,8 +1646,7 @@ OscLoop_setTable(OscLoop *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1825,69 +1655,13 @@ OscLoop_setTable(OscLoop *self, PyObject *arg)
 static PyObject *
 OscLoop_setFreq(OscLoop *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 OscLoop_setFeedback(OscLoop *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->feedback);
-	if (isNumber == 1) {
-		self->feedback = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->feedback = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->feedback, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->feedback_stream);
-        self->feedback_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(feedback, 3)
 }	
 
 static PyMemberDef OscLoop_members[] = {
@@ -2297,69 +2071,13 @@ static PyObject * Phasor_inplace_div(Phasor *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Phasor_setFreq(Phasor *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Phasor_setPhase(Phasor *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->phase);
-	if (isNumber == 1) {
-		self->phase = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->phase = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->phase, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->phase_stream);
-        self->phase_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(phase, 3)
 }	
 
 static PyMemberDef Phasor_members[] = {
@@ -2674,8 +2392,7 @@ Pointer_setTable(Pointer *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -2708,6 +2425,8 @@ Pointer_setIndex(Pointer *self, PyObject *arg)
     Py_XDECREF(self->index_stream);
     self->index_stream = (Stream *)streamtmp;
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -3026,8 +2745,7 @@ TableIndex_setTable(TableIndex *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3060,6 +2778,8 @@ TableIndex_setIndex(TableIndex *self, PyObject *arg)
     Py_XDECREF(self->index_stream);
     self->index_stream = (Stream *)streamtmp;
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -3386,8 +3106,7 @@ Lookup_setTable(Lookup *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -3420,6 +3139,8 @@ Lookup_setIndex(Lookup *self, PyObject *arg)
     Py_XDECREF(self->index_stream);
     self->index_stream = (Stream *)streamtmp;
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -4140,8 +3861,7 @@ Pulsar_setTable(Pulsar *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -4158,8 +3878,7 @@ Pulsar_setEnv(Pulsar *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->env);
-    self->env = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(env, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -4168,103 +3887,19 @@ Pulsar_setEnv(Pulsar *self, PyObject *arg)
 static PyObject *
 Pulsar_setFreq(Pulsar *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Pulsar_setPhase(Pulsar *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->phase);
-	if (isNumber == 1) {
-		self->phase = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->phase = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->phase, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->phase_stream);
-        self->phase_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(phase, 3)
 }	
 
 static PyObject *
 Pulsar_setFrac(Pulsar *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->frac);
-	if (isNumber == 1) {
-		self->frac = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->frac = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->frac, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->frac_stream);
-        self->frac_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(frac, 4)
 }	
 
 static PyObject *
@@ -4618,6 +4253,8 @@ TableRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->interp = 2;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, TableRead_compute_next_data_frame);
     self->mode_func_ptr = TableRead_setProcMode;
     
@@ -4725,8 +4362,7 @@ TableRead_setTable(TableRead *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -4735,35 +4371,7 @@ TableRead_setTable(TableRead *self, PyObject *arg)
 static PyObject *
 TableRead_setFreq(TableRead *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
@@ -4803,6 +4411,7 @@ TableRead_setInterp(TableRead *self, PyObject *arg)
 MYFLT *
 TableRead_getTrigsBuffer(TableRead *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
@@ -5637,103 +5246,19 @@ static PyObject * Fm_inplace_div(Fm *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Fm_setCarrier(Fm *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->car);
-	if (isNumber == 1) {
-		self->car = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->car = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->car, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->car_stream);
-        self->car_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(car, 2)
 }	
 
 static PyObject *
 Fm_setRatio(Fm *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->ratio);
-	if (isNumber == 1) {
-		self->ratio = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->ratio = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->ratio, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->ratio_stream);
-        self->ratio_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(ratio, 3)
 }	
 
 static PyObject *
 Fm_setIndex(Fm *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->index);
-	if (isNumber == 1) {
-		self->index = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->index = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->index, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->index_stream);
-        self->index_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(index, 4)
 }	
 
 static PyMemberDef Fm_members[] = {
@@ -6142,137 +5667,25 @@ static PyObject * CrossFm_inplace_div(CrossFm *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 CrossFm_setCarrier(CrossFm *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->car);
-	if (isNumber == 1) {
-		self->car = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->car = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->car, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->car_stream);
-        self->car_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(car, 2)
 }	
 
 static PyObject *
 CrossFm_setRatio(CrossFm *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->ratio);
-	if (isNumber == 1) {
-		self->ratio = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->ratio = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->ratio, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->ratio_stream);
-        self->ratio_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(ratio, 3)
 }	
 
 static PyObject *
 CrossFm_setInd1(CrossFm *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->ind1);
-	if (isNumber == 1) {
-		self->ind1 = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->ind1 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->ind1, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->ind1_stream);
-        self->ind1_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(ind1, 4)
 }	
 
 static PyObject *
 CrossFm_setInd2(CrossFm *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->ind2);
-	if (isNumber == 1) {
-		self->ind2 = PyNumber_Float(tmp);
-        self->modebuffer[5] = 0;
-	}
-	else {
-		self->ind2 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->ind2, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->ind2_stream);
-        self->ind2_stream = (Stream *)streamtmp;
-		self->modebuffer[5] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(ind2, 5)
 }	
 
 static PyMemberDef CrossFm_members[] = {
@@ -6696,69 +6109,13 @@ static PyObject * Blit_inplace_div(Blit *self, PyObject *arg) { INPLACE_DIV };
 static PyObject *
 Blit_setFreq(Blit *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->freq);
-	if (isNumber == 1) {
-		self->freq = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->freq = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->freq, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->freq_stream);
-        self->freq_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(freq, 2)
 }	
 
 static PyObject *
 Blit_setHarms(Blit *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->harms);
-	if (isNumber == 1) {
-		self->harms = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->harms = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->harms, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->harms_stream);
-        self->harms_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(harms, 3)
 }	
 
 static PyMemberDef Blit_members[] = {
@@ -7236,74 +6593,19 @@ static PyObject * Rossler_inplace_div(Rossler *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 Rossler_setPitch(Rossler *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->pitch);
-	if (isNumber == 1) {
-		self->pitch = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->pitch = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->pitch, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->pitch_stream);
-        self->pitch_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(pitch, 2)
 }	
 
 static PyObject *
 Rossler_setChaos(Rossler *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->chaos);
-	if (isNumber == 1) {
-		self->chaos = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->chaos = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->chaos, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->chaos_stream);
-        self->chaos_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(chaos, 3)
 }	
 
 MYFLT *
 Rossler_getAltBuffer(Rossler *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->altBuffer;
 }    
 
@@ -8078,74 +7380,19 @@ static PyObject * Lorenz_inplace_div(Lorenz *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Lorenz_setPitch(Lorenz *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->pitch);
-	if (isNumber == 1) {
-		self->pitch = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->pitch = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->pitch, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->pitch_stream);
-        self->pitch_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(pitch, 2)
 }	
 
 static PyObject *
 Lorenz_setChaos(Lorenz *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->chaos);
-	if (isNumber == 1) {
-		self->chaos = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->chaos = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->chaos, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->chaos_stream);
-        self->chaos_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(chaos, 3)
 }	
 
 MYFLT *
 Lorenz_getAltBuffer(Lorenz *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->altBuffer;
 }    
 
@@ -107,6 +107,8 @@ OscReceiver_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (OscReceiver *)type->tp_alloc(type, 0);
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, OscReceiver_compute_next_data_frame);
     
     return (PyObject *)self;
@@ -330,6 +332,8 @@ OscReceive_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[1] = 0;
 
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, OscReceive_compute_next_data_frame);
     self->mode_func_ptr = OscReceive_setProcMode;
 
@@ -564,6 +568,8 @@ OscSend_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->host = NULL;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, OscSend_compute_next_data_frame);
     
     return (PyObject *)self;
@@ -761,6 +767,8 @@ OscDataSend_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->host = NULL;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, OscDataSend_compute_next_data_frame);
     
     return (PyObject *)self;
@@ -939,10 +947,17 @@ int OscDataReceive_handler(const char *path, const char *types, lo_arg **argv, i
     return 0;
 }
 
+/* Control side, see Server_postCallback. The handler builds the Python arguments. */
+static void
+OscDataReceive_poll(PyObject *obj, double value)
+{
+    while (lo_server_recv_noblock(((OscDataReceive *)obj)->osc_server, 0) != 0) {};
+}
+
 static void
 OscDataReceive_compute_next_data_frame(OscDataReceive *self)
 {
-    while (lo_server_recv_noblock(self->osc_server, 0) != 0) {};
+    Server_postCallback(self->server, OscDataReceive_poll, (PyObject *)self, 0.0);
 }
 
 static int
@@ -990,6 +1005,7 @@ OscDataReceive_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (OscDataReceive *)type->tp_alloc(type, 0);
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
     Stream_setFunctionPtr(self->stream, OscDataReceive_compute_next_data_frame);
     
     return (PyObject *)self;
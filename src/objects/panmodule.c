@@ -25,6 +25,7 @@
 #include "streammodule.h"
 #include "servermodule.h"
 #include "dummymodule.h"
+#include "cmdqueue.h"
 
 typedef struct {
     pyo_audio_HEAD
@@ -180,6 +181,7 @@ Panner_splitter_aa(Panner *self) {
 MYFLT *
 Panner_getSamplesBuffer(Panner *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -320,69 +322,13 @@ static PyObject * Panner_stop(Panner *self) { STOP };
 static PyObject *
 Panner_setPan(Panner *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->pan);
-	if (isNumber == 1) {
-		self->pan = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->pan = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->pan, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->pan_stream);
-        self->pan_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(pan, 0)
 }	
 
 static PyObject *
 Panner_setSpread(Panner *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->spread);
-	if (isNumber == 1) {
-		self->spread = PyNumber_Float(tmp);
-        self->modebuffer[1] = 0;
-	}
-	else {
-		self->spread = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->spread, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->spread_stream);
-        self->spread_stream = (Stream *)streamtmp;
-		self->modebuffer[1] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(spread, 1)
 }	
 
 static PyMemberDef Panner_members[] = {
@@ -855,6 +801,7 @@ SPanner_splitter_a(SPanner *self) {
 MYFLT *
 SPanner_getSamplesBuffer(SPanner *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -987,35 +934,7 @@ static PyObject * SPanner_stop(SPanner *self) { STOP };
 static PyObject *
 SPanner_setPan(SPanner *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->pan);
-	if (isNumber == 1) {
-		self->pan = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->pan = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->pan, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->pan_stream);
-        self->pan_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(pan, 0)
 }	
 
 static PyMemberDef SPanner_members[] = {
@@ -1444,6 +1363,7 @@ Switcher_splitter_a(Switcher *self) {
 MYFLT *
 Switcher_getSamplesBuffer(Switcher *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -1561,35 +1481,7 @@ static PyObject * Switcher_stop(Switcher *self) { STOP };
 static PyObject *
 Switcher_setVoice(Switcher *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->voice);
-	if (isNumber == 1) {
-		self->voice = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->voice = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->voice, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->voice_stream);
-        self->voice_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(voice, 0)
 }	
 
 static PyMemberDef Switcher_members[] = {
@@ -1928,6 +1820,7 @@ PyTypeObject SwitchType = {
 typedef struct {
     pyo_audio_HEAD
     PyObject *inputs;
+    PyObject *input_streams;
     PyObject *voice;
     Stream *voice_stream;
     int chSize;
@@ -1957,8 +1850,8 @@ Selector_generate_i(Selector *self) {
         j1--; j--;
     }
 
-    MYFLT *st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j1), "_getStream", NULL));
-    MYFLT *st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j), "_getStream", NULL));
+    MYFLT *st1 = Stream_getData((Stream *)PyList_GET_ITEM(self->input_streams, j1));
+    MYFLT *st2 = Stream_getData((Stream *)PyList_GET_ITEM(self->input_streams, j));
 
     voice = P_clip(voice - j1);
     voice1 = MYSQRT(1.0 - voice);
@@ -1978,8 +1871,8 @@ Selector_generate_a(Selector *self) {
 
     old_j1 = 0; 
     old_j = 1;
-    st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, old_j1), "_getStream", NULL));
-    st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, old_j), "_getStream", NULL));
+    st1 = Stream_getData((Stream *)PyList_GET_ITEM(self->input_streams, old_j1));
+    st2 = Stream_getData((Stream *)PyList_GET_ITEM(self->input_streams, old_j));
     
     for (i=0; i<self->bufsize; i++) {
         voice = Selector_clip_voice(self, vc[i]);
@@ -1990,11 +1883,11 @@ Selector_generate_a(Selector *self) {
             j1--; j--;
         }
         if (j1 != old_j1) {
-            st1 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j1), "_getStream", NULL));
+            st1 = Stream_getData((Stream *)PyList_GET_ITEM(self->input_streams, j1));
             old_j1 = j1;
         }    
         if (j != old_j) {
-            st2 = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyList_GET_ITEM(self->inputs, j), "_getStream", NULL));
+            st2 = Stream_getData((Stream *)PyList_GET_ITEM(self->input_streams, j));
             old_j = j;
         }    
 
@@ -2072,6 +1965,7 @@ Selector_traverse(Selector *self, visitproc visit, void *arg)
 {
     pyo_VISIT
     Py_VISIT(self->inputs);
+    Py_VISIT(self->input_streams);
     Py_VISIT(self->voice);
     Py_VISIT(self->voice_stream);
     return 0;
@@ -2082,6 +1976,7 @@ Selector_clear(Selector *self)
 {
     pyo_CLEAR
     Py_CLEAR(self->inputs);
+    Py_CLEAR(self->input_streams);
     Py_CLEAR(self->voice);
     Py_CLEAR(self->voice_stream);
     return 0;
@@ -2173,6 +2068,7 @@ static PyObject * Selector_inplace_div(Selector *self, PyObject *arg) { INPLACE_
 static PyObject *
 Selector_setInputs(Selector *self, PyObject *arg)
 {
+    int i;
 	PyObject *tmp;
 	
 	if (! PyList_Check(arg)) {
@@ -2186,6 +2082,13 @@ Selector_setInputs(Selector *self, PyObject *arg)
     Py_INCREF(tmp);
 	Py_XDECREF(self->inputs);
     self->inputs = tmp;
+    Py_XDECREF(self->input_streams);
+    self->input_streams = PyList_New(self->chSize);
+    for (i=0; i<self->chSize; i++) {
+        PyList_SET_ITEM(self->input_streams, i, PyObject_CallMethod(PyList_GET_ITEM(self->inputs, i), "_getStream", NULL));
+    }
+
+	Server_graphChanged((PyObject *)self->server);
 
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -2194,35 +2097,7 @@ Selector_setInputs(Selector *self, PyObject *arg)
 static PyObject *
 Selector_setVoice(Selector *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->voice);
-	if (isNumber == 1) {
-		self->voice = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->voice = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->voice, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->voice_stream);
-        self->voice_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(voice, 2)
 }	
 
 static PyMemberDef Selector_members[] = {
@@ -2338,78 +2213,234 @@ Selector_new,                                     /* tp_new */
 /****************/
 /**** Mixer *****/
 /****************/
+
+/* Mixing state, only touched by the thread computing the blocks. Gains are
+   stored by output then input ([out * ins + in]). A new, larger matrix is 
+   built by Python when the inputs outgrow it and swapped in by a command. */
+typedef struct {
+    int ins; /* number of input slots */
+    int outs;
+    Stream **streams; /* NULL for a free slot */
+    MYFLT *gains; /* target amplitudes */
+    MYFLT *currents; /* amplitudes reached by the ramps */
+    MYFLT *steps;
+    long *remaining; /* samples left in the ramps, -1 while a ramp waits to start */
+    MYFLT **buffers; /* scratch, input buffers of the current block */
+    MYFLT **mixins; /* scratch, inputs with a steady gain for one output */
+    MYFLT *mixgains;
+} MixerMatrix;
+
+enum { MIXER_CMD_TIME, MIXER_CMD_ADD, MIXER_CMD_DEL, MIXER_CMD_GAIN, MIXER_CMD_RESIZE };
+
 typedef struct {
     pyo_audio_HEAD
-    PyObject *inputs;
-    PyObject *gains;
-    PyObject *lastGains;
-    PyObject *currentGains;
-    PyObject *stepVals;
-    PyObject *timeCounts;
+    PyObject *inputs; /* voice -> input object */
+    PyObject *slots; /* voice -> index in the matrix */
+    PyObject *gains; /* voice -> list of amplitudes, as set from Python */
     int num_outs;
     MYFLT time;
     long timeStep;
+    MixerMatrix *matrix; /* used by the audio side */
+    MixerMatrix *latest; /* last matrix built by Python, sizes the slots */
+    char *taken; /* slots in use, Python side */
+    PyoCommandQueue *commands;
     MYFLT *buffer_streams;
 } Mixer;
 
+static MixerMatrix *
+MixerMatrix_new(int ins, int outs)
+{
+    MixerMatrix *m = (MixerMatrix *)calloc(1, sizeof(MixerMatrix));
+    m->ins = ins;
+    m->outs = outs;
+    m->streams = (Stream **)calloc(ins, sizeof(Stream *));
+    m->gains = (MYFLT *)calloc(ins * outs, sizeof(MYFLT));
+    m->currents = (MYFLT *)calloc(ins * outs, sizeof(MYFLT));
+    m->steps = (MYFLT *)calloc(ins * outs, sizeof(MYFLT));
+    m->remaining = (long *)calloc(ins * outs, sizeof(long));
+    m->buffers = (MYFLT **)calloc(ins, sizeof(MYFLT *));
+    m->mixins = (MYFLT **)calloc(ins, sizeof(MYFLT *));
+    m->mixgains = (MYFLT *)calloc(ins, sizeof(MYFLT));
+    return m;
+}
+
+static void
+MixerMatrix_free(void *ptr)
+{
+    MixerMatrix *m = (MixerMatrix *)ptr;
+    free(m->streams);
+    free(m->gains);
+    free(m->currents);
+    free(m->steps);
+    free(m->remaining);
+    free(m->buffers);
+    free(m->mixins);
+    free(m->mixgains);
+    free(m);
+}
+
+static void
+Mixer_releaseObject(void *ptr)
+{
+    Py_DECREF((PyObject *)ptr);
+}
+
+/* Audio side */
+static void
+Mixer_applyCommands(Mixer *self)
+{
+    int i, j, k, c, ramps = 0;
+    PyoCommand cmd;
+    MixerMatrix *m, *old;
+
+    while (PyoCommandQueue_pop(self->commands, &cmd)) {
+        m = self->matrix;
+        switch (cmd.type) {
+            case MIXER_CMD_TIME:
+                self->timeStep = (long)cmd.value;
+                /* Running ramps end on the next sample. */
+                for (i=0; i<m->ins*m->outs; i++) {
+                    if (m->remaining[i] > 1)
+                        m->remaining[i] = 1;
+                }
+                break;
+            case MIXER_CMD_ADD:
+                m->streams[cmd.index] = (Stream *)cmd.ptr;
+                for (k=0; k<m->outs; k++) {
+                    c = k * m->ins + cmd.index;
+                    m->gains[c] = m->currents[c] = m->steps[c] = 0.0;
+                    m->remaining[c] = 0;
+                }
+                break;
+            case MIXER_CMD_DEL:
+                m->streams[cmd.index] = NULL;
+                break;
+            case MIXER_CMD_GAIN:
+                c = cmd.index2 * m->ins + cmd.index;
+                if ((MYFLT)cmd.value == m->gains[c])
+                    break;
+                m->gains[c] = (MYFLT)cmd.value;
+                m->remaining[c] = -1;
+                ramps = 1;
+                break;
+            case MIXER_CMD_RESIZE:
+                old = m;
+                m = (MixerMatrix *)cmd.ptr;
+                for (j=0; j<old->ins; j++) {
+                    m->streams[j] = old->streams[j];
+                    for (k=0; k<m->outs; k++) {
+                        m->gains[k * m->ins + j] = old->gains[k * old->ins + j];
+                        m->currents[k * m->ins + j] = old->currents[k * old->ins + j];
+                        m->steps[k * m->ins + j] = old->steps[k * old->ins + j];
+                        m->remaining[k * m->ins + j] = old->remaining[k * old->ins + j];
+                    }
+                }
+                self->matrix = m;
+                break;
+        }
+    }
+
+    /* Ramps start once every command is applied, with the latest time. */
+    if (ramps) {
+        m = self->matrix;
+        for (c=0; c<m->ins*m->outs; c++) {
+            if (m->remaining[c] != -1)
+                continue;
+            if (self->timeStep > 1) {
+                m->steps[c] = (m->gains[c] - m->currents[c]) / self->timeStep;
+                m->remaining[c] = self->timeStep;
+            }
+            else {
+                m->currents[c] = m->gains[c];
+                m->remaining[c] = 0;
+            }
+        }
+    }
+}
+
 static void
 Mixer_generate(Mixer *self) {
-    int num, k, j, i, tmpCount;
-    MYFLT amp, lastAmp, currentAmp, tmpStepVal;
-    PyObject *keys;
-    PyObject *key;
-    PyObject *list_of_gains, *list_of_last_gains, *list_of_current_gains, *list_of_step_vals, *list_of_time_counts;
+    int i, j, k, c, num;
+    long count;
+    MYFLT amp, target, step;
+    MYFLT *st, *out;
+    MixerMatrix *m;
+
+    Mixer_applyCommands(self);
+    m = self->matrix;
 
     for (i=0; i<(self->num_outs * self->bufsize); i++) {
         self->buffer_streams[i] = 0.0;
     }
-    
-    keys = PyDict_Keys(self->inputs);
-    num = PyList_Size(keys);
-
-    if (num == 0)
-        return;
-
-    for (j=0; j<num; j++) {
-        key = PyList_GET_ITEM(keys, j);
-        MYFLT *st = Stream_getData((Stream *)PyObject_CallMethod((PyObject *)PyDict_GetItem(self->inputs, key), "_getStream", NULL));
-        list_of_gains = PyDict_GetItem(self->gains, key);
-        list_of_last_gains = PyDict_GetItem(self->lastGains, key);
-        list_of_current_gains = PyDict_GetItem(self->currentGains, key);
-        list_of_step_vals = PyDict_GetItem(self->stepVals, key);
-        list_of_time_counts = PyDict_GetItem(self->timeCounts, key);
-        for (k=0; k<self->num_outs; k++) {
-            amp = (MYFLT)PyFloat_AS_DOUBLE(PyList_GET_ITEM(list_of_gains, k));
-            lastAmp = (MYFLT)PyFloat_AS_DOUBLE(PyList_GET_ITEM(list_of_last_gains, k));
-            currentAmp = (MYFLT)PyFloat_AS_DOUBLE(PyList_GET_ITEM(list_of_current_gains, k));
-            tmpStepVal = (MYFLT)PyFloat_AS_DOUBLE(PyList_GET_ITEM(list_of_step_vals, k));
-            tmpCount = (int)PyLong_AsLong(PyList_GET_ITEM(list_of_time_counts, k));
-            if (amp != lastAmp) {
-                tmpCount = 0;
-                tmpStepVal = (amp - currentAmp) / self->timeStep;
-                PyList_SET_ITEM(list_of_last_gains, k, PyFloat_FromDouble(amp));
-            }    
+
+    for (j=0; j<m->ins; j++) {
+        m->buffers[j] = m->streams[j] == NULL ? NULL : Stream_getData(m->streams[j]);
+    }
+
+    for (k=0; k<self->num_outs; k++) {
+        out = self->buffer_streams + self->bufsize * k;
+        num = 0;
+        for (j=0; j<m->ins; j++) {
+            st = m->buffers[j];
+            if (st == NULL)
+                continue;
+            c = k * m->ins + j;
+            if (m->remaining[c] == 0) {
+                if (m->currents[c] != 0.0) {
+                    m->mixins[num] = st;
+                    m->mixgains[num++] = m->currents[c];
+                }
+                continue;
+            }
+            /* Ramp toward the new amplitude, the last step lands on the target. */
+            amp = m->currents[c];
+            target = m->gains[c];
+            step = m->steps[c];
+            count = m->remaining[c];
             for (i=0; i<self->bufsize; i++) {
-                if (tmpCount == (self->timeStep - 1)) {
-                    currentAmp = amp;
-                    tmpCount++;
+                if (count == 1) {
+                    amp = target;
+                    count = 0;
+                }
+                else if (count > 1) {
+                    amp += step;
+                    count--;
                 }
-                else if (tmpCount < self->timeStep) {
-                    currentAmp += tmpStepVal;
-                    tmpCount++;
-                }    
-                self->buffer_streams[self->bufsize * k + i] += st[i] * currentAmp;
+                out[i] += st[i] * amp;
             }
-            PyList_SET_ITEM(list_of_current_gains, k, PyFloat_FromDouble(currentAmp));
-            PyList_SET_ITEM(list_of_step_vals, k, PyFloat_FromDouble(tmpStepVal));
-            PyList_SET_ITEM(list_of_time_counts, k, PyLong_FromLong(tmpCount));
-        }    
+            m->currents[c] = amp;
+            m->remaining[c] = count;
+        }
+        if (num > 0)
+            pyo_vec_mix(out, m->mixins, m->mixgains, num, self->bufsize);
+    }
+}
+
+/* Python side. The blocks are computed while the audio thread holds the GIL
+   (or the block lock, see Server_lockBlocks), so when the ring is full the
+   commands can be applied right away. */
+static void
+Mixer_sendCommand(Mixer *self, int type, int index, int index2, double value, void *ptr)
+{
+    PyoCommand cmd;
+    int locked;
+    cmd.type = type;
+    cmd.index = index;
+    cmd.index2 = index2;
+    cmd.value = value;
+    cmd.ptr = ptr;
+    if (PyoCommandQueue_push(self->commands, &cmd) < 0) {
+        locked = Server_lockBlocks(self->server);
+        Mixer_applyCommands(self);
+        PyoCommandQueue_push(self->commands, &cmd);
+        Server_unlockBlocks(self->server, locked);
     }
 }
 
 MYFLT *
 Mixer_getSamplesBuffer(Mixer *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->buffer_streams;
 }    
 
@@ -2430,6 +2461,7 @@ Mixer_traverse(Mixer *self, visitproc visit, void *arg)
 {
     pyo_VISIT
     Py_VISIT(self->inputs);
+    Py_VISIT(self->slots);
     Py_VISIT(self->gains);
     return 0;
 }
@@ -2439,6 +2471,7 @@ Mixer_clear(Mixer *self)
 {
     pyo_CLEAR
     Py_CLEAR(self->inputs);
+    Py_CLEAR(self->slots);
     Py_CLEAR(self->gains);
     return 0;
 }
@@ -2446,6 +2479,11 @@ Mixer_clear(Mixer *self)
 static void
 Mixer_dealloc(Mixer* self)
 {
+    Mixer_applyCommands(self);
+    PyoCommandQueue_free(self->commands);
+    if (self->matrix != NULL)
+        MixerMatrix_free(self->matrix);
+    free(self->taken);
     free(self->data);
     free(self->buffer_streams);
     Mixer_clear(self);
@@ -2462,16 +2500,14 @@ Mixer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (Mixer *)type->tp_alloc(type, 0);
     
     self->inputs = PyDict_New();
+    self->slots = PyDict_New();
     self->gains = PyDict_New();
-    self->lastGains = PyDict_New();
-    self->currentGains = PyDict_New();
-    self->stepVals = PyDict_New();
-    self->timeCounts = PyDict_New();
     self->num_outs = 2;
     self->time = 0.025;
-    self->timeStep = (long)(self->time * self->sr);
+    self->commands = PyoCommandQueue_new(1024);
     
     INIT_OBJECT_COMMON
+    self->timeStep = (long)(self->time * self->sr);
     Stream_setFunctionPtr(self->stream, Mixer_compute_next_data_frame);
     self->mode_func_ptr = Mixer_setProcMode;
     return (PyObject *)self;
@@ -2487,6 +2523,9 @@ Mixer_init(Mixer *self, PyObject *args, PyObject *kwds)
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "|iO", kwlist, &self->num_outs, &timetmp))
         return -1; 
 
+    self->matrix = self->latest = MixerMatrix_new(8, self->num_outs);
+    self->taken = (char *)calloc(8, sizeof(char));
+
     if (timetmp) {
         PyObject_CallMethod((PyObject *)self, "setTime", "O", timetmp);
     }
@@ -2511,8 +2550,7 @@ static PyObject * Mixer_stop(Mixer *self) { STOP };
 static PyObject *
 Mixer_setTime(Mixer *self, PyObject *arg)
 {
-    int i, j, num;
-	PyObject *tmp, *keys, *key, *list_of_time_counts;
+	PyObject *tmp;
 	
 	if (arg == NULL) {
 		Py_INCREF(Py_None);
@@ -2521,23 +2559,11 @@ Mixer_setTime(Mixer *self, PyObject *arg)
     
 	int isNumber = PyNumber_Check(arg);
 	
-	tmp = arg;
-	Py_INCREF(tmp);
 	if (isNumber == 1) {
-		self->time = PyFloat_AS_DOUBLE(PyNumber_Float(tmp));
-        self->timeStep = (long)(self->time * self->sr);
-        
-        keys = PyDict_Keys(self->inputs);
-        num = PyList_Size(keys);
-        if (num != 0) {
-            for (j=0; j<num; j++) {
-                key = PyList_GET_ITEM(keys, j);
-                list_of_time_counts = PyDict_GetItem(self->timeCounts, key);
-                for (i=0; i<self->num_outs; i++) {
-                    PyList_SET_ITEM(list_of_time_counts, i, PyLong_FromLong(self->timeStep-1));
-                }    
-            }
-        }    
+		tmp = PyNumber_Float(arg);
+		self->time = PyFloat_AS_DOUBLE(tmp);
+		Py_DECREF(tmp);
+        Mixer_sendCommand(self, MIXER_CMD_TIME, 0, 0, (double)(long)(self->time * self->sr), NULL);
 	}
     
 	Py_INCREF(Py_None);
@@ -2547,14 +2573,10 @@ Mixer_setTime(Mixer *self, PyObject *arg)
 static PyObject *
 Mixer_addInput(Mixer *self, PyObject *args, PyObject *kwds)
 {
-    int i;
-	PyObject *tmp;
-    PyObject *initGains;
-    PyObject *initLastGains;
-    PyObject *initCurrentGains;
-    PyObject *initStepVals;
-    PyObject *initTimeCounts;
-    PyObject *voice;
+    int i, slot;
+	PyObject *tmp, *slotobj, *old, *initGains;
+    PyObject *voice, *streamtmp;
+    MixerMatrix *m;
 
     static char *kwlist[] = {"voice", "input", NULL};
     
@@ -2562,26 +2584,51 @@ Mixer_addInput(Mixer *self, PyObject *args, PyObject *kwds)
         Py_INCREF(Py_None);
         return Py_None;
     }
-    
+
+    streamtmp = PyObject_CallMethod(tmp, "_getStream", NULL);
+    if (streamtmp == NULL)
+        return NULL;
+
+    slotobj = PyDict_GetItem(self->slots, voice);
+    if (slotobj != NULL) {
+        /* Replaces the input, the old one is kept alive until the audio side drops it. */
+        slot = (int)PyInt_AsLong(slotobj);
+        old = PyDict_GetItem(self->inputs, voice);
+        Py_INCREF(old);
+        Mixer_sendCommand(self, MIXER_CMD_DEL, slot, 0, 0.0, NULL);
+        PyoCommandQueue_defer(self->commands, old, Mixer_releaseObject);
+    }
+    else {
+        for (slot=0; slot<self->latest->ins && self->taken[slot]; slot++);
+        if (slot == self->latest->ins) {
+            m = self->latest;
+            self->latest = MixerMatrix_new(m->ins * 2, self->num_outs);
+            self->taken = (char *)realloc(self->taken, self->latest->ins * sizeof(char));
+            for (i=m->ins; i<self->latest->ins; i++)
+                self->taken[i] = 0;
+            Mixer_sendCommand(self, MIXER_CMD_RESIZE, 0, 0, 0.0, self->latest);
+            PyoCommandQueue_defer(self->commands, m, MixerMatrix_free);
+        }
+        self->taken[slot] = 1;
+        slotobj = PyInt_FromLong(slot);
+        PyDict_SetItem(self->slots, voice, slotobj);
+        Py_DECREF(slotobj);
+    }
+
+    /* The input object owns its stream and stays in self->inputs while the matrix points to the stream. */
     PyDict_SetItem(self->inputs, voice, tmp);
+    Mixer_sendCommand(self, MIXER_CMD_ADD, slot, 0, 0.0, streamtmp);
+    Py_DECREF(streamtmp);
+
     initGains = PyList_New(self->num_outs);
-    initLastGains = PyList_New(self->num_outs);
-    initCurrentGains = PyList_New(self->num_outs);
-    initStepVals = PyList_New(self->num_outs);
-    initTimeCounts = PyList_New(self->num_outs);
     for (i=0; i<self->num_outs; i++) {
         PyList_SET_ITEM(initGains, i, PyFloat_FromDouble(0.0));
-        PyList_SET_ITEM(initLastGains, i, PyFloat_FromDouble(0.0));
-        PyList_SET_ITEM(initCurrentGains, i, PyFloat_FromDouble(0.0));
-        PyList_SET_ITEM(initStepVals, i, PyFloat_FromDouble(0.0));
-        PyList_SET_ITEM(initTimeCounts, i, PyInt_FromLong(0));
     }
     PyDict_SetItem(self->gains, voice, initGains);
-    PyDict_SetItem(self->lastGains, voice, initLastGains);
-    PyDict_SetItem(self->currentGains, voice, initCurrentGains);
-    PyDict_SetItem(self->stepVals, voice, initStepVals);
-    PyDict_SetItem(self->timeCounts, voice, initTimeCounts);
+    Py_DECREF(initGains);
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }	
@@ -2589,22 +2636,26 @@ Mixer_addInput(Mixer *self, PyObject *args, PyObject *kwds)
 static PyObject *
 Mixer_delInput(Mixer *self, PyObject *arg)
 {
-    int ret;
-    
-    PyObject *key = arg;
-    ret = PyDict_DelItem(self->inputs, key);
-    if (ret == 0) {
-        PyDict_DelItem(self->gains, key);
-        PyDict_DelItem(self->lastGains, key);
-        PyDict_DelItem(self->currentGains, key);
-        PyDict_DelItem(self->stepVals, key);
-        PyDict_DelItem(self->timeCounts, key);
-    }    
-    else {
+    int slot;
+    PyObject *key = arg, *slotobj, *old;
+
+    slotobj = PyDict_GetItem(self->slots, key);
+    if (slotobj == NULL) {
+        PyErr_Clear();
         Py_INCREF(Py_None);
         return Py_None;
     }
 
+    slot = (int)PyInt_AsLong(slotobj);
+    Mixer_sendCommand(self, MIXER_CMD_DEL, slot, 0, 0.0, NULL);
+    self->taken[slot] = 0;
+    old = PyDict_GetItem(self->inputs, key);
+    Py_INCREF(old);
+    PyoCommandQueue_defer(self->commands, old, Mixer_releaseObject);
+    PyDict_DelItem(self->inputs, key);
+    PyDict_DelItem(self->slots, key);
+    PyDict_DelItem(self->gains, key);
+
 	Py_INCREF(Py_None);
 	return Py_None;        
 }
@@ -2613,7 +2664,7 @@ static PyObject *
 Mixer_setAmp(Mixer *self, PyObject *args, PyObject *kwds)
 {
     int tmpout;
-    PyObject *tmpin, *amp;
+    PyObject *tmpin, *amp, *slotobj;
     static char *kwlist[] = {"vin", "vout", "amp", NULL};
     
     if (! PyArg_ParseTupleAndKeywords(args, kwds, "OiO", kwlist, &tmpin, &tmpout, &amp)) {
@@ -2626,9 +2677,15 @@ Mixer_setAmp(Mixer *self, PyObject *args, PyObject *kwds)
         Py_INCREF(Py_None);
         return Py_None;        
     }
+
+    slotobj = PyDict_GetItem(self->slots, tmpin);
+    if (slotobj == NULL || tmpout < 0 || tmpout >= self->num_outs) {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
     
-    Py_INCREF(amp);
-    PyList_SET_ITEM(PyDict_GetItem(self->gains, tmpin), tmpout, PyNumber_Float(amp));
+    PyList_SetItem(PyDict_GetItem(self->gains, tmpin), tmpout, PyNumber_Float(amp));
+    Mixer_sendCommand(self, MIXER_CMD_GAIN, (int)PyInt_AsLong(slotobj), tmpout, PyFloat_AsDouble(amp), NULL);
 
     Py_INCREF(Py_None);
     return Py_None;
@@ -2639,6 +2696,7 @@ static PyMemberDef Mixer_members[] = {
     {"stream", T_OBJECT_EX, offsetof(Mixer, stream), 0, "Stream object."},
     {"inputs", T_OBJECT_EX, offsetof(Mixer, inputs), 0, "Dictionary of input streams."},
     {"gains", T_OBJECT_EX, offsetof(Mixer, gains), 0, "Dictionary of list of amplitudes."},
+    {"slots", T_OBJECT_EX, offsetof(Mixer, slots), 0, "Dictionary of the inputs' positions in the gain matrix."},
     {NULL}  /* Sentinel */
 };
 
@@ -19,6 +19,7 @@
  *************************************************************************/
 
 #include <Python.h>
+#include <math.h>
 #include "structmember.h"
 #include "pyomodule.h"
 #include "streammodule.h"
@@ -31,59 +32,129 @@ typedef struct {
     PyObject *time;
     Stream *time_stream;
     int modebuffer[1];
-    MYFLT sampleToSec;
-    double currentTime;
+    MYFLT *trigs; /* triggers placed by the events of the block */
+    double nextTime; /* sample of the next call, on the server's timeline */
+    double lastTime; /* sample of the last call */
+    int queued; /* 1 if the next call is waiting on the timeline */
+    int firing; /* 1 while the function is called from the block */
     int init;
 } Pattern;
 
+/* Control side, see Server_postCallback. */
 static void
-Pattern_generate_i(Pattern *self) {
-    MYFLT tm;
-    int i, flag;
-    
-    flag = 0;
-    tm = PyFloat_AS_DOUBLE(self->time);
+Pattern_callFunction(PyObject *obj, double value)
+{
+    Server_callPython(((Pattern *)obj)->callable, Py_None);
+}
 
-    for (i=0; i<self->bufsize; i++) {
-        if (self->currentTime >= tm) {
-            flag = 1;
-            self->currentTime = 0.;
-        }    
+/* Period in samples, for a scalar time. */
+static double
+Pattern_getPeriod(Pattern *self)
+{
+    double tm = PyFloat_AS_DOUBLE(self->time) * self->sr;
 
-        self->currentTime += self->sampleToSec;
-    }
-    if (flag == 1 || self->init == 1) {
-        PyObject_Call((PyObject *)self->callable, PyTuple_New(0), NULL);
+    return tm > 1.0 ? tm : 1.0;
+}
+
+/* Places a call at `offset` in the block, `time` being its sample on the timeline. */
+static void
+Pattern_fire(Pattern *self, double time, int offset)
+{
+    self->trigs[offset] = 1.0;
+    self->lastTime = time;
+    /* A time changed by the function itself is taken here, see Pattern_setProcMode. */
+    self->firing = 1;
+    Server_postCallback(self->server, Pattern_callFunction, (PyObject *)self, 0.0);
+    self->firing = 0;
+    if (self->modebuffer[0] == 0)
+        self->nextTime = time + Pattern_getPeriod(self);
+}
+
+static void Pattern_event(PyObject *obj, unsigned long long time, int offset);
+
+static void
+Pattern_schedule(Pattern *self)
+{
+    /* If the timeline is full, the call is late and made by Pattern_generate_i. */
+    self->queued = Server_scheduleEvent(self->server, (unsigned long long)ceil(self->nextTime), Pattern_event, (PyObject *)self) == 0;
+}
+
+/* Timeline side, at the start of the block holding the call. */
+static void
+Pattern_event(PyObject *obj, unsigned long long time, int offset)
+{
+    Pattern *self = (Pattern *)obj;
+
+    self->queued = 0;
+    /* Stopped meanwhile, or played again, the processing function starts over. */
+    if (self->init == 1 || Stream_getStreamActive(self->stream) == 0)
+        return;
+    Pattern_fire(self, self->nextTime, offset);
+    if (self->modebuffer[0] == 0 && self->queued == 0)
+        Pattern_schedule(self);
+}
+
+/* Scalar time, the calls are placed on the timeline. */
+static void
+Pattern_generate_i(Pattern *self) {
+    int offset;
+    unsigned long long start = Server_getElapsedSamples(self->server);
+    double end = (double)(start + self->bufsize);
+
+    if (self->init == 1) {
+        Server_cancelEvents(self->server, (PyObject *)self);
+        self->queued = 0;
+        self->nextTime = (double)start;
         self->init = 0;
     }
+    /* Just played (the first call is right away), or the timeline was full. */
+    if (self->queued == 0) {
+        if (self->nextTime < (double)start)
+            self->nextTime = (double)start;
+        while (self->modebuffer[0] == 0 && ceil(self->nextTime) < end) {
+            offset = (int)(ceil(self->nextTime) - start);
+            Pattern_fire(self, self->nextTime, offset);
+        }
+        if (self->modebuffer[0] == 0 && self->queued == 0)
+            Pattern_schedule(self);
+    }
+    memcpy(self->data, self->trigs, self->bufsize * sizeof(MYFLT));
+    memset(self->trigs, 0, self->bufsize * sizeof(MYFLT));
 }
 
+/* Audio-rate time, read at every sample. */
 static void
 Pattern_generate_a(Pattern *self) {
-    int i, flag;
-    
+    int i = 0;
+    double start = (double)Server_getElapsedSamples(self->server);
     MYFLT *tm = Stream_getData((Stream *)self->time_stream);
-    
-    flag = 0;
-    for (i=0; i<self->bufsize; i++) {
-        if (self->currentTime >= tm[i]) {
-            flag = 1;
-            self->currentTime = 0.;
-        }    
-        
-        self->currentTime += self->sampleToSec;
-    }
-    if (flag == 1 || self->init == 1) {
-        PyObject_Call((PyObject *)self->callable, PyTuple_New(0), NULL);
+
+    if (self->init == 1) {
+        Server_cancelEvents(self->server, (PyObject *)self);
+        self->queued = 0;
         self->init = 0;
-    }    
+        Pattern_fire(self, start, 0);
+        i = 1;
+    }
+    for (; i<self->bufsize && self->modebuffer[0] == 1; i++) {
+        if ((start + i - self->lastTime) >= tm[i] * self->sr)
+            Pattern_fire(self, start + i, i);
+    }
+    /* The function gave a scalar time. */
+    if (self->modebuffer[0] == 0 && self->queued == 0)
+        Pattern_schedule(self);
+    memcpy(self->data, self->trigs, self->bufsize * sizeof(MYFLT));
+    memset(self->trigs, 0, self->bufsize * sizeof(MYFLT));
 }
 
-
+/* Also called when a new time is applied: the waiting call is moved to the
+   last call plus the new period (right away if this is already past). */
 static void
 Pattern_setProcMode(Pattern *self)
 {
+    double now;
     int procmode = self->modebuffer[0];
+
     switch (procmode) {
         case 0:        
             self->proc_func_ptr = Pattern_generate_i;
@@ -92,6 +163,18 @@ Pattern_setProcMode(Pattern *self)
             self->proc_func_ptr = Pattern_generate_a;
             break;
     }
+
+    if (self->init == 1 || self->firing == 1 || Stream_getStreamActive(self->stream) == 0)
+        return;
+    Server_cancelEvents(self->server, (PyObject *)self);
+    self->queued = 0;
+    if (procmode == 0) {
+        now = (double)Server_getElapsedSamples(self->server);
+        self->nextTime = self->lastTime + Pattern_getPeriod(self);
+        if (self->nextTime < now)
+            self->nextTime = now;
+        Pattern_schedule(self);
+    }
 }
 
 static void
@@ -124,6 +207,7 @@ static void
 Pattern_dealloc(Pattern* self)
 {
     free(self->data);
+    free(self->trigs);
     Pattern_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -142,13 +226,15 @@ Pattern_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->init = 1;
 
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
     Stream_setFunctionPtr(self->stream, Pattern_compute_next_data_frame);
     self->mode_func_ptr = Pattern_setProcMode;
 
     Stream_setStreamActive(self->stream, 0);
     
-    self->sampleToSec = 1. / self->sr;
-    self->currentTime = 0.;
+    self->trigs = (MYFLT *)calloc(self->bufsize, sizeof(MYFLT));
+    self->nextTime = self->lastTime = 0.;
+    self->queued = self->firing = 0;
     
     return (PyObject *)self;
 }
@@ -215,35 +301,7 @@ Pattern_setFunction(Pattern *self, PyObject *arg)
 static PyObject *
 Pattern_setTime(Pattern *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->time);
-	if (isNumber == 1) {
-		self->time = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->time = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->time, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->time_stream);
-        self->time_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(time, 0)
 }	
 
 static PyMemberDef Pattern_members[] = {
@@ -318,17 +376,26 @@ typedef struct {
     int last_value;
 } Score;
 
+/* Control side, see Server_postCallback. */
+static void
+Score_callFunction(PyObject *obj, double value)
+{
+    Score *self = (Score *)obj;
+
+    sprintf(self->curfname, "%s%i()\n", self->fname, (int)value);
+    PyRun_SimpleString(self->curfname);
+}
+
 static void
 Score_selector(Score *self) {
-    int i, inval, state, res;
+    int i, inval;
     
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
     for (i=0; i<self->bufsize; i++) {
         inval = (int)in[i];
         if (inval != self->last_value) {
-            res = sprintf(self->curfname, "%s%i()\n", self->fname, inval);
-            state = PyRun_SimpleString(self->curfname);
+            Server_postCallback(self->server, Score_callFunction, (PyObject *)self, (double)inval);
             self->last_value = inval;
         }    
     }
@@ -385,6 +452,7 @@ Score_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->last_value = -99;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
     Stream_setFunctionPtr(self->stream, Score_compute_next_data_frame);
     self->mode_func_ptr = Score_setProcMode;
     
@@ -483,29 +551,51 @@ typedef struct {
     PyObject *callable;
     PyObject *arg;
     MYFLT time;
-    MYFLT sampleToSec;
-    double currentTime;
+    unsigned long long when; /* sample of the call, on the server's timeline */
+    int init;
 } CallAfter;
 
+/* Control side, see Server_postCallback. */
+static void
+CallAfter_callFunction(PyObject *obj, double value)
+{
+    CallAfter *self = (CallAfter *)obj;
+
+    Server_callPython(self->callable, self->arg);
+}
+
+static void
+CallAfter_fire(CallAfter *self)
+{
+    Server_postCallback(self->server, CallAfter_callFunction, (PyObject *)self, 0.0);
+    STOP_PROCESSING
+}
+
+/* Timeline side, at the start of the block holding the call. */
+static void
+CallAfter_event(PyObject *obj, unsigned long long time, int offset)
+{
+    CallAfter *self = (CallAfter *)obj;
+
+    if (Stream_getStreamActive(self->stream) == 1)
+        CallAfter_fire(self);
+}
+
 static void
 CallAfter_generate(CallAfter *self) {
-    int i;
-    PyObject *tuple;
+    unsigned long long start = Server_getElapsedSamples(self->server);
 
-    for (i=0; i<self->bufsize; i++) {
-        if (self->currentTime >= self->time) {
-            if (self->arg == Py_None)
-                PyObject_Call(self->callable, PyTuple_New(0), NULL);
-            else {
-                tuple = PyTuple_New(1);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                PyObject_Call(self->callable, tuple, NULL);                
-            }
-            PyObject_CallMethod((PyObject *)self, "stop", NULL);
-            break;
-        }
-        self->currentTime += self->sampleToSec;
+    if (self->init == 1) {
+        Server_cancelEvents(self->server, (PyObject *)self);
+        self->when = start + (unsigned long long)(self->time * self->sr + 0.5);
+        self->init = 0;
+        if (self->when < start + self->bufsize || 
+            Server_scheduleEvent(self->server, self->when, CallAfter_event, (PyObject *)self) < 0)
+            self->when = start;
     }
+    /* Due in this block, or the timeline was full. */
+    if (self->when < start + self->bufsize)
+        CallAfter_fire(self);
 }
 
 static void
@@ -557,13 +647,12 @@ CallAfter_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     
     self->time = 1.;
     self->arg = Py_None;
+    self->init = 1;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
     Stream_setFunctionPtr(self->stream, CallAfter_compute_next_data_frame);
     self->mode_func_ptr = CallAfter_setProcMode;
-
-    self->sampleToSec = 1. / self->sr;
-    self->currentTime = 0.;
     
     return (PyObject *)self;
 }
@@ -602,7 +691,12 @@ CallAfter_init(CallAfter *self, PyObject *args, PyObject *kwds)
 static PyObject * CallAfter_getServer(CallAfter* self) { GET_SERVER };
 static PyObject * CallAfter_getStream(CallAfter* self) { GET_STREAM };
 
-static PyObject * CallAfter_play(CallAfter *self, PyObject *args, PyObject *kwds) { PLAY };
+static PyObject * 
+CallAfter_play(CallAfter *self, PyObject *args, PyObject *kwds) 
+{ 
+    self->init = 1;
+    PLAY 
+};
 static PyObject * CallAfter_stop(CallAfter *self) { STOP };
 
 static PyMemberDef CallAfter_members[] = {
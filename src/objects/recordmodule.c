@@ -25,6 +25,7 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 #include "sndfile.h"
+#include "sndwriter.h"
 #include "interpolation.h"
 
 /************/
@@ -36,41 +37,49 @@ typedef struct {
     PyObject *input_stream_list;
     int chnls;
     int buffering;
-    int count;
     int listlen;
     char *recpath;
-    SNDFILE *recfile;
     SF_INFO recinfo;
-    MYFLT *buffer;
+    PyoSndWriter *writer; /* NULL once stopped */
+    unsigned long overflows;
+    unsigned long long dropped;
+    MYFLT *buffer; /* one interleaved block */
 } Record;
 
 static void
 Record_process(Record *self) {
-    int i, j, chnl, offset, totlen;
+    int i, j, chnl;
     MYFLT *in;
 
-    totlen = self->chnls*self->bufsize*self->buffering;
-    
-    if (self->count == self->buffering) {
-        self->count = 0;
-        for (i=0; i<totlen; i++) {
-            self->buffer[i] = 0.0;
-        }
-    }    
+    if (self->writer == NULL)
+        return;
 
-    offset = self->bufsize * self->chnls * self->count;
-    
+    memset(self->buffer, 0, self->chnls * self->bufsize * sizeof(MYFLT));
     for (j=0; j<self->listlen; j++) {
         chnl = j % self->chnls;
         in = Stream_getData((Stream *)PyList_GET_ITEM(self->input_stream_list, j));
         for (i=0; i<self->bufsize; i++) {
-            self->buffer[i*self->chnls+chnl+offset] += in[i];
+            self->buffer[i*self->chnls+chnl] += in[i];
         }
     }
-    self->count++;
-    
-    if (self->count == self->buffering)
-        SF_WRITE(self->recfile, self->buffer, totlen);
+    PyoSndWriter_write(self->writer, self->buffer, self->bufsize);
+}
+
+/* Python side. Stops the writes and closes the file. */
+static void
+Record_close(Record *self)
+{
+    PyoSndWriter *writer;
+    int locked = Server_lockBlocks(self->server);
+
+    writer = self->writer;
+    self->writer = NULL;
+    Server_unlockBlocks(self->server, locked);
+    if (writer == NULL)
+        return;
+    PyoSndWriter_getOverflows(writer, &self->overflows, &self->dropped);
+    if (PyoSndWriter_close(writer) < 0)
+        printf("Error while writing file %s.\n", self->recpath);
 }
 
 static void
@@ -106,6 +115,7 @@ Record_clear(Record *self)
 static void
 Record_dealloc(Record* self)
 {
+    Record_close(self);
     free(self->data);
     free(self->buffer);
     Record_clear(self);
@@ -123,7 +133,8 @@ Record_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     
     self->chnls = 2;
     self->buffering = 4;
-    self->count = 0;
+    self->writer = NULL;
+    self->overflows = self->dropped = 0;
     
     INIT_OBJECT_COMMON
     Stream_setFunctionPtr(self->stream, Record_compute_next_data_frame);
@@ -134,7 +145,7 @@ Record_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 static int
 Record_init(Record *self, PyObject *args, PyObject *kwds)
 {
-    int i, buflen;
+    int i, chunk;
     int fileformat = 0;
     int sampletype = 0;
     PyObject *input_listtmp;
@@ -182,16 +193,19 @@ Record_init(Record *self, PyObject *args, PyObject *kwds)
             break;
     }
     
-    /* Open the output file. */
-    if (! (self->recfile = sf_open(self->recpath, SFM_WRITE, &self->recinfo))) {   
+    /* Open the output file. The writer thread gets at least `buffering` blocks at once. Offline,
+       the rendering waits for the disk, in real time the frames that don't fit are dropped. */
+    chunk = self->bufsize * (self->buffering > 0 ? self->buffering : 1);
+    if (chunk < PYO_SNDWRITER_CHUNK_FRAMES)
+        chunk = PYO_SNDWRITER_CHUNK_FRAMES;
+    self->writer = PyoSndWriter_open(self->recpath, &self->recinfo, chunk, (int)(PYO_SNDWRITER_SECONDS * self->sr / chunk) + 2,
+                                     (sizeof(MYFLT) == sizeof(double) ? PYO_SNDWRITER_DOUBLE : 0) |
+                                     (((Server *)self->server)->audio_be_type == PyoOffline ? 0 : PYO_SNDWRITER_REALTIME));
+    if (self->writer == NULL) {   
         printf ("Not able to open output file %s.\n", self->recpath);
     }	
 
-    buflen = self->bufsize * self->chnls * self->buffering;
-    self->buffer = (MYFLT *)realloc(self->buffer, buflen * sizeof(MYFLT));
-    for (i=0; i<buflen; i++) {
-        self->buffer[i] = 0.;
-    }    
+    self->buffer = (MYFLT *)realloc(self->buffer, self->bufsize * self->chnls * sizeof(MYFLT));
     
     Py_INCREF(self->stream);
     PyObject_CallMethod(self->server, "addStream", "O", self->stream);
@@ -208,10 +222,21 @@ static PyObject * Record_getStream(Record* self) { GET_STREAM };
 static PyObject * Record_play(Record *self, PyObject *args, PyObject *kwds) { PLAY };
 static PyObject * Record_stop(Record *self) 
 { 
-    sf_close(self->recfile);
+    Record_close(self);
     STOP
 };
 
+static PyObject *
+Record_getOverflows(Record *self)
+{
+    unsigned long overflows = self->overflows;
+    unsigned long long dropped = self->dropped;
+
+    if (self->writer != NULL)
+        PyoSndWriter_getOverflows(self->writer, &overflows, &dropped);
+    return Py_BuildValue("(kK)", overflows, dropped);
+}
+
 static PyMemberDef Record_members[] = {
 {"server", T_OBJECT_EX, offsetof(Record, server), 0, "Pyo server."},
 {"stream", T_OBJECT_EX, offsetof(Record, stream), 0, "Stream object."},
@@ -225,6 +250,7 @@ static PyMethodDef Record_methods[] = {
 {"deleteStream", (PyCFunction)Record_deleteStream, METH_NOARGS, "Remove stream from server and delete the object."},
 {"play", (PyCFunction)Record_play, METH_VARARGS|METH_KEYWORDS, "Starts computing without sending sound to soundcard."},
 {"stop", (PyCFunction)Record_stop, METH_NOARGS, "Stops computing."},
+{"getOverflows", (PyCFunction)Record_getOverflows, METH_NOARGS, "Returns the number of overflows and of dropped frames."},
 {NULL}  /* Sentinel */
 };
 
@@ -370,6 +396,8 @@ ControlRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->tmp_list = PyList_New(0);
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, ControlRec_compute_next_data_frame);
     self->mode_func_ptr = ControlRec_setProcMode;
 
@@ -658,6 +686,8 @@ ControlRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[1] = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, ControlRead_compute_next_data_frame);
     self->mode_func_ptr = ControlRead_setProcMode;
     
@@ -808,6 +838,7 @@ ControlRead_setInterp(ControlRead *self, PyObject *arg)
 MYFLT *
 ControlRead_getTrigsBuffer(ControlRead *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
@@ -1284,6 +1315,8 @@ NoteinRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->last_pitch = self->last_vel = 0.0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, NoteinRec_compute_next_data_frame);
     self->mode_func_ptr = NoteinRec_setProcMode;
     
@@ -1558,6 +1591,8 @@ NoteinRead_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[1] = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, NoteinRead_compute_next_data_frame);
     self->mode_func_ptr = NoteinRead_setProcMode;
     
@@ -1693,6 +1728,7 @@ NoteinRead_setLoop(NoteinRead *self, PyObject *arg)
 MYFLT *
 NoteinRead_getTrigsBuffer(NoteinRead *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
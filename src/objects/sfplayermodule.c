@@ -26,6 +26,7 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 #include "sndfile.h"
+#include "diskstream.h"
 #include "interpolation.h"
 
 /* SfPlayer object */
@@ -34,7 +35,7 @@ typedef struct {
     PyObject *speed;
     Stream *speed_stream;
     int modebuffer[1];
-    SNDFILE *sf;
+    PyoDiskStream *ds;
     SF_INFO info;
     char *path;
     int loop;
@@ -76,6 +77,19 @@ MYFLT min_arr(MYFLT *a,int n)
     return m;
 }
 
+/* Tells the disk readers where the next buffers will be read */
+static void
+SfPlayer_setDiskPosition(SfPlayer *self, MYFLT sp)
+{
+    double rate = MYFABS(sp) * self->srScale * self->sr;
+
+    if (sp < 0)
+        PyoDiskStream_setPosition(self->ds, self->pointerPos, -1, rate, 0,
+                                  self->startPos == 0. ? self->sndSize - 1 : self->startPos);
+    else
+        PyoDiskStream_setPosition(self->ds, self->pointerPos, sp > 0 ? 1 : 0, rate, self->sndSize, self->startPos);
+}
+
 static void
 SfPlayer_readframes_i(SfPlayer *self) {
     MYFLT sp, frac, bufpos, delta, startPos;
@@ -95,14 +109,13 @@ SfPlayer_readframes_i(SfPlayer *self) {
     
     if (sp > 0) { /* forward reading */
         index = (int)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
 
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples left in the file */
         if ((index+buflen) > self->sndSize) {   
             shortbuflen = self->sndSize - index;
             pad = (buflen-shortbuflen)*self->sndChnls;
-            SF_READ(self->sf, buffer, shortbuflen*self->sndChnls);
+            PyoDiskStream_read(self->ds, index, shortbuflen, buffer);
             if (self->loop == 0) { /* with zero padding if noloop */
                 for (i=0; i<pad; i++) {
                     buffer[i+shortbuflen*self->sndChnls] = 0.;
@@ -110,15 +123,14 @@ SfPlayer_readframes_i(SfPlayer *self) {
             }
             else { /* wrap around and read new samples if loop */
                 MYFLT buftemp[pad];
-                sf_seek(self->sf, (int)self->startPos, SEEK_SET);
-                SF_READ(self->sf, buftemp, pad);
+                PyoDiskStream_read(self->ds, (int)self->startPos, buflen-shortbuflen, buftemp);
                 for (i=0; i<(pad); i++) {
                     buffer[i+shortbuflen*self->sndChnls] = buftemp[i];
                 }
             }    
         }
         else /* without zero padding */
-            SF_READ(self->sf, buffer, totlen);
+            PyoDiskStream_read(self->ds, index, buflen, buffer);
     
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
@@ -171,23 +183,20 @@ SfPlayer_readframes_i(SfPlayer *self) {
             }
             else { /* wrap around and read new samples if loop */
                 MYFLT buftemp[padlen];
-                sf_seek(self->sf, (int)startPos-pad, SEEK_SET);
-                SF_READ(self->sf, buftemp, padlen);
+                PyoDiskStream_read(self->ds, (int)startPos-pad, pad, buftemp);
                 for (i=0; i<padlen; i++) {
                     buffer[i] = buftemp[i];
                 }
             }
             
             MYFLT buftemp2[shortbuflen*self->sndChnls];
-            sf_seek(self->sf, 0, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen*self->sndChnls);
+            PyoDiskStream_read(self->ds, 0, shortbuflen, buftemp2);
             for (i=0; i<(shortbuflen*self->sndChnls); i++) {
                 buffer[i+padlen] = buftemp2[i];
             }    
         }
         else /* without zero padding */
-            sf_seek(self->sf, index-buflen, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buffer, totlen);
+            PyoDiskStream_read(self->ds, index-buflen, buflen, buffer);
         
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
@@ -238,6 +247,8 @@ SfPlayer_readframes_i(SfPlayer *self) {
             self->samplesBuffer[i] = 0.0;
         }
     }
+
+    SfPlayer_setDiskPosition(self, sp);
 }    
 
 static void
@@ -273,7 +284,7 @@ SfPlayer_clear(SfPlayer *self)
 static void
 SfPlayer_dealloc(SfPlayer* self)
 {
-    sf_close(self->sf);
+    PyoDiskStream_close(self->ds);
     free(self->tempTrigsBuffer);
     free(self->trigsBuffer);
     free(self->data);
@@ -297,6 +308,8 @@ SfPlayer_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[0] = 0;
 
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, SfPlayer_compute_next_data_frame);
     self->mode_func_ptr = SfPlayer_setProcMode;
     
@@ -327,9 +340,8 @@ SfPlayer_init(SfPlayer *self, PyObject *args, PyObject *kwds)
     SET_INTERP_POINTER
     
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
-    if (self->sf == NULL)
+    self->ds = PyoDiskStream_open(self->path, &self->info, 0);
+    if (self->ds == NULL)
     {
         printf("Failed to open the file.\n");
     }
@@ -351,6 +363,9 @@ SfPlayer_init(SfPlayer *self, PyObject *args, PyObject *kwds)
         self->startPos = 0.0;
     
     self->pointerPos = self->startPos;
+
+    PyoDiskStream_setBlocking(self->ds, ((Server *)self->server)->audio_be_type == PyoOffline);
+    SfPlayer_setDiskPosition(self, self->modebuffer[0] == 0 ? PyFloat_AS_DOUBLE(self->speed) : 1.0);
     
     Py_INCREF(self);
     return 0;
@@ -363,6 +378,7 @@ static PyObject * SfPlayer_play(SfPlayer *self, PyObject *args, PyObject *kwds)
 { 
     self->init = 1;
     self->pointerPos = self->startPos;
+    SfPlayer_setDiskPosition(self, self->modebuffer[0] == 0 ? PyFloat_AS_DOUBLE(self->speed) : 1.0);
     PLAY
 };
 
@@ -370,6 +386,7 @@ static PyObject * SfPlayer_out(SfPlayer *self, PyObject *args, PyObject *kwds)
 {
     self->init = 1;
     self->pointerPos = self->startPos;
+    SfPlayer_setDiskPosition(self, self->modebuffer[0] == 0 ? PyFloat_AS_DOUBLE(self->speed) : 1.0);
     OUT
 };
 
@@ -378,35 +395,7 @@ static PyObject * SfPlayer_stop(SfPlayer *self) { STOP };
 static PyObject *
 SfPlayer_setSpeed(SfPlayer *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->speed);
-	if (isNumber == 1) {
-		self->speed = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->speed = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->speed, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->speed_stream);
-        self->speed_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(speed, 0)
 }	
 
 static PyObject *
@@ -420,12 +409,11 @@ SfPlayer_setSound(SfPlayer *self, PyObject *arg)
     
     self->path = PyString_AsString(arg);
 
-    sf_close(self->sf);
+    PyoDiskStream_close(self->ds);
 
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
-    if (self->sf == NULL)
+    self->ds = PyoDiskStream_open(self->path, &self->info, 0);
+    if (self->ds == NULL)
     {
         printf("Failed to open the file.\n");
     }
@@ -438,6 +426,9 @@ SfPlayer_setSound(SfPlayer *self, PyObject *arg)
     
     self->startPos = 0.0;
     self->pointerPos = self->startPos;
+
+    PyoDiskStream_setBlocking(self->ds, ((Server *)self->server)->audio_be_type == PyoOffline);
+    SfPlayer_setDiskPosition(self, self->modebuffer[0] == 0 ? PyFloat_AS_DOUBLE(self->speed) : 1.0);
     
     Py_INCREF(Py_None);
     return Py_None;
@@ -500,12 +491,14 @@ SfPlayer_setInterp(SfPlayer *self, PyObject *arg)
 MYFLT *
 SfPlayer_getSamplesBuffer(SfPlayer *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->samplesBuffer;
 }    
 
 MYFLT *
 SfPlayer_getTrigsBuffer(SfPlayer *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<(self->bufsize*self->sndChnls); i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
@@ -1118,7 +1111,7 @@ typedef struct {
     PyObject *speed;
     Stream *speed_stream;
     int modebuffer[1];
-    SNDFILE *sf;
+    PyoDiskStream *ds;
     SF_INFO info;
     char *path;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
@@ -1142,6 +1135,14 @@ typedef struct {
 static void SfMarkerShuffler_chooseNewMark(SfMarkerShuffler *self, int dir);
 /******************/
 
+/* Tells the disk readers where the next buffers will be read */
+static void
+SfMarkerShuffler_setDiskPosition(SfMarkerShuffler *self, MYFLT sp)
+{
+    PyoDiskStream_setPosition(self->ds, self->pointerPos, self->lastDir, MYFABS(sp) * self->srScale * self->sr,
+                              self->endPos, self->nextStartPos);
+}
+
 static void
 SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
     MYFLT sp, frac, bufpos, delta, tmp;
@@ -1173,26 +1174,24 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
             self->lastDir = 1;
         }
         index = (int)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
         
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples to read in the file */
         if ((index+buflen) > self->endPos) {
             shortbuflen = self->endPos - index;
-            SF_READ(self->sf, buffer, shortbuflen*self->sndChnls);
+            PyoDiskStream_read(self->ds, index, shortbuflen, buffer);
 
             /* wrap around and read new samples from new marker */
             int pad = buflen - shortbuflen;
             int padlen = pad*self->sndChnls;
             MYFLT buftemp[padlen];
-            sf_seek(self->sf, (int)self->nextStartPos, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
+            PyoDiskStream_read(self->ds, (int)self->nextStartPos, pad, buftemp);
             for (i=0; i<padlen; i++) {
                 buffer[i+shortbuflen*self->sndChnls] = buftemp[i];
             }
         }
         else /* without wraparound */
-            SF_READ(self->sf, buffer, totlen);
+            PyoDiskStream_read(self->ds, index, buflen, buffer);
         
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
@@ -1232,22 +1231,19 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
 
             /* wrap around and read new samples from new marker */
             MYFLT buftemp[padlen];
-            sf_seek(self->sf, (int)self->nextStartPos-pad, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
+            PyoDiskStream_read(self->ds, (int)self->nextStartPos-pad, pad, buftemp);
             for (i=0; i<padlen; i++) {
                 buffer[i] = buftemp[i];
             }
             
             MYFLT buftemp2[shortbuflen*self->sndChnls];
-            sf_seek(self->sf, self->endPos, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen*self->sndChnls);
+            PyoDiskStream_read(self->ds, (long)self->endPos, shortbuflen, buftemp2);
             for (i=0; i<(shortbuflen*self->sndChnls); i++) {
                 buffer[i+padlen] = buftemp2[i];
             }    
         }
         else { /* without wraparound */
-            sf_seek(self->sf, index-buflen, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buffer, totlen);
+            PyoDiskStream_read(self->ds, index-buflen, buflen, buffer);
         }
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
@@ -1288,6 +1284,8 @@ SfMarkerShuffler_readframes_i(SfMarkerShuffler *self) {
             self->samplesBuffer[i] = 0.0;
         }
     }
+
+    SfMarkerShuffler_setDiskPosition(self, sp);
 }    
 
 static void
@@ -1373,7 +1371,7 @@ SfMarkerShuffler_clear(SfMarkerShuffler *self)
 static void
 SfMarkerShuffler_dealloc(SfMarkerShuffler* self)
 {
-    sf_close(self->sf);
+    PyoDiskStream_close(self->ds);
     free(self->samplesBuffer);
     free(self->markers);
     free(self->data);
@@ -1434,9 +1432,8 @@ SfMarkerShuffler_init(SfMarkerShuffler *self, PyObject *args, PyObject *kwds)
         self->interp_func_ptr = cubic;
     
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
-    if (self->sf == NULL)
+    self->ds = PyoDiskStream_open(self->path, &self->info, 0);
+    if (self->ds == NULL)
     {
         printf("Failed to open the file.\n");
     }
@@ -1450,6 +1447,8 @@ SfMarkerShuffler_init(SfMarkerShuffler *self, PyObject *args, PyObject *kwds)
 
     self->samplesBuffer = (MYFLT *)realloc(self->samplesBuffer, self->bufsize * self->sndChnls * sizeof(MYFLT));
 
+    PyoDiskStream_setBlocking(self->ds, ((Server *)self->server)->audio_be_type == PyoOffline);
+
     srand((unsigned)(time(0)));
 
     Py_INCREF(self);
@@ -1466,35 +1465,7 @@ static PyObject * SfMarkerShuffler_stop(SfMarkerShuffler *self) { STOP };
 static PyObject *
 SfMarkerShuffler_setSpeed(SfMarkerShuffler *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->speed);
-	if (isNumber == 1) {
-		self->speed = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->speed = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->speed, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->speed_stream);
-        self->speed_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(speed, 0)
 }	
 
 static PyObject *
@@ -1529,6 +1500,7 @@ SfMarkerShuffler_setInterp(SfMarkerShuffler *self, PyObject *arg)
 MYFLT *
 SfMarkerShuffler_getSamplesBuffer(SfMarkerShuffler *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->samplesBuffer;
 }    
 
@@ -1874,7 +1846,7 @@ typedef struct {
     PyObject *mark;
     Stream *mark_stream;
     int modebuffer[2];
-    SNDFILE *sf;
+    PyoDiskStream *ds;
     SF_INFO info;
     char *path;
     int interp; /* 0 = default to 2, 1 = nointerp, 2 = linear, 3 = cos, 4 = cubic */
@@ -1899,6 +1871,14 @@ typedef struct {
 static void SfMarkerLooper_chooseNewMark(SfMarkerLooper *self, int dir);
 /******************/
 
+/* Tells the disk readers where the next buffers will be read */
+static void
+SfMarkerLooper_setDiskPosition(SfMarkerLooper *self, MYFLT sp)
+{
+    PyoDiskStream_setPosition(self->ds, self->pointerPos, self->lastDir, MYFABS(sp) * self->srScale * self->sr,
+                              self->endPos, self->nextStartPos);
+}
+
 static void
 SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
     MYFLT sp, frac, bufpos, delta, tmp;
@@ -1930,26 +1910,24 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
             self->lastDir = 1;
         }
         index = (int)self->pointerPos;
-        sf_seek(self->sf, index, SEEK_SET); /* sets position pointer in the file */
         
         /* fill a buffer with enough samples to satisfy speed reading */
         /* if not enough samples to read in the file */
         if ((index+buflen) > self->endPos) {
             shortbuflen = self->endPos - index;
-            SF_READ(self->sf, buffer, shortbuflen*self->sndChnls);
+            PyoDiskStream_read(self->ds, index, shortbuflen, buffer);
             
             /* wrap around and read new samples if loop */
             int pad = buflen - shortbuflen;
             int padlen = pad*self->sndChnls;
             MYFLT buftemp[padlen];
-            sf_seek(self->sf, (int)self->nextStartPos, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
+            PyoDiskStream_read(self->ds, (int)self->nextStartPos, pad, buftemp);
             for (i=0; i<(padlen); i++) {
                 buffer[i+shortbuflen*self->sndChnls] = buftemp[i];
             }
         }
         else /* without zero padding */
-            SF_READ(self->sf, buffer, totlen);
+            PyoDiskStream_read(self->ds, index, buflen, buffer);
         
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
@@ -1989,22 +1967,19 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
             
             /* wrap around and read new samples if loop */
             MYFLT buftemp[padlen];
-            sf_seek(self->sf, (int)self->nextStartPos-pad, SEEK_SET);
-            SF_READ(self->sf, buftemp, padlen);
+            PyoDiskStream_read(self->ds, (int)self->nextStartPos-pad, pad, buftemp);
             for (i=0; i<padlen; i++) {
                 buffer[i] = buftemp[i];
             }
             
             MYFLT buftemp2[shortbuflen*self->sndChnls];
-            sf_seek(self->sf, self->endPos, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buftemp2, shortbuflen*self->sndChnls);
+            PyoDiskStream_read(self->ds, (long)self->endPos, shortbuflen, buftemp2);
             for (i=0; i<(shortbuflen*self->sndChnls); i++) {
                 buffer[i+padlen] = buftemp2[i];
             }    
         }
         else { /* without zero padding */
-            sf_seek(self->sf, index-buflen, SEEK_SET); /* sets position pointer in the file */
-            SF_READ(self->sf, buffer, totlen);
+            PyoDiskStream_read(self->ds, index-buflen, buflen, buffer);
         }
         /* de-interleave samples */
         for (i=0; i<totlen; i++) {
@@ -2045,6 +2020,8 @@ SfMarkerLooper_readframes_i(SfMarkerLooper *self) {
             self->samplesBuffer[i] = 0.0;
         }
     }
+
+    SfMarkerLooper_setDiskPosition(self, sp);
 }    
 
 static void
@@ -2141,7 +2118,7 @@ SfMarkerLooper_clear(SfMarkerLooper *self)
 static void
 SfMarkerLooper_dealloc(SfMarkerLooper* self)
 {
-    sf_close(self->sf);
+    PyoDiskStream_close(self->ds);
     free(self->samplesBuffer);
     free(self->markers);
     free(self->data);
@@ -2210,9 +2187,8 @@ SfMarkerLooper_init(SfMarkerLooper *self, PyObject *args, PyObject *kwds)
         self->interp_func_ptr = cubic;
     
     /* Open the sound file. */
-    self->info.format = 0;
-    self->sf = sf_open(self->path, SFM_READ, &self->info);
-    if (self->sf == NULL)
+    self->ds = PyoDiskStream_open(self->path, &self->info, 0);
+    if (self->ds == NULL)
     {
         printf("Failed to open the file.\n");
     }
@@ -2226,6 +2202,8 @@ SfMarkerLooper_init(SfMarkerLooper *self, PyObject *args, PyObject *kwds)
     
     self->samplesBuffer = (MYFLT *)realloc(self->samplesBuffer, self->bufsize * self->sndChnls * sizeof(MYFLT));
     
+    PyoDiskStream_setBlocking(self->ds, ((Server *)self->server)->audio_be_type == PyoOffline);
+
     srand((unsigned)(time(0)));
     
     Py_INCREF(self);
@@ -2242,65 +2220,13 @@ static PyObject * SfMarkerLooper_stop(SfMarkerLooper *self) { STOP };
 static PyObject *
 SfMarkerLooper_setSpeed(SfMarkerLooper *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->speed);
-	if (isNumber == 1) {
-		self->speed = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->speed = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->speed, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->speed_stream);
-        self->speed_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(speed, 0)
 }	
 
 static PyObject *
 SfMarkerLooper_setMark(SfMarkerLooper *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->mark);
-	if (isNumber == 1) {
-		self->mark = PyNumber_Float(tmp);
-        self->modebuffer[1] = 0;
-	}
-	else {
-		self->mark = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->mark, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->mark_stream);
-        self->mark_stream = (Stream *)streamtmp;
-		self->modebuffer[1] = 1;
-	}
-
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(mark, 1)
 }	
 
 static PyObject *
@@ -2335,6 +2261,7 @@ SfMarkerLooper_setInterp(SfMarkerLooper *self, PyObject *arg)
 MYFLT *
 SfMarkerLooper_getSamplesBuffer(SfMarkerLooper *self)
 {
+    Stream_touch(self->stream);
     return (MYFLT *)self->samplesBuffer;
 }    
 
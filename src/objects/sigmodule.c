@@ -181,33 +181,7 @@ Sig_init(Sig *self, PyObject *args, PyObject *kwds)
 static PyObject *
 Sig_setValue(Sig *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-    Py_DECREF(self->value);
-	if (isNumber == 1) {
-		self->value = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-    }
-    else {
-		self->value = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->value, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->value_stream);
-        self->value_stream = (Stream *)streamtmp;
-        self->modebuffer[2] = 1;
-    }
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(value, 2)
 }	
 
 static PyObject * Sig_getServer(Sig* self) { GET_SERVER };
@@ -555,33 +529,7 @@ SigTo_init(SigTo *self, PyObject *args, PyObject *kwds)
 static PyObject *
 SigTo_setValue(SigTo *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-    Py_DECREF(self->value);
-	if (isNumber == 1) {
-		self->value = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-    }
-    else {
-		self->value = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->value, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->value_stream);
-        self->value_stream = (Stream *)streamtmp;
-        self->modebuffer[2] = 1;
-    }
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(value, 2)
 }	
 
 static PyObject *
@@ -755,10 +703,18 @@ typedef struct {
     int flag;
 } VarPort;
 
+/* Control side, see Server_postCallback. */
+static void
+VarPort_callFunction(PyObject *obj, double value)
+{
+    VarPort *self = (VarPort *)obj;
+
+    Server_callPython(self->callable, self->arg);
+}
+
 static void
 VarPort_generates_i(VarPort *self) {
     int i;
-    PyObject *tuple;
 
     if (self->value != self->lastValue) {
         self->flag = 1;
@@ -779,17 +735,8 @@ VarPort_generates_i(VarPort *self) {
     
     if (self->timeCount >= self->timeout && self->flag == 1) {
         self->flag = 0;
-        if (self->callable != Py_None) {
-            if (self->arg != Py_None) {
-                tuple = PyTuple_New(1);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-            }
-            else {
-                tuple = PyTuple_New(0);
-            }
-
-            PyObject_Call(self->callable, tuple, NULL);
-        }   
+        if (self->callable != Py_None)
+            Server_postCallback(self->server, VarPort_callFunction, (PyObject *)self, 0.0);
     }
 }
 
@@ -896,6 +843,7 @@ VarPort_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->arg = Py_None;
 
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
     Stream_setFunctionPtr(self->stream, VarPort_compute_next_data_frame);
     self->mode_func_ptr = VarPort_setProcMode;
     
@@ -26,6 +26,7 @@
 #include "servermodule.h"
 #include "dummymodule.h"
 #include "sndfile.h"
+#include "sndmap.h"
 #include "wind.h"
 
 #define __TABLE_MODULE
@@ -59,6 +60,7 @@ void
 TableStream_setData(TableStream *self, MYFLT *data)
 {
     self->data = data;
+    self->version++;
 }    
 
 int
@@ -71,8 +73,23 @@ void
 TableStream_setSize(TableStream *self, int size)
 {
     self->size = size;
+    self->version++;
 }    
 
+/* Objects caching data computed from the table (ie. Convolve) compare
+   this value with the one they saw to know if the table has changed. */
+int
+TableStream_getVersion(TableStream *self)
+{
+    return self->version;
+}
+
+void
+TableStream_incVersion(TableStream *self)
+{
+    self->version++;
+}
+
 double
 TableStream_getSamplingRate(TableStream *self)
 {
@@ -142,6 +159,7 @@ HarmTable_generate(HarmTable *self) {
     int i, j, ampsize;
     MYFLT factor, amplitude, val;
     
+    TableStream_incVersion(self->tablestream);
     ampsize = PyList_Size(self->amplist);
     MYFLT array[ampsize];
     for(j=0; j<ampsize; j++) {
@@ -199,6 +217,7 @@ HarmTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (HarmTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->amplist = PyList_New(0);
     PyList_Append(self->amplist, PyFloat_FromDouble(1.));
@@ -376,6 +395,7 @@ ChebyTable_generate(ChebyTable *self) {
     int i, j, ampsize, halfsize;
     MYFLT factor, amplitude, val, ihalfsize, index, x;
     
+    TableStream_incVersion(self->tablestream);
     ampsize = PyList_Size(self->amplist);
     if (ampsize > 12)
         ampsize = 12;
@@ -475,6 +495,7 @@ ChebyTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (ChebyTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->amplist = PyList_New(0);
     PyList_Append(self->amplist, PyFloat_FromDouble(1.));
@@ -651,6 +672,7 @@ HannTable_generate(HannTable *self) {
     int i, halfSize;
     MYFLT val;
     
+    TableStream_incVersion(self->tablestream);
     halfSize = self->size / 2 - 1;
     
     for(i=0; i<self->size; i++) {
@@ -693,6 +715,7 @@ HannTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (HannTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->size = 8192;
     
@@ -832,6 +855,7 @@ typedef struct {
 
 static void
 WinTable_generate(WinTable *self) {
+    TableStream_incVersion(self->tablestream);
     gen_window(self->data, self->size, self->type);
     self->data[self->size] = self->data[0];
 }
@@ -868,6 +892,7 @@ WinTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (WinTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->size = 8192;
     self->type = 2;
@@ -1032,6 +1057,7 @@ ParaTable_generate(ParaTable *self) {
     int i, sizeMinusOne;
     MYFLT rdur, rdur2, level, slope, curve;
     
+    TableStream_incVersion(self->tablestream);
     sizeMinusOne = self->size - 1;
     rdur = 1.0 / sizeMinusOne;
     rdur2 = rdur * rdur;
@@ -1081,6 +1107,7 @@ ParaTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (ParaTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->size = 8192;
     
@@ -1226,6 +1253,7 @@ LinTable_generate(LinTable *self) {
     int x1, y1;
     MYFLT x2, y2, diff;
     
+    TableStream_incVersion(self->tablestream);
     y1 = 0;
     y2 = 0.0;
 
@@ -1293,6 +1321,7 @@ LinTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (LinTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->pointslist = PyList_New(0);
     self->size = 8192;
@@ -1507,6 +1536,7 @@ CosTable_generate(CosTable *self) {
     int x1, y1;
     MYFLT x2, y2, mu, mu2;
         
+    TableStream_incVersion(self->tablestream);
     y1 = 0;
     y2 = 0.0;
     
@@ -1576,6 +1606,7 @@ CosTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (CosTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->pointslist = PyList_New(0);
     self->size = 8192;
@@ -1794,6 +1825,7 @@ CurveTable_generate(CurveTable *self) {
     MYFLT m0, m1, mu, mu2, mu3;
     MYFLT a0, a1, a2, a3;
 
+    TableStream_incVersion(self->tablestream);
     for (i=0; i<self->size; i++) {
         self->data[i] = 0.0;
     }
@@ -1884,6 +1916,7 @@ CurveTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (CurveTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->pointslist = PyList_New(0);
     self->size = 8192;
@@ -2146,6 +2179,7 @@ ExpTable_generate(ExpTable *self) {
     int x1, x2;
     MYFLT y1, y2, range, inc, pointer, scl; 
     
+    TableStream_incVersion(self->tablestream);
     for (i=0; i<self->size; i++) {
         self->data[i] = 0.0;
     }
@@ -2235,6 +2269,7 @@ ExpTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (ExpTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->pointslist = PyList_New(0);
     self->size = 8192;
@@ -2489,14 +2524,65 @@ typedef struct {
     int chnl;
     MYFLT start;
     MYFLT stop;
+    int mapped; /* shares a memory mapped copy of the sound (see sndmap.h) */
+    PyoSndMap *map; /* NULL when the table owns its data */
 } SndTable;
 
+static int
+SndTable_loadMapped(SndTable *self) {
+    PyoSndMap *map;
+
+    map = PyoSndMap_acquire(self->path, self->start, self->stop);
+    if (map == NULL)
+        return -1;
+
+    if (self->map != NULL)
+        PyoSndMap_release(self->map);
+    else
+        free(self->data);
+    self->map = map;
+    self->data = PyoSndMap_getData(map, self->chnl);
+    self->size = PyoSndMap_getSize(map);
+    self->sndSr = PyoSndMap_getSamplingRate(map);
+
+    self->start = 0.0;
+    self->stop = -1.0;
+    TableStream_setSize(self->tablestream, self->size);
+    TableStream_setSamplingRate(self->tablestream, self->sndSr);
+    TableStream_setData(self->tablestream, self->data);
+    return 0;
+}
+
+/* Gives the table its own copy of the samples before writing to them. */
+static void
+SndTable_detach(SndTable *self) {
+    MYFLT *data;
+
+    if (self->map == NULL)
+        return;
+    data = (MYFLT *)malloc((self->size + 1) * sizeof(MYFLT));
+    memcpy(data, self->data, (self->size + 1) * sizeof(MYFLT));
+    PyoSndMap_release(self->map);
+    self->map = NULL;
+    self->data = data;
+    TableStream_setData(self->tablestream, self->data);
+}
+
 static void
 SndTable_loadSound(SndTable *self) {
     SNDFILE *sf;
     SF_INFO info;
     unsigned int i, num, num_items, num_chnls, snd_size, start, stop;
+    long first, last;
     MYFLT *tmp;
+
+    if (self->mapped && SndTable_loadMapped(self) == 0)
+        return;
+    if (self->map != NULL) {
+        PyoSndMap_release(self->map);
+        self->map = NULL;
+        self->data = NULL;
+    }
         
     info.format = 0;
     sf = sf_open(self->path, SFM_READ, &info);
@@ -2508,15 +2594,9 @@ SndTable_loadSound(SndTable *self) {
     self->sndSr = info.samplerate;
     num_chnls = info.channels;
 
-    if (self->stop <= 0 || self->stop <= self->start || (self->stop*self->sndSr) > snd_size)
-        stop = snd_size;
-    else
-        stop = (unsigned int)(self->stop * self->sndSr);
-
-    if (self->start < 0 || (self->start*self->sndSr) > snd_size)
-        start = 0;
-    else
-        start = (unsigned int)(self->start * self->sndSr);
+    PyoSndMap_getRange(self->start, self->stop, self->sndSr, snd_size, &first, &last);
+    start = first;
+    stop = last;
     
     self->size = stop - start;
     num_items = self->size * num_chnls;
@@ -2563,7 +2643,10 @@ SndTable_clear(SndTable *self)
 static void
 SndTable_dealloc(SndTable* self)
 {
-    free(self->data);
+    if (self->map != NULL)
+        PyoSndMap_release(self->map);
+    else
+        free(self->data);
     SndTable_clear(self);
     self->ob_type->tp_free((PyObject*)self);
 }
@@ -2576,9 +2659,12 @@ SndTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (SndTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->chnl = 0;
     self->stop = -1.0;
+    self->mapped = 0;
+    self->map = NULL;
 
     MAKE_NEW_TABLESTREAM(self->tablestream, &TableStreamType, NULL);
     
@@ -2588,9 +2674,9 @@ SndTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 static int
 SndTable_init(SndTable *self, PyObject *args, PyObject *kwds)
 {    
-    static char *kwlist[] = {"path", "chnl", "start", "stop", NULL};
+    static char *kwlist[] = {"path", "chnl", "start", "stop", "mapped", NULL};
     
-    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_S_IFF, kwlist, &self->path, &self->chnl, &self->start, &self->stop))
+    if (! PyArg_ParseTupleAndKeywords(args, kwds, TYPE_S_IFFI, kwlist, &self->path, &self->chnl, &self->start, &self->stop, &self->mapped))
         return -1; 
     
     SndTable_loadSound(self);
@@ -2601,10 +2687,10 @@ SndTable_init(SndTable *self, PyObject *args, PyObject *kwds)
 
 static PyObject * SndTable_getServer(SndTable* self) { GET_SERVER };
 static PyObject * SndTable_getTableStream(SndTable* self) { GET_TABLE_STREAM };
-static PyObject * SndTable_setData(SndTable *self, PyObject *arg) { SET_TABLE_DATA };
-static PyObject * SndTable_normalize(SndTable *self) { NORMALIZE };
+static PyObject * SndTable_setData(SndTable *self, PyObject *arg) { SndTable_detach(self); SET_TABLE_DATA };
+static PyObject * SndTable_normalize(SndTable *self) { SndTable_detach(self); NORMALIZE };
 static PyObject * SndTable_getTable(SndTable *self) { GET_TABLE };
-static PyObject * SndTable_put(SndTable *self, PyObject *args, PyObject *kwds) { TABLE_PUT };
+static PyObject * SndTable_put(SndTable *self, PyObject *args, PyObject *kwds) { SndTable_detach(self); TABLE_PUT };
 static PyObject * SndTable_get(SndTable *self, PyObject *args, PyObject *kwds) { TABLE_GET };
 
 static PyObject * 
@@ -2743,6 +2829,7 @@ NewTable_recordChunk(NewTable *self, MYFLT *data, int datasize)
 {
     int i;
 
+    TableStream_incVersion(self->tablestream);
     if (self->feedback == 0.0) {
         for (i=0; i<datasize; i++) {
             self->data[self->pointer++] = data[i];
@@ -2795,6 +2882,7 @@ NewTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (NewTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->pointer = 0;
     self->feedback = 0.0;
@@ -2887,6 +2975,7 @@ NewTable_setTable(NewTable *self, PyObject *value)
     for(i=0; i<self->size; i++) {
         self->data[i] = PyFloat_AS_DOUBLE(PyNumber_Float(PyList_GET_ITEM(value, i)));
     }
+    TableStream_incVersion(self->tablestream);
     
     Py_RETURN_NONE;    
 }
@@ -3013,6 +3102,7 @@ DataTable_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (DataTable *)type->tp_alloc(type, 0);
     
     self->server = PyServer_get_server();
+    Py_INCREF(self->server);
     
     self->pointer = 0;
     
@@ -3098,6 +3188,7 @@ DataTable_setTable(DataTable *self, PyObject *value)
     for(i=0; i<self->size; i++) {
         self->data[i] = PyFloat_AS_DOUBLE(PyNumber_Float(PyList_GET_ITEM(value, i)));
     }
+    TableStream_incVersion(self->tablestream);
     
     Py_RETURN_NONE;    
 }
@@ -3267,6 +3358,8 @@ TableRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->fadetime = 0.;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
 
     Stream_setFunctionPtr(self->stream, TableRec_compute_next_data_frame);
     Stream_setStreamActive(self->stream, 0);
@@ -3292,6 +3385,7 @@ TableRec_init(TableRec *self, PyObject *args, PyObject *kwds)
     Py_XDECREF(self->input_stream);
     self->input_stream = (Stream *)input_streamtmp;
     
+    Py_INCREF(tabletmp);
     Py_XDECREF(self->table);
     self->table = (NewTable *)tabletmp;
     
@@ -3351,6 +3445,7 @@ TableRec_setTable(TableRec *self, PyObject *arg)
 MYFLT *
 TableRec_getTrigsBuffer(TableRec *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
@@ -3654,6 +3749,8 @@ TableMorph_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self = (TableMorph *)type->tp_alloc(type, 0);
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     
     Stream_setFunctionPtr(self->stream, TableMorph_compute_next_data_frame);
     
@@ -3948,6 +4045,8 @@ TrigTableRec_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->fadetime = 0.;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     
     Stream_setFunctionPtr(self->stream, TrigTableRec_compute_next_data_frame);
     
@@ -3979,6 +4078,7 @@ TrigTableRec_init(TrigTableRec *self, PyObject *args, PyObject *kwds)
     Py_XDECREF(self->trig_stream);
     self->trig_stream = (Stream *)trig_streamtmp;
     
+    Py_INCREF(tabletmp);
     Py_XDECREF(self->table);
     self->table = (NewTable *)tabletmp;
     
@@ -4032,6 +4132,7 @@ TrigTableRec_setTable(TrigTableRec *self, PyObject *arg)
 MYFLT *
 TrigTableRec_getTrigsBuffer(TrigTableRec *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
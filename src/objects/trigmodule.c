@@ -243,35 +243,7 @@ static PyObject * TrigRandInt_inplace_div(TrigRandInt *self, PyObject *arg) { IN
 static PyObject *
 TrigRandInt_setMax(TrigRandInt *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->max);
-	if (isNumber == 1) {
-		self->max = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->max = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->max, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->max_stream);
-        self->max_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(max, 2)
 }	
 
 static PyMemberDef TrigRandInt_members[] = {
@@ -718,69 +690,13 @@ static PyObject * TrigRand_inplace_div(TrigRand *self, PyObject *arg) { INPLACE_
 static PyObject *
 TrigRand_setMin(TrigRand *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->min);
-	if (isNumber == 1) {
-		self->min = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->min = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->min, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->min_stream);
-        self->min_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(min, 2)
 }	
 
 static PyObject *
 TrigRand_setMax(TrigRand *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->max);
-	if (isNumber == 1) {
-		self->max = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->max = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->max, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->max_stream);
-        self->max_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(max, 3)
 }	
 
 static PyObject *
@@ -1295,23 +1211,23 @@ typedef struct {
     PyObject *func;
 } TrigFunc;
 
+/* Control side, see Server_postCallback. */
+static void
+TrigFunc_callFunction(PyObject *obj, double value)
+{
+    TrigFunc *self = (TrigFunc *)obj;
+
+    Server_callPython(self->func, self->arg);
+}
+
 static void
 TrigFunc_generate(TrigFunc *self) {
     int i;
-    PyObject *tuple;
     MYFLT *in = Stream_getData((Stream *)self->input_stream);
     
     for (i=0; i<self->bufsize; i++) {
-        if (in[i] == 1) {
-            if (self->arg == Py_None)
-                PyObject_Call(self->func, PyTuple_New(0), NULL);
-            else {
-                tuple = PyTuple_New(1);
-                PyTuple_SET_ITEM(tuple, 0, self->arg);
-                PyObject_Call(self->func, tuple, NULL);                
-            }
-
-        }    
+        if (in[i] == 1)
+            Server_postCallback(self->server, TrigFunc_callFunction, (PyObject *)self, 0.0);
     }
 }
 
@@ -1363,6 +1279,7 @@ TrigFunc_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
     self->arg = Py_None;
 
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
     Stream_setFunctionPtr(self->stream, TrigFunc_compute_next_data_frame);
     return (PyObject *)self;
 }
@@ -1788,8 +1705,7 @@ TrigEnv_setTable(TrigEnv *self, PyObject *arg)
 	}
     
 	tmp = arg;
-	Py_DECREF(self->table);
-    self->table = PyObject_CallMethod((PyObject *)tmp, "getTableStream", "");
+    SWAP_FIELD(table, PyObject_CallMethod((PyObject *)tmp, "getTableStream", ""))
     
 	Py_INCREF(Py_None);
 	return Py_None;
@@ -1798,35 +1714,7 @@ TrigEnv_setTable(TrigEnv *self, PyObject *arg)
 static PyObject *
 TrigEnv_setDur(TrigEnv *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->dur);
-	if (isNumber == 1) {
-		self->dur = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->dur = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->dur, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->dur_stream);
-        self->dur_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(dur, 2)
 }	
 
 static PyObject *
@@ -1852,6 +1740,7 @@ TrigEnv_setInterp(TrigEnv *self, PyObject *arg)
 MYFLT *
 TrigEnv_getTrigsBuffer(TrigEnv *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
@@ -2407,6 +2296,8 @@ TrigLinseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[1] = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, TrigLinseg_compute_next_data_frame);
     self->mode_func_ptr = TrigLinseg_setProcMode;
 
@@ -2502,6 +2393,7 @@ TrigLinseg_setList(TrigLinseg *self, PyObject *value)
 MYFLT *
 TrigLinseg_getTrigsBuffer(TrigLinseg *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
@@ -3081,6 +2973,8 @@ TrigExpseg_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
 	self->modebuffer[1] = 0;
     
     INIT_OBJECT_COMMON
+    Stream_setStreamSerial(self->stream, 1);
+    Stream_setStreamPython(self->stream, 1);
     Stream_setFunctionPtr(self->stream, TrigExpseg_compute_next_data_frame);
     self->mode_func_ptr = TrigExpseg_setProcMode;
     
@@ -3204,6 +3098,7 @@ TrigExpseg_setInverse(TrigExpseg *self, PyObject *arg)
 MYFLT *
 TrigExpseg_getTrigsBuffer(TrigExpseg *self)
 {
+    Stream_touch(self->stream);
     int i;
     for (i=0; i<self->bufsize; i++) {
         self->tempTrigsBuffer[i] = self->trigsBuffer[i];
@@ -4161,69 +4056,13 @@ TrigXnoise_setType(TrigXnoise *self, PyObject *arg)
 static PyObject *
 TrigXnoise_setX1(TrigXnoise *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->x1);
-	if (isNumber == 1) {
-		self->x1 = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->x1 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->x1, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->x1_stream);
-        self->x1_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(x1, 2)
 }	
 
 static PyObject *
 TrigXnoise_setX2(TrigXnoise *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->x2);
-	if (isNumber == 1) {
-		self->x2 = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->x2 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->x2, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->x2_stream);
-        self->x2_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(x2, 3)
 }	
 
 static PyMemberDef TrigXnoise_members[] = {
@@ -5006,69 +4845,13 @@ TrigXnoiseMidi_setRange(TrigXnoiseMidi *self, PyObject *args)
 static PyObject *
 TrigXnoiseMidi_setX1(TrigXnoiseMidi *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->x1);
-	if (isNumber == 1) {
-		self->x1 = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->x1 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->x1, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->x1_stream);
-        self->x1_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(x1, 2)
 }	
 
 static PyObject *
 TrigXnoiseMidi_setX2(TrigXnoiseMidi *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->x2);
-	if (isNumber == 1) {
-		self->x2 = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->x2 = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->x2, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->x2_stream);
-        self->x2_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(x2, 3)
 }	
 
 static PyMemberDef TrigXnoiseMidi_members[] = {
@@ -5844,35 +5627,7 @@ static PyObject * Thresh_inplace_div(Thresh *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Thresh_setThreshold(Thresh *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->threshold);
-	if (isNumber == 1) {
-		self->threshold = PyNumber_Float(tmp);
-        self->modebuffer[0] = 0;
-	}
-	else {
-		self->threshold = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->threshold, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->threshold_stream);
-        self->threshold_stream = (Stream *)streamtmp;
-		self->modebuffer[0] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(threshold, 0)
 }	
 
 static PyObject *
@@ -6214,35 +5969,7 @@ static PyObject * Percent_inplace_div(Percent *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 Percent_setPercent(Percent *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->percent);
-	if (isNumber == 1) {
-		self->percent = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->percent = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->percent, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->percent_stream);
-        self->percent_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(percent, 2)
 }	
 
 static PyMemberDef Percent_members[] = {
@@ -874,35 +874,7 @@ static PyObject * Interp_inplace_div(Interp *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 Interp_setInterp(Interp *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->interp);
-	if (isNumber == 1) {
-		self->interp = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->interp = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->interp, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->interp_stream);
-        self->interp_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(interp, 2)
 }
 
 static PyMemberDef Interp_members[] = {
@@ -1258,35 +1230,7 @@ static PyObject * SampHold_inplace_div(SampHold *self, PyObject *arg) { INPLACE_
 static PyObject *
 SampHold_setValue(SampHold *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->value);
-	if (isNumber == 1) {
-		self->value = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->value = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->value, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->value_stream);
-        self->value_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(value, 2)
 }
 
 static PyMemberDef SampHold_members[] = {
@@ -1669,6 +1613,8 @@ Compare_setComp(Compare *self, PyObject *arg)
     
     (*self->mode_func_ptr)(self);
     
+	Server_graphChanged((PyObject *)self->server);
+
 	Py_INCREF(Py_None);
 	return Py_None;
 }
@@ -2081,69 +2027,13 @@ static PyObject * Between_inplace_div(Between *self, PyObject *arg) { INPLACE_DI
 static PyObject *
 Between_setMin(Between *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->min);
-	if (isNumber == 1) {
-		self->min = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->min = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->min, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->min_stream);
-        self->min_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(min, 2)
 }	
 
 static PyObject *
 Between_setMax(Between *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-	
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->max);
-	if (isNumber == 1) {
-		self->max = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->max = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->max, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->max_stream);
-        self->max_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(max, 3)
 }	
 
 static PyMemberDef Between_members[] = {
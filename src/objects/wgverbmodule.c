@@ -591,103 +591,19 @@ static PyObject * WGVerb_inplace_div(WGVerb *self, PyObject *arg) { INPLACE_DIV
 static PyObject *
 WGVerb_setFeedback(WGVerb *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->feedback);
-	if (isNumber == 1) {
-		self->feedback = PyNumber_Float(tmp);
-        self->modebuffer[2] = 0;
-	}
-	else {
-		self->feedback = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->feedback, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->feedback_stream);
-        self->feedback_stream = (Stream *)streamtmp;
-		self->modebuffer[2] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(feedback, 2)
 }	
 
 static PyObject *
 WGVerb_setCutoff(WGVerb *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->cutoff);
-	if (isNumber == 1) {
-		self->cutoff = PyNumber_Float(tmp);
-        self->modebuffer[3] = 0;
-	}
-	else {
-		self->cutoff = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->cutoff, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->cutoff_stream);
-        self->cutoff_stream = (Stream *)streamtmp;
-		self->modebuffer[3] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(cutoff, 3)
 }	
 
 static PyObject *
 WGVerb_setMix(WGVerb *self, PyObject *arg)
 {
-	PyObject *tmp, *streamtmp;
-	
-	if (arg == NULL) {
-		Py_INCREF(Py_None);
-		return Py_None;
-	}
-    
-	int isNumber = PyNumber_Check(arg);
-    
-	tmp = arg;
-	Py_INCREF(tmp);
-	Py_DECREF(self->mix);
-	if (isNumber == 1) {
-		self->mix = PyNumber_Float(tmp);
-        self->modebuffer[4] = 0;
-	}
-	else {
-		self->mix = tmp;
-        streamtmp = PyObject_CallMethod((PyObject *)self->mix, "_getStream", NULL);
-        Py_INCREF(streamtmp);
-        Py_XDECREF(self->mix_stream);
-        self->mix_stream = (Stream *)streamtmp;
-		self->modebuffer[4] = 1;
-	}
-    
-    (*self->mode_func_ptr)(self);
-    
-	Py_INCREF(Py_None);
-	return Py_None;
+    SET_PARAM(mix, 4)
 }	
 
 static PyMemberDef WGVerb_members[] = {
@@ -0,0 +1,67 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Arithmetic expressions fused into Dummy objects, rendered offline.
+
+Run with: python tests/test_dummy.py
+
+"""
+import os, tempfile, unittest
+from pyo import *
+
+s = Server(sr=44100, nchnls=1, buffersize=64, duplex=0, audio="offline")
+
+class DummyTest(unittest.TestCase):
+    def setUp(self):
+        s.boot()
+        fd, self.filename = tempfile.mkstemp(suffix=".wav")
+        os.close(fd)
+        s.recordOptions(dur=.01, filename=self.filename)
+        self.lfo = Sig(1)
+
+    def tearDown(self):
+        s.shutdown()
+        os.remove(self.filename)
+
+    def render(self):
+        s.start()
+
+    def test_fused(self):
+        m = self.lfo * .5
+        f = (m + 200).play()
+        self.render()
+        # `m` is copied into `f` and never built.
+        self.assertTrue(m._objs is None)
+        self.assertAlmostEqual(f.get(), 200.5, 3)
+
+    def test_mul_after_fusion(self):
+        m = self.lfo * .5
+        f = (m + 200).play()
+        m.mul = 2
+        self.render()
+        self.assertAlmostEqual(m.get(), 2, 3)
+        self.assertAlmostEqual(f.get(), 202, 3)
+
+    def test_add_after_fusion(self):
+        m = self.lfo * .5
+        f = m + 200
+        m.setAdd(10)
+        f.play()
+        self.render()
+        self.assertAlmostEqual(f.get(), 210.5, 3)
+
+    def test_chain_after_fusion(self):
+        m = self.lfo * .5
+        f = m + 200
+        g = (f * 2).play()
+        h = (m - 1).play()
+        m.mul = 3
+        self.render()
+        self.assertAlmostEqual(g.get(), 406, 3)
+        self.assertAlmostEqual(h.get(), 2, 3)
+        f.add = 100
+        self.render()
+        self.assertAlmostEqual(g.get(), 206, 3)
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Pattern's calls on the server's timeline, rendered offline.
+
+Run with: python tests/test_pattern.py
+
+"""
+import os, tempfile, unittest
+from pyo import *
+
+SR = 44100
+
+s = Server(sr=SR, nchnls=1, buffersize=64, duplex=0, audio="offline")
+
+class PatternTest(unittest.TestCase):
+    def setUp(self):
+        s.boot()
+        fd, self.filename = tempfile.mkstemp(suffix=".wav")
+        os.close(fd)
+        # 683 buffers of 64 samples, 0.991 second.
+        s.recordOptions(dur=.99, filename=self.filename)
+        self.calls = []
+
+    def tearDown(self):
+        s.setCommandDelay(0)
+        s.shutdown()
+        os.remove(self.filename)
+
+    def call(self):
+        self.calls.append(1)
+
+    def render(self, pat):
+        s.start()
+        pat.stop()
+
+    def test_time(self):
+        p = Pattern(self.call, time=.1).play()
+        self.render(p)
+        self.assertEqual(len(self.calls), 10)
+
+    def shorten(self, delay):
+        p = Pattern(self.call, time=10).play()
+        def shorten():
+            p.time = .05
+        s.setCommandDelay(delay)
+        a = CallAfter(shorten, time=.35)
+        self.render(p)
+        # 0, then right away at .35 (the last call plus .05 is past), then every .05.
+        self.assertEqual(len(self.calls), 14)
+
+    def test_shorten_time(self):
+        self.shorten(0)
+
+    def test_shorten_time_queued(self):
+        # Goes through the command ring, applied by the audio side.
+        self.shorten(.01)
+
+    def test_audio_rate_time(self):
+        t = Sig(.1)
+        p = Pattern(self.call, time=t).play()
+        def shorten():
+            t.value = .05
+        a = CallAfter(shorten, time=.5)
+        self.render(p)
+        # 0 to .4 every .1, then every .05 from .5, where .4 plus .05 is past.
+        self.assertEqual(len(self.calls), 15)
+
+    def test_stopped_server(self):
+        # Calls at 0, 21870, then 43740, due in the buffer after the rendering.
+        p = Pattern(self.call, time=21870./SR).play()
+        s.start()
+        self.assertEqual(len(self.calls), 2)
+        # Applied by this thread, the server being stopped, which must not fire the events.
+        a = Sig(0)
+        a.value = 1
+        self.assertEqual(len(self.calls), 2)
+        p.stop()
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,44 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Objects created by renderBatch's jobs, kept after the renderings.
+
+Run with: python tests/test_renderbatch.py
+
+"""
+import os, gc, tempfile, unittest
+from pyo import *
+
+s = Server(audio="offline")
+
+class RenderBatchTest(unittest.TestCase):
+    def setUp(self):
+        self.filenames = []
+        for i in range(3):
+            fd, filename = tempfile.mkstemp(suffix=".wav")
+            os.close(fd)
+            self.filenames.append(filename)
+        self.kept = []
+
+    def tearDown(self):
+        for filename in self.filenames:
+            os.remove(filename)
+
+    def patch(self, freq):
+        a = Sine(freq, mul=.1)
+        self.kept.append(a)
+        return a.out()
+
+    def test_objects_outlive_servers(self):
+        jobs = [(self.patch, .2, filename, (100 * (i + 1),)) for i, filename in enumerate(self.filenames)]
+        renderBatch(jobs, threads=2, verbosity=0)
+        gc.collect()
+        # The standalone Servers are shut down but still referenced by their objects.
+        for a in self.kept:
+            self.assertTrue(isinstance(a._base_objs[0].getServer(), Server_base))
+        del a
+        del self.kept[:]
+        gc.collect()
+
+if __name__ == "__main__":
+    unittest.main()
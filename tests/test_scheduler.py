@@ -0,0 +1,53 @@
+#!/usr/bin/env python
+# encoding: utf-8
+"""
+Multi-threaded processing must render exactly as the serial one, offline.
+
+Run with: python tests/test_scheduler.py
+
+"""
+import os, tempfile, unittest
+from pyo import *
+
+SR = 44100
+
+s = Server(sr=SR, nchnls=1, buffersize=64, duplex=0, audio="offline")
+
+class SchedulerTest(unittest.TestCase):
+    def setUp(self):
+        fd, self.filename = tempfile.mkstemp(suffix=".wav")
+        os.close(fd)
+
+    def tearDown(self):
+        os.remove(self.filename)
+
+    def render(self, threads, build):
+        s.setThreads(threads)
+        s.boot()
+        s.recordOptions(dur=.2, filename=self.filename)
+        t = NewTable(.2)
+        objs = build()
+        rec = TableRec(objs[-1], t).play()
+        s.start()
+        samples = t._base_objs[0].getTable()
+        s.shutdown()
+        return samples
+
+    def selector(self):
+        # Inputs 2 and 3 are deeper than 0 and 1 and are only read once the voice reaches them.
+        ins = [Sine(freq=100), Sine(freq=150)]
+        ins += [Biquad(Biquad(Sine(freq=100*(i+2), mul=.5), freq=500+i), freq=1000) for i in range(2)]
+        voice = Phasor(5, mul=3)
+        return ins + [voice, Selector(ins, voice=voice)]
+
+    def assertSameSamples(self, a, b):
+        # assertEqual's diff of two long lists takes forever, reports the first different sample instead.
+        diff = [i for i in range(len(a)) if a[i] != b[i]]
+        self.assertEqual(diff[:1], [], "first different sample: %s" % diff[:1])
+
+    def test_selector(self):
+        serial = self.render(1, self.selector)
+        self.assertSameSamples(self.render(4, self.selector), serial)
+
+if __name__ == "__main__":
+    unittest.main()